@@ -29,6 +29,10 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
 
  dnl Check for internationalization functions in libewf/libewf_i18n.c 
  AC_CHECK_FUNCS([bindtextdomain])
+
+ dnl Check for memory mapped file headers and functions in libewf/libewf_mapped_file_pool.c
+ AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+ AC_CHECK_FUNCS([mmap munmap])
  ])
 
 dnl Function to detect whether version 1 API support should be enabled
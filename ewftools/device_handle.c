@@ -27,8 +27,10 @@
 #include "device_handle.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libcsystem.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
@@ -221,6 +223,24 @@ int device_handle_free(
 	}
 	if( *device_handle != NULL )
 	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *device_handle )->read_ahead_thread_pool != NULL )
+		{
+			if( device_handle_stop_read_ahead(
+			     *device_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop read-ahead.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		memory_free(
 		 ( *device_handle )->input_buffer );
 
@@ -931,6 +951,24 @@ int device_handle_close(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->read_ahead_thread_pool != NULL )
+	{
+		if( device_handle_stop_read_ahead(
+		     device_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		if( libsmdev_handle_close(
@@ -983,7 +1021,9 @@ int device_handle_close(
 }
 
 /* Reads a buffer from the input of the device handle
- * Returns the number of bytes written or -1 on error
+ * If read-ahead was started the buffer is obtained from the read-ahead thread
+ * in which case the read size must match that of the read-ahead buffer
+ * Returns the number of bytes read or -1 on error
  */
 ssize_t device_handle_read_buffer(
          device_handle_t *device_handle,
@@ -991,7 +1031,156 @@ ssize_t device_handle_read_buffer(
          size_t read_size,
          libcerror_error_t **error )
 {
-	static char *function = "device_handle_read_buffer";
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	device_handle_read_ahead_buffer_t *read_ahead_buffer = NULL;
+#endif
+	static char *function                                = "device_handle_read_buffer";
+	ssize_t read_count                                   = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( device_handle->read_ahead_thread_pool != NULL )
+	{
+		if( device_handle->number_of_queued_read_ahead_buffers <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid device handle - no read-ahead buffers remaining.",
+			 function );
+
+			return( -1 );
+		}
+		/* The read-ahead thread reads sequentially hence the buffers are popped in order
+		 */
+		if( libcthreads_queue_pop(
+		     device_handle->read_ahead_queue,
+		     (intptr_t **) &read_ahead_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop read-ahead buffer from queue.",
+			 function );
+
+			return( -1 );
+		}
+		device_handle->number_of_queued_read_ahead_buffers -= 1;
+
+		if( read_ahead_buffer->read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from input.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_size != read_ahead_buffer->read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: read size value does not match size of read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = read_ahead_buffer->read_count;
+
+		if( memory_copy(
+		     buffer,
+		     read_ahead_buffer->data,
+		     (size_t) read_count ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		if( device_handle->remaining_read_ahead_size > 0 )
+		{
+			if( device_handle_push_read_ahead_buffer(
+			     device_handle,
+			     read_ahead_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push read-ahead buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+#endif
+	{
+		read_count = device_handle_read_input_buffer(
+		              device_handle,
+		              buffer,
+		              read_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from input.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( read_count );
+}
+
+/* Reads a buffer directly from the input handle of the device handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t device_handle_read_input_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "device_handle_read_input_buffer";
 	ssize_t read_count    = 0;
 
 	if( device_handle == NULL )
@@ -1079,6 +1268,442 @@ ssize_t device_handle_read_buffer(
 	return( read_count );
 }
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Starts reading ahead from the current offset of the input
+ * The read-ahead thread keeps the read-ahead buffers in flight and reads
+ * the input sequentially in blocks of buffer size up to the read-ahead size
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_start_read_ahead(
+     device_handle_t *device_handle,
+     int number_of_buffers,
+     size_t buffer_size,
+     size64_t read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function          = "device_handle_start_read_ahead";
+	size_t read_ahead_buffers_size = 0;
+	int buffer_index               = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( device_handle->read_ahead_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid device handle - read-ahead thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers < 2 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid number of buffers value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead_buffers_size = sizeof( device_handle_read_ahead_buffer_t ) * number_of_buffers;
+
+	device_handle->read_ahead_buffers = (device_handle_read_ahead_buffer_t *) memory_allocate(
+	                                                                           read_ahead_buffers_size );
+
+	if( device_handle->read_ahead_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     device_handle->read_ahead_buffers,
+	     0,
+	     read_ahead_buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead buffers.",
+		 function );
+
+		memory_free(
+		 device_handle->read_ahead_buffers );
+
+		device_handle->read_ahead_buffers = NULL;
+
+		goto on_error;
+	}
+	device_handle->number_of_read_ahead_buffers = number_of_buffers;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		device_handle->read_ahead_buffers[ buffer_index ].data = (uint8_t *) memory_allocate(
+		                                                                      sizeof( uint8_t ) * buffer_size );
+
+		if( device_handle->read_ahead_buffers[ buffer_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read-ahead buffer: %d data.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_queue_initialize(
+	     &( device_handle->read_ahead_queue ),
+	     number_of_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( device_handle->read_ahead_thread_pool ),
+	     NULL,
+	     1,
+	     number_of_buffers,
+	     (int (*)(intptr_t *, void *)) &device_handle_read_ahead,
+	     (void *) device_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	device_handle->read_ahead_buffer_size    = buffer_size;
+	device_handle->remaining_read_ahead_size = read_ahead_size;
+	device_handle->read_ahead_failed         = 0;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( device_handle->remaining_read_ahead_size == 0 )
+		{
+			break;
+		}
+		if( device_handle_push_read_ahead_buffer(
+		     device_handle,
+		     &( device_handle->read_ahead_buffers[ buffer_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push read-ahead buffer: %d.",
+			 function,
+			 buffer_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	device_handle_stop_read_ahead(
+	 device_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Stops reading ahead
+ * Waits until the reads that are in flight have completed
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_stop_read_ahead(
+     device_handle_t *device_handle,
+     libcerror_error_t **error )
+{
+	device_handle_read_ahead_buffer_t *read_ahead_buffer = NULL;
+	static char *function                                = "device_handle_stop_read_ahead";
+	int buffer_index                                     = 0;
+	int result                                           = 1;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The remaining read-ahead buffers are not pushed again
+	 */
+	device_handle->remaining_read_ahead_size = 0;
+
+	/* Popping every queued read-ahead buffer waits for the reads in flight
+	 */
+	while( device_handle->number_of_queued_read_ahead_buffers > 0 )
+	{
+		if( libcthreads_queue_pop(
+		     device_handle->read_ahead_queue,
+		     (intptr_t **) &read_ahead_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop read-ahead buffer from queue.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		device_handle->number_of_queued_read_ahead_buffers -= 1;
+	}
+	if( device_handle->read_ahead_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( device_handle->read_ahead_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join read-ahead thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	device_handle->number_of_queued_read_ahead_buffers = 0;
+
+	/* The read-ahead buffers are owned by the device handle
+	 * hence the queue does not free them
+	 */
+	if( device_handle->read_ahead_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( device_handle->read_ahead_queue ),
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( device_handle->read_ahead_buffers != NULL )
+	{
+		for( buffer_index = 0;
+		     buffer_index < device_handle->number_of_read_ahead_buffers;
+		     buffer_index++ )
+		{
+			if( device_handle->read_ahead_buffers[ buffer_index ].data != NULL )
+			{
+				memory_free(
+				 device_handle->read_ahead_buffers[ buffer_index ].data );
+			}
+		}
+		memory_free(
+		 device_handle->read_ahead_buffers );
+
+		device_handle->read_ahead_buffers = NULL;
+	}
+	device_handle->number_of_read_ahead_buffers = 0;
+	device_handle->read_ahead_buffer_size       = 0;
+	device_handle->read_ahead_failed            = 0;
+
+	return( result );
+}
+
+/* Pushes a read-ahead buffer onto the read-ahead thread pool
+ * The buffer is used to read the next block of the remaining read-ahead size
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_push_read_ahead_buffer(
+     device_handle_t *device_handle,
+     device_handle_read_ahead_buffer_t *read_ahead_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "device_handle_push_read_ahead_buffer";
+	size_t read_size      = 0;
+
+	if( device_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid device handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	read_size = device_handle->read_ahead_buffer_size;
+
+	if( (size64_t) read_size > device_handle->remaining_read_ahead_size )
+	{
+		read_size = (size_t) device_handle->remaining_read_ahead_size;
+	}
+	read_ahead_buffer->read_size  = read_size;
+	read_ahead_buffer->read_count = 0;
+
+	if( libcthreads_thread_pool_push(
+	     device_handle->read_ahead_thread_pool,
+	     (intptr_t *) read_ahead_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push read-ahead buffer onto thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	device_handle->remaining_read_ahead_size          -= read_size;
+	device_handle->number_of_queued_read_ahead_buffers += 1;
+
+	return( 1 );
+}
+
+/* Reads a read-ahead buffer from the input
+ * Callback function for the read-ahead thread pool
+ * Error retries and zeroing the buffer on error are handled by the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int device_handle_read_ahead(
+     device_handle_read_ahead_buffer_t *read_ahead_buffer,
+     device_handle_t *device_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "device_handle_read_ahead";
+	int result               = 1;
+
+	if( read_ahead_buffer == NULL )
+	{
+		return( -1 );
+	}
+	/* Once reading failed the remaining read-ahead buffers are not read
+	 */
+	if( device_handle->read_ahead_failed != 0 )
+	{
+		read_ahead_buffer->read_count = -1;
+	}
+	else
+	{
+		read_ahead_buffer->read_count = device_handle_read_input_buffer(
+		                                 device_handle,
+		                                 read_ahead_buffer->data,
+		                                 read_ahead_buffer->read_size,
+		                                 &error );
+
+		if( read_ahead_buffer->read_count < 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read buffer from input.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			device_handle->read_ahead_failed = 1;
+
+			result = -1;
+		}
+	}
+	/* The read-ahead buffer is always pushed onto the queue
+	 * so that the reader does not wait indefinitely
+	 */
+	if( libcthreads_queue_push(
+	     device_handle->read_ahead_queue,
+	     (intptr_t *) read_ahead_buffer,
+	     &error ) != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to push read-ahead buffer onto queue.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Seeks the offset in the input file
  * Returns the new offset if successful or -1 on error
  */
@@ -1101,6 +1726,26 @@ off64_t device_handle_seek_offset(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Seeking invalidates the data that was read ahead
+	 */
+	if( device_handle->read_ahead_thread_pool != NULL )
+	{
+		if( device_handle_stop_read_ahead(
+		     device_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( device_handle->type == DEVICE_HANDLE_TYPE_DEVICE )
 	{
 		offset = libsmdev_handle_seek_offset(
@@ -27,6 +27,7 @@
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libodraw.h"
 #include "ewftools_libsmdev.h"
 #include "ewftools_libsmraw.h"
@@ -72,6 +73,27 @@ enum DEVICE_HANDLE_TRACK_TYPES
 	DEVICE_HANDLE_TRACK_TYPE_CDI_2352,
 };
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+typedef struct device_handle_read_ahead_buffer device_handle_read_ahead_buffer_t;
+
+struct device_handle_read_ahead_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The size of the data to read
+	 */
+	size_t read_size;
+
+	/* The number of bytes read or -1 on error
+	 */
+	ssize_t read_count;
+};
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 typedef struct device_handle device_handle_t;
 
 struct device_handle
@@ -115,6 +137,43 @@ struct device_handle
 	/* The nofication output stream
 	 */
 	FILE *notify_stream;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The read-ahead thread pool
+	 * a single thread that reads the input sequentially
+	 */
+	libcthreads_thread_pool_t *read_ahead_thread_pool;
+
+	/* The read-ahead queue, contains the buffers in the order they were read
+	 */
+	libcthreads_queue_t *read_ahead_queue;
+
+	/* The read-ahead buffers
+	 */
+	device_handle_read_ahead_buffer_t *read_ahead_buffers;
+
+	/* The number of read-ahead buffers
+	 */
+	int number_of_read_ahead_buffers;
+
+	/* The number of read-ahead buffers that were pushed onto the thread pool
+	 * and not yet popped from the queue
+	 */
+	int number_of_queued_read_ahead_buffers;
+
+	/* The read-ahead buffer size
+	 */
+	size_t read_ahead_buffer_size;
+
+	/* The size that remains to be read ahead
+	 */
+	size64_t remaining_read_ahead_size;
+
+	/* Value to indicate reading ahead failed
+	 * only accessed by the read-ahead thread
+	 */
+	int read_ahead_failed;
+#endif
 };
 
 const char *device_handle_get_track_type(
@@ -166,6 +225,36 @@ ssize_t device_handle_read_buffer(
          size_t read_size,
          libcerror_error_t **error );
 
+ssize_t device_handle_read_input_buffer(
+         device_handle_t *device_handle,
+         uint8_t *buffer,
+         size_t read_size,
+         libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int device_handle_start_read_ahead(
+     device_handle_t *device_handle,
+     int number_of_buffers,
+     size_t buffer_size,
+     size64_t read_ahead_size,
+     libcerror_error_t **error );
+
+int device_handle_stop_read_ahead(
+     device_handle_t *device_handle,
+     libcerror_error_t **error );
+
+int device_handle_push_read_ahead_buffer(
+     device_handle_t *device_handle,
+     device_handle_read_ahead_buffer_t *read_ahead_buffer,
+     libcerror_error_t **error );
+
+int device_handle_read_ahead(
+     device_handle_read_ahead_buffer_t *read_ahead_buffer,
+     device_handle_t *device_handle );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 off64_t device_handle_seek_offset(
          device_handle_t *device_handle,
          off64_t offset,
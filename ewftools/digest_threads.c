@@ -0,0 +1,844 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_threads.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Frees a digest buffer
+ * Returns 1 if successful or -1 on error
+ */
+int digest_buffer_free(
+     digest_buffer_t **digest_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_buffer_free";
+
+	if( digest_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_buffer != NULL )
+	{
+		if( ( *digest_buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *digest_buffer )->data );
+		}
+		memory_free(
+		 *digest_buffer );
+
+		*digest_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Creates digest threads
+ * Creates a thread for every digest context that is not NULL
+ * Make sure the value digest_threads is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_initialize(
+     digest_threads_t **digest_threads,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	digest_buffer_t *digest_buffer = NULL;
+	static char *function          = "digest_threads_initialize";
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_threads != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest threads value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_threads = memory_allocate_structure(
+	                   digest_threads_t );
+
+	if( *digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest threads.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_threads,
+	     0,
+	     sizeof( digest_threads_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest threads.",
+		 function );
+
+		memory_free(
+		 *digest_threads );
+
+		*digest_threads = NULL;
+
+		return( -1 );
+	}
+	( *digest_threads )->md5_context    = md5_context;
+	( *digest_threads )->sha1_context   = sha1_context;
+	( *digest_threads )->sha256_context = sha256_context;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_threads )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( ( *digest_threads )->buffer_queue ),
+	     DIGEST_THREADS_NUMBER_OF_BUFFERS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create buffer queue.",
+		 function );
+
+		goto on_error;
+	}
+	/* The data of the buffers is allocated on demand
+	 */
+	while( ( *digest_threads )->number_of_buffers < DIGEST_THREADS_NUMBER_OF_BUFFERS )
+	{
+		digest_buffer = memory_allocate_structure(
+		                 digest_buffer_t );
+
+		if( digest_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create digest buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     digest_buffer,
+		     0,
+		     sizeof( digest_buffer_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear digest buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     ( *digest_threads )->buffer_queue,
+		     (intptr_t *) digest_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push digest buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		digest_buffer = NULL;
+
+		( *digest_threads )->number_of_buffers += 1;
+	}
+	if( md5_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_threads )->md5_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_threads_update_md5,
+		     (void *) *digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create MD5 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_threads )->number_of_threads += 1;
+	}
+	if( sha1_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_threads )->sha1_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_threads_update_sha1,
+		     (void *) *digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA1 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_threads )->number_of_threads += 1;
+	}
+	if( sha256_context != NULL )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( ( *digest_threads )->sha256_thread_pool ),
+		     NULL,
+		     1,
+		     DIGEST_THREADS_NUMBER_OF_BUFFERS,
+		     (int (*)(intptr_t *, void *)) &digest_threads_update_sha256,
+		     (void *) *digest_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create SHA256 thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		( *digest_threads )->number_of_threads += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( digest_buffer != NULL )
+	{
+		memory_free(
+		 digest_buffer );
+	}
+	if( *digest_threads != NULL )
+	{
+		digest_threads_free(
+		 digest_threads,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees digest threads
+ * Waits until the digest hash threads processed all the queued buffers
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_free(
+     digest_threads_t **digest_threads,
+     libcerror_error_t **error )
+{
+	digest_buffer_t *digest_buffer = NULL;
+	static char *function          = "digest_threads_free";
+	int buffer_index               = 0;
+	int result                     = 1;
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_threads != NULL )
+	{
+		/* Popping every buffer from the queue waits for the threads to finish
+		 */
+		for( buffer_index = 0;
+		     buffer_index < ( *digest_threads )->number_of_buffers;
+		     buffer_index++ )
+		{
+			if( libcthreads_queue_pop(
+			     ( *digest_threads )->buffer_queue,
+			     (intptr_t **) &digest_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to pop digest buffer from queue.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			if( digest_buffer_free(
+			     &digest_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->md5_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_threads )->md5_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join MD5 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->sha1_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_threads )->sha1_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA1 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->sha256_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *digest_threads )->sha256_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join SHA256 thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->buffer_queue != NULL )
+		{
+			if( libcthreads_queue_free(
+			     &( ( *digest_threads )->buffer_queue ),
+			     (int (*)(intptr_t **, libcerror_error_t **)) &digest_buffer_free,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free buffer queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *digest_threads )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_threads )->update_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash(es).",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *digest_threads );
+
+		*digest_threads = NULL;
+	}
+	return( result );
+}
+
+/* Releases a reference to a digest buffer
+ * The buffer is returned to the queue when the last reference is released
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_release_buffer(
+     digest_threads_t *digest_threads,
+     digest_buffer_t *digest_buffer,
+     int result )
+{
+	int reference_count = 0;
+
+	if( ( digest_threads == NULL )
+	 || ( digest_buffer == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_threads->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		digest_threads->update_failed = 1;
+	}
+	digest_buffer->reference_count -= 1;
+
+	reference_count = digest_buffer->reference_count;
+
+	if( libcthreads_mutex_release(
+	     digest_threads->mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	if( reference_count == 0 )
+	{
+		if( libcthreads_queue_push(
+		     digest_threads->buffer_queue,
+		     (intptr_t *) digest_buffer,
+		     NULL ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates the MD5 digest hash
+ * Callback function for the MD5 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_update_md5(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_threads_update_md5";
+	int result               = 1;
+
+	if( ( digest_buffer == NULL )
+	 || ( digest_threads == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libhmac_md5_update(
+	     digest_threads->md5_context,
+	     digest_buffer->data,
+	     digest_buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to update MD5 digest hash.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( digest_threads_release_buffer(
+	     digest_threads,
+	     digest_buffer,
+	     result ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Updates the SHA1 digest hash
+ * Callback function for the SHA1 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_update_sha1(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_threads_update_sha1";
+	int result               = 1;
+
+	if( ( digest_buffer == NULL )
+	 || ( digest_threads == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libhmac_sha1_update(
+	     digest_threads->sha1_context,
+	     digest_buffer->data,
+	     digest_buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to update SHA1 digest hash.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( digest_threads_release_buffer(
+	     digest_threads,
+	     digest_buffer,
+	     result ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Updates the SHA256 digest hash
+ * Callback function for the SHA256 thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_update_sha256(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "digest_threads_update_sha256";
+	int result               = 1;
+
+	if( ( digest_buffer == NULL )
+	 || ( digest_threads == NULL ) )
+	{
+		return( -1 );
+	}
+	if( libhmac_sha256_update(
+	     digest_threads->sha256_context,
+	     digest_buffer->data,
+	     digest_buffer->data_size,
+	     &error ) != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to update SHA256 digest hash.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	if( digest_threads_release_buffer(
+	     digest_threads,
+	     digest_buffer,
+	     result ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+}
+
+/* Queues a copy of the data to be processed by the digest hash threads
+ * Blocks until a buffer is available if all buffers are in use
+ * Returns 1 if successful or -1 on error
+ */
+int digest_threads_update(
+     digest_threads_t *digest_threads,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libcthreads_thread_pool_t *thread_pools[ 3 ];
+
+	digest_buffer_t *digest_buffer = NULL;
+	static char *function          = "digest_threads_update";
+	void *reallocation             = NULL;
+	int number_of_unqueued_threads = 0;
+	int thread_pool_index          = 0;
+	int update_failed              = 0;
+
+	if( digest_threads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_threads->number_of_threads == 0 )
+	{
+		return( 1 );
+	}
+	if( libcthreads_queue_pop(
+	     digest_threads->buffer_queue,
+	     (intptr_t **) &digest_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop digest buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer is not referenced by any thread until it is pushed
+	 * onto the first thread pool, hence the reference count is set upfront
+	 */
+	digest_buffer->reference_count = digest_threads->number_of_threads;
+	number_of_unqueued_threads     = digest_threads->number_of_threads;
+
+	if( libcthreads_mutex_grab(
+	     digest_threads->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	update_failed = digest_threads->update_failed;
+
+	if( libcthreads_mutex_release(
+	     digest_threads->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( update_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash(es).",
+		 function );
+
+		goto on_error;
+	}
+	if( buffer_size > digest_buffer->allocated_data_size )
+	{
+		reallocation = memory_reallocate(
+		                digest_buffer->data,
+		                sizeof( uint8_t ) * buffer_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize digest buffer data.",
+			 function );
+
+			goto on_error;
+		}
+		digest_buffer->data                = (uint8_t *) reallocation;
+		digest_buffer->allocated_data_size = buffer_size;
+	}
+	if( memory_copy(
+	     digest_buffer->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer to digest buffer.",
+		 function );
+
+		goto on_error;
+	}
+	digest_buffer->data_size = buffer_size;
+
+	thread_pools[ 0 ] = digest_threads->md5_thread_pool;
+	thread_pools[ 1 ] = digest_threads->sha1_thread_pool;
+	thread_pools[ 2 ] = digest_threads->sha256_thread_pool;
+
+	for( thread_pool_index = 0;
+	     thread_pool_index < 3;
+	     thread_pool_index++ )
+	{
+		if( thread_pools[ thread_pool_index ] == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_push(
+		     thread_pools[ thread_pool_index ],
+		     (intptr_t *) digest_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push digest buffer onto thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_unqueued_threads -= 1;
+	}
+	return( 1 );
+
+on_error:
+	/* Release the references of the threads the buffer was not pushed to
+	 */
+	while( number_of_unqueued_threads > 0 )
+	{
+		digest_threads_release_buffer(
+		 digest_threads,
+		 digest_buffer,
+		 -1 );
+
+		number_of_unqueued_threads -= 1;
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,163 @@
+/*
+ * Digest hash threads
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_THREADS_H )
+#define _DIGEST_THREADS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of buffers that can be queued for the digest hash threads
+ */
+#define DIGEST_THREADS_NUMBER_OF_BUFFERS	16
+
+typedef struct digest_buffer digest_buffer_t;
+
+struct digest_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The allocated size of the data
+	 */
+	size_t allocated_data_size;
+
+	/* The number of digest hash threads that have not yet processed the buffer
+	 */
+	int reference_count;
+};
+
+typedef struct digest_threads digest_threads_t;
+
+/* The digest threads calculate each digest hash on a dedicated thread
+ * The data is copied into a reference counted buffer that is passed to
+ * every digest hash thread and is reused once all of them processed it
+ */
+struct digest_threads
+{
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The MD5 thread pool
+	 */
+	libcthreads_thread_pool_t *md5_thread_pool;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA1 thread pool
+	 */
+	libcthreads_thread_pool_t *sha1_thread_pool;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The SHA256 thread pool
+	 */
+	libcthreads_thread_pool_t *sha256_thread_pool;
+
+	/* The number of digest hash threads
+	 */
+	int number_of_threads;
+
+	/* The buffer queue
+	 * contains the buffers that are not in use
+	 */
+	libcthreads_queue_t *buffer_queue;
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+	/* The mutex
+	 * protects the buffer reference counts and the update failed value
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* Value to indicate if updating a digest hash failed
+	 */
+	int update_failed;
+};
+
+int digest_buffer_free(
+     digest_buffer_t **digest_buffer,
+     libcerror_error_t **error );
+
+int digest_threads_initialize(
+     digest_threads_t **digest_threads,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int digest_threads_free(
+     digest_threads_t **digest_threads,
+     libcerror_error_t **error );
+
+int digest_threads_release_buffer(
+     digest_threads_t *digest_threads,
+     digest_buffer_t *digest_buffer,
+     int result );
+
+int digest_threads_update_md5(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads );
+
+int digest_threads_update_sha1(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads );
+
+int digest_threads_update_sha256(
+     digest_buffer_t *digest_buffer,
+     digest_threads_t *digest_threads );
+
+int digest_threads_update(
+     digest_threads_t *digest_threads,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
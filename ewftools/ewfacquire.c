@@ -113,9 +113,9 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                  [ -C case_number ] [ -d digest_type ] [ -D description ]\n"
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
-	                 "                  [ -g number_of_sectors ] [ -l log_filename ]\n"
-	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                  [ -g number_of_sectors ] [ -j number_of_threads ]\n"
+	                 "                  [ -l log_filename ] [ -m media_type ] [ -M media_flags ]\n"
+	                 "                  [ -N notes ] [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
 	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
@@ -147,6 +147,12 @@ void ewfacquire_usage_fprint(
 	                 "\t        encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-g      specify the number of sectors to be used as error granularity\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     specify the number of threads used to compress the chunks,\n"
+	                 "\t        the input is then read ahead and every digest (hash)\n"
+	                 "\t        calculated on its own thread\n"
+	                 "\t        (default is 0, which represents single-threaded mode)\n"
+	                 "\t        when resuming an acquiry the chunks are compressed\n"
+	                 "\t        single-threaded\n" );
 	fprintf( stream, "\t-l:     logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m:     specify the media type, options: fixed (default), removable,\n"
 	                 "\t        optical, memory\n" );
@@ -550,29 +556,6 @@ int ewfacquire_determine_sessions(
 	return( 1 );
 }
 
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-
-/* Prepares a storage media buffer for writing
- * Callback function for the process thread pool
- * Returns 1 if successful or -1 on error
- */
-int ewfacquire_process_storage_media_buffer(
-     storage_media_buffer_t *storage_media_buffer,
-     void *arguments LIBCSYSTEM_ATTRIBUTE_UNUSED )
-{
-        libcerror_error_t *error = NULL;
-        static char *function    = "cthreads_test_thread_pool_callback_function";
-        int result               = 0;
-
-	LIBCSYSTEM_UNREFERENCED_PARAMETER( arguments )
-
-	/* TODO */
-
-	return( -1 );
-}
-
-#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
-
 /* Reads the input
  * Returns 1 if successful or -1 on error
  */
@@ -587,9 +570,6 @@ int ewfacquire_read_input(
      log_handle_t *log_handle,
      libcerror_error_t **error )
 {
-#if defined( HAVE_MULTI_THREAD_SUPPORT )
-	libcthreads_thread_pool_t *process_thread_pool = NULL;
-#endif
 	process_status_t *process_status               = NULL;
 	storage_media_buffer_t *storage_media_buffer   = NULL;
 	uint8_t *data                                  = NULL;
@@ -605,8 +585,10 @@ int ewfacquire_read_input(
 	ssize_t write_count                            = 0;
 	uint32_t chunk_size                            = 0;
 	uint8_t storage_media_buffer_mode              = 0;
+	uint8_t read_ahead_started                     = 0;
 	int number_of_read_errors                      = 0;
 	int read_error_iterator                        = 0;
+	int result                                     = 0;
 	int status                                     = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -653,11 +635,18 @@ int ewfacquire_read_input(
 
 		return( -1 );
 	}
+	/* Resuming reads back the chunks that were already written
+	 * which cannot be combined with preparing chunks on multiple threads
+	 */
+	if( resume_acquiry_offset > 0 )
+	{
+		use_multi_threading = 0;
+	}
 #if !defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( use_multi_threading != 0 )
 	{
 		libcerror_error_set(
-		 &error,
+		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
 		 "%s: multi-threading not supported.",
@@ -797,21 +786,18 @@ int ewfacquire_read_input(
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
 	if( use_multi_threading != 0 )
 	{
-/* TODO multi-processing set up processing and write threads */
-		if( libcthreads_thread_pool_create(
-		     &process_thread_pool,
-		     NULL,
-		     4,
-		     256,
-		     NULL,
-		     NULL,
+		if( imaging_handle_initialize_threads(
+		     imaging_handle,
+		     imaging_handle->number_of_threads,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize integrity hash(es).",
+			 "%s: unable to initialize threads.",
 			 function );
 
 			goto on_error;
@@ -866,11 +852,24 @@ int ewfacquire_read_input(
 	{
 		if( storage_media_buffer == NULL )
 		{
-			if( storage_media_buffer_initialize(
-			     &storage_media_buffer,
-			     storage_media_buffer_mode,
-			     process_buffer_size,
-			     error ) != 1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( use_multi_threading != 0 )
+			{
+				result = imaging_handle_get_storage_media_buffer(
+				          imaging_handle,
+				          &storage_media_buffer,
+				          error );
+			}
+			else
+#endif
+			{
+				result = storage_media_buffer_initialize(
+				          &storage_media_buffer,
+				          storage_media_buffer_mode,
+				          process_buffer_size,
+				          error );
+			}
+			if( result != 1 )
 			{
 				libcerror_error_set(
 				 error,
@@ -890,6 +889,32 @@ int ewfacquire_read_input(
 		}
 		if( (off64_t) acquiry_count >= resume_acquiry_offset )
 		{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The input is read ahead from the first offset that is read from the device
+			 * which is also done when resuming an acquiry
+			 */
+			if( ( imaging_handle->number_of_threads > 0 )
+			 && ( read_ahead_started == 0 ) )
+			{
+				if( device_handle_start_read_ahead(
+				     device_handle,
+				     EWFCOMMON_NUMBER_OF_READ_AHEAD_BUFFERS,
+				     process_buffer_size,
+				     (size64_t) imaging_handle->acquiry_size - acquiry_count,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to start read-ahead.",
+					 function );
+
+					goto on_error;
+				}
+				read_ahead_started = 1;
+			}
+#endif
 			read_count = device_handle_read_buffer(
 				      device_handle,
 				      storage_media_buffer->raw_buffer,
@@ -1056,11 +1081,32 @@ int ewfacquire_read_input(
 		}
 		if( (off64_t) acquiry_count >= resume_acquiry_offset )
 		{
-			if( use_multi_threading != 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			/* The first storage media buffer is prepared and written by this thread
+			 * so that the write values of the output handle are initialized
+			 * before the process threads prepare storage media buffers
+			 */
+			if( ( use_multi_threading != 0 )
+			 && ( acquiry_count > 0 ) )
 			{
-/* TODO multi-processing */
+				if( imaging_handle_queue_storage_media_buffer(
+				     imaging_handle,
+				     storage_media_buffer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to queue storage media buffer.",
+					 function );
+
+					goto on_error;
+				}
+				storage_media_buffer = NULL;
 			}
 			else
+#endif
 			{
 				process_count = imaging_handle_prepare_write_buffer(
 						 imaging_handle,
@@ -1119,11 +1165,47 @@ int ewfacquire_read_input(
 			break;
 		}
 	}
-	if( storage_media_buffer != NULL )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( read_ahead_started != 0 )
 	{
-		if( storage_media_buffer_free(
-		     &storage_media_buffer,
+		/* Waits for the reads in flight, after which the read errors are complete
+		 */
+		if( device_handle_stop_read_ahead(
+		     device_handle,
 		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+		read_ahead_started = 0;
+	}
+#endif
+	if( storage_media_buffer != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( use_multi_threading != 0 )
+		{
+			result = imaging_handle_release_storage_media_buffer(
+			          imaging_handle,
+			          storage_media_buffer,
+			          error );
+
+			storage_media_buffer = NULL;
+		}
+		else
+#endif
+		{
+			result = storage_media_buffer_free(
+			          &storage_media_buffer,
+			          error );
+		}
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
@@ -1135,7 +1217,26 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
-/* TODO multi-processing */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_multi_threading != 0 )
+	{
+		/* Waits for the remaining storage media buffers to be written
+		 */
+		if( imaging_handle_free_threads(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	if( imaging_handle_finalize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -1224,10 +1325,6 @@ int ewfacquire_read_input(
 	{
 		status = PROCESS_STATUS_ABORTED;
 	}
-	if( use_multi_threading != 0 )
-	{
-/* TODO multi-processing tear down processing and write threads */
-	}
 	if( process_status_stop(
 	     process_status,
 	     acquiry_count,
@@ -1321,6 +1418,29 @@ int ewfacquire_read_input(
 	return( 1 );
 
 on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( read_ahead_started != 0 )
+	{
+		device_handle_stop_read_ahead(
+		 device_handle,
+		 NULL );
+	}
+	if( use_multi_threading != 0 )
+	{
+		if( storage_media_buffer != NULL )
+		{
+			imaging_handle_release_storage_media_buffer(
+			 imaging_handle,
+			 storage_media_buffer,
+			 NULL );
+
+			storage_media_buffer = NULL;
+		}
+		imaging_handle_free_threads(
+		 imaging_handle,
+		 NULL );
+	}
+#endif
 	if( storage_media_buffer != NULL )
 	{
 		storage_media_buffer_free(
@@ -1370,6 +1490,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_media_type                = NULL;
 	libcstring_system_character_t *option_notes                     = NULL;
 	libcstring_system_character_t *option_number_of_error_retries   = NULL;
+	libcstring_system_character_t *option_number_of_threads         = NULL;
 	libcstring_system_character_t *option_offset                    = NULL;
 	libcstring_system_character_t *option_process_buffer_size       = NULL;
 	libcstring_system_character_t *option_secondary_target_filename = NULL;
@@ -1431,7 +1552,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hl:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1516,6 +1637,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -2225,6 +2351,32 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		result = imaging_handle_set_number_of_threads(
+			  ewfacquire_imaging_handle,
+			  option_number_of_threads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 0.\n" );
+		}
+		else
+		{
+			use_multi_threading = 1;
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = imaging_handle_set_additional_digest_types(
@@ -107,11 +107,13 @@ void usage_fprint(
 	                 "                        [ -C case_number ] [ -d digest_type ]\n"
 	                 "                        [ -D description ] [ -e examiner_name ]\n"
 	                 "                        [ -E evidence_number ] [ -f format ]\n"
-	                 "                        [ -l log_filename ] [ -m media_type ]\n"
-	                 "                        [ -M media_flags ] [ -N notes ]\n"
-	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
-	                 "                        [ -t target ] [ -2 secondary_target ]\n"
+	                 "                        [ -j number_of_threads ] [ -l log_filename ]\n"
+	                 "                        [ -m media_type ] [ -M media_flags ]\n"
+	                 "                        [ -N notes ] [ -o offset ]\n"
+	                 "                        [ -p process_buffer_size ]\n"
+	                 "                        [ -P bytes_per_sector ] [ -Q queue_depth ]\n"
+	                 "                        [ -S segment_file_size ] [ -t target ]\n"
+	                 "                        [ -2 secondary_target ]\n"
 	                 "                        [ -hqsvVx ]\n\n" );
 
 	fprintf( stream, "\tReads data from stdin\n\n" );
@@ -140,6 +142,9 @@ void usage_fprint(
 	                 "\t    encase3, encase4, encase5, encase6 (default), encase7, linen5,\n"
 	                 "\t    linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h: shows this help\n" );
+	fprintf( stream, "\t-j: specify the number of threads used to compress the chunks,\n"
+	                 "\t    every digest (hash) is then calculated on its own thread\n"
+	                 "\t    (default is 0, which represents single-threaded mode)\n" );
 	fprintf( stream, "\t-l: logs acquiry errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-m: specify the media type, options: fixed (default), removable,\n"
 	                 "\t    optical, memory\n" );
@@ -149,6 +154,8 @@ void usage_fprint(
 	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
+	fprintf( stream, "\t-Q: specify the maximum number of chunks in flight when using\n"
+	                 "\t    multiple threads (default is 4 per thread, maximum is 1024)\n" );
 	fprintf( stream, "\t-s: swap byte pairs of the media data (from AB to BA)\n"
 	                 "\t    (use this for big to little endian conversion and vice versa)\n" );
 
@@ -466,6 +473,7 @@ int ewfacquirestream_read_input(
      uint8_t swap_byte_pairs,
      uint8_t read_error_retries,
      uint8_t print_status_information,
+     uint8_t use_multi_threading,
      uint8_t use_chunk_data_functions,
      log_handle_t *log_handle,
      libcerror_error_t **error )
@@ -483,6 +491,7 @@ int ewfacquirestream_read_input(
 	ssize_t process_count                        = 0;
 	ssize_t write_count                          = 0;
 	uint8_t storage_media_buffer_mode            = 0;
+	int result                                   = 0;
 	int status                                   = PROCESS_STATUS_COMPLETED;
 
 	if( imaging_handle == NULL )
@@ -518,6 +527,19 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_multi_threading != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	if( imaging_handle_get_chunk_size(
 	     imaging_handle,
 	     &chunk_size,
@@ -543,7 +565,8 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
-	if( use_chunk_data_functions != 0 )
+	if( ( use_multi_threading != 0 )
+	 || ( use_chunk_data_functions != 0 ) )
 	{
 		process_buffer_size       = (size_t) chunk_size;
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA;
@@ -560,21 +583,27 @@ int ewfacquirestream_read_input(
 		}
 		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_BUFFERED;
 	}
-	if( storage_media_buffer_initialize(
-	     &storage_media_buffer,
-	     storage_media_buffer_mode,
-	     process_buffer_size,
-	     error ) != 1 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_multi_threading != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create storage media buffer.",
-		 function );
+		if( imaging_handle_initialize_threads(
+		     imaging_handle,
+		     imaging_handle->number_of_threads,
+		     storage_media_buffer_mode,
+		     process_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize threads.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
+#endif
 	if( imaging_handle_initialize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -622,6 +651,37 @@ int ewfacquirestream_read_input(
 	while( ( imaging_handle->acquiry_size == 0 )
 	    || ( acquiry_count < (size64_t) imaging_handle->acquiry_size ) )
 	{
+		if( storage_media_buffer == NULL )
+		{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( use_multi_threading != 0 )
+			{
+				result = imaging_handle_get_storage_media_buffer(
+				          imaging_handle,
+				          &storage_media_buffer,
+				          error );
+			}
+			else
+#endif
+			{
+				result = storage_media_buffer_initialize(
+				          &storage_media_buffer,
+				          storage_media_buffer_mode,
+				          process_buffer_size,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create storage media buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		read_size = process_buffer_size;
 
 		/* Align with acquiry offset if necessary
@@ -729,38 +789,68 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
-		process_count = imaging_handle_prepare_write_buffer(
-		                 imaging_handle,
-		                 storage_media_buffer,
-		                 error );
-
-		if( process_count < 0 )
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* The first storage media buffer is prepared and written by this thread
+		 * so that the write values of the output handle are initialized
+		 * before the process threads prepare storage media buffers.
+		 * The storage media buffers are written in the order they were read
+		 * hence the total size does not need to be known in advance
+		 */
+		if( ( use_multi_threading != 0 )
+		 && ( acquiry_count > 0 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			"%s: unable to prepare buffer before write.",
-			 function );
+			if( imaging_handle_queue_storage_media_buffer(
+			     imaging_handle,
+			     storage_media_buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue storage media buffer.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
+			storage_media_buffer = NULL;
 		}
-		write_count = imaging_handle_write_buffer(
-		               imaging_handle,
-		               storage_media_buffer,
-		               process_count,
-		               error );
-
-		if( write_count < 0 )
+		else
+#endif
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write data to file.",
-			 function );
+			process_count = imaging_handle_prepare_write_buffer(
+			                 imaging_handle,
+			                 storage_media_buffer,
+			                 error );
 
-			goto on_error;
+			if( process_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				"%s: unable to prepare buffer before write.",
+				 function );
+
+				goto on_error;
+			}
+			write_count = imaging_handle_write_buffer(
+			               imaging_handle,
+			               storage_media_buffer,
+			               process_count,
+			               error );
+
+			if( write_count < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data to file.",
+				 function );
+
+				goto on_error;
+			}
 		}
 		acquiry_count += read_count;
 
@@ -783,19 +873,57 @@ int ewfacquirestream_read_input(
 			break;
 		}
 	}
-	if( storage_media_buffer_free(
-	     &storage_media_buffer,
-	     error ) != 1 )
+	if( storage_media_buffer != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free storage media buffer.",
-		 function );
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( use_multi_threading != 0 )
+		{
+			result = imaging_handle_release_storage_media_buffer(
+			          imaging_handle,
+			          storage_media_buffer,
+			          error );
 
-		goto on_error;
+			storage_media_buffer = NULL;
+		}
+		else
+#endif
+		{
+			result = storage_media_buffer_free(
+			          &storage_media_buffer,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_multi_threading != 0 )
+	{
+		/* Waits for the remaining storage media buffers to be written
+		 */
+		if( imaging_handle_free_threads(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free threads.",
+			 function );
+
+			goto on_error;
+		}
 	}
+#endif
 	if( imaging_handle_finalize_integrity_hash(
 	     imaging_handle,
 	     error ) != 1 )
@@ -906,6 +1034,23 @@ on_error:
 		 &process_status,
 		 NULL );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_multi_threading != 0 )
+	{
+		if( storage_media_buffer != NULL )
+		{
+			imaging_handle_release_storage_media_buffer(
+			 imaging_handle,
+			 storage_media_buffer,
+			 NULL );
+
+			storage_media_buffer = NULL;
+		}
+		imaging_handle_free_threads(
+		 imaging_handle,
+		 NULL );
+	}
+#endif
 	if( storage_media_buffer != NULL )
 	{
 		storage_media_buffer_free(
@@ -939,8 +1084,10 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_media_flags               = NULL;
 	libcstring_system_character_t *option_media_type                = NULL;
 	libcstring_system_character_t *option_notes                     = NULL;
+	libcstring_system_character_t *option_number_of_threads         = NULL;
 	libcstring_system_character_t *option_offset                    = NULL;
 	libcstring_system_character_t *option_process_buffer_size       = NULL;
+	libcstring_system_character_t *option_queue_depth               = NULL;
         libcstring_system_character_t *option_secondary_target_filename = NULL;
         libcstring_system_character_t *option_sectors_per_chunk         = NULL;
 	libcstring_system_character_t *option_size                      = NULL;
@@ -957,6 +1104,7 @@ int main( int argc, char * const argv[] )
 	uint8_t resume_acquiry                                          = 0;
 	uint8_t swap_byte_pairs                                         = 0;
 	uint8_t use_chunk_data_functions                                = 0;
+	uint8_t use_multi_threading                                     = 0;
 	uint8_t verbose                                                 = 0;
 	int result                                                      = 0;
 
@@ -1020,7 +1168,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hl:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qQ:sS:t:vVx2:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1100,6 +1248,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -1140,6 +1293,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'Q':
+				option_queue_depth = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 's':
 				swap_byte_pairs = 1;
 
@@ -1621,6 +1779,54 @@ int main( int argc, char * const argv[] )
 			 "Unsupported process buffer size defaulting to: chunk size.\n" );
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		result = imaging_handle_set_number_of_threads(
+			  ewfacquirestream_imaging_handle,
+			  option_number_of_threads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 0.\n" );
+		}
+		else
+		{
+			use_multi_threading = 1;
+		}
+	}
+	if( option_queue_depth != NULL )
+	{
+		result = imaging_handle_set_queue_depth(
+			  ewfacquirestream_imaging_handle,
+			  option_queue_depth,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set queue depth.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported queue depth defaulting to: 4 per thread.\n" );
+		}
+	}
 	if( option_additional_digest_types != NULL )
 	{
 		result = imaging_handle_set_additional_digest_types(
@@ -1740,6 +1946,7 @@ int main( int argc, char * const argv[] )
 	          swap_byte_pairs,
 	          read_error_retries,
 	          print_status_information,
+	          use_multi_threading,
 	          use_chunk_data_functions,
 	          log_handle,
 	          &error );
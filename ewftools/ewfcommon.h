@@ -32,6 +32,11 @@
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT	INT32_MAX
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT	INT64_MAX
 
+#define EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS			64
+#define EWFCOMMON_NUMBER_OF_STORAGE_MEDIA_BUFFERS_PER_THREAD	4
+#define EWFCOMMON_NUMBER_OF_READ_AHEAD_BUFFERS			4
+#define EWFCOMMON_MAXIMUM_QUEUE_DEPTH				1024
+
 /* This definition is intended for automated testing of variable process buffer sizes
  */
 #if !defined( EWFCOMMON_PROCESS_BUFFER_SIZE )
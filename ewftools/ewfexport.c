@@ -110,7 +110,8 @@ void usage_fprint(
 
 	fprintf( stream, "Usage: ewfexport [ -A codepage ] [ -b number_of_sectors ]\n"
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
-	                 "                 [ -d digest_type ] [ -f format ] [ -l log_filename ]\n"
+	                 "                 [ -d digest_type ] [ -f format ]\n"
+	                 "                 [ -j number_of_threads ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
 	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
 
@@ -138,6 +139,10 @@ void usage_fprint(
 	                 "\t           smart, encase1, encase2, encase3, encase4, encase5, encase6,\n"
 	                 "\t           encase7, encase7-v2, linen5, linen6, linen7, ewfx\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-j:        specify the number of threads used to scan the segment\n"
+	                 "\t           files and to read ahead and decompress the chunks,\n"
+	                 "\t           every digest (hash) is then calculated on its own\n"
+	                 "\t           thread (default is 0, no read-ahead)\n" );
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
@@ -246,6 +251,7 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_compression_values      = NULL;
 	libcstring_system_character_t *option_format                  = NULL;
 	libcstring_system_character_t *option_header_codepage         = NULL;
+	libcstring_system_character_t *option_number_of_threads       = NULL;
 	libcstring_system_character_t *option_maximum_segment_size    = NULL;
 	libcstring_system_character_t *option_offset                  = NULL;
 	libcstring_system_character_t *option_process_buffer_size     = NULL;
@@ -325,7 +331,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hl:o:p:qsS:t:uvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -385,6 +391,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -552,6 +563,28 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
+	if( option_number_of_threads != NULL )
+	{
+		result = export_handle_set_number_of_threads(
+			  ewfexport_export_handle,
+			  option_number_of_threads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 0.\n" );
+		}
+	}
 	if( libcsystem_signal_attach(
 	     ewfexport_signal_handler,
 	     &error ) != 1 )
@@ -93,17 +93,26 @@ void usage_fprint(
 	fprintf( stream, "Use ewfmount to mount the EWF format (Expert Witness\n"
                          "Compression Format)\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ]\n"
-	                 "                ewf_files mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -c cache_size ] [ -f format ] [ -i index_file ]\n"
+	                 "                [ -p cache_policy ] [ -X extended_options ]\n"
+	                 "                [ -hvV ] ewf_files mount_point\n\n" );
 
 	fprintf( stream, "\tewf_files:   the first or the entire set of EWF segment files\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
+	fprintf( stream, "\t-c:          specify the size of the data cache in bytes\n"
+	                 "\t             (default is 8 chunks)\n" );
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default),\n"
 	                 "\t             files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-i:          specify the index file, used to speed up opening\n"
+	                 "\t             the segment files, the index file is created if needed\n" );
+	fprintf( stream, "\t-p:          specify the data cache policy, options: direct (default),\n"
+	                 "\t             2q (keeps repeatedly read data when large amounts of\n"
+	                 "\t             data are read once)\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
-	                 "\t             ewfmount will remain running in the foreground\n" );
+	                 "\t             ewfmount will remain running in the foreground\n"
+	                 "\t             and prints the cache statistics when unmounted\n" );
 	fprintf( stream, "\t-V:          print version\n" );
 	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
 }
@@ -1310,6 +1319,26 @@ void ewfmount_fuse_destroy(
 
 	if( ewfmount_mount_handle != NULL )
 	{
+		if( libcnotify_verbose != 0 )
+		{
+			if( mount_handle_cache_statistics_fprint(
+			     ewfmount_mount_handle,
+			     stderr,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print cache statistics.",
+				 function );
+
+				libcnotify_print_error_backtrace(
+				 error );
+				libcerror_error_free(
+				 &error );
+			}
+		}
 		if( mount_handle_free(
 		     &ewfmount_mount_handle,
 		     &error ) != 1 )
@@ -3090,8 +3119,11 @@ int main( int argc, char * const argv[] )
 
 	libewf_error_t *error                                   = NULL;
 	libcstring_system_character_t *mount_point              = NULL;
+	libcstring_system_character_t *option_cache_policy      = NULL;
+	libcstring_system_character_t *option_cache_size        = NULL;
 	libcstring_system_character_t *option_extended_options  = NULL;
 	libcstring_system_character_t *option_format            = NULL;
+	libcstring_system_character_t *option_index_filename    = NULL;
 	libcstring_system_character_t *program                  = _LIBCSTRING_SYSTEM_STRING( "ewfmount" );
 	libcstring_system_integer_t option                      = 0;
 	int number_of_filenames                                 = 0;
@@ -3147,7 +3179,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "f:hvVX:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "c:f:hi:p:vVX:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -3163,6 +3195,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (libcstring_system_integer_t) 'c':
+				option_cache_size = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'f':
 				option_format = optarg;
 
@@ -3174,6 +3211,16 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'i':
+				option_index_filename = optarg;
+
+				break;
+
+			case (libcstring_system_integer_t) 'p':
+				option_cache_policy = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'v':
 				verbose = 1;
 
@@ -3286,6 +3333,64 @@ int main( int argc, char * const argv[] )
 			 "Unsupported input format defaulting to: raw.\n" );
 		}
 	}
+	if( option_cache_size != NULL )
+	{
+		result = mount_handle_set_cache_size(
+			  ewfmount_mount_handle,
+			  option_cache_size,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set cache size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported cache size defaulting to: 8 chunks.\n" );
+		}
+	}
+	if( option_index_filename != NULL )
+	{
+		if( mount_handle_set_index_filename(
+		     ewfmount_mount_handle,
+		     option_index_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set index filename.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_cache_policy != NULL )
+	{
+		result = mount_handle_set_cache_policy(
+			  ewfmount_mount_handle,
+			  option_cache_policy,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set cache policy.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported cache policy defaulting to: direct.\n" );
+		}
+	}
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
@@ -64,7 +64,8 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfverify [ -A codepage ] [ -d digest_type ] [ -f format ]\n"
-	                 "                 [ -l log_filename ] [ -p process_buffer_size ]\n"
+	                 "                 [ -j number_of_threads ] [ -l log_filename ]\n"
+	                 "                 [ -p process_buffer_size ] [ -Q queue_depth ]\n"
 	                 "                 [ -hqvVwx ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
@@ -79,10 +80,16 @@ void usage_fprint(
 	fprintf( stream, "\t-f:        specify the input format, options: raw (default),\n"
 	                 "\t           files (restricted to logical volume files)\n" );
 	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-j:        specify the number of threads used to scan the segment\n"
+	                 "\t           files and to read ahead and decompress the chunks,\n"
+	                 "\t           every digest (hash) is then calculated on its own\n"
+	                 "\t           thread (default is 0, no read-ahead)\n" );
 	fprintf( stream, "\t-l:        logs verification errors and the digest (hash) to the\n"
 	                 "\t           log_filename\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
+	fprintf( stream, "\t-Q:        specify the asynchronous IO queue depth used to read\n"
+	                 "\t           the segment files (default is 0, synchronous IO)\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
@@ -153,7 +160,9 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_additional_digest_types = NULL;
 	libcstring_system_character_t *option_format                  = NULL;
 	libcstring_system_character_t *option_header_codepage         = NULL;
+	libcstring_system_character_t *option_number_of_threads       = NULL;
 	libcstring_system_character_t *option_process_buffer_size     = NULL;
+	libcstring_system_character_t *option_queue_depth             = NULL;
 
 	log_handle_t *log_handle                                      = NULL;
 
@@ -199,7 +208,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:hl:p:qvVwx" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "A:d:f:hj:l:p:qQ:vVwx" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -236,6 +245,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (libcstring_system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'l':
 				log_filename = optarg;
 
@@ -251,6 +265,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'Q':
+				option_queue_depth = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'v':
 				verbose = 1;
 
@@ -451,6 +470,50 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
+	if( option_number_of_threads != NULL )
+	{
+		result = verification_handle_set_number_of_threads(
+			  ewfverify_verification_handle,
+			  option_number_of_threads,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: 0.\n" );
+		}
+	}
+	if( option_queue_depth != NULL )
+	{
+		result = verification_handle_set_async_io_queue_depth(
+			  ewfverify_verification_handle,
+			  option_queue_depth,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set asynchronous IO queue depth.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported asynchronous IO queue depth defaulting to: 0.\n" );
+		}
+	}
 	if( libcsystem_signal_attach(
 	     ewfverify_signal_handler,
 	     &error ) != 1 )
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_threads.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libewf.h"
@@ -145,6 +146,18 @@ struct export_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+	/* The number of threads
+	 * 0 represents no multi-threading
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads
+	 * calculate the digest hashes on separate threads
+	 */
+	digest_threads_t *digest_threads;
+#endif
+
 	/* The calculated SHA256 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha256_hash_string;
@@ -385,6 +398,11 @@ int export_handle_set_process_buffer_size(
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int export_handle_set_additional_digest_types(
      export_handle_t *export_handle,
      const libcstring_system_character_t *string,
@@ -32,6 +32,7 @@
 
 #include "byte_size_string.h"
 #include "digest_hash.h"
+#include "digest_threads.h"
 #include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
@@ -39,6 +40,7 @@
 #include "ewftools_libcsplit.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libcsystem.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "guid.h"
@@ -285,6 +287,24 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->digest_threads != NULL )
+		{
+			if( digest_threads_free(
+			     &( ( *imaging_handle )->digest_threads ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest threads.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -1155,81 +1175,820 @@ ssize_t imaging_handle_write_buffer(
 		               storage_media_buffer->process_checksum,
 		               error );
 	}
-	else
+	else
+	{
+		write_count = libewf_handle_write_buffer(
+		               imaging_handle->output_handle,
+		               storage_media_buffer->raw_buffer,
+		               write_size,
+		               error );
+	}
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		if( ( error != NULL )
+		 && ( libcerror_error_matches(
+		       *error,
+		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
+		{
+			return( -1 );
+		}
+/* TODO ask for alternative segment file location and try again */
+		return( -1 );
+	}
+	if( imaging_handle->secondary_output_handle != NULL )
+	{
+		if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+		{
+			secondary_write_count = libewf_handle_write_chunk(
+			                         imaging_handle->secondary_output_handle,
+			                         raw_write_buffer,
+			                         raw_write_buffer_size,
+			                         storage_media_buffer->raw_buffer_data_size,
+			                         storage_media_buffer->is_compressed,
+			                         storage_media_buffer->checksum_buffer,
+			                         storage_media_buffer->checksum,
+			                         storage_media_buffer->process_checksum,
+			                         error );
+		}
+		else
+		{
+			secondary_write_count = libewf_handle_write_buffer(
+			                         imaging_handle->secondary_output_handle,
+			                         storage_media_buffer->raw_buffer,
+			                         write_size,
+			                         error );
+		}
+		if( secondary_write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to secondary output handle.",
+			 function );
+
+			if( ( error != NULL )
+			 && ( libcerror_error_matches(
+			       *error,
+			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
+			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
+			{
+				return( -1 );
+			}
+/* TODO ask for alternative segment file location and try again */
+			return( -1 );
+		}
+	}
+	return( write_count );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Initializes the threads used to prepare and write storage media buffers
+ * Creates the storage media buffers, a process thread pool with the number of threads
+ * and an output thread pool with a single thread that writes the storage media buffers in order
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_threads(
+     imaging_handle_t *imaging_handle,
+     int number_of_threads,
+     uint8_t storage_media_buffer_mode,
+     size_t storage_media_buffer_size,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "imaging_handle_initialize_threads";
+	size_t output_storage_media_buffers_size     = 0;
+	int maximum_number_of_storage_media_buffers  = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->process_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid imaging handle - process thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->queue_depth > 0 )
+	{
+		maximum_number_of_storage_media_buffers = imaging_handle->queue_depth;
+	}
+	else
+	{
+		maximum_number_of_storage_media_buffers = number_of_threads * EWFCOMMON_NUMBER_OF_STORAGE_MEDIA_BUFFERS_PER_THREAD;
+	}
+
+	output_storage_media_buffers_size = sizeof( storage_media_buffer_t * ) * maximum_number_of_storage_media_buffers;
+
+	imaging_handle->output_storage_media_buffers = (storage_media_buffer_t **) memory_allocate(
+	                                                                            output_storage_media_buffers_size );
+
+	if( imaging_handle->output_storage_media_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output storage media buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     imaging_handle->output_storage_media_buffers,
+	     0,
+	     output_storage_media_buffers_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output storage media buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( imaging_handle->output_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_initialize(
+	     &( imaging_handle->storage_media_buffer_queue ),
+	     maximum_number_of_storage_media_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create storage media buffer queue.",
+		 function );
+
+		goto on_error;
+	}
+	imaging_handle->number_of_storage_media_buffers = 0;
+	imaging_handle->process_sequence_number         = 0;
+	imaging_handle->output_sequence_number          = 0;
+	imaging_handle->output_failed                   = 0;
+
+	/* The storage media buffers are allocated up front and recycled
+	 * which limits the amount of data that is read ahead of the output
+	 */
+	while( imaging_handle->number_of_storage_media_buffers < maximum_number_of_storage_media_buffers )
+	{
+		if( storage_media_buffer_initialize(
+		     &storage_media_buffer,
+		     storage_media_buffer_mode,
+		     storage_media_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     imaging_handle->storage_media_buffer_queue,
+		     (intptr_t *) storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push storage media buffer onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+
+		imaging_handle->number_of_storage_media_buffers += 1;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( imaging_handle->output_thread_pool ),
+	     NULL,
+	     1,
+	     maximum_number_of_storage_media_buffers,
+	     (int (*)(intptr_t *, void *)) &imaging_handle_output_storage_media_buffer,
+	     (void *) imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( imaging_handle->process_thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     maximum_number_of_storage_media_buffers,
+	     (int (*)(intptr_t *, void *)) &imaging_handle_process_storage_media_buffer,
+	     (void *) imaging_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create process thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_free(
+		 &storage_media_buffer,
+		 NULL );
+	}
+	imaging_handle_free_threads(
+	 imaging_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the threads used to prepare and write storage media buffers
+ * Waits until all the storage media buffers have been written and returned to the queue,
+ * which requires that all storage media buffers obtained by the caller have been released
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_free_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "imaging_handle_free_threads";
+	int result                                   = 1;
+	int storage_media_buffer_index               = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* Popping every storage media buffer from the queue waits for the threads to finish
+	 */
+	for( storage_media_buffer_index = 0;
+	     storage_media_buffer_index < imaging_handle->number_of_storage_media_buffers;
+	     storage_media_buffer_index++ )
+	{
+		if( libcthreads_queue_pop(
+		     imaging_handle->storage_media_buffer_queue,
+		     (intptr_t **) &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to pop storage media buffer from queue.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		if( storage_media_buffer_free(
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->process_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->process_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join process thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->output_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( imaging_handle->output_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	imaging_handle->number_of_storage_media_buffers = 0;
+
+	if( imaging_handle->storage_media_buffer_queue != NULL )
+	{
+		if( libcthreads_queue_free(
+		     &( imaging_handle->storage_media_buffer_queue ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &storage_media_buffer_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free storage media buffer queue.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->output_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( imaging_handle->output_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( imaging_handle->output_storage_media_buffers != NULL )
+	{
+		memory_free(
+		 imaging_handle->output_storage_media_buffers );
+
+		imaging_handle->output_storage_media_buffers = NULL;
+	}
+	if( imaging_handle->output_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		imaging_handle->output_failed = 0;
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves a storage media buffer that is not in use
+ * Blocks until the threads have written a storage media buffer if none is available
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_get_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_get_storage_media_buffer";
+	int output_failed     = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_pop(
+	     imaging_handle->storage_media_buffer_queue,
+	     (intptr_t **) storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to pop storage media buffer from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     imaging_handle->output_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab output mutex.",
+		 function );
+
+		goto on_error;
+	}
+	output_failed = imaging_handle->output_failed;
+
+	if( libcthreads_mutex_release(
+	     imaging_handle->output_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release output mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( output_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_queue_push(
+	 imaging_handle->storage_media_buffer_queue,
+	 (intptr_t *) *storage_media_buffer,
+	 NULL );
+
+	*storage_media_buffer = NULL;
+
+	return( -1 );
+}
+
+/* Releases a storage media buffer that was retrieved but not queued
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_release_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_release_storage_media_buffer";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_push(
+	     imaging_handle->storage_media_buffer_queue,
+	     (intptr_t *) storage_media_buffer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto queue.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prepares a storage media buffer before writing
+ * Callback function for the process thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_process_storage_media_buffer(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "imaging_handle_process_storage_media_buffer";
+	int result               = 1;
+
+	if( storage_media_buffer == NULL )
+	{
+		return( -1 );
+	}
+	storage_media_buffer->process_count = imaging_handle_prepare_write_buffer(
+	                                       imaging_handle,
+	                                       storage_media_buffer,
+	                                       &error );
+
+	if( storage_media_buffer->process_count < 0 )
+	{
+		libcnotify_printf(
+		 "%s: unable to prepare storage media buffer before write.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	/* The storage media buffer is always passed on to the output thread
+	 * which returns it to the queue
+	 */
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->output_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     &error ) != 1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to push storage media buffer onto output thread pool.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Writes the prepared storage media buffers in order of their sequence number
+ * Callback function for the output thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_output_storage_media_buffer(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle )
+{
+	libcerror_error_t *error       = NULL;
+	static char *function          = "imaging_handle_output_storage_media_buffer";
+	ssize_t write_count            = 0;
+	int output_failed              = 0;
+	int result                     = 1;
+	int storage_media_buffer_index = 0;
+
+	if( storage_media_buffer == NULL )
+	{
+		return( -1 );
+	}
+	/* Only the output thread accesses the output storage media buffers
+	 */
+	storage_media_buffer_index = (int) ( storage_media_buffer->sequence_number % imaging_handle->number_of_storage_media_buffers );
+
+	imaging_handle->output_storage_media_buffers[ storage_media_buffer_index ] = storage_media_buffer;
+
+	storage_media_buffer_index = (int) ( imaging_handle->output_sequence_number % imaging_handle->number_of_storage_media_buffers );
+
+	while( imaging_handle->output_storage_media_buffers[ storage_media_buffer_index ] != NULL )
+	{
+		storage_media_buffer = imaging_handle->output_storage_media_buffers[ storage_media_buffer_index ];
+
+		imaging_handle->output_storage_media_buffers[ storage_media_buffer_index ] = NULL;
+
+		/* Once writing failed the remaining storage media buffers are not written
+		 */
+		if( output_failed == 0 )
+		{
+			if( storage_media_buffer->process_count < 0 )
+			{
+				output_failed = 1;
+			}
+			else
+			{
+				write_count = imaging_handle_write_buffer(
+				               imaging_handle,
+				               storage_media_buffer,
+				               (size_t) storage_media_buffer->process_count,
+				               &error );
+
+				if( write_count < 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to write storage media buffer.\n",
+					 function );
+
+					libcnotify_print_error_backtrace(
+					 error );
+					libcerror_error_free(
+					 &error );
+
+					output_failed = 1;
+				}
+			}
+			if( output_failed != 0 )
+			{
+				if( libcthreads_mutex_grab(
+				     imaging_handle->output_mutex,
+				     NULL ) == 1 )
+				{
+					imaging_handle->output_failed = 1;
+
+					libcthreads_mutex_release(
+					 imaging_handle->output_mutex,
+					 NULL );
+				}
+				result = -1;
+			}
+		}
+		imaging_handle->output_sequence_number += 1;
+
+		if( libcthreads_queue_push(
+		     imaging_handle->storage_media_buffer_queue,
+		     (intptr_t *) storage_media_buffer,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to push storage media buffer onto queue.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			result = -1;
+		}
+		storage_media_buffer_index = (int) ( imaging_handle->output_sequence_number % imaging_handle->number_of_storage_media_buffers );
+	}
+	return( result );
+}
+
+/* Queues a storage media buffer to be prepared and written by the threads
+ * The storage media buffers are written in the order they are queued
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_queue_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_queue_storage_media_buffer";
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( imaging_handle->process_thread_pool == NULL )
 	{
-		write_count = libewf_handle_write_buffer(
-		               imaging_handle->output_handle,
-		               storage_media_buffer->raw_buffer,
-		               write_size,
-		               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid imaging handle - missing process thread pool.",
+		 function );
+
+		return( -1 );
 	}
-	if( write_count == -1 )
+	if( storage_media_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write storage media buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
 		 function );
 
-		if( ( error != NULL )
-		 && ( libcerror_error_matches(
-		       *error,
-		       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-		       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
-		{
-			return( -1 );
-		}
-/* TODO ask for alternative segment file location and try again */
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	storage_media_buffer->sequence_number = imaging_handle->process_sequence_number;
+	storage_media_buffer->process_count   = 0;
+
+	if( libcthreads_thread_pool_push(
+	     imaging_handle->process_thread_pool,
+	     (intptr_t *) storage_media_buffer,
+	     error ) != 1 )
 	{
-		if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
-		{
-			secondary_write_count = libewf_handle_write_chunk(
-			                         imaging_handle->secondary_output_handle,
-			                         raw_write_buffer,
-			                         raw_write_buffer_size,
-			                         storage_media_buffer->raw_buffer_data_size,
-			                         storage_media_buffer->is_compressed,
-			                         storage_media_buffer->checksum_buffer,
-			                         storage_media_buffer->checksum,
-			                         storage_media_buffer->process_checksum,
-			                         error );
-		}
-		else
-		{
-			secondary_write_count = libewf_handle_write_buffer(
-			                         imaging_handle->secondary_output_handle,
-			                         storage_media_buffer->raw_buffer,
-			                         write_size,
-			                         error );
-		}
-		if( secondary_write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer to secondary output handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push storage media buffer onto process thread pool.",
+		 function );
 
-			if( ( error != NULL )
-			 && ( libcerror_error_matches(
-			       *error,
-			       LIBCERROR_ERROR_DOMAIN_OUTPUT,
-			       LIBCERROR_OUTPUT_ERROR_INSUFFICIENT_SPACE ) == 0 ) )
-			{
-				return( -1 );
-			}
-/* TODO ask for alternative segment file location and try again */
-			return( -1 );
-		}
+		return( -1 );
 	}
-	return( write_count );
+	imaging_handle->process_sequence_number += 1;
+
+	return( 1 );
 }
 
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 /* Seeks the offset in the input file
  * Returns the new offset if successful or -1 on error
  */
@@ -1509,6 +2268,27 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->number_of_threads > 0 )
+	{
+		if( digest_threads_initialize(
+		     &( imaging_handle->digest_threads ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -1572,6 +2352,27 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_threads != NULL )
+	{
+		if( digest_threads_update(
+		     imaging_handle->digest_threads,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash(es) on digest threads.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1653,6 +2454,26 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_threads != NULL )
+	{
+		/* Waits for the digest threads to process the remaining data
+		 */
+		if( digest_threads_free(
+		     &( imaging_handle->digest_threads ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest threads.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( imaging_handle->calculated_md5_hash_string == NULL )
@@ -3863,6 +4684,152 @@ int imaging_handle_set_process_buffer_size(
 	return( result );
 }
 
+/* Sets the number of threads used to prepare the storage media buffers before writing
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_number_of_threads(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function      = "imaging_handle_set_number_of_threads";
+	int result                 = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	size_t string_length       = 0;
+	uint64_t number_of_threads = 0;
+#endif
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->number_of_threads = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( string[ 0 ] != (libcstring_system_character_t) '-' )
+	{
+		string_length = libcstring_system_string_length(
+				 string );
+
+		if( libcsystem_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine number of threads.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( number_of_threads > 0 )
+		 && ( number_of_threads <= (uint64_t) EWFCOMMON_MAXIMUM_NUMBER_OF_THREADS ) )
+		{
+			imaging_handle->number_of_threads = (int) number_of_threads;
+
+			result = 1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Sets the queue depth, the maximum number of storage media buffers in flight
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_queue_depth(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_queue_depth";
+	int result            = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	size_t string_length  = 0;
+	uint64_t queue_depth  = 0;
+#endif
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	imaging_handle->queue_depth = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( string[ 0 ] != (libcstring_system_character_t) '-' )
+	{
+		string_length = libcstring_system_string_length(
+				 string );
+
+		if( libcsystem_string_decimal_copy_to_64_bit(
+		     string,
+		     string_length + 1,
+		     &queue_depth,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine queue depth.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( queue_depth > 0 )
+		 && ( queue_depth <= (uint64_t) EWFCOMMON_MAXIMUM_QUEUE_DEPTH ) )
+		{
+			imaging_handle->queue_depth = (int) queue_depth;
+
+			result = 1;
+		}
+	}
+#endif
+	return( result );
+}
+
 /* Sets the additional digest types
  * Returns 1 if successful or -1 on error
  */
@@ -26,8 +26,10 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_threads.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
+#include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
 #include "storage_media_buffer.h"
@@ -196,6 +198,13 @@ struct imaging_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads
+	 * calculate the digest hashes on separate threads
+	 */
+	digest_threads_t *digest_threads;
+#endif
+
 	/* Value to indicate if the chunk data instead of the buffered read and write functions should be used
 	 */
 	uint8_t use_chunk_data_functions;
@@ -220,10 +229,62 @@ struct imaging_handle
 	 */
 	size_t process_buffer_size;
 
+	/* The number of threads used to prepare the storage media buffers before writing
+	 * 0 represents no multi-threading
+	 */
+	int number_of_threads;
+
+	/* The queue depth, the maximum number of storage media buffers in flight
+	 * 0 represents the default number of storage media buffers per thread
+	 */
+	int queue_depth;
+
 	/* The nofication output stream
 	 */
 	FILE *notify_stream;
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The storage media buffer queue
+	 * contains the storage media buffers that are not in use
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* The number of storage media buffers
+	 */
+	int number_of_storage_media_buffers;
+
+	/* The process thread pool
+	 * prepares the storage media buffers before writing
+	 */
+	libcthreads_thread_pool_t *process_thread_pool;
+
+	/* The output thread pool
+	 * writes the prepared storage media buffers in order
+	 */
+	libcthreads_thread_pool_t *output_thread_pool;
+
+	/* The output storage media buffers
+	 * contains the prepared storage media buffers that are waiting to be written
+	 */
+	storage_media_buffer_t **output_storage_media_buffers;
+
+	/* The sequence number of the next storage media buffer to process
+	 */
+	uint64_t process_sequence_number;
+
+	/* The sequence number of the next storage media buffer to write
+	 */
+	uint64_t output_sequence_number;
+
+	/* The output mutex
+	 */
+	libcthreads_mutex_t *output_mutex;
+
+	/* Value to indicate if writing the output failed
+	 */
+	int output_failed;
+#endif
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -281,6 +342,44 @@ ssize_t imaging_handle_write_buffer(
          size_t write_size,
          libcerror_error_t **error );
 
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int imaging_handle_initialize_threads(
+     imaging_handle_t *imaging_handle,
+     int number_of_threads,
+     uint8_t storage_media_buffer_mode,
+     size_t storage_media_buffer_size,
+     libcerror_error_t **error );
+
+int imaging_handle_free_threads(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
+int imaging_handle_get_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t **storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_release_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+int imaging_handle_process_storage_media_buffer(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
+int imaging_handle_output_storage_media_buffer(
+     storage_media_buffer_t *storage_media_buffer,
+     imaging_handle_t *imaging_handle );
+
+int imaging_handle_queue_storage_media_buffer(
+     imaging_handle_t *imaging_handle,
+     storage_media_buffer_t *storage_media_buffer,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
 off64_t imaging_handle_seek_offset(
          imaging_handle_t *imaging_handle,
          off64_t offset,
@@ -449,6 +548,16 @@ int imaging_handle_set_process_buffer_size(
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_number_of_threads(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
+int imaging_handle_set_queue_depth(
+     imaging_handle_t *imaging_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_additional_digest_types(
      imaging_handle_t *imaging_handle,
      const libcstring_system_character_t *string,
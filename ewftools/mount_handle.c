@@ -23,6 +23,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "byte_size_string.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libewf.h"
@@ -253,6 +254,190 @@ int mount_handle_set_maximum_number_of_open_handles(
 	return( 1 );
 }
 
+/* Sets the cache size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_cache_size(
+     mount_handle_t *mount_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function  = "mount_handle_set_cache_size";
+	size_t string_length   = 0;
+	uint64_t size_variable = 0;
+	int result             = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	result = byte_size_string_convert(
+	          string,
+	          string_length,
+	          &size_variable,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine cache size.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libewf_handle_set_cache_size(
+		     mount_handle->input_handle,
+		     (size64_t) size_variable,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache size in input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Sets the cache policy
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int mount_handle_set_cache_policy(
+     mount_handle_t *mount_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_cache_policy";
+	size_t string_length  = 0;
+	uint8_t cache_policy  = 0;
+	int result            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+	if( string_length == 2 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "2q" ),
+		     2 ) == 0 )
+		{
+			cache_policy = LIBEWF_CACHE_POLICY_2Q;
+			result       = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( libcstring_system_string_compare(
+		     string,
+		     _LIBCSTRING_SYSTEM_STRING( "direct" ),
+		     6 ) == 0 )
+		{
+			cache_policy = LIBEWF_CACHE_POLICY_DIRECT;
+			result       = 1;
+		}
+	}
+	if( result != 0 )
+	{
+		if( libewf_handle_set_cache_policy(
+		     mount_handle->input_handle,
+		     cache_policy,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache policy in input handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Sets the index filename
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_index_filename(
+     mount_handle_t *mount_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_index_filename";
+	size_t string_length  = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = libcstring_system_string_length(
+	                 string );
+
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_set_index_filename_wide(
+	     mount_handle->input_handle,
+	     string,
+	     string_length,
+	     error ) != 1 )
+#else
+	if( libewf_handle_set_index_filename(
+	     mount_handle->input_handle,
+	     string,
+	     string_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index filename in input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Sets the format
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -503,6 +688,73 @@ int mount_handle_close(
 	return( 0 );
 }
 
+/* Prints the cache statistics of the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_cache_statistics_fprint(
+     mount_handle_t *mount_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function     = "mount_handle_cache_statistics_fprint";
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_get_cache_statistics(
+	     mount_handle->input_handle,
+	     &number_of_hits,
+	     &number_of_misses,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache statistics from input handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 stream,
+	 "Cache statistics:\n" );
+	fprintf(
+	 stream,
+	 "\tnumber of hits:\t\t%" PRIu64 "\n",
+	 number_of_hits );
+	fprintf(
+	 stream,
+	 "\tnumber of misses:\t%" PRIu64 "\n",
+	 number_of_misses );
+	fprintf(
+	 stream,
+	 "\n" );
+
+	return( 1 );
+}
+
 /* Read a buffer from the input handle
  * Return the number of bytes read if successful or -1 on error
  */
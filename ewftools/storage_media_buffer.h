@@ -90,6 +90,15 @@ struct storage_media_buffer
 	/* The checksum of the data within the buffer
 	 */
 	uint32_t checksum;
+
+	/* The sequence number
+	 * used to write the buffers processed by multiple threads in order
+	 */
+	uint64_t sequence_number;
+
+	/* The number of bytes processed before writing or -1 on error
+	 */
+	ssize_t process_count;
 };
 
 int storage_media_buffer_initialize(
@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_threads.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcstring.h"
 #include "ewftools_libewf.h"
@@ -119,6 +120,18 @@ struct verification_handle
 	 */
 	uint8_t sha256_context_initialized;
 
+	/* The number of threads
+	 * 0 represents no multi-threading
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The digest threads
+	 * calculate the digest hashes on separate threads
+	 */
+	digest_threads_t *digest_threads;
+#endif
+
 	/* The calculated SHA256 digest hash string
 	 */
 	libcstring_system_character_t *calculated_sha256_hash_string;
@@ -270,6 +283,16 @@ int verification_handle_set_process_buffer_size(
      const libcstring_system_character_t *string,
      libcerror_error_t **error );
 
+int verification_handle_set_number_of_threads(
+     verification_handle_t *verification_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
+int verification_handle_set_async_io_queue_depth(
+     verification_handle_t *verification_handle,
+     const libcstring_system_character_t *string,
+     libcerror_error_t **error );
+
 int verification_handle_set_additional_digest_types(
      verification_handle_t *verification_handle,
      const libcstring_system_character_t *string,
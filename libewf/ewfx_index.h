@@ -0,0 +1,295 @@
+/*
+ * libewf EWF eXtention index file
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EWFX_INDEX_H )
+#define _EWFX_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The index file consists of:
+ * the file header
+ * for every segment file:
+ *   the segment header
+ *   the number of sections section descriptors
+ *   the number of chunk groups chunk group descriptors
+ *   the number of packed chunk groups packed chunk group descriptors,
+ *   each followed by the chunk data sizes and the chunk flags
+ * the checksum of all (previous) data
+ */
+
+typedef struct ewfx_index_file_header ewfx_index_file_header_t;
+
+struct ewfx_index_file_header
+{
+	/* The signature
+	 * consists of 8 bytes
+	 * "EWFXINDX"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The number of segments
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_segments[ 4 ];
+
+	/* The segment file type
+	 * consists of 1 byte
+	 */
+	uint8_t segment_file_type;
+
+	/* The segment file major version
+	 * consists of 1 byte
+	 */
+	uint8_t major_version;
+
+	/* The segment file minor version
+	 * consists of 1 byte
+	 */
+	uint8_t minor_version;
+
+	/* Padding
+	 * consists of 1 byte
+	 */
+	uint8_t padding1;
+
+	/* The compression method
+	 * consists of 2 bytes (16 bits)
+	 */
+	uint8_t compression_method[ 2 ];
+
+	/* Padding
+	 * consists of 2 bytes
+	 */
+	uint8_t padding2[ 2 ];
+
+	/* The chunk size
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t chunk_size[ 4 ];
+
+	/* The set identifier
+	 * consists of 16 bytes
+	 */
+	uint8_t set_identifier[ 16 ];
+};
+
+typedef struct ewfx_index_segment_header ewfx_index_segment_header_t;
+
+struct ewfx_index_segment_header
+{
+	/* The segment file size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t segment_file_size[ 8 ];
+
+	/* The segment number
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t segment_number[ 4 ];
+
+	/* The segment file flags
+	 * consists of 1 byte
+	 */
+	uint8_t segment_file_flags;
+
+	/* Padding
+	 * consists of 3 bytes
+	 */
+	uint8_t padding1[ 3 ];
+
+	/* The device information section index
+	 * consists of 4 bytes (32 bits)
+	 * 0xffffffff if not set
+	 */
+	uint8_t device_information_section_index[ 4 ];
+
+	/* The number of sections
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_sections[ 4 ];
+
+	/* The number of chunk groups
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_chunk_groups[ 4 ];
+
+	/* The number of packed chunk groups
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_packed_chunk_groups[ 4 ];
+
+	/* The last section offset
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t last_section_offset[ 8 ];
+
+	/* The storage media size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The number of chunks
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t number_of_chunks[ 8 ];
+};
+
+typedef struct ewfx_index_section ewfx_index_section_t;
+
+struct ewfx_index_section
+{
+	/* The section type
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t type[ 4 ];
+
+	/* The section type string
+	 * consists of 16 bytes
+	 */
+	uint8_t type_string[ 16 ];
+
+	/* The data flags
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t data_flags[ 4 ];
+
+	/* The start offset
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t start_offset[ 8 ];
+
+	/* The end offset
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t end_offset[ 8 ];
+
+	/* The size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t size[ 8 ];
+
+	/* The data size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The padding size
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t padding_size[ 4 ];
+
+	/* Padding
+	 * consists of 4 bytes
+	 */
+	uint8_t padding1[ 4 ];
+
+	/* The data integrity hash
+	 * consists of 16 bytes
+	 */
+	uint8_t data_integrity_hash[ 16 ];
+};
+
+typedef struct ewfx_index_chunk_group ewfx_index_chunk_group_t;
+
+struct ewfx_index_chunk_group
+{
+	/* The data offset
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t data_offset[ 8 ];
+
+	/* The data size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t data_size[ 8 ];
+
+	/* The storage media size
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t storage_media_size[ 8 ];
+
+	/* The range flags
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t range_flags[ 4 ];
+
+	/* Padding
+	 * consists of 4 bytes
+	 */
+	uint8_t padding1[ 4 ];
+};
+
+typedef struct ewfx_index_packed_chunk_group ewfx_index_packed_chunk_group_t;
+
+struct ewfx_index_packed_chunk_group
+{
+	/* The index of the first chunk
+	 * relative to the first chunk of the segment file
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t first_chunk_index[ 8 ];
+
+	/* The data offset of the first chunk
+	 * consists of 8 bytes (64 bits)
+	 */
+	uint8_t data_offset[ 8 ];
+
+	/* The number of chunks
+	 * consists of 4 bytes (32 bits)
+	 */
+	uint8_t number_of_chunks[ 4 ];
+
+	/* The sizes entry size
+	 * consists of 1 byte
+	 * contains 2 or 4
+	 */
+	uint8_t sizes_entry_size;
+
+	/* Padding
+	 * consists of 3 bytes
+	 */
+	uint8_t padding1[ 3 ];
+
+	/* The chunk data sizes
+	 * consists of the number of chunks times the sizes entry size bytes
+	 */
+
+	/* The chunk flags
+	 * consists of 2 bits per chunk, rounded up to whole bytes
+	 */
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,1170 @@
+/*
+ * Asynchronous IO functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include <errno.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_async_io.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+/* Creates an asynchronous IO
+ * Make sure the value async_io is referencing, is set to NULL
+ * Returns 1 if successful, 0 if asynchronous IO is not available or -1 on error
+ */
+int libewf_async_io_initialize(
+     libewf_async_io_t **async_io,
+     int queue_depth,
+     int maximum_number_of_open_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_initialize";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_io != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid asynchronous IO value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_files < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open files value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	*async_io = memory_allocate_structure(
+	             libewf_async_io_t );
+
+	if( *async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *async_io,
+	     0,
+	     sizeof( libewf_async_io_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear asynchronous IO.",
+		 function );
+
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+
+		return( -1 );
+	}
+	/* The kernel can lack io_uring support or it can be disabled,
+	 * in which case the synchronous reads are used instead
+	 */
+	if( io_uring_queue_init(
+	     (unsigned int) queue_depth,
+	     &( ( *async_io )->ring ),
+	     0 ) != 0 )
+	{
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+
+		return( 0 );
+	}
+	( *async_io )->queue_depth                  = queue_depth;
+	( *async_io )->maximum_number_of_open_files = maximum_number_of_open_files;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Frees an asynchronous IO
+ * The files that are still open are closed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_free(
+     libewf_async_io_t **async_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( *async_io != NULL )
+	{
+		for( entry_index = 0;
+		     entry_index < ( *async_io )->number_of_entries;
+		     entry_index++ )
+		{
+			if( libewf_async_io_close_file(
+			     *async_io,
+			     entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to close file: %d.",
+				 function,
+				 entry_index );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+		io_uring_queue_exit(
+		 &( ( *async_io )->ring ) );
+#endif
+		if( ( *async_io )->files != NULL )
+		{
+			memory_free(
+			 ( *async_io )->files );
+		}
+		if( ( *async_io )->requests != NULL )
+		{
+			memory_free(
+			 ( *async_io )->requests );
+		}
+		memory_free(
+		 *async_io );
+
+		*async_io = NULL;
+	}
+	return( result );
+}
+
+/* Sets the maximum number of open files
+ * A value of 0 represents no maximum
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_set_maximum_number_of_open_files(
+     libewf_async_io_t *async_io,
+     int maximum_number_of_open_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_set_maximum_number_of_open_files";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_open_files < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of open files value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	async_io->maximum_number_of_open_files = maximum_number_of_open_files;
+
+	return( 1 );
+}
+
+/* Retrieves the file descriptor of a file IO pool entry
+ * The file is opened on demand, using the name of the file IO pool entry
+ * hence the file IO pool must only contain file IO handles
+ * If the maximum number of open files is reached the least recently used file is closed
+ * Returns 1 if successful, 0 if the file cannot be opened or -1 on error
+ */
+int libewf_async_io_get_file_descriptor(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *file_descriptor,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	libbfio_handle_t *file_io_handle = NULL;
+	libewf_async_io_file_t *files    = NULL;
+	char *filename                   = NULL;
+	size_t filename_size             = 0;
+	uint64_t last_access_count       = 0;
+	int close_entry_index            = -1;
+	int entry_index                  = 0;
+	int safe_file_descriptor         = -1;
+#endif
+	static char *function            = "libewf_async_io_get_file_descriptor";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	if( file_io_pool_entry >= async_io->number_of_entries )
+	{
+		files = (libewf_async_io_file_t *) memory_reallocate(
+		                                    async_io->files,
+		                                    sizeof( libewf_async_io_file_t ) * ( file_io_pool_entry + 1 ) );
+
+		if( files == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize files.",
+			 function );
+
+			return( -1 );
+		}
+		async_io->files = files;
+
+		for( entry_index = async_io->number_of_entries;
+		     entry_index <= file_io_pool_entry;
+		     entry_index++ )
+		{
+			async_io->files[ entry_index ].file_descriptor   = -1;
+			async_io->files[ entry_index ].last_access_count = 0;
+			async_io->files[ entry_index ].cannot_be_opened  = 0;
+		}
+		async_io->number_of_entries = file_io_pool_entry + 1;
+	}
+	if( async_io->files[ file_io_pool_entry ].cannot_be_opened != 0 )
+	{
+		return( 0 );
+	}
+	async_io->access_count += 1;
+
+	if( async_io->files[ file_io_pool_entry ].file_descriptor != -1 )
+	{
+		async_io->files[ file_io_pool_entry ].last_access_count = async_io->access_count;
+
+		*file_descriptor = async_io->files[ file_io_pool_entry ].file_descriptor;
+
+		return( 1 );
+	}
+	/* The maximum number of open files can have been lowered
+	 * hence multiple files can need to be closed
+	 */
+	while( ( async_io->maximum_number_of_open_files > 0 )
+	    && ( async_io->number_of_open_files >= async_io->maximum_number_of_open_files ) )
+	{
+		close_entry_index = -1;
+
+		for( entry_index = 0;
+		     entry_index < async_io->number_of_entries;
+		     entry_index++ )
+		{
+			if( async_io->files[ entry_index ].file_descriptor == -1 )
+			{
+				continue;
+			}
+			if( ( close_entry_index == -1 )
+			 || ( async_io->files[ entry_index ].last_access_count < last_access_count ) )
+			{
+				close_entry_index = entry_index;
+				last_access_count = async_io->files[ entry_index ].last_access_count;
+			}
+		}
+		if( close_entry_index == -1 )
+		{
+			break;
+		}
+		if( libewf_async_io_close_file(
+		     async_io,
+		     close_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to close file: %d.",
+			 function,
+			 close_entry_index );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	filename = (char *) memory_allocate(
+	                     sizeof( char ) * filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+	safe_file_descriptor = open(
+	                        filename,
+	                        O_RDONLY );
+
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	/* If the file cannot be opened its data is read from the file IO pool instead
+	 */
+	if( safe_file_descriptor == -1 )
+	{
+		async_io->files[ file_io_pool_entry ].cannot_be_opened = 1;
+
+		return( 0 );
+	}
+	async_io->files[ file_io_pool_entry ].file_descriptor   = safe_file_descriptor;
+	async_io->files[ file_io_pool_entry ].last_access_count = async_io->access_count;
+
+	async_io->number_of_open_files += 1;
+
+	*file_descriptor = safe_file_descriptor;
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Closes the file of a file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_close_file(
+     libewf_async_io_t *async_io,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_async_io_close_file";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= async_io->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( async_io->files[ file_io_pool_entry ].file_descriptor != -1 )
+	{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+		if( close(
+		     async_io->files[ file_io_pool_entry ].file_descriptor ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			async_io->files[ file_io_pool_entry ].file_descriptor = -1;
+			async_io->number_of_open_files                       -= 1;
+
+			return( -1 );
+		}
+#endif
+		async_io->files[ file_io_pool_entry ].file_descriptor = -1;
+		async_io->number_of_open_files                       -= 1;
+	}
+	return( 1 );
+}
+
+/* Prepares the read of the remaining data of a request
+ * Reads that were prepared but not yet submitted are submitted first if a file needs
+ * to be opened, since opening a file can close another file these reads refer to
+ * Returns 1 if successful, 0 if the file cannot be opened or -1 on error
+ */
+int libewf_async_io_prepare_read(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     libewf_async_io_request_t *request,
+     int *number_of_unsubmitted_reads,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	int file_descriptor                         = -1;
+	int result                                  = 0;
+#endif
+	static char *function                       = "libewf_async_io_prepare_read";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( request->read_size >= request->size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid request - read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_unsubmitted_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of unsubmitted reads.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	if( ( *number_of_unsubmitted_reads > 0 )
+	 && ( ( request->file_io_pool_entry >= async_io->number_of_entries )
+	  ||  ( async_io->files[ request->file_io_pool_entry ].file_descriptor == -1 ) ) )
+	{
+		result = io_uring_submit(
+		          &( async_io->ring ) );
+
+		if( result < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_unsubmitted_reads = 0;
+	}
+	result = libewf_async_io_get_file_descriptor(
+	          async_io,
+	          file_io_pool,
+	          request->file_io_pool_entry,
+	          &file_descriptor,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file descriptor: %d.",
+			 function,
+			 request->file_io_pool_entry );
+		}
+		return( result );
+	}
+	submission_queue_entry = io_uring_get_sqe(
+	                          &( async_io->ring ) );
+
+	/* If the submission queue is full submit the reads to free up entries
+	 */
+	if( submission_queue_entry == NULL )
+	{
+		result = io_uring_submit(
+		          &( async_io->ring ) );
+
+		if( result < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to submit reads.",
+			 function );
+
+			return( -1 );
+		}
+		*number_of_unsubmitted_reads = 0;
+
+		submission_queue_entry = io_uring_get_sqe(
+		                          &( async_io->ring ) );
+
+		if( submission_queue_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve submission queue entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	io_uring_prep_read(
+	 submission_queue_entry,
+	 file_descriptor,
+	 &( request->buffer[ request->read_size ] ),
+	 (unsigned int) ( request->size - request->read_size ),
+	 (uint64_t) ( request->offset + request->read_size ) );
+
+	io_uring_sqe_set_data(
+	 submission_queue_entry,
+	 (void *) request );
+
+	*number_of_unsubmitted_reads += 1;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Waits for the reads in flight to complete, discarding their results
+ * This is used on error, since the reads in flight refer to the request buffers
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_async_io_wait_for_reads(
+     libewf_async_io_t *async_io,
+     int *number_of_reads_in_flight,
+     int *number_of_unsubmitted_reads )
+{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	int result                                  = 0;
+#endif
+
+	if( ( async_io == NULL )
+	 || ( number_of_reads_in_flight == NULL )
+	 || ( number_of_unsubmitted_reads == NULL ) )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	if( *number_of_unsubmitted_reads > 0 )
+	{
+		if( io_uring_submit(
+		     &( async_io->ring ) ) < 0 )
+		{
+			return( -1 );
+		}
+		*number_of_unsubmitted_reads = 0;
+	}
+	while( *number_of_reads_in_flight > 0 )
+	{
+		result = io_uring_wait_cqe(
+		          &( async_io->ring ),
+		          &completion_queue_entry );
+
+		if( result == -EINTR )
+		{
+			continue;
+		}
+		else if( result < 0 )
+		{
+			return( -1 );
+		}
+		io_uring_cqe_seen(
+		 &( async_io->ring ),
+		 completion_queue_entry );
+
+		*number_of_reads_in_flight -= 1;
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the data of multiple requests, with up to the queue depth number of reads in flight
+ * A read that completes partially is resubmitted for the remaining data,
+ * the read of a request stops at the end of the file
+ * Returns 1 if successful, 0 if a file cannot be opened or -1 on error
+ */
+int libewf_async_io_read_requests(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     libewf_async_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	libewf_async_io_request_t *request          = NULL;
+	int number_of_reads_in_flight               = 0;
+	int number_of_unsubmitted_reads             = 0;
+	int read_result                             = 0;
+	int request_index                           = 0;
+	int result                                  = 1;
+#endif
+	static char *function                       = "libewf_async_io_read_requests";
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of requests value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		request = &( requests[ request_index ] );
+
+		if( ( request->offset < 0 )
+		 || ( request->buffer == NULL )
+		 || ( request->size > (size_t) INT32_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid request: %d.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		request->read_size = 0;
+	}
+	request_index = 0;
+
+	while( ( request_index < number_of_requests )
+	    || ( number_of_reads_in_flight > 0 ) )
+	{
+		while( ( request_index < number_of_requests )
+		    && ( number_of_reads_in_flight < async_io->queue_depth ) )
+		{
+			request = &( requests[ request_index++ ] );
+
+			if( request->size == 0 )
+			{
+				continue;
+			}
+			result = libewf_async_io_prepare_read(
+			          async_io,
+			          file_io_pool,
+			          request,
+			          &number_of_unsubmitted_reads,
+			          error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+			number_of_reads_in_flight += 1;
+		}
+		if( result != 1 )
+		{
+			break;
+		}
+		if( number_of_unsubmitted_reads > 0 )
+		{
+			if( io_uring_submit(
+			     &( async_io->ring ) ) < 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_GENERIC,
+				 "%s: unable to submit reads.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			number_of_unsubmitted_reads = 0;
+		}
+		if( number_of_reads_in_flight == 0 )
+		{
+			break;
+		}
+		read_result = io_uring_wait_cqe(
+		               &( async_io->ring ),
+		               &completion_queue_entry );
+
+		if( read_result == -EINTR )
+		{
+			continue;
+		}
+		else if( read_result < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to wait for read completion.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		request     = (libewf_async_io_request_t *) io_uring_cqe_get_data( completion_queue_entry );
+		read_result = completion_queue_entry->res;
+
+		io_uring_cqe_seen(
+		 &( async_io->ring ),
+		 completion_queue_entry );
+
+		number_of_reads_in_flight -= 1;
+
+		if( ( read_result == -EINTR )
+		 || ( read_result == -EAGAIN ) )
+		{
+			read_result = 0;
+		}
+		else if( read_result < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " in file IO pool entry: %d with error: %d.",
+			 function,
+			 request->offset + request->read_size,
+			 request->file_io_pool_entry,
+			 -read_result );
+
+			result = -1;
+
+			break;
+		}
+		/* A read of 0 bytes represents the end of the file
+		 */
+		else if( read_result == 0 )
+		{
+			continue;
+		}
+		request->read_size += (size_t) read_result;
+
+		if( request->read_size < request->size )
+		{
+			result = libewf_async_io_prepare_read(
+			          async_io,
+			          file_io_pool,
+			          request,
+			          &number_of_unsubmitted_reads,
+			          error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+			number_of_reads_in_flight += 1;
+		}
+	}
+	if( result != 1 )
+	{
+		libewf_async_io_wait_for_reads(
+		 async_io,
+		 &number_of_reads_in_flight,
+		 &number_of_unsubmitted_reads );
+	}
+	return( result );
+#else
+	return( 0 );
+#endif
+}
+
+/* Reads data of a file IO pool entry at a specific offset into a buffer
+ * The read is split into multiple reads of LIBEWF_ASYNC_IO_REQUEST_SIZE that are in flight at once
+ * Returns 1 if successful, 0 if the file cannot be opened or -1 on error
+ */
+int libewf_async_io_read_buffer(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libewf_async_io_request_t *requests = NULL;
+	static char *function               = "libewf_async_io_read_buffer";
+	size_t buffer_offset                = 0;
+	size_t request_size                 = 0;
+	size_t safe_read_size               = 0;
+	int number_of_requests              = 0;
+	int request_index                   = 0;
+	int result                          = 0;
+
+	if( async_io == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid asynchronous IO.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size / LIBEWF_ASYNC_IO_REQUEST_SIZE ) >= (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_requests = (int) ( buffer_size / LIBEWF_ASYNC_IO_REQUEST_SIZE );
+
+	if( ( buffer_size % LIBEWF_ASYNC_IO_REQUEST_SIZE ) != 0 )
+	{
+		number_of_requests += 1;
+	}
+	if( number_of_requests > async_io->number_of_allocated_requests )
+	{
+		requests = (libewf_async_io_request_t *) memory_reallocate(
+		                                          async_io->requests,
+		                                          sizeof( libewf_async_io_request_t ) * number_of_requests );
+
+		if( requests == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize requests.",
+			 function );
+
+			return( -1 );
+		}
+		async_io->requests                     = requests;
+		async_io->number_of_allocated_requests = number_of_requests;
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		request_size = buffer_size - buffer_offset;
+
+		if( request_size > LIBEWF_ASYNC_IO_REQUEST_SIZE )
+		{
+			request_size = LIBEWF_ASYNC_IO_REQUEST_SIZE;
+		}
+		async_io->requests[ request_index ].file_io_pool_entry = file_io_pool_entry;
+		async_io->requests[ request_index ].offset             = offset + (off64_t) buffer_offset;
+		async_io->requests[ request_index ].buffer             = &( buffer[ buffer_offset ] );
+		async_io->requests[ request_index ].size               = request_size;
+		async_io->requests[ request_index ].read_size          = 0;
+
+		buffer_offset += request_size;
+	}
+	result = libewf_async_io_read_requests(
+	          async_io,
+	          file_io_pool,
+	          async_io->requests,
+	          number_of_requests,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read requests.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The data read is contiguous up to the first request that was cut short by the end of the file
+		 */
+		for( request_index = 0;
+		     request_index < number_of_requests;
+		     request_index++ )
+		{
+			safe_read_size += async_io->requests[ request_index ].read_size;
+
+			if( async_io->requests[ request_index ].read_size < async_io->requests[ request_index ].size )
+			{
+				break;
+			}
+		}
+		*read_size = safe_read_size;
+	}
+	return( result );
+}
+
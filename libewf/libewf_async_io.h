@@ -0,0 +1,194 @@
+/*
+ * Asynchronous IO functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ASYNC_IO_H )
+#define _LIBEWF_ASYNC_IO_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING ) && !defined( WINAPI )
+#define HAVE_LIBEWF_ASYNC_IO_SUPPORT
+#endif
+
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+#include <liburing.h>
+#endif
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_async_io_request libewf_async_io_request_t;
+
+struct libewf_async_io_request
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The number of bytes read
+	 * this is less than the size if the end of the file was reached
+	 */
+	size_t read_size;
+};
+
+typedef struct libewf_async_io_file libewf_async_io_file_t;
+
+struct libewf_async_io_file
+{
+	/* The file descriptor, -1 if the file is not open
+	 */
+	int file_descriptor;
+
+	/* The last access count
+	 */
+	uint64_t last_access_count;
+
+	/* Value to indicate the file cannot be opened
+	 */
+	uint8_t cannot_be_opened;
+};
+
+typedef struct libewf_async_io libewf_async_io_t;
+
+/* The asynchronous IO reads segment file data with multiple reads in flight at once
+ * It uses its own read-only file descriptors of the segment files, which are opened on demand
+ * and of which the least recently used is closed when the maximum number of open files is reached
+ */
+struct libewf_async_io
+{
+#if defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	/* The submission and completion ring
+	 */
+	struct io_uring ring;
+#endif
+
+	/* The queue depth
+	 */
+	int queue_depth;
+
+	/* The files, indexed by file IO pool entry
+	 */
+	libewf_async_io_file_t *files;
+
+	/* The number of file entries
+	 */
+	int number_of_entries;
+
+	/* The number of open files
+	 */
+	int number_of_open_files;
+
+	/* The maximum number of open files, 0 represents no maximum
+	 */
+	int maximum_number_of_open_files;
+
+	/* The access count
+	 */
+	uint64_t access_count;
+
+	/* The requests used to split a buffer read
+	 */
+	libewf_async_io_request_t *requests;
+
+	/* The number of allocated requests
+	 */
+	int number_of_allocated_requests;
+};
+
+int libewf_async_io_initialize(
+     libewf_async_io_t **async_io,
+     int queue_depth,
+     int maximum_number_of_open_files,
+     libcerror_error_t **error );
+
+int libewf_async_io_free(
+     libewf_async_io_t **async_io,
+     libcerror_error_t **error );
+
+int libewf_async_io_set_maximum_number_of_open_files(
+     libewf_async_io_t *async_io,
+     int maximum_number_of_open_files,
+     libcerror_error_t **error );
+
+int libewf_async_io_get_file_descriptor(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     int *file_descriptor,
+     libcerror_error_t **error );
+
+int libewf_async_io_close_file(
+     libewf_async_io_t *async_io,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_async_io_prepare_read(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     libewf_async_io_request_t *request,
+     int *number_of_unsubmitted_reads,
+     libcerror_error_t **error );
+
+int libewf_async_io_wait_for_reads(
+     libewf_async_io_t *async_io,
+     int *number_of_reads_in_flight,
+     int *number_of_unsubmitted_reads );
+
+int libewf_async_io_read_requests(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     libewf_async_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+int libewf_async_io_read_buffer(
+     libewf_async_io_t *async_io,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,90 @@
+/*
+ * Buffer pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_BUFFER_POOL_H )
+#define _LIBEWF_BUFFER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_buffer_pool libewf_buffer_pool_t;
+
+/* The buffer pool keeps unused buffers of the same size for reuse
+ * so that buffers of chunk size do not need to be allocated and freed for every chunk
+ */
+struct libewf_buffer_pool
+{
+	/* The buffer size
+	 */
+	size_t buffer_size;
+
+	/* The unused buffers
+	 */
+	uint8_t **buffers;
+
+	/* The number of unused buffers
+	 */
+	int number_of_buffers;
+
+	/* The maximum number of unused buffers
+	 */
+	int maximum_number_of_buffers;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libewf_buffer_pool_initialize(
+     libewf_buffer_pool_t **buffer_pool,
+     size_t buffer_size,
+     int maximum_number_of_buffers,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_free(
+     libewf_buffer_pool_t **buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_get_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+int libewf_buffer_pool_release_buffer(
+     libewf_buffer_pool_t *buffer_pool,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -28,13 +28,37 @@
 #endif
 
 #include "libewf_checksum.h"
+#include "libewf_definitions.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
 
-#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+#define LIBEWF_CHECKSUM_TARGET_SSSE3
+#define LIBEWF_CHECKSUM_TARGET_AVX2
+#else
+#define LIBEWF_CHECKSUM_TARGET_SSSE3	__attribute__ ((target ("ssse3")))
+#define LIBEWF_CHECKSUM_TARGET_AVX2	__attribute__ ((target ("avx2")))
+#endif
+
+/* The Adler-32 kernel, -1 represents the kernel has not been determined yet
+ */
+static int libewf_checksum_adler32_kernel = -1;
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
 
 /* Calculates the little-endian Adler-32 of a buffer
  * It uses the initial value to calculate a new Adler-32
+ * The fastest kernel supported by the CPU is used, if no SIMD kernel
+ * is supported zlib is used if available or otherwise the byte-by-byte kernel
  * Returns 1 if successful or -1 on error
  */
 int libewf_checksum_calculate_adler32(
@@ -45,6 +69,80 @@ int libewf_checksum_calculate_adler32(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_checksum_calculate_adler32";
+	int result            = 0;
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+	/* The kernel is the same for all threads, hence it does not need to be locked
+	 */
+	if( libewf_checksum_adler32_kernel == -1 )
+	{
+		libewf_checksum_adler32_kernel = libewf_checksum_get_adler32_kernel();
+	}
+	if( libewf_checksum_adler32_kernel == LIBEWF_ADLER32_KERNEL_AVX2 )
+	{
+		result = libewf_checksum_calculate_adler32_avx2(
+		          checksum_value,
+		          buffer,
+		          size,
+		          initial_value,
+		          error );
+	}
+	else if( libewf_checksum_adler32_kernel == LIBEWF_ADLER32_KERNEL_SSSE3 )
+	{
+		result = libewf_checksum_calculate_adler32_ssse3(
+		          checksum_value,
+		          buffer,
+		          size,
+		          initial_value,
+		          error );
+	}
+	else
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+	{
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+		result = libewf_checksum_calculate_adler32_zlib(
+		          checksum_value,
+		          buffer,
+		          size,
+		          initial_value,
+		          error );
+#else
+		result = libewf_checksum_calculate_adler32_scalar(
+		          checksum_value,
+		          buffer,
+		          size,
+		          initial_value,
+		          error );
+#endif
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate Adler-32.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+
+/* Calculates the little-endian Adler-32 of a buffer using zlib
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_checksum_calculate_adler32_zlib(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_checksum_calculate_adler32_zlib";
 
 	if( checksum_value == NULL )
 	{
@@ -87,20 +185,20 @@ int libewf_checksum_calculate_adler32(
 	return( 1 );
 }
 
-#else
+#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
 
-/* Calculates the little-endian Adler-32 of a buffer
+/* Calculates the little-endian Adler-32 of a buffer using a byte-by-byte kernel
  * It uses the initial value to calculate a new Adler-32
  * Returns 1 if successful or -1 on error
  */
-int libewf_checksum_calculate_adler32(
+int libewf_checksum_calculate_adler32_scalar(
      uint32_t *checksum_value,
      const uint8_t *buffer,
      size_t size,
      uint32_t initial_value,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_checksum_calculate_adler32";
+	static char *function = "libewf_checksum_calculate_adler32_scalar";
 	size_t buffer_offset  = 0;
 	uint32_t lower_word   = 0;
 	uint32_t upper_word   = 0;
@@ -337,5 +435,514 @@ int libewf_checksum_calculate_adler32(
 	return( 1 );
 }
 
-#endif /* defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) ) */
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+/* Determines the fastest Adler-32 kernel supported by the CPU
+ * Returns the Adler-32 kernel
+ */
+int libewf_checksum_get_adler32_kernel(
+     void )
+{
+	int cpu_information[ 4 ];
+
+	uint64_t extended_control_register = 0;
+	int kernel                         = LIBEWF_ADLER32_KERNEL_DEFAULT;
+	int maximum_function               = 0;
+
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	maximum_function = cpu_information[ 0 ];
+#else
+	maximum_function = (int) __get_cpuid_max(
+	                          0,
+	                          NULL );
+#endif
+	if( maximum_function < 1 )
+	{
+		return( kernel );
+	}
+#if defined( _MSC_VER )
+	__cpuid(
+	 cpu_information,
+	 1 );
+#else
+	__cpuid(
+	 1,
+	 cpu_information[ 0 ],
+	 cpu_information[ 1 ],
+	 cpu_information[ 2 ],
+	 cpu_information[ 3 ] );
+#endif
+	/* Check the SSSE3 bit of ECX
+	 */
+	if( ( cpu_information[ 2 ] & 0x00000200UL ) == 0 )
+	{
+		return( kernel );
+	}
+	kernel = LIBEWF_ADLER32_KERNEL_SSSE3;
+
+	/* Check the OSXSAVE and AVX bits of ECX
+	 */
+	if( ( ( cpu_information[ 2 ] & 0x08000000UL ) == 0 )
+	 || ( ( cpu_information[ 2 ] & 0x10000000UL ) == 0 )
+	 || ( maximum_function < 7 ) )
+	{
+		return( kernel );
+	}
+	/* Check if the operating system saves the XMM and YMM registers
+	 */
+#if defined( _MSC_VER )
+	extended_control_register = (uint64_t) _xgetbv(
+	                                        0 );
+#else
+	{
+		uint32_t eax = 0;
+		uint32_t edx = 0;
+
+		__asm__ __volatile__ (
+		 "xgetbv" : "=a" ( eax ), "=d" ( edx ) : "c" ( 0 ) );
+
+		extended_control_register = ( (uint64_t) edx << 32 ) | eax;
+	}
+#endif
+	if( ( extended_control_register & 0x06 ) != 0x06 )
+	{
+		return( kernel );
+	}
+#if defined( _MSC_VER )
+	__cpuidex(
+	 cpu_information,
+	 7,
+	 0 );
+#else
+	__cpuid_count(
+	 7,
+	 0,
+	 cpu_information[ 0 ],
+	 cpu_information[ 1 ],
+	 cpu_information[ 2 ],
+	 cpu_information[ 3 ] );
+#endif
+	/* Check the AVX2 bit of EBX
+	 */
+	if( ( cpu_information[ 1 ] & 0x00000020UL ) != 0 )
+	{
+		kernel = LIBEWF_ADLER32_KERNEL_AVX2;
+	}
+	return( kernel );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using a SSSE3 kernel
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_CHECKSUM_TARGET_SSSE3 \
+int libewf_checksum_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m128i first_byte_weights;
+	__m128i ones;
+	__m128i second_byte_weights;
+	__m128i previous_lower_words;
+	__m128i lower_words;
+	__m128i upper_words;
+	__m128i values_128bit;
+	__m128i zero;
+
+	static char *function   = "libewf_checksum_calculate_adler32_ssse3";
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	/* Weights of the 32 bytes in a block, the first 16 bytes
+	 * are weighted 32 to 17 and the last 16 bytes 16 to 1
+	 */
+	first_byte_weights  = _mm_setr_epi8(
+	                       32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	second_byte_weights = _mm_setr_epi8(
+	                       16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones                = _mm_set1_epi16(
+	                       1 );
+	zero                = _mm_setzero_si128();
+
+	number_of_blocks = size / 32;
+
+	while( number_of_blocks > 0 )
+	{
+		/* The modulo calculation is needed at least every 5552 (0x15b0) bytes
+		 * 173 blocks of 32 bytes is 5536 bytes, the largest multiple of 32 that fits
+		 */
+		block_index = 173;
+
+		if( block_index > number_of_blocks )
+		{
+			block_index = number_of_blocks;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm_set_epi32(
+		                        0,
+		                        0,
+		                        0,
+		                        (int) ( lower_word * block_index ) );
+		upper_words          = _mm_set_epi32(
+		                        0,
+		                        0,
+		                        0,
+		                        (int) upper_word );
+		lower_words          = _mm_setzero_si128();
+
+		while( block_index > 0 )
+		{
+			/* The lower words of the previous blocks are added
+			 * to the upper word for each byte in the block
+			 */
+			previous_lower_words = _mm_add_epi32(
+			                        previous_lower_words,
+			                        lower_words );
+
+			values_128bit = _mm_loadu_si128(
+			                 (__m128i *) buffer );
+
+			lower_words = _mm_add_epi32(
+			               lower_words,
+			               _mm_sad_epu8(
+			                values_128bit,
+			                zero ) );
+
+			upper_words = _mm_add_epi32(
+			               upper_words,
+			               _mm_madd_epi16(
+			                _mm_maddubs_epi16(
+			                 values_128bit,
+			                 first_byte_weights ),
+			                ones ) );
+
+			values_128bit = _mm_loadu_si128(
+			                 (__m128i *) &( buffer[ 16 ] ) );
+
+			lower_words = _mm_add_epi32(
+			               lower_words,
+			               _mm_sad_epu8(
+			                values_128bit,
+			                zero ) );
+
+			upper_words = _mm_add_epi32(
+			               upper_words,
+			               _mm_madd_epi16(
+			                _mm_maddubs_epi16(
+			                 values_128bit,
+			                 second_byte_weights ),
+			                ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm_add_epi32(
+		               upper_words,
+		               _mm_slli_epi32(
+		                previous_lower_words,
+		                5 ) );
+
+		/* Calculate the sum of the 4 x 32-bit values
+		 */
+		lower_words = _mm_add_epi32(
+		               lower_words,
+		               _mm_shuffle_epi32(
+		                lower_words,
+		                _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		lower_words = _mm_add_epi32(
+		               lower_words,
+		               _mm_shuffle_epi32(
+		                lower_words,
+		                _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32(
+		                          lower_words );
+
+		upper_words = _mm_add_epi32(
+		               upper_words,
+		               _mm_shuffle_epi32(
+		                upper_words,
+		                _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_words = _mm_add_epi32(
+		               upper_words,
+		               _mm_shuffle_epi32(
+		                upper_words,
+		                _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32(
+		                         upper_words );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	size %= 32;
+
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= 65521;
+	upper_word %= 65521;
+
+	*checksum_value = ( upper_word << 16 ) | lower_word;
+
+	return( 1 );
+}
+
+/* Calculates the little-endian Adler-32 of a buffer using an AVX2 kernel
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or -1 on error
+ */
+LIBEWF_CHECKSUM_TARGET_AVX2 \
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error )
+{
+	__m256i byte_weights;
+	__m256i ones;
+	__m256i previous_lower_words;
+	__m256i lower_words;
+	__m256i upper_words;
+	__m256i values_256bit;
+	__m256i zero;
+	__m128i values_128bit;
+
+	static char *function   = "libewf_checksum_calculate_adler32_avx2";
+	size_t number_of_blocks = 0;
+	size_t block_index      = 0;
+	uint32_t lower_word     = 0;
+	uint32_t upper_word     = 0;
+
+	if( checksum_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum value.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	lower_word = initial_value & 0xffff;
+	upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	/* Weights of the 32 bytes in a block
+	 */
+	byte_weights = _mm256_setr_epi8(
+	                32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	ones         = _mm256_set1_epi16(
+	                1 );
+	zero         = _mm256_setzero_si256();
+
+	number_of_blocks = size / 32;
+
+	while( number_of_blocks > 0 )
+	{
+		/* The modulo calculation is needed at least every 5552 (0x15b0) bytes
+		 * 173 blocks of 32 bytes is 5536 bytes, the largest multiple of 32 that fits
+		 */
+		block_index = 173;
+
+		if( block_index > number_of_blocks )
+		{
+			block_index = number_of_blocks;
+		}
+		number_of_blocks -= block_index;
+
+		previous_lower_words = _mm256_set_epi32(
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        (int) ( lower_word * block_index ) );
+		upper_words          = _mm256_set_epi32(
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        0,
+		                        (int) upper_word );
+		lower_words          = _mm256_setzero_si256();
+
+		while( block_index > 0 )
+		{
+			/* The lower words of the previous blocks are added
+			 * to the upper word for each byte in the block
+			 */
+			previous_lower_words = _mm256_add_epi32(
+			                        previous_lower_words,
+			                        lower_words );
+
+			values_256bit = _mm256_loadu_si256(
+			                 (__m256i *) buffer );
+
+			lower_words = _mm256_add_epi32(
+			               lower_words,
+			               _mm256_sad_epu8(
+			                values_256bit,
+			                zero ) );
+
+			upper_words = _mm256_add_epi32(
+			               upper_words,
+			               _mm256_madd_epi16(
+			                _mm256_maddubs_epi16(
+			                 values_256bit,
+			                 byte_weights ),
+			                ones ) );
+
+			buffer      += 32;
+			block_index -= 1;
+		}
+		upper_words = _mm256_add_epi32(
+		               upper_words,
+		               _mm256_slli_epi32(
+		                previous_lower_words,
+		                5 ) );
+
+		/* Calculate the sum of the 8 x 32-bit values
+		 */
+		values_128bit = _mm_add_epi32(
+		                 _mm256_castsi256_si128(
+		                  lower_words ),
+		                 _mm256_extracti128_si256(
+		                  lower_words,
+		                  1 ) );
+		values_128bit = _mm_add_epi32(
+		                 values_128bit,
+		                 _mm_shuffle_epi32(
+		                  values_128bit,
+		                  _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		values_128bit = _mm_add_epi32(
+		                 values_128bit,
+		                 _mm_shuffle_epi32(
+		                  values_128bit,
+		                  _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32(
+		                          values_128bit );
+
+		values_128bit = _mm_add_epi32(
+		                 _mm256_castsi256_si128(
+		                  upper_words ),
+		                 _mm256_extracti128_si256(
+		                  upper_words,
+		                  1 ) );
+		values_128bit = _mm_add_epi32(
+		                 values_128bit,
+		                 _mm_shuffle_epi32(
+		                  values_128bit,
+		                  _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		values_128bit = _mm_add_epi32(
+		                 values_128bit,
+		                 _mm_shuffle_epi32(
+		                  values_128bit,
+		                  _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_word = (uint32_t) _mm_cvtsi128_si32(
+		                         values_128bit );
+
+		lower_word %= 65521;
+		upper_word %= 65521;
+	}
+	size %= 32;
+
+	while( size > 0 )
+	{
+		lower_word += *buffer;
+		upper_word += lower_word;
+
+		buffer++;
+		size--;
+	}
+	lower_word %= 65521;
+	upper_word %= 65521;
+
+	*checksum_value = ( upper_word << 16 ) | lower_word;
+
+	return( 1 );
+}
+
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
 
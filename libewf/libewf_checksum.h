@@ -31,6 +31,16 @@
 extern "C" {
 #endif
 
+/* The SSSE3 and AVX2 kernels are available on x86 using compilers
+ * that support intrinsics for these instruction sets
+ */
+#if ( defined( __i386__ ) || defined( __x86_64__ ) || defined( _M_IX86 ) || defined( _M_X64 ) ) \
+ && ( defined( __clang__ ) \
+  || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) \
+  || ( defined( _MSC_VER ) && ( _MSC_VER >= 1800 ) ) )
+#define LIBEWF_CHECKSUM_HAVE_X86_SIMD
+#endif
+
 int libewf_checksum_calculate_adler32(
      uint32_t *checksum_value,
      const uint8_t *buffer,
@@ -38,6 +48,45 @@ int libewf_checksum_calculate_adler32(
      uint32_t initial_value,
      libcerror_error_t **error );
 
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+
+int libewf_checksum_calculate_adler32_zlib(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif
+
+int libewf_checksum_calculate_adler32_scalar(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+
+int libewf_checksum_get_adler32_kernel(
+     void );
+
+int libewf_checksum_calculate_adler32_ssse3(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+int libewf_checksum_calculate_adler32_avx2(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value,
+     libcerror_error_t **error );
+
+#endif
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,965 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int maximum_number_of_entries,
+     int maximum_number_of_recent_entries,
+     libcerror_error_t **error )
+{
+	static char *function                 = "libewf_chunk_cache_initialize";
+	size_t buckets_size                   = 0;
+	int maximum_number_of_evicted_entries = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > ( INT_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_recent_entries <= 0 )
+	 || ( maximum_number_of_recent_entries > maximum_number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of recent entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The evicted queue remembers half as many chunks as the cache contains
+	 */
+	maximum_number_of_evicted_entries = maximum_number_of_entries / 2;
+
+	if( maximum_number_of_evicted_entries == 0 )
+	{
+		maximum_number_of_evicted_entries = 1;
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	( *chunk_cache )->number_of_buckets = maximum_number_of_entries + maximum_number_of_evicted_entries;
+
+	buckets_size = sizeof( libewf_chunk_cache_entry_t * ) * ( *chunk_cache )->number_of_buckets;
+
+	( *chunk_cache )->buckets = (libewf_chunk_cache_entry_t **) memory_allocate(
+	                                                             buckets_size );
+
+	if( ( *chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_cache )->maximum_number_of_entries         = maximum_number_of_entries;
+	( *chunk_cache )->maximum_number_of_recent_entries  = maximum_number_of_recent_entries;
+	( *chunk_cache )->maximum_number_of_evicted_entries = maximum_number_of_evicted_entries;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *chunk_cache )->buckets );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_free";
+	int queue                         = 0;
+	int result                        = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		for( queue = 0;
+		     queue < LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES;
+		     queue++ )
+		{
+			while( ( *chunk_cache )->first_entry[ queue ] != NULL )
+			{
+				entry = ( *chunk_cache )->first_entry[ queue ];
+
+				( *chunk_cache )->first_entry[ queue ] = entry->next_entry;
+
+				if( entry->chunk_data != NULL )
+				{
+					if( libewf_chunk_data_free(
+					     &( entry->chunk_data ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free chunk: %" PRIu64 " data.",
+						 function,
+						 entry->chunk_index );
+
+						result = -1;
+					}
+				}
+				memory_free(
+				 entry );
+			}
+		}
+		memory_free(
+		 ( *chunk_cache )->buckets );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the entry of a specific chunk
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_get_entry_by_chunk_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *bucket_entry = NULL;
+	static char *function                    = "libewf_chunk_cache_get_entry_by_chunk_index";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_entry = chunk_cache->buckets[ chunk_index % chunk_cache->number_of_buckets ];
+
+	while( bucket_entry != NULL )
+	{
+		if( bucket_entry->chunk_index == chunk_index )
+		{
+			*entry = bucket_entry;
+
+			return( 1 );
+		}
+		bucket_entry = bucket_entry->next_bucket_entry;
+	}
+	return( 0 );
+}
+
+/* Removes an entry from its queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_remove_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( entry->queue < 0 )
+	 || ( entry->queue >= LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid entry - queue value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		chunk_cache->first_entry[ entry->queue ] = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		chunk_cache->last_entry[ entry->queue ] = entry->previous_entry;
+	}
+	chunk_cache->number_of_entries[ entry->queue ] -= 1;
+
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+
+	return( 1 );
+}
+
+/* Prepends an entry to a specific queue
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_prepend_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     int queue,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_prepend_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue < 0 )
+	 || ( queue >= LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	entry->queue          = queue;
+	entry->previous_entry = NULL;
+	entry->next_entry     = chunk_cache->first_entry[ queue ];
+
+	if( chunk_cache->first_entry[ queue ] != NULL )
+	{
+		chunk_cache->first_entry[ queue ]->previous_entry = entry;
+	}
+	else
+	{
+		chunk_cache->last_entry[ queue ] = entry;
+	}
+	chunk_cache->first_entry[ queue ] = entry;
+
+	chunk_cache->number_of_entries[ queue ] += 1;
+
+	return( 1 );
+}
+
+/* Frees an entry that was removed from its queue
+ * The entry is also removed from its hash bucket
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t **bucket_entry = NULL;
+	static char *function                     = "libewf_chunk_cache_free_entry";
+	int result                                = 1;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		bucket_entry = &( chunk_cache->buckets[ ( *entry )->chunk_index % chunk_cache->number_of_buckets ] );
+
+		while( *bucket_entry != NULL )
+		{
+			if( *bucket_entry == *entry )
+			{
+				*bucket_entry = ( *entry )->next_bucket_entry;
+
+				break;
+			}
+			bucket_entry = &( ( *bucket_entry )->next_bucket_entry );
+		}
+		if( ( *entry )->chunk_data != NULL )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( *entry )->chunk_data ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 ( *entry )->chunk_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( result );
+}
+
+/* Evicts an entry to make room for the chunk data of another entry
+ * The oldest entry of the recent queue is evicted when the recent queue
+ * exceeds its maximum, its chunk index is remembered in the evicted queue.
+ * Otherwise the least recently used entry of the frequent queue is evicted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_evict_entry";
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_RECENT ] > chunk_cache->maximum_number_of_recent_entries )
+	 || ( chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT ] == 0 ) )
+	{
+		entry = chunk_cache->last_entry[ LIBEWF_CHUNK_CACHE_QUEUE_RECENT ];
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing last recent entry.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from recent queue.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_chunk_data_free(
+		     &( entry->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk: %" PRIu64 " data.",
+			 function,
+			 entry->chunk_index );
+
+			libewf_chunk_cache_free_entry(
+			 chunk_cache,
+			 &entry,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_prepend_entry(
+		     chunk_cache,
+		     entry,
+		     LIBEWF_CHUNK_CACHE_QUEUE_EVICTED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to prepend entry to evicted queue.",
+			 function );
+
+			libewf_chunk_cache_free_entry(
+			 chunk_cache,
+			 &entry,
+			 NULL );
+
+			return( -1 );
+		}
+		if( chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_EVICTED ] <= chunk_cache->maximum_number_of_evicted_entries )
+		{
+			return( 1 );
+		}
+		entry = chunk_cache->last_entry[ LIBEWF_CHUNK_CACHE_QUEUE_EVICTED ];
+	}
+	else
+	{
+		entry = chunk_cache->last_entry[ LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT ];
+	}
+	if( libewf_chunk_cache_remove_entry(
+	     chunk_cache,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove entry from queue.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_cache_free_entry(
+	     chunk_cache,
+	     &entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entry.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if the chunk cache contains the chunk data of a specific chunk
+ * The position of the chunk in the queues is not changed
+ * Returns 1 if the chunk is cached, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_has_chunk_data";
+	int result                        = 0;
+
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( ( result == 0 )
+	      || ( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_EVICTED ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chunk data of a specific chunk
+ * The chunk data remains managed by the chunk cache
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_get_chunk_data";
+	int result                        = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( ( result == 0 )
+	      || ( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_EVICTED ) )
+	{
+		return( 0 );
+	}
+	/* Entries in the recent queue are not moved, so that a chunk that
+	 * is accessed multiple times in short succession is not considered frequent
+	 */
+	if( ( entry->queue == LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT )
+	 && ( entry != chunk_cache->first_entry[ LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT ] ) )
+	{
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from frequent queue.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_chunk_cache_prepend_entry(
+		     chunk_cache,
+		     entry,
+		     LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to prepend entry to frequent queue.",
+			 function );
+
+			libewf_chunk_cache_free_entry(
+			 chunk_cache,
+			 &entry,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	*chunk_data = entry->chunk_data;
+
+	return( 1 );
+}
+
+/* Sets the chunk data of a specific chunk
+ * The chunk cache takes over the management of the chunk data and sets chunk data to NULL
+ * Chunk data of a chunk that is already cached is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_set_chunk_data";
+	int queue                         = LIBEWF_CHUNK_CACHE_QUEUE_RECENT;
+	int result                        = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_chunk_cache_get_entry_by_chunk_index(
+	          chunk_cache,
+	          chunk_index,
+	          &entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( entry->queue != LIBEWF_CHUNK_CACHE_QUEUE_EVICTED )
+		{
+			/* The chunk was cached by another reader in the meantime
+			 */
+			if( libewf_chunk_data_free(
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+		/* A chunk that is accessed again after it was evicted from
+		 * the recent queue is considered frequent
+		 */
+		if( libewf_chunk_cache_remove_entry(
+		     chunk_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry from evicted queue.",
+			 function );
+
+			entry = NULL;
+
+			goto on_error;
+		}
+		queue = LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT;
+	}
+	else
+	{
+		entry = memory_allocate_structure(
+		         libewf_chunk_cache_entry_t );
+
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     entry,
+		     0,
+		     sizeof( libewf_chunk_cache_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entry.",
+			 function );
+
+			memory_free(
+			 entry );
+
+			entry = NULL;
+
+			goto on_error;
+		}
+		entry->chunk_index = chunk_index;
+
+		entry->next_bucket_entry = chunk_cache->buckets[ chunk_index % chunk_cache->number_of_buckets ];
+
+		chunk_cache->buckets[ chunk_index % chunk_cache->number_of_buckets ] = entry;
+	}
+	/* The entry is not part of a queue while making room
+	 * so that it cannot be evicted itself
+	 */
+	while( ( chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_RECENT ]
+	       + chunk_cache->number_of_entries[ LIBEWF_CHUNK_CACHE_QUEUE_FREQUENT ] ) >= chunk_cache->maximum_number_of_entries )
+	{
+		if( libewf_chunk_cache_evict_entry(
+		     chunk_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to evict entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_chunk_cache_prepend_entry(
+	     chunk_cache,
+	     entry,
+	     queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to prepend entry to queue.",
+		 function );
+
+		goto on_error;
+	}
+	entry->chunk_data = *chunk_data;
+	*chunk_data       = NULL;
+
+	return( 1 );
+
+on_error:
+	if( entry != NULL )
+	{
+		libewf_chunk_cache_free_entry(
+		 chunk_cache,
+		 &entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
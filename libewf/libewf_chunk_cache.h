@@ -0,0 +1,167 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 * NULL if the entry is in the evicted queue
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The queue that contains the entry
+	 */
+	int queue;
+
+	/* The previous entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *previous_entry;
+
+	/* The next entry in the queue
+	 */
+	libewf_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the same hash bucket
+	 */
+	libewf_chunk_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+/* The chunk cache uses the 2Q replacement policy
+ * Chunks that are accessed once are kept in the (FIFO) recent queue
+ * Chunks that are accessed again after they were evicted from the recent queue
+ * are kept in the (LRU) frequent queue
+ * A sequential read therefore only replaces chunks in the recent queue
+ */
+struct libewf_chunk_cache
+{
+	/* The hash buckets
+	 */
+	libewf_chunk_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The first (most recently used) entry of each queue
+	 */
+	libewf_chunk_cache_entry_t *first_entry[ LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES ];
+
+	/* The last (least recently used) entry of each queue
+	 */
+	libewf_chunk_cache_entry_t *last_entry[ LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES ];
+
+	/* The number of entries of each queue
+	 */
+	int number_of_entries[ LIBEWF_CHUNK_CACHE_NUMBER_OF_QUEUES ];
+
+	/* The maximum number of entries that contain chunk data
+	 */
+	int maximum_number_of_entries;
+
+	/* The maximum number of entries in the recent queue
+	 */
+	int maximum_number_of_recent_entries;
+
+	/* The maximum number of entries in the evicted queue
+	 */
+	int maximum_number_of_evicted_entries;
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     int maximum_number_of_entries,
+     int maximum_number_of_recent_entries,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_entry_by_chunk_index(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_remove_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_prepend_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t *entry,
+     int queue,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libewf_chunk_cache_entry_t **entry,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_evict_entry(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_has_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -33,6 +33,8 @@
 #include "libewf_libcnotify.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_mapped_file_pool.h"
+#include "libewf_read_ahead_buffer.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -43,6 +45,7 @@
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
      size_t data_size,
+     libewf_buffer_pool_t *buffer_pool,
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_initialize";
@@ -113,6 +116,8 @@ int libewf_chunk_data_initialize(
 
 		return( -1 );
 	}
+	( *chunk_data )->buffer_pool = buffer_pool;
+
 	if( data_size > 0 )
 	{
 		/* The allocated data size should be rounded to the next 16-byte increment
@@ -123,22 +128,23 @@ int libewf_chunk_data_initialize(
 		}
 		data_size = ( data_size / 16 ) * 16;
 
-		( *chunk_data )->data = (uint8_t *) memory_allocate(
-		                                     sizeof( uint8_t ) * data_size );
-
-		if( ( *chunk_data )->data == NULL )
+		if( libewf_chunk_data_allocate_buffer(
+		     *chunk_data,
+		     data_size,
+		     &( ( *chunk_data )->data ),
+		     &( ( *chunk_data )->allocated_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 			 "%s: unable to create data.",
 			 function );
 
 			goto on_error;
 		}
-		( *chunk_data )->allocated_data_size = data_size;
-		( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		( *chunk_data )->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 	}
 	return( 1 );
 
@@ -160,6 +166,7 @@ on_error:
 int libewf_chunk_data_initialize_clear_data(
      libewf_chunk_data_t **chunk_data,
      size_t data_size,
+     libewf_buffer_pool_t *buffer_pool,
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_initialize_clear_data";
@@ -230,6 +237,8 @@ int libewf_chunk_data_initialize_clear_data(
 
 		return( -1 );
 	}
+	( *chunk_data )->buffer_pool = buffer_pool;
+
 	if( data_size > 0 )
 	{
 		/* The allocated data size should be rounded to the next 16-byte increment
@@ -240,15 +249,17 @@ int libewf_chunk_data_initialize_clear_data(
 		}
 		data_size = ( data_size / 16 ) * 16;
 
-		( *chunk_data )->data = (uint8_t *) memory_allocate(
-		                                     sizeof( uint8_t ) * data_size );
-
-		if( ( *chunk_data )->data == NULL )
+		if( libewf_chunk_data_allocate_buffer(
+		     *chunk_data,
+		     data_size,
+		     &( ( *chunk_data )->data ),
+		     &( ( *chunk_data )->allocated_data_size ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 			 "%s: unable to create data.",
 			 function );
 
@@ -257,7 +268,7 @@ int libewf_chunk_data_initialize_clear_data(
 		if( memory_set(
 		     ( *chunk_data )->data,
 		     0,
-		     sizeof( uint8_t ) * data_size ) == NULL )
+		     sizeof( uint8_t ) * ( *chunk_data )->allocated_data_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
@@ -268,8 +279,7 @@ int libewf_chunk_data_initialize_clear_data(
 
 			goto on_error;
 		}
-		( *chunk_data )->allocated_data_size = data_size;
-		( *chunk_data )->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		( *chunk_data )->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 	}
 	return( 1 );
 
@@ -278,8 +288,11 @@ on_error:
 	{
 		if( ( *chunk_data )->data != NULL )
 		{
-			memory_free(
-			 ( *chunk_data )->data );
+			libewf_chunk_data_free_buffer(
+			 *chunk_data,
+			 &( ( *chunk_data )->data ),
+			 ( *chunk_data )->allocated_data_size,
+			 NULL );
 		}
 		memory_free(
 		 *chunk_data );
@@ -297,6 +310,7 @@ int libewf_chunk_data_free(
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_free";
+	int result            = 1;
 
 	if( chunk_data == NULL )
 	{
@@ -311,25 +325,408 @@ int libewf_chunk_data_free(
 	}
 	if( *chunk_data != NULL )
 	{
+		/* The chunk data is still referenced, hence only the reference is released
+		 */
+		if( ( *chunk_data )->number_of_references > 0 )
+		{
+			( *chunk_data )->number_of_references -= 1;
+
+			*chunk_data = NULL;
+
+			return( 1 );
+		}
 		if( ( ( *chunk_data )->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			if( ( *chunk_data )->data != NULL )
+			if( libewf_chunk_data_free_buffer(
+			     *chunk_data,
+			     &( ( *chunk_data )->data ),
+			     ( *chunk_data )->allocated_data_size,
+			     error ) != 1 )
 			{
-				memory_free(
-				 ( *chunk_data )->data );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free data.",
+				 function );
+
+				result = -1;
 			}
 		}
-		if( ( *chunk_data )->compressed_data != NULL )
+		if( libewf_chunk_data_free_buffer(
+		     *chunk_data,
+		     &( ( *chunk_data )->compressed_data ),
+		     ( *chunk_data )->allocated_compressed_data_size,
+		     error ) != 1 )
 		{
-			memory_free(
-			 ( *chunk_data )->compressed_data );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compressed data.",
+			 function );
+
+			result = -1;
 		}
 		memory_free(
 		 *chunk_data );
 
 		*chunk_data = NULL;
 	}
+	return( result );
+}
+
+/* Allocates a buffer for the chunk data
+ * The buffer is retrieved from the buffer pool if the size fits the buffers of the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_allocate_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocated_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocated size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->buffer_pool != NULL )
+	 && ( size <= chunk_data->buffer_pool->buffer_size ) )
+	{
+		*buffer = NULL;
+
+		if( libewf_buffer_pool_get_buffer(
+		     chunk_data->buffer_pool,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve buffer from buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+		*allocated_size = chunk_data->buffer_pool->buffer_size;
+	}
+	else
+	{
+		*buffer = (uint8_t *) memory_allocate(
+		                       sizeof( uint8_t ) * size );
+
+		if( *buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+		*allocated_size = size;
+	}
+	return( 1 );
+}
+
+/* Frees a buffer of the chunk data
+ * The buffer is released to the buffer pool if its allocated size matches the buffers of the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t allocated_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_free_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *buffer == NULL )
+	{
+		return( 1 );
+	}
+	if( ( chunk_data->buffer_pool != NULL )
+	 && ( allocated_size == chunk_data->buffer_pool->buffer_size ) )
+	{
+		if( libewf_buffer_pool_release_buffer(
+		     chunk_data->buffer_pool,
+		     buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffer to buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		memory_free(
+		 *buffer );
+
+		*buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Clones the chunk data
+ * The data and compressed data are copied into newly allocated buffers
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_clone(
+     libewf_chunk_data_t **destination_chunk_data,
+     libewf_chunk_data_t *source_chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_clone";
+
+	if( destination_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_chunk_data == NULL )
+	{
+		*destination_chunk_data = NULL;
+
+		return( 1 );
+	}
+	if( ( ( source_chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) == 0 )
+	 && ( source_chunk_data->data_size > source_chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source chunk data - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*destination_chunk_data = memory_allocate_structure(
+	                           libewf_chunk_data_t );
+
+	if( *destination_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create destination chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     *destination_chunk_data,
+	     source_chunk_data,
+	     sizeof( libewf_chunk_data_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy source to destination chunk data.",
+		 function );
+
+		memory_free(
+		 *destination_chunk_data );
+
+		*destination_chunk_data = NULL;
+
+		return( -1 );
+	}
+	( *destination_chunk_data )->data                           = NULL;
+	( *destination_chunk_data )->allocated_data_size            = 0;
+	( *destination_chunk_data )->compressed_data                = NULL;
+	( *destination_chunk_data )->allocated_compressed_data_size = 0;
+	( *destination_chunk_data )->number_of_references           = 0;
+	( *destination_chunk_data )->flags                          = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA
+	                                                            | ( source_chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL );
+
+	if( source_chunk_data->data != NULL )
+	{
+		if( libewf_chunk_data_allocate_buffer(
+		     *destination_chunk_data,
+		     source_chunk_data->allocated_data_size,
+		     &( ( *destination_chunk_data )->data ),
+		     &( ( *destination_chunk_data )->allocated_data_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_data )->data,
+		     source_chunk_data->data,
+		     source_chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( source_chunk_data->compressed_data != NULL )
+	{
+		if( libewf_chunk_data_allocate_buffer(
+		     *destination_chunk_data,
+		     source_chunk_data->compressed_data_size,
+		     &( ( *destination_chunk_data )->compressed_data ),
+		     &( ( *destination_chunk_data )->allocated_compressed_data_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination compressed data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     ( *destination_chunk_data )->compressed_data,
+		     source_chunk_data->compressed_data,
+		     source_chunk_data->compressed_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy source to destination compressed data.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
+
+on_error:
+	if( *destination_chunk_data != NULL )
+	{
+		if( ( *destination_chunk_data )->compressed_data != NULL )
+		{
+			libewf_chunk_data_free_buffer(
+			 *destination_chunk_data,
+			 &( ( *destination_chunk_data )->compressed_data ),
+			 ( *destination_chunk_data )->allocated_compressed_data_size,
+			 NULL );
+		}
+		if( ( *destination_chunk_data )->data != NULL )
+		{
+			libewf_chunk_data_free_buffer(
+			 *destination_chunk_data,
+			 &( ( *destination_chunk_data )->data ),
+			 ( *destination_chunk_data )->allocated_data_size,
+			 NULL );
+		}
+		memory_free(
+		 *destination_chunk_data );
+
+		*destination_chunk_data = NULL;
+	}
+	return( -1 );
 }
 
 /* Packs the chunk data
@@ -345,6 +742,7 @@ int libewf_chunk_data_pack(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
 	static char *function = "libewf_chunk_data_pack";
@@ -487,15 +885,17 @@ int libewf_chunk_data_pack(
 			{
 				chunk_data->compressed_data_size = 2 * chunk_size;
 			}
-			chunk_data->compressed_data = (uint8_t *) memory_allocate(
-			                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
-
-			if( chunk_data->compressed_data == NULL )
+			if( libewf_chunk_data_allocate_buffer(
+			     chunk_data,
+			     chunk_data->compressed_data_size,
+			     &( chunk_data->compressed_data ),
+			     &( chunk_data->allocated_compressed_data_size ),
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 				 "%s: unable to create compressed data.",
 				 function );
 
@@ -519,6 +919,7 @@ int libewf_chunk_data_pack(
 		     compressed_zero_byte_empty_block,
 		     compressed_zero_byte_empty_block_size,
 		     pack_flags,
+		     compression_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -536,14 +937,29 @@ int libewf_chunk_data_pack(
 		{
 			if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 			{
-				memory_free(
-				 chunk_data->data );
+				if( libewf_chunk_data_free_buffer(
+				     chunk_data,
+				     &( chunk_data->data ),
+				     chunk_data->allocated_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free data.",
+					 function );
+
+					goto on_error;
+				}
 			}
-			chunk_data->data  = chunk_data->compressed_data;
-			chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+			chunk_data->data                = chunk_data->compressed_data;
+			chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+			chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
 
-			chunk_data->compressed_data      = NULL;
-			chunk_data->compressed_data_size = 0;
+			chunk_data->compressed_data                = NULL;
+			chunk_data->allocated_compressed_data_size = 0;
+			chunk_data->compressed_data_size           = 0;
 		}
 		chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 	}
@@ -552,12 +968,14 @@ int libewf_chunk_data_pack(
 on_error:
 	if( chunk_data->compressed_data != NULL )
 	{
-		memory_free(
-		 chunk_data->compressed_data );
-
-		chunk_data->compressed_data = NULL;
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->compressed_data ),
+		 chunk_data->allocated_compressed_data_size,
+		 NULL );
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->allocated_compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
 
 	return( -1 );
 }
@@ -583,6 +1001,7 @@ int libewf_chunk_data_pack_buffer(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
 	static char *function            = "libewf_chunk_data_pack_buffer";
@@ -820,6 +1239,7 @@ int libewf_chunk_data_pack_buffer(
 			          compression_level,
 			          data,
 			          chunk_data_size,
+			          compression_context,
 			          error );
 
 			if( result == -1 )
@@ -1015,9 +1435,15 @@ int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      uint32_t chunk_size,
      uint16_t compression_method,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
+	uint8_t fill_pattern[ 8 ];
+
 	static char *function = "libewf_chunk_data_unpack";
+	size_t data_size      = 0;
+	uint64_t pattern      = 0;
+	int result            = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1030,6 +1456,12 @@ int libewf_chunk_data_unpack(
 
 		return( -1 );
 	}
+	/* A fill pattern is already unpacked
+	 */
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) != 0 )
+	{
+		return( 1 );
+	}
 	if( chunk_data->data == NULL )
 	{
 		libcerror_error_set(
@@ -1069,30 +1501,60 @@ int libewf_chunk_data_unpack(
 
 				return( -1 );
 			}
-			chunk_data->compressed_data      = chunk_data->data;
-			chunk_data->compressed_data_size = chunk_data->data_size;
+			/* Chunks that contain a fill pattern are not decompressed
+			 */
+			result = libewf_chunk_data_unpack_fill(
+			          chunk_data,
+			          chunk_size,
+			          compression_method,
+			          compression_context,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack fill pattern.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				return( 1 );
+			}
+			chunk_data->compressed_data                = chunk_data->data;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+			chunk_data->compressed_data_size           = chunk_data->data_size;
+
+			chunk_data->data                = NULL;
+			chunk_data->allocated_data_size = 0;
 
 			/* Reserve 4 bytes for the checksum
 			 */
-			chunk_data->allocated_data_size = (size_t) ( chunk_size + 4 );
+			data_size = (size_t) ( chunk_size + 4 );
 
 			/* The allocated data size should be rounded to the next 16-byte increment
 			 */
-			if( ( chunk_data->allocated_data_size % 16 ) != 0 )
+			if( ( data_size % 16 ) != 0 )
 			{
-				chunk_data->allocated_data_size += 16;
+				data_size += 16;
 			}
-			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
+			data_size = ( data_size / 16 ) * 16;
 
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
+			if( libewf_chunk_data_allocate_buffer(
+			     chunk_data,
+			     data_size,
+			     &( chunk_data->data ),
+			     &( chunk_data->allocated_data_size ),
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
 				 "%s: unable to create data.",
 				 function );
 
@@ -1110,6 +1572,7 @@ int libewf_chunk_data_unpack(
 		     chunk_data->range_flags,
 		     0,
 		     0,
+		     compression_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1136,7 +1599,308 @@ int libewf_chunk_data_unpack(
 			chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
 		}
 		chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
+
+		/* Remember the encoding of a decompressed chunk that contains a fill pattern
+		 * so that subsequent chunks with the same encoding are not decompressed
+		 */
+		if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) == 0 )
+		 && ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 && ( compression_context != NULL )
+		 && ( chunk_data->compressed_data_size <= (size_t) LIBEWF_MAXIMUM_FILL_ENCODING_SIZE )
+		 && ( chunk_data->data_size >= 8 ) )
+		{
+			result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+			          chunk_data->data,
+			          chunk_data->data_size,
+			          &pattern,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to determine if chunk data contains a fill pattern.",
+				 function );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				if( memory_copy(
+				     fill_pattern,
+				     chunk_data->data,
+				     8 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy fill pattern.",
+					 function );
+
+					return( -1 );
+				}
+				if( libewf_compression_context_set_fill_encoding(
+				     compression_context,
+				     chunk_data->compressed_data,
+				     chunk_data->compressed_data_size,
+				     chunk_data->data_size,
+				     fill_pattern,
+				     8,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set fill encoding.",
+					 function );
+
+					return( -1 );
+				}
+				if( libewf_chunk_data_set_fill(
+				     chunk_data,
+				     chunk_data->data_size,
+				     fill_pattern,
+				     8,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set fill pattern.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Unpacks chunk data that contains a fill pattern
+ * A fill pattern is either stored explicitly or recognized from
+ * the encoding of a previously decompressed chunk
+ * Returns 1 if successful, 0 if the chunk data does not contain a fill pattern or -1 on error
+ */
+int libewf_chunk_data_unpack_fill(
+     libewf_chunk_data_t *chunk_data,
+     uint32_t chunk_size,
+     uint16_t compression_method,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	static char *function = "libewf_chunk_data_unpack_fill";
+	size_t data_size      = 0;
+	int result            = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	 || ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+	{
+		if( chunk_data->data_size < 8 )
+		{
+			return( 0 );
+		}
+		if( memory_copy(
+		     fill_pattern,
+		     chunk_data->data,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		data_size = (size_t) chunk_size;
+	}
+	else
+	{
+		if( ( compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 || ( compression_context == NULL ) )
+		{
+			return( 0 );
+		}
+		result = libewf_compression_context_get_fill_encoding(
+		          compression_context,
+		          chunk_data->data,
+		          chunk_data->data_size,
+		          &data_size,
+		          fill_pattern,
+		          8,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve fill encoding.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( data_size > (size_t) chunk_size )
+		{
+			return( 0 );
+		}
+	}
+	if( libewf_chunk_data_set_fill(
+	     chunk_data,
+	     data_size,
+	     fill_pattern,
+	     8,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_IS_PACKED );
+
+	return( 1 );
+}
+
+/* Replaces the data of the chunk data by a fill pattern
+ * The data is released and the fill pattern is expanded when the chunk data is read
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_set_fill(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_set_fill";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
 	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fill pattern size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     chunk_data->fill_pattern,
+	     fill_pattern,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
+	{
+		if( libewf_chunk_data_free_buffer(
+		     chunk_data,
+		     &( chunk_data->data ),
+		     chunk_data->allocated_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	chunk_data->data                = NULL;
+	chunk_data->allocated_data_size = 0;
+	chunk_data->data_size           = data_size;
+	chunk_data->flags              |= LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL;
+
 	return( 1 );
 }
 
@@ -1154,6 +1918,7 @@ int libewf_chunk_data_unpack_buffer(
      uint32_t range_flags,
      uint32_t chunk_checksum,
      int8_t chunk_io_flags,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
 	static char *function        = "libewf_chunk_data_unpack_buffer";
@@ -1264,34 +2029,22 @@ int libewf_chunk_data_unpack_buffer(
 			}
 			*data_size = (size_t) chunk_size;
 
-			switch( chunk_size % 8 )
-			{
-				case 7:
-					data[ --chunk_size ] = compressed_data[ 7 ];
-				case 6:
-					data[ --chunk_size ] = compressed_data[ 6 ];
-				case 5:
-					data[ --chunk_size ] = compressed_data[ 5 ];
-				case 4:
-					data[ --chunk_size ] = compressed_data[ 4 ];
-				case 3:
-					data[ --chunk_size ] = compressed_data[ 3 ];
-				case 2:
-					data[ --chunk_size ] = compressed_data[ 2 ];
-				case 1:
-					data[ --chunk_size ] = compressed_data[ 1 ];
-			}
-			while( chunk_size > 0 )
+			if( libewf_chunk_data_fill_buffer(
+			     compressed_data,
+			     8,
+			     0,
+			     data,
+			     (size_t) chunk_size,
+			     error ) != 1 )
 			{
-/* TODO make this memory aligned ? */
-				data[ --chunk_size ] = compressed_data[ 7 ];
-				data[ --chunk_size ] = compressed_data[ 6 ];
-				data[ --chunk_size ] = compressed_data[ 5 ];
-				data[ --chunk_size ] = compressed_data[ 4 ];
-				data[ --chunk_size ] = compressed_data[ 3 ];
-				data[ --chunk_size ] = compressed_data[ 2 ];
-				data[ --chunk_size ] = compressed_data[ 1 ];
-				data[ --chunk_size ] = compressed_data[ 0 ];
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to fill chunk data.",
+				 function );
+
+				return( -1 );
 			}
 		}
 		else
@@ -1302,6 +2055,7 @@ int libewf_chunk_data_unpack_buffer(
 			     compression_method,
 			     data,
 			     data_size,
+			     compression_context,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1369,6 +2123,618 @@ int libewf_chunk_data_unpack_buffer(
 	return( 1 );
 }
 
+/* Unpacks chunk data directly into a buffer, without an intermediate chunk data
+ * If the chunk data is compressed the compressed data is unpacked into the data,
+ * which must be able to contain a full chunk. Otherwise the data must already contain
+ * the chunk data, without the checksum, and the checksum is validated
+ * The range flags are updated to mark corrupted chunk data
+ * Returns the number of bytes of unpacked data or -1 on error
+ */
+ssize_t libewf_chunk_data_unpack_into_buffer(
+         const uint8_t *compressed_data,
+         size_t compressed_data_size,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t chunk_size,
+         uint16_t compression_method,
+         uint32_t *range_flags,
+         uint32_t chunk_checksum,
+         libewf_compression_context_t *compression_context,
+         libcerror_error_t **error )
+{
+	uint8_t fill_pattern[ 8 ];
+
+	static char *function = "libewf_chunk_data_unpack_into_buffer";
+	size_t unpacked_size  = 0;
+	uint64_t pattern      = 0;
+	int result            = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( data_size < (size_t) chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		/* Chunks that contain a previously recognized fill pattern are not decompressed
+		 */
+		if( ( ( *range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+		 && ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 && ( compression_context != NULL ) )
+		{
+			result = libewf_compression_context_get_fill_encoding(
+			          compression_context,
+			          compressed_data,
+			          compressed_data_size,
+			          &unpacked_size,
+			          fill_pattern,
+			          8,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve fill encoding.",
+				 function );
+
+				return( -1 );
+			}
+			else if( ( result != 0 )
+			      && ( unpacked_size <= (size_t) chunk_size ) )
+			{
+				if( libewf_chunk_data_fill_buffer(
+				     fill_pattern,
+				     8,
+				     0,
+				     data,
+				     unpacked_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to fill chunk data.",
+					 function );
+
+					return( -1 );
+				}
+				return( (ssize_t) unpacked_size );
+			}
+		}
+		unpacked_size = (size_t) chunk_size;
+	}
+	else if( ( *range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		/* Add the size of the checksum, which is not stored in the data
+		 */
+		unpacked_size = data_size + 4;
+	}
+	else
+	{
+		return( (ssize_t) data_size );
+	}
+	if( libewf_chunk_data_unpack_buffer(
+	     data,
+	     &unpacked_size,
+	     compressed_data,
+	     compressed_data_size,
+	     chunk_size,
+	     compression_method,
+	     *range_flags,
+	     chunk_checksum,
+	     LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET,
+	     compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk buffer.",
+		 function );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		*range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+		if( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			return( (ssize_t) chunk_size );
+		}
+		return( (ssize_t) data_size );
+	}
+	/* Remember the encoding of a decompressed chunk that contains a fill pattern
+	 * so that subsequent chunks with the same encoding are not decompressed
+	 */
+	if( ( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	 && ( ( *range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	 && ( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
+	 && ( compression_context != NULL )
+	 && ( compressed_data_size <= (size_t) LIBEWF_MAXIMUM_FILL_ENCODING_SIZE )
+	 && ( unpacked_size >= 8 ) )
+	{
+		result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+		          data,
+		          unpacked_size,
+		          &pattern,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to determine if chunk data contains a fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libewf_compression_context_set_fill_encoding(
+			     compression_context,
+			     compressed_data,
+			     compressed_data_size,
+			     unpacked_size,
+			     data,
+			     8,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set fill encoding.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) unpacked_size );
+}
+
+/* Reads (unpacked) chunk data at a specific offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_chunk_data_read_buffer(
+         libewf_chunk_data_t *chunk_data,
+         off64_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_buffer";
+	size_t read_size      = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->data == NULL )
+	 && ( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid chunk data - data is packed.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_offset < 0 )
+	 || ( (size_t) chunk_data_offset > chunk_data->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	read_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+	if( read_size > buffer_size )
+	{
+		read_size = buffer_size;
+	}
+	if( read_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) != 0 )
+	{
+		if( libewf_chunk_data_fill_buffer(
+		     chunk_data->fill_pattern,
+		     8,
+		     chunk_data_offset,
+		     buffer,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( memory_copy(
+	          buffer,
+	          &( ( chunk_data->data )[ chunk_data_offset ] ),
+	          read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data to buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) read_size );
+}
+
+/* Fills a buffer with a 64-bit fill pattern
+ * The chunk data offset determines the position in the fill pattern of the first byte
+ * A pattern of a single byte value is filled using a memory set, other patterns
+ * are written once and the filled part is then doubled using memory copies
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_fill_buffer(
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     off64_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_fill_buffer";
+	size_t copy_size      = 0;
+	size_t fill_size      = 0;
+	uint8_t pattern_index = 0;
+
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fill pattern size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 1 );
+	}
+	for( pattern_index = 1;
+	     pattern_index < 8;
+	     pattern_index++ )
+	{
+		if( fill_pattern[ pattern_index ] != fill_pattern[ 0 ] )
+		{
+			break;
+		}
+	}
+	/* An empty-block is filled with a single byte value
+	 */
+	if( pattern_index == 8 )
+	{
+		if( memory_set(
+		     buffer,
+		     fill_pattern[ 0 ],
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to set buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	pattern_index = (uint8_t) ( chunk_data_offset % 8 );
+
+	while( ( fill_size < 8 )
+	    && ( fill_size < buffer_size ) )
+	{
+		buffer[ fill_size++ ] = fill_pattern[ pattern_index ];
+
+		pattern_index = ( pattern_index + 1 ) % 8;
+	}
+	/* The filled part of the buffer is a multiple of the pattern size
+	 * hence it can be copied as a whole without changing the phase of the pattern
+	 */
+	while( fill_size < buffer_size )
+	{
+		copy_size = buffer_size - fill_size;
+
+		if( copy_size > fill_size )
+		{
+			copy_size = fill_size;
+		}
+		if( memory_copy(
+		     &( buffer[ fill_size ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		fill_size += copy_size;
+	}
+	return( 1 );
+}
+
+/* Expands the fill pattern of the chunk data into data
+ * This is needed before the data of the chunk data can be modified
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_expand_fill(
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_expand_fill";
+	size_t data_size      = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) == 0 )
+	{
+		return( 1 );
+	}
+	if( chunk_data->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data_size > (size_t) ( SSIZE_MAX - 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Reserve 4 bytes for the checksum
+	 */
+	data_size = chunk_data->data_size + 4;
+
+	/* The allocated data size should be rounded to the next 16-byte increment
+	 */
+	if( ( data_size % 16 ) != 0 )
+	{
+		data_size += 16;
+	}
+	data_size = ( data_size / 16 ) * 16;
+
+	if( libewf_chunk_data_allocate_buffer(
+	     chunk_data,
+	     data_size,
+	     &( chunk_data->data ),
+	     &( chunk_data->allocated_data_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_fill_buffer(
+	     chunk_data->fill_pattern,
+	     8,
+	     0,
+	     chunk_data->data,
+	     chunk_data->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to fill data.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+
+	return( 1 );
+
+on_error:
+	if( chunk_data->data != NULL )
+	{
+		libewf_chunk_data_free_buffer(
+		 chunk_data,
+		 &( chunk_data->data ),
+		 chunk_data->allocated_data_size,
+		 NULL );
+	}
+	chunk_data->allocated_data_size = 0;
+
+	return( -1 );
+}
+
 /* Checks if a buffer containing the chunk data is filled with same value bytes (empty-block)
  * Returns 1 if a pattern was found, 0 if not or -1 on error
  */
@@ -1874,6 +3240,301 @@ int libewf_chunk_data_get_checksum(
 	return( result );
 }
 
+/* Creates chunk data from a copy of packed data
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_initialize_from_packed_data(
+     libewf_chunk_data_t **chunk_data,
+     const uint8_t *packed_data,
+     size_t packed_data_size,
+     uint32_t chunk_data_flags,
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_initialize_from_packed_data";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( packed_data_size == 0 )
+	 || ( packed_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid packed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     packed_data_size,
+	     buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( *chunk_data )->data,
+	     packed_data,
+	     packed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy packed data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_data )->data_size = packed_data_size;
+
+	( *chunk_data )->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                             & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads chunk data from a file IO pool entry
+ * The chunk data is read as packed data
+ * If a mapped file pool is provided the chunk data is copied from the mapped file if available
+ * otherwise if a read-ahead buffer is provided the chunk data is read using the read-ahead buffer
+ * Make sure the value chunk_data is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_read_file_io_pool(
+     libewf_chunk_data_t **chunk_data,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libewf_buffer_pool_t *buffer_pool,
+     libewf_read_ahead_buffer_t *read_ahead_buffer,
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_file_io_pool";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data_size == (size64_t) 0 )
+	 || ( chunk_data_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     (size_t) chunk_data_size,
+	     buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	if( mapped_file_pool != NULL )
+	{
+		result = libewf_mapped_file_pool_read_buffer(
+		          mapped_file_pool,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          ( *chunk_data )->data,
+		          (size_t) chunk_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk data from mapped file.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			read_count = (ssize_t) chunk_data_size;
+		}
+	}
+	if( result == 0 )
+	{
+		if( read_ahead_buffer != NULL )
+		{
+			read_count = libewf_read_ahead_buffer_read_buffer(
+			              read_ahead_buffer,
+			              file_io_pool,
+			              file_io_pool_entry,
+			              chunk_data_offset,
+			              ( *chunk_data )->data,
+			              (size_t) chunk_data_size,
+			              error );
+		}
+		else
+		{
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     chunk_data_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+				 function,
+				 chunk_data_offset,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			read_count = libbfio_pool_read_buffer(
+				      file_io_pool,
+				      file_io_pool_entry,
+				      ( *chunk_data )->data,
+				      (size_t) chunk_data_size,
+				      error );
+		}
+	}
+	if( read_count != (ssize_t) chunk_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_data )->data_size = (size_t) read_count;
+
+	( *chunk_data )->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                             & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -1893,7 +3554,6 @@ int libewf_chunk_data_read_element_data(
 	libewf_chunk_data_t *chunk_data = NULL;
 	static char *function           = "libewf_chunk_data_read_element_data";
 	off64_t storage_media_offset    = 0;
-	ssize_t read_count              = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	uint64_t chunk_index            = -1;
@@ -1946,31 +3606,6 @@ int libewf_chunk_data_read_element_data(
 
 		return( -1 );
 	}
-	if( libewf_chunk_data_initialize(
-	     &chunk_data,
-	     (size_t) chunk_data_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk data.",
-		 function );
-
-		goto on_error;
-	}
-	if( chunk_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing chunk data.",
-		 function );
-
-		goto on_error;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1990,32 +3625,17 @@ int libewf_chunk_data_read_element_data(
 		 file_io_pool_entry );
 	}
 #endif
-	if( libbfio_pool_seek_offset(
+	if( libewf_chunk_data_read_file_io_pool(
+	     &chunk_data,
 	     file_io_pool,
 	     file_io_pool_entry,
 	     chunk_data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
-		 function,
-		 chunk_data_offset,
-		 file_io_pool_entry );
-
-		goto on_error;
-	}
-	read_count = libbfio_pool_read_buffer(
-		      file_io_pool,
-		      file_io_pool_entry,
-		      chunk_data->data,
-		      (size_t) chunk_data_size,
-		      error );
-
-	if( read_count != (ssize_t) chunk_data_size )
+	     chunk_data_size,
+	     chunk_data_flags,
+	     NULL,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
@@ -2026,11 +3646,6 @@ int libewf_chunk_data_read_element_data(
 
 		goto on_error;
 	}
-	chunk_data->data_size = (size_t) read_count;
-
-	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
-	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
-
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
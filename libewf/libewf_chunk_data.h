@@ -25,11 +25,15 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_compression_context.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_mapped_file_pool.h"
+#include "libewf_read_ahead_buffer.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -51,6 +55,10 @@ struct libewf_chunk_data
 	 */
 	size_t data_size;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
 	/* The compressed data
 	 */
 	uint8_t *compressed_data;
@@ -79,6 +87,21 @@ struct libewf_chunk_data
 	 */
 	uint8_t flags;
 
+	/* The fill pattern
+	 * only used if the chunk data item contains a fill pattern instead of data
+	 */
+	uint8_t fill_pattern[ 8 ];
+
+	/* The number of references in addition to the owner of the chunk data
+	 * such as chunk views, the chunk data is only freed if there are no references
+	 */
+	int number_of_references;
+
+	/* The buffer pool the data and compressed data buffers are retrieved from
+	 * only used if the allocated size matches the buffer size of the buffer pool
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
 /* TODO chunk data rewrite */
 	/* The chunk IO flags
 	 */
@@ -88,17 +111,37 @@ struct libewf_chunk_data
 int libewf_chunk_data_initialize(
      libewf_chunk_data_t **chunk_data,
      size_t data_size,
+     libewf_buffer_pool_t *buffer_pool,
      libcerror_error_t **error );
 
 int libewf_chunk_data_initialize_clear_data(
      libewf_chunk_data_t **chunk_data,
      size_t data_size,
+     libewf_buffer_pool_t *buffer_pool,
      libcerror_error_t **error );
 
 int libewf_chunk_data_free(
      libewf_chunk_data_t **chunk_data,
      libcerror_error_t **error );
 
+int libewf_chunk_data_allocate_buffer(
+     libewf_chunk_data_t *chunk_data,
+     size_t size,
+     uint8_t **buffer,
+     size_t *allocated_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_free_buffer(
+     libewf_chunk_data_t *chunk_data,
+     uint8_t **buffer,
+     size_t allocated_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_clone(
+     libewf_chunk_data_t **destination_chunk_data,
+     libewf_chunk_data_t *source_chunk_data,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
      uint32_t chunk_size,
@@ -108,6 +151,7 @@ int libewf_chunk_data_pack(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error );
 
 int libewf_chunk_data_pack_buffer(
@@ -127,12 +171,28 @@ int libewf_chunk_data_pack_buffer(
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error );
 
 int libewf_chunk_data_unpack(
      libewf_chunk_data_t *chunk_data,
      uint32_t chunk_size,
      uint16_t compression_method,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_unpack_fill(
+     libewf_chunk_data_t *chunk_data,
+     uint32_t chunk_size,
+     uint16_t compression_method,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_set_fill(
+     libewf_chunk_data_t *chunk_data,
+     size_t data_size,
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
      libcerror_error_t **error );
 
 int libewf_chunk_data_unpack_buffer(
@@ -145,6 +205,38 @@ int libewf_chunk_data_unpack_buffer(
      uint32_t range_flags,
      uint32_t chunk_checksum,
      int8_t chunk_io_flags,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+ssize_t libewf_chunk_data_unpack_into_buffer(
+         const uint8_t *compressed_data,
+         size_t compressed_data_size,
+         uint8_t *data,
+         size_t data_size,
+         uint32_t chunk_size,
+         uint16_t compression_method,
+         uint32_t *range_flags,
+         uint32_t chunk_checksum,
+         libewf_compression_context_t *compression_context,
+         libcerror_error_t **error );
+
+ssize_t libewf_chunk_data_read_buffer(
+         libewf_chunk_data_t *chunk_data,
+         off64_t chunk_data_offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+int libewf_chunk_data_fill_buffer(
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     off64_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_expand_fill(
+     libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
 int libewf_chunk_data_check_for_empty_block(
@@ -175,6 +267,26 @@ int libewf_chunk_data_get_checksum(
      uint32_t *checksum,
      libcerror_error_t **error );
 
+int libewf_chunk_data_initialize_from_packed_data(
+     libewf_chunk_data_t **chunk_data,
+     const uint8_t *packed_data,
+     size_t packed_data_size,
+     uint32_t chunk_data_flags,
+     libewf_buffer_pool_t *buffer_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_read_file_io_pool(
+     libewf_chunk_data_t **chunk_data,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t chunk_data_flags,
+     libewf_buffer_pool_t *buffer_pool,
+     libewf_read_ahead_buffer_t *read_ahead_buffer,
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
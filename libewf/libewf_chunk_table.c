@@ -26,12 +26,15 @@
 
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_table.h"
+#include "libewf_compressed_chunk_cache.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_packed_chunk_table.h"
+#include "libewf_read_ahead_buffer.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -177,6 +180,54 @@ int libewf_chunk_table_free(
 
 			result = -1;
 		}
+		if( ( *chunk_table )->packed_chunk_table != NULL )
+		{
+			if( libewf_packed_chunk_table_free(
+			     &( ( *chunk_table )->packed_chunk_table ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free packed chunk table.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_table )->compressed_chunk_cache != NULL )
+		{
+			if( libewf_compressed_chunk_cache_free(
+			     &( ( *chunk_table )->compressed_chunk_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free compressed chunk cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_table )->read_ahead_buffer != NULL )
+		{
+			if( libewf_read_ahead_buffer_free(
+			     &( ( *chunk_table )->read_ahead_buffer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free read-ahead buffer.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *chunk_table );
 
@@ -251,7 +302,12 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
-	( *destination_chunk_table )->checksum_errors = NULL;
+	( *destination_chunk_table )->checksum_errors        = NULL;
+	( *destination_chunk_table )->packed_chunk_table     = NULL;
+	( *destination_chunk_table )->compressed_chunk_cache = NULL;
+	( *destination_chunk_table )->read_ahead_buffer      = NULL;
+	( *destination_chunk_table )->buffer_pool            = NULL;
+	( *destination_chunk_table )->mapped_file_pool       = NULL;
 
 	if( libcdata_range_list_clone(
 	     &( ( *destination_chunk_table )->checksum_errors ),
@@ -269,11 +325,84 @@ int libewf_chunk_table_clone(
 
 		goto on_error;
 	}
+	/* The packed chunk table of the destination is filled when its chunk groups are read
+	 */
+	if( source_chunk_table->packed_chunk_table != NULL )
+	{
+		if( libewf_packed_chunk_table_initialize(
+		     &( ( *destination_chunk_table )->packed_chunk_table ),
+		     source_chunk_table->packed_chunk_table->maximum_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination packed chunk table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( source_chunk_table->compressed_chunk_cache != NULL )
+	{
+		if( libewf_compressed_chunk_cache_initialize(
+		     &( ( *destination_chunk_table )->compressed_chunk_cache ),
+		     source_chunk_table->compressed_chunk_cache->maximum_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination compressed chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( source_chunk_table->read_ahead_buffer != NULL )
+	{
+		if( libewf_read_ahead_buffer_initialize(
+		     &( ( *destination_chunk_table )->read_ahead_buffer ),
+		     source_chunk_table->read_ahead_buffer->minimum_read_ahead_size,
+		     source_chunk_table->read_ahead_buffer->maximum_read_ahead_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination read-ahead buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	return( 1 );
 
 on_error:
 	if( *destination_chunk_table != NULL )
 	{
+		if( ( *destination_chunk_table )->compressed_chunk_cache != NULL )
+		{
+			libewf_compressed_chunk_cache_free(
+			 &( ( *destination_chunk_table )->compressed_chunk_cache ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->packed_chunk_table != NULL )
+		{
+			libewf_packed_chunk_table_free(
+			 &( ( *destination_chunk_table )->packed_chunk_table ),
+			 NULL );
+		}
+		if( ( *destination_chunk_table )->checksum_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( ( *destination_chunk_table )->checksum_errors ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *destination_chunk_table );
 
@@ -282,6 +411,155 @@ on_error:
 	return( -1 );
 }
 
+/* Initializes the packed chunk table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_initialize_packed_chunk_table(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_initialize_packed_chunk_table";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->packed_chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk table - packed chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_packed_chunk_table_initialize(
+	     &( chunk_table->packed_chunk_table ),
+	     maximum_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the compressed chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_initialize_compressed_chunk_cache(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_initialize_compressed_chunk_cache";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->compressed_chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk table - compressed chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_compressed_chunk_cache_initialize(
+	     &( chunk_table->compressed_chunk_cache ),
+	     maximum_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Initializes the segment file read-ahead buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_initialize_read_ahead_buffer(
+     libewf_chunk_table_t *chunk_table,
+     size_t minimum_read_ahead_size,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_initialize_read_ahead_buffer";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->read_ahead_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk table - read-ahead buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_read_ahead_buffer_initialize(
+	     &( chunk_table->read_ahead_buffer ),
+	     minimum_read_ahead_size,
+	     maximum_read_ahead_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the number of checksum errors
  * Returns 1 if successful or -1 on error
  */
@@ -698,38 +976,37 @@ int libewf_chunk_table_chunk_exists_for_offset(
 	return( result );
 }
 
-/* Retrieves the chunk data of a chunk at a specific offset
- * Adds a checksum error if the data is corrupted
- * Returns 1 if successful or -1 on error
+/* Retrieves the chunk data of a chunk using the packed chunk table
+ * The chunk data is not unpacked, hence it can still be packed
+ * Returns 1 if successful, 0 if the chunk is not in the packed chunk table or -1 on error
  */
-int libewf_chunk_table_get_chunk_data_by_offset(
+int libewf_chunk_table_get_packed_chunk_data_from_packed_chunk_table(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
-     libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
-     libewf_media_values_t *media_values,
-     libewf_segment_table_t *segment_table,
-     libfdata_range_list_t *delta_chunks_range_list,
-     libfcache_cache_t *chunk_groups_cache,
      libfcache_cache_t *chunks_cache,
      off64_t offset,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	libfdata_list_t *chunks_list        = NULL;
-	static char *function               = "libewf_chunk_table_get_chunk_data_by_offset";
-	off64_t chunk_offset                = 0;
-	off64_t chunk_group_data_offset     = 0;
-	off64_t segment_file_data_offset    = 0;
-	size_t chunk_data_size              = 0;
-	uint64_t start_sector               = 0;
-	uint64_t number_of_sectors          = 0;
-	uint32_t segment_number             = 0;
-	int chunk_groups_list_index         = 0;
-	int chunks_list_index               = 0;
-	int result                          = 0;
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	libfcache_cache_value_t *cache_value = NULL;
+	const uint8_t *compressed_data       = NULL;
+	static char *function                = "libewf_chunk_table_get_packed_chunk_data_from_packed_chunk_table";
+	size64_t packed_chunk_data_size      = 0;
+	size_t compressed_data_size          = 0;
+	off64_t cache_value_offset           = 0;
+	off64_t packed_chunk_data_offset     = 0;
+	int64_t cache_value_timestamp        = 0;
+	intptr_t *value                      = NULL;
+	uint32_t compressed_data_range_flags = 0;
+	uint32_t range_flags                 = 0;
+	int cache_entry_index                = 0;
+	int cache_value_file_index           = -1;
+	int file_io_pool_entry               = 0;
+	int number_of_cache_entries          = 0;
+	int result                           = 0;
 
 	if( chunk_table == NULL )
 	{
@@ -742,24 +1019,13 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( media_values == NULL )
+	if( chunk_table->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media values.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk table - missing IO handle.",
 		 function );
 
 		return( -1 );
@@ -786,119 +1052,1147 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 		return( -1 );
 	}
-	if( delta_chunks_range_list != NULL )
+	if( chunk_table->packed_chunk_table == NULL )
 	{
-		result = libfdata_range_list_get_element_value_at_offset(
-			  delta_chunks_range_list,
-			  (intptr_t *) file_io_pool,
-			  chunks_cache,
-			  offset,
-			  chunk_data_offset,
-			  (intptr_t **) chunk_data,
-			  0,
-			  error );
+		return( 0 );
+	}
+	result = libewf_packed_chunk_table_get_chunk_by_index(
+	          chunk_table->packed_chunk_table,
+	          chunk_index,
+	          &file_io_pool_entry,
+	          &packed_chunk_data_offset,
+	          &packed_chunk_data_size,
+	          &range_flags,
+	          error );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve chunk: %" PRIu64 " from delta chunks range list.",
-			 function,
-			 chunk_index );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from packed chunk table.",
+		 function,
+		 chunk_index );
 
-			return( -1 );
-		}
+		goto on_error;
 	}
-	if( result == 0 )
+	else if( result == 0 )
 	{
-		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
-			  chunk_table,
-			  file_io_pool,
-			  segment_table,
-			  chunk_groups_cache,
-			  offset,
-			  &segment_number,
-			  &segment_file_data_offset,
-			  &segment_file,
-			  &chunk_groups_list_index,
-			  &chunk_group_data_offset,
+		return( 0 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunks cache entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks cache entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	cache_entry_index = (int) ( chunk_index % number_of_cache_entries );
+
+	if( libfcache_cache_get_value_by_index(
+	     chunks_cache,
+	     cache_entry_index,
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from chunks cache.",
+		 function,
+		 cache_entry_index );
+
+		goto on_error;
+	}
+	if( cache_value != NULL )
+	{
+		if( libfcache_cache_value_get_identifier(
+		     cache_value,
+		     &cache_value_file_index,
+		     &cache_value_offset,
+		     &cache_value_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( cache_value_file_index == file_io_pool_entry )
+	 && ( cache_value_offset == packed_chunk_data_offset )
+	 && ( cache_value_timestamp == LIBEWF_PACKED_CHUNK_TABLE_CACHE_TIMESTAMP ) )
+	{
+		if( libfcache_cache_value_get_value(
+		     cache_value,
+		     &value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve cache value.",
+			 function );
+
+			goto on_error;
+		}
+		*chunk_data = (libewf_chunk_data_t *) value;
+	}
+	else
+	{
+		result = 0;
+
+		if( ( chunk_table->compressed_chunk_cache != NULL )
+		 && ( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 ) )
+		{
+			result = libewf_compressed_chunk_cache_get_data(
+			          chunk_table->compressed_chunk_cache,
+			          chunk_index,
+			          &compressed_data,
+			          &compressed_data_size,
+			          &compressed_data_range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data from compressed chunk cache.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libewf_chunk_data_initialize_from_packed_data(
+				     &safe_chunk_data,
+				     compressed_data,
+				     compressed_data_size,
+				     compressed_data_range_flags,
+				     chunk_table->buffer_pool,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " data from compressed chunk cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
+		if( result == 0 )
+		{
+			if( libewf_chunk_data_read_file_io_pool(
+			     &safe_chunk_data,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     packed_chunk_data_offset,
+			     packed_chunk_data_size,
+			     range_flags,
+			     chunk_table->buffer_pool,
+			     chunk_table->read_ahead_buffer,
+			     chunk_table->mapped_file_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( ( chunk_table->compressed_chunk_cache != NULL )
+			 && ( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 ) )
+			{
+				if( libewf_compressed_chunk_cache_set_data(
+				     chunk_table->compressed_chunk_cache,
+				     chunk_index,
+				     safe_chunk_data->data,
+				     safe_chunk_data->data_size,
+				     range_flags,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data in compressed chunk cache.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
+		if( libfcache_cache_set_value_by_index(
+		     chunks_cache,
+		     cache_entry_index,
+		     file_io_pool_entry,
+		     packed_chunk_data_offset,
+		     LIBEWF_PACKED_CHUNK_TABLE_CACHE_TIMESTAMP,
+		     (intptr_t *) safe_chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in chunks cache.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* chunks_cache takes over management of chunk_data
+		 */
+		*chunk_data     = safe_chunk_data;
+		safe_chunk_data = NULL;
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	*chunk_data_offset = offset - (off64_t) ( chunk_index * chunk_table->io_handle->chunk_size );
+
+	return( 1 );
+
+on_error:
+	if( safe_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset
+ * The chunk data is not unpacked, hence it can still be packed
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_table_get_packed_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfdata_range_list_t *delta_chunks_range_list,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	libfdata_list_t *chunks_list        = NULL;
+	static char *function               = "libewf_chunk_table_get_packed_chunk_data_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( delta_chunks_range_list != NULL )
+	{
+		result = libfdata_range_list_get_element_value_at_offset(
+			  delta_chunks_range_list,
+			  (intptr_t *) file_io_pool,
+			  chunks_cache,
+			  offset,
+			  chunk_data_offset,
+			  (intptr_t **) chunk_data,
+			  0,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from delta chunks range list.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_packed_chunk_data_from_packed_chunk_table(
+			  chunk_table,
+			  chunk_index,
+			  file_io_pool,
+			  chunks_cache,
+			  offset,
+			  chunk_data,
+			  chunk_data_offset,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data using packed chunk table.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+			  chunk_table,
+			  file_io_pool,
+			  segment_table,
+			  chunk_groups_cache,
+			  offset,
+			  &segment_number,
+			  &segment_file_data_offset,
+			  &segment_file,
+			  &chunk_groups_list_index,
+			  &chunk_group_data_offset,
 			  &chunks_list,
 			  error );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file chunk group at offset: %" PRIi64 ".",
-			 function,
-			 offset );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( result != 0 )
+		{
+			if( chunks_list == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunks list: %d.",
+				 function,
+				 chunk_groups_list_index );
+
+				return( -1 );
+			}
+			result = libfdata_list_get_element_value_at_offset(
+				  chunks_list,
+				  (intptr_t *) file_io_pool,
+				  chunks_cache,
+				  chunk_group_data_offset,
+				  &chunks_list_index,
+				  chunk_data_offset,
+				  (intptr_t **) chunk_data,
+				  0,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at offset: %" PRIi64 ".",
+				 function,
+				 chunk_index,
+				 chunk_groups_list_index,
+				 segment_number,
+				 segment_file_data_offset );
+
+				return( -1 );
+			}
+			/* Store the chunks of the chunk group in the packed chunk table
+			 * so that the chunk group does not need to be read again
+			 */
+			if( ( result != 0 )
+			 && ( chunk_table->packed_chunk_table != NULL )
+			 && ( chunk_index >= (uint64_t) chunks_list_index ) )
+			{
+				if( libewf_packed_chunk_table_insert_chunks_list(
+				     chunk_table->packed_chunk_table,
+				     chunk_index - chunks_list_index,
+				     chunks_list,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert chunk group: %d in packed chunk table.",
+					 function,
+					 chunk_groups_list_index );
+
+					return( -1 );
+				}
+			}
+			if( ( result != 0 )
+			 && ( chunk_table->compressed_chunk_cache != NULL )
+			 && ( *chunk_data != NULL )
+			 && ( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+			 && ( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 ) )
+			{
+				if( libewf_compressed_chunk_cache_set_data(
+				     chunk_table->compressed_chunk_cache,
+				     chunk_index,
+				     ( *chunk_data )->data,
+				     ( *chunk_data )->data_size,
+				     ( *chunk_data )->range_flags,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data in compressed chunk cache.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		if( *chunk_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Retrieves the range of a chunk at a specific offset
+ * The chunk data itself is not read
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfdata_range_list_t *delta_chunks_range_list,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	libfdata_list_t *chunks_list        = NULL;
+	static char *function               = "libewf_chunk_table_get_chunk_range_by_offset";
+	off64_t chunk_group_data_offset     = 0;
+	off64_t element_data_offset         = 0;
+	off64_t segment_file_data_offset    = 0;
+	uint32_t segment_number             = 0;
+	int chunk_groups_list_index         = 0;
+	int chunks_list_index               = 0;
+	int result                          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( delta_chunks_range_list != NULL )
+	{
+		result = libfdata_range_list_get_element_at_offset(
+		          delta_chunks_range_list,
+		          offset,
+		          &element_data_offset,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from delta chunks range list.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*range_flags |= LIBEWF_RANGE_FLAG_IS_DELTA;
+		}
+	}
+	if( ( result == 0 )
+	 && ( chunk_table->packed_chunk_table != NULL ) )
+	{
+		result = libewf_packed_chunk_table_get_chunk_by_index(
+		          chunk_table->packed_chunk_table,
+		          chunk_index,
+		          file_io_pool_entry,
+		          chunk_data_offset,
+		          chunk_data_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " from packed chunk table.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
+		          chunk_table,
+		          file_io_pool,
+		          segment_table,
+		          chunk_groups_cache,
+		          offset,
+		          &segment_number,
+		          &segment_file_data_offset,
+		          &segment_file,
+		          &chunk_groups_list_index,
+		          &chunk_group_data_offset,
+		          &chunks_list,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file chunk group at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		if( result != 0 )
+		{
+			if( chunks_list == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunks list: %d.",
+				 function,
+				 chunk_groups_list_index );
+
+				return( -1 );
+			}
+			result = libfdata_list_get_element_at_offset(
+			          chunks_list,
+			          chunk_group_data_offset,
+			          &chunks_list_index,
+			          &element_data_offset,
+			          file_io_pool_entry,
+			          chunk_data_offset,
+			          chunk_data_size,
+			          range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " from chunk group: %d in segment file: %" PRIu32 " at offset: %" PRIi64 ".",
+				 function,
+				 chunk_index,
+				 chunk_groups_list_index,
+				 segment_number,
+				 segment_file_data_offset );
+
+				return( -1 );
+			}
+			/* Store the chunks of the chunk group in the packed chunk table
+			 * so that the chunk group does not need to be read again
+			 */
+			if( ( result != 0 )
+			 && ( chunk_table->packed_chunk_table != NULL )
+			 && ( chunk_index >= (uint64_t) chunks_list_index ) )
+			{
+				if( libewf_packed_chunk_table_insert_chunks_list(
+				     chunk_table->packed_chunk_table,
+				     chunk_index - chunks_list_index,
+				     chunks_list,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert chunk group: %d in packed chunk table.",
+					 function,
+					 chunk_groups_list_index );
+
+					return( -1 );
+				}
+			}
+		}
+	}
+	return( result );
+}
+
+/* Determines if the chunk data of a chunk in the packed chunk table is stored in the chunks cache
+ * Returns 1 if the chunk data is cached, 0 if not or -1 on error
+ */
+int libewf_chunk_table_chunk_data_is_cached(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libfcache_cache_t *chunks_cache,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value = NULL;
+	static char *function                = "libewf_chunk_table_chunk_data_is_cached";
+	off64_t cache_value_offset           = 0;
+	int64_t cache_value_timestamp        = 0;
+	int cache_value_file_index           = -1;
+	int number_of_cache_entries          = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunks cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_get_value_by_index(
+	     chunks_cache,
+	     (int) ( chunk_index % number_of_cache_entries ),
+	     &cache_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value: %d from chunks cache.",
+		 function,
+		 (int) ( chunk_index % number_of_cache_entries ) );
+
+		return( -1 );
+	}
+	if( cache_value == NULL )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_value_get_identifier(
+	     cache_value,
+	     &cache_value_file_index,
+	     &cache_value_offset,
+	     &cache_value_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache value identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cache_value_file_index == file_io_pool_entry )
+	 && ( cache_value_offset == chunk_data_offset )
+	 && ( cache_value_timestamp == LIBEWF_PACKED_CHUNK_TABLE_CACHE_TIMESTAMP ) )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Unpacks the chunk data of a chunk
+ * Clears the data of a corrupted chunk if zero on error is set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_unpack_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t *chunk_data,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_unpack_chunk_data";
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
+	{
+		return( 1 );
+	}
+	if( libewf_chunk_data_unpack(
+	     chunk_data,
+	     media_values->chunk_size,
+	     io_handle->compression_method,
+	     compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	 && ( io_handle->zero_on_error != 0 ) )
+	{
+		if( memory_set(
+		     chunk_data->data,
+		     0,
+		     chunk_data->data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to zero chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Creates the chunk data of a missing chunk
+ * The data is cleared and the chunk is marked as corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_create_missing_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_chunk_table_create_missing_chunk_data";
+	off64_t chunk_offset   = 0;
+	size_t chunk_data_size = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
+	chunk_data_size = media_values->chunk_size;
+
+	if( (size64_t) ( chunk_offset + chunk_data_size ) > media_values->media_size )
+	{
+		chunk_data_size = (size_t) ( media_values->media_size - chunk_offset );
+	}
+	if( libewf_chunk_data_initialize_clear_data(
+	     chunk_data,
+	     chunk_data_size,
+	     chunk_table->buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	( *chunk_data )->data_size    = chunk_data_size;
+	( *chunk_data )->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+
+	return( 1 );
+}
+
+/* Appends a checksum error for a corrupted chunk at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_append_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     libewf_media_values_t *media_values,
+     off64_t chunk_offset,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_chunk_table_append_chunk_checksum_error";
+	uint64_t number_of_sectors = 0;
+	uint64_t start_sector      = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid media values - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	start_sector      = chunk_offset / media_values->bytes_per_sector;
+	number_of_sectors = media_values->sectors_per_chunk;
+
+	if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
+	{
+		number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
+	}
+	if( libcdata_range_list_insert_range(
+	     chunk_table->checksum_errors,
+	     start_sector,
+	     number_of_sectors,
+	     NULL,
+	     NULL,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to insert checksum error in range list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( result != 0 )
-		{
-			if( chunks_list == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunks list: %d.",
-				 function,
-				 chunk_groups_list_index );
+/* Retrieves the chunk data of a chunk at a specific offset
+ * Adds a checksum error if the data is corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_table_get_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_media_values_t *media_values,
+     libewf_segment_table_t *segment_table,
+     libfdata_range_list_t *delta_chunks_range_list,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_table_get_chunk_data_by_offset";
+	off64_t chunk_offset  = 0;
+	int result            = 0;
 
-				return( -1 );
-			}
-			result = libfdata_list_get_element_value_at_offset(
-				  chunks_list,
-				  (intptr_t *) file_io_pool,
-				  chunks_cache,
-				  chunk_group_data_offset,
-				  &chunks_list_index,
-				  chunk_data_offset,
-				  (intptr_t **) chunk_data,
-				  0,
-				  error );
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
 
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk group: %d in segment file: %" PRIu32 " at offset: %" PRIi64 ".",
-				 function,
-				 chunk_index,
-				 chunk_groups_list_index,
-				 segment_number,
-				 segment_file_data_offset );
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
 
-				return( -1 );
-			}
-		}
+		return( -1 );
 	}
-	if( result != 0 )
+	result = libewf_chunk_table_get_packed_chunk_data_by_offset(
+	          chunk_table,
+	          chunk_index,
+	          file_io_pool,
+	          segment_table,
+	          delta_chunks_range_list,
+	          chunk_groups_cache,
+	          chunks_cache,
+	          offset,
+	          chunk_data,
+	          chunk_data_offset,
+	          error );
+
+	if( result == -1 )
 	{
-		if( *chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-			return( -1 );
-		}
-		if( libewf_chunk_data_unpack(
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libewf_chunk_table_unpack_chunk_data(
+		     chunk_table,
+		     chunk_index,
+		     io_handle,
+		     media_values,
 		     *chunk_data,
-		     media_values->chunk_size,
-		     io_handle->compression_method,
+		     compression_context,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -911,93 +2205,43 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 
 			return( -1 );
 		}
-		if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
-		{
-			if( io_handle->zero_on_error != 0 )
-			{
-				if( memory_set(
-				     ( *chunk_data )->data,
-				     0,
-				     ( *chunk_data )->data_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to zero chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-			}
-			chunk_offset = offset - *chunk_data_offset;
-		}
+		chunk_offset = offset - *chunk_data_offset;
 	}
 	else
 	{
-		chunk_offset    = (off64_t) chunk_index * media_values->chunk_size;
-		chunk_data_size = media_values->chunk_size;
-
-		if( (size64_t) ( chunk_offset + chunk_data_size ) > media_values->media_size )
-		{
-			chunk_data_size = (size_t) ( media_values->media_size - chunk_offset );
-		}
-		if( libewf_chunk_data_initialize_clear_data(
+		if( libewf_chunk_table_create_missing_chunk_data(
+		     chunk_table,
+		     chunk_index,
+		     media_values,
 		     chunk_data,
-		     chunk_data_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
-
-			return( -1 );
-		}
-		if( *chunk_data == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk data: %" PRIu64 ".",
+			 "%s: unable to create missing chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		( *chunk_data )->data_size    = chunk_data_size;
-		( *chunk_data )->range_flags |= LIBEWF_RANGE_FLAG_IS_CORRUPTED;
+		chunk_offset       = (off64_t) chunk_index * media_values->chunk_size;
+		*chunk_data_offset = offset - chunk_offset;
 	}
 	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 	{
-		/* Add checksum error
-		 */
-		start_sector      = chunk_offset / media_values->bytes_per_sector;
-		number_of_sectors = media_values->sectors_per_chunk;
-
-		if( ( start_sector + number_of_sectors ) > (uint64_t) media_values->number_of_sectors )
-		{
-			number_of_sectors = (uint64_t) media_values->number_of_sectors - start_sector;
-		}
-		if( libcdata_range_list_insert_range(
-		     chunk_table->checksum_errors,
-		     start_sector,
-		     number_of_sectors,
-		     NULL,
-		     NULL,
-		     NULL,
+		if( libewf_chunk_table_append_chunk_checksum_error(
+		     chunk_table,
+		     media_values,
+		     chunk_offset,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to insert checksum error in range list.",
+			 "%s: unable to append checksum error.",
 			 function );
 
 			return( -1 );
@@ -1006,6 +2250,124 @@ int libewf_chunk_table_get_chunk_data_by_offset(
 	return( 1 );
 }
 
+/* Sets the chunk data of a chunk in the packed chunk table
+ * Returns 1 if successful, 0 if the chunk is not in the packed chunk table or -1 on error
+ */
+int libewf_chunk_table_set_chunk_data_in_packed_chunk_table(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libfcache_cache_t *chunks_cache,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_chunk_table_set_chunk_data_in_packed_chunk_table";
+	size64_t packed_chunk_data_size  = 0;
+	off64_t packed_chunk_data_offset = 0;
+	uint32_t range_flags             = 0;
+	int file_io_pool_entry           = 0;
+	int number_of_cache_entries      = 0;
+	int result                       = 0;
+
+	if( chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_table->packed_chunk_table == NULL )
+	{
+		return( 0 );
+	}
+	result = libewf_packed_chunk_table_get_chunk_by_index(
+	          chunk_table->packed_chunk_table,
+	          chunk_index,
+	          &file_io_pool_entry,
+	          &packed_chunk_data_offset,
+	          &packed_chunk_data_size,
+	          &range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " from packed chunk table.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfcache_cache_get_number_of_entries(
+	     chunks_cache,
+	     &number_of_cache_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunks cache entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_cache_entries <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks cache entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfcache_cache_set_value_by_index(
+	     chunks_cache,
+	     (int) ( chunk_index % number_of_cache_entries ),
+	     file_io_pool_entry,
+	     packed_chunk_data_offset,
+	     LIBEWF_PACKED_CHUNK_TABLE_CACHE_TIMESTAMP,
+	     (intptr_t *) chunk_data,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+	     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data in chunks cache.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Sets the chunk data of a chunk at a specific offset
  * Adds a checksum error if the data is corrupted
  * Returns 1 if successful or -1 on error
@@ -1079,6 +2441,28 @@ int libewf_chunk_table_set_chunk_data_by_offset(
 		}
 	}
 	else
+	{
+		result = libewf_chunk_table_set_chunk_data_in_packed_chunk_table(
+			  chunk_table,
+			  chunk_index,
+			  chunks_cache,
+			  chunk_data,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data using packed chunk table.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
 	{
 		result = libewf_chunk_table_get_segment_file_chunk_group_by_offset(
 			  chunk_table,
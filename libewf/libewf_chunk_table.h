@@ -25,11 +25,18 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_buffer_pool.h"
+#include "libewf_compressed_chunk_cache.h"
+#include "libewf_chunk_data.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcerror.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
+#include "libewf_mapped_file_pool.h"
+#include "libewf_media_values.h"
+#include "libewf_packed_chunk_table.h"
+#include "libewf_read_ahead_buffer.h"
 #include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 
@@ -56,6 +63,28 @@ struct libewf_chunk_table
 	/* The sectors with checksum errors
 	 */
 	libcdata_range_list_t *checksum_errors;
+
+	/* The packed chunk table
+	 */
+	libewf_packed_chunk_table_t *packed_chunk_table;
+
+	/* The compressed chunk cache
+	 */
+	libewf_compressed_chunk_cache_t *compressed_chunk_cache;
+
+	/* The segment file read-ahead buffer
+	 */
+	libewf_read_ahead_buffer_t *read_ahead_buffer;
+
+	/* The buffer pool used for the chunk data
+	 * the buffer pool is not managed by the chunk table
+	 */
+	libewf_buffer_pool_t *buffer_pool;
+
+	/* The mapped file pool used to read the chunk data
+	 * the mapped file pool is not managed by the chunk table
+	 */
+	libewf_mapped_file_pool_t *mapped_file_pool;
 };
 
 int libewf_chunk_table_initialize(
@@ -72,6 +101,22 @@ int libewf_chunk_table_clone(
      libewf_chunk_table_t *source_chunk_table,
      libcerror_error_t **error );
 
+int libewf_chunk_table_initialize_packed_chunk_table(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_initialize_compressed_chunk_cache(
+     libewf_chunk_table_t *chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_initialize_read_ahead_buffer(
+     libewf_chunk_table_t *chunk_table,
+     size_t minimum_read_ahead_size,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_number_of_checksum_errors(
      libewf_chunk_table_t *chunk_table,
      uint32_t *number_of_errors,
@@ -113,6 +158,73 @@ int libewf_chunk_table_chunk_exists_for_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libewf_chunk_table_get_packed_chunk_data_from_packed_chunk_table(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_packed_chunk_data_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfdata_range_list_t *delta_chunks_range_list,
+     libfcache_cache_t *chunk_groups_cache,
+     libfcache_cache_t *chunks_cache,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_get_chunk_range_by_offset(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libbfio_pool_t *file_io_pool,
+     libewf_segment_table_t *segment_table,
+     libfdata_range_list_t *delta_chunks_range_list,
+     libfcache_cache_t *chunk_groups_cache,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_chunk_data_is_cached(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libfcache_cache_t *chunks_cache,
+     int file_io_pool_entry,
+     off64_t chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_unpack_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t *chunk_data,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_create_missing_chunk_data(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libewf_media_values_t *media_values,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_append_chunk_checksum_error(
+     libewf_chunk_table_t *chunk_table,
+     libewf_media_values_t *media_values,
+     off64_t chunk_offset,
+     libcerror_error_t **error );
+
 int libewf_chunk_table_get_chunk_data_by_offset(
      libewf_chunk_table_t *chunk_table,
      uint64_t chunk_index,
@@ -126,6 +238,14 @@ int libewf_chunk_table_get_chunk_data_by_offset(
      off64_t offset,
      libewf_chunk_data_t **chunk_data,
      off64_t *chunk_data_offset,
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_chunk_table_set_chunk_data_in_packed_chunk_table(
+     libewf_chunk_table_t *chunk_table,
+     uint64_t chunk_index,
+     libfcache_cache_t *chunks_cache,
+     libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
 int libewf_chunk_table_set_chunk_data_by_offset(
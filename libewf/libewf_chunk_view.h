@@ -0,0 +1,67 @@
+/*
+ * Chunk view functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INTERNAL_CHUNK_VIEW_H )
+#define _LIBEWF_INTERNAL_CHUNK_VIEW_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_extern.h"
+#include "libewf_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_internal_chunk_view libewf_internal_chunk_view_t;
+
+struct libewf_internal_chunk_view
+{
+	/* The internal EWF handle
+	 */
+	libewf_internal_handle_t *internal_handle;
+
+	/* The referenced chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+};
+
+int libewf_chunk_view_initialize(
+     libewf_chunk_view_t **chunk_view,
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_chunk_view_free(
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,650 @@
+/*
+ * Compressed chunk cache functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_compressed_chunk_cache.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a compressed chunk cache
+ * Make sure the value compressed_chunk_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compressed_chunk_cache_initialize(
+     libewf_compressed_chunk_cache_t **compressed_chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libewf_compressed_chunk_cache_initialize";
+	size_t buckets_size        = 0;
+	size64_t number_of_buckets = 0;
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compressed chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_size == 0 )
+	 || ( maximum_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of buckets is based on the number of compressed chunks
+	 * of LIBEWF_COMPRESSED_CHUNK_CACHE_BUCKET_DATA_SIZE that fit in the cache
+	 */
+	number_of_buckets = maximum_size / LIBEWF_COMPRESSED_CHUNK_CACHE_BUCKET_DATA_SIZE;
+
+	if( number_of_buckets < LIBEWF_COMPRESSED_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS )
+	{
+		number_of_buckets = LIBEWF_COMPRESSED_CHUNK_CACHE_MINIMUM_NUMBER_OF_BUCKETS;
+	}
+	else if( number_of_buckets > LIBEWF_COMPRESSED_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS )
+	{
+		number_of_buckets = LIBEWF_COMPRESSED_CHUNK_CACHE_MAXIMUM_NUMBER_OF_BUCKETS;
+	}
+	*compressed_chunk_cache = memory_allocate_structure(
+	                           libewf_compressed_chunk_cache_t );
+
+	if( *compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compressed chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compressed_chunk_cache,
+	     0,
+	     sizeof( libewf_compressed_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compressed chunk cache.",
+		 function );
+
+		memory_free(
+		 *compressed_chunk_cache );
+
+		*compressed_chunk_cache = NULL;
+
+		return( -1 );
+	}
+	( *compressed_chunk_cache )->number_of_buckets = (int) number_of_buckets;
+
+	buckets_size = sizeof( libewf_compressed_chunk_cache_entry_t * ) * ( *compressed_chunk_cache )->number_of_buckets;
+
+	( *compressed_chunk_cache )->buckets = (libewf_compressed_chunk_cache_entry_t **) memory_allocate(
+	                                                                                   buckets_size );
+
+	if( ( *compressed_chunk_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *compressed_chunk_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *compressed_chunk_cache )->maximum_size = maximum_size;
+
+	return( 1 );
+
+on_error:
+	if( *compressed_chunk_cache != NULL )
+	{
+		if( ( *compressed_chunk_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *compressed_chunk_cache )->buckets );
+		}
+		memory_free(
+		 *compressed_chunk_cache );
+
+		*compressed_chunk_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compressed chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compressed_chunk_cache_free(
+     libewf_compressed_chunk_cache_t **compressed_chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_compressed_chunk_cache_entry_t *entry = NULL;
+	static char *function                        = "libewf_compressed_chunk_cache_free";
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressed_chunk_cache != NULL )
+	{
+		while( ( *compressed_chunk_cache )->first_entry != NULL )
+		{
+			entry = ( *compressed_chunk_cache )->first_entry;
+
+			( *compressed_chunk_cache )->first_entry = entry->next_entry;
+
+			memory_free(
+			 entry->data );
+
+			memory_free(
+			 entry );
+		}
+		memory_free(
+		 ( *compressed_chunk_cache )->buckets );
+
+		memory_free(
+		 *compressed_chunk_cache );
+
+		*compressed_chunk_cache = NULL;
+	}
+	return( 1 );
+}
+
+/* Removes an entry from the least recently used list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compressed_chunk_cache_remove_entry(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     libewf_compressed_chunk_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compressed_chunk_cache_remove_entry";
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry->previous_entry != NULL )
+	{
+		entry->previous_entry->next_entry = entry->next_entry;
+	}
+	else
+	{
+		compressed_chunk_cache->first_entry = entry->next_entry;
+	}
+	if( entry->next_entry != NULL )
+	{
+		entry->next_entry->previous_entry = entry->previous_entry;
+	}
+	else
+	{
+		compressed_chunk_cache->last_entry = entry->previous_entry;
+	}
+	entry->previous_entry = NULL;
+	entry->next_entry     = NULL;
+
+	return( 1 );
+}
+
+/* Removes an entry from the cache and frees it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compressed_chunk_cache_free_entry(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     libewf_compressed_chunk_cache_entry_t *entry,
+     libcerror_error_t **error )
+{
+	libewf_compressed_chunk_cache_entry_t **bucket_entry = NULL;
+	static char *function                                = "libewf_compressed_chunk_cache_free_entry";
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	bucket_entry = &( compressed_chunk_cache->buckets[ entry->chunk_index % compressed_chunk_cache->number_of_buckets ] );
+
+	while( *bucket_entry != NULL )
+	{
+		if( *bucket_entry == entry )
+		{
+			*bucket_entry = entry->next_bucket_entry;
+
+			break;
+		}
+		bucket_entry = &( ( *bucket_entry )->next_bucket_entry );
+	}
+	if( libewf_compressed_chunk_cache_remove_entry(
+	     compressed_chunk_cache,
+	     entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+		 "%s: unable to remove entry.",
+		 function );
+
+		return( -1 );
+	}
+	compressed_chunk_cache->size              -= entry->data_size;
+	compressed_chunk_cache->number_of_entries -= 1;
+
+	memory_free(
+	 entry->data );
+
+	memory_free(
+	 entry );
+
+	return( 1 );
+}
+
+/* Retrieves the compressed data of a specific chunk
+ * The data remains owned by the cache and is only valid until the next call to
+ * libewf_compressed_chunk_cache_set_data or libewf_compressed_chunk_cache_free
+ * Returns 1 if successful, 0 if not cached or -1 on error
+ */
+int libewf_compressed_chunk_cache_get_data(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_compressed_chunk_cache_entry_t *entry = NULL;
+	static char *function                        = "libewf_compressed_chunk_cache_get_data";
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	entry = compressed_chunk_cache->buckets[ chunk_index % compressed_chunk_cache->number_of_buckets ];
+
+	while( entry != NULL )
+	{
+		if( entry->chunk_index == chunk_index )
+		{
+			break;
+		}
+		entry = entry->next_bucket_entry;
+	}
+	if( entry == NULL )
+	{
+		return( 0 );
+	}
+	/* Move the entry to the front of the least recently used list
+	 */
+	if( entry != compressed_chunk_cache->first_entry )
+	{
+		if( libewf_compressed_chunk_cache_remove_entry(
+		     compressed_chunk_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+			 "%s: unable to remove entry.",
+			 function );
+
+			return( -1 );
+		}
+		entry->next_entry = compressed_chunk_cache->first_entry;
+
+		compressed_chunk_cache->first_entry->previous_entry = entry;
+		compressed_chunk_cache->first_entry                 = entry;
+	}
+	*data        = entry->data;
+	*data_size   = entry->data_size;
+	*range_flags = entry->range_flags;
+
+	return( 1 );
+}
+
+/* Sets the compressed data of a specific chunk
+ * The data is copied and the least recently used chunks are evicted
+ * until the data fits within the maximum size
+ * Returns 1 if successful, 0 if the data is too large to be cached or -1 on error
+ */
+int libewf_compressed_chunk_cache_set_data(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	libewf_compressed_chunk_cache_entry_t *entry = NULL;
+	static char *function                        = "libewf_compressed_chunk_cache_set_data";
+	int bucket_index                             = 0;
+
+	if( compressed_chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) data_size > compressed_chunk_cache->maximum_size )
+	{
+		return( 0 );
+	}
+	bucket_index = (int) ( chunk_index % compressed_chunk_cache->number_of_buckets );
+
+	entry = compressed_chunk_cache->buckets[ bucket_index ];
+
+	while( entry != NULL )
+	{
+		if( entry->chunk_index == chunk_index )
+		{
+			break;
+		}
+		entry = entry->next_bucket_entry;
+	}
+	if( entry != NULL )
+	{
+		if( libewf_compressed_chunk_cache_free_entry(
+		     compressed_chunk_cache,
+		     entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entry of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		entry = NULL;
+	}
+	while( ( compressed_chunk_cache->last_entry != NULL )
+	    && ( ( compressed_chunk_cache->size + data_size ) > compressed_chunk_cache->maximum_size ) )
+	{
+		if( libewf_compressed_chunk_cache_free_entry(
+		     compressed_chunk_cache,
+		     compressed_chunk_cache->last_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to evict least recently used entry.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	entry = memory_allocate_structure(
+	         libewf_compressed_chunk_cache_entry_t );
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( libewf_compressed_chunk_cache_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		memory_free(
+		 entry );
+
+		return( -1 );
+	}
+	entry->data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * data_size );
+
+	if( entry->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     entry->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		goto on_error;
+	}
+	entry->chunk_index = chunk_index;
+	entry->data_size   = data_size;
+	entry->range_flags = range_flags;
+
+	entry->next_bucket_entry                        = compressed_chunk_cache->buckets[ bucket_index ];
+	compressed_chunk_cache->buckets[ bucket_index ] = entry;
+
+	entry->next_entry = compressed_chunk_cache->first_entry;
+
+	if( compressed_chunk_cache->first_entry != NULL )
+	{
+		compressed_chunk_cache->first_entry->previous_entry = entry;
+	}
+	else
+	{
+		compressed_chunk_cache->last_entry = entry;
+	}
+	compressed_chunk_cache->first_entry = entry;
+
+	compressed_chunk_cache->size              += data_size;
+	compressed_chunk_cache->number_of_entries += 1;
+
+	return( 1 );
+
+on_error:
+	if( entry != NULL )
+	{
+		if( entry->data != NULL )
+		{
+			memory_free(
+			 entry->data );
+		}
+		memory_free(
+		 entry );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,146 @@
+/*
+ * Compressed chunk cache functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSED_CHUNK_CACHE_H )
+#define _LIBEWF_COMPRESSED_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_compressed_chunk_cache_entry libewf_compressed_chunk_cache_entry_t;
+
+struct libewf_compressed_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The compressed chunk data
+	 */
+	uint8_t *data;
+
+	/* The compressed chunk data size
+	 */
+	size_t data_size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+
+	/* The previous entry in the least recently used list
+	 */
+	libewf_compressed_chunk_cache_entry_t *previous_entry;
+
+	/* The next entry in the least recently used list
+	 */
+	libewf_compressed_chunk_cache_entry_t *next_entry;
+
+	/* The next entry in the same bucket
+	 */
+	libewf_compressed_chunk_cache_entry_t *next_bucket_entry;
+};
+
+typedef struct libewf_compressed_chunk_cache libewf_compressed_chunk_cache_t;
+
+/* The compressed chunk cache contains the compressed data of chunks
+ * as stored in the segment files, so that a chunk that was evicted from
+ * the (decompressed) chunks cache can be decompressed again without
+ * reading it from the segment file. The compressed chunk cache uses
+ * a bounded amount of memory and evicts the least recently used chunks
+ */
+struct libewf_compressed_chunk_cache
+{
+	/* The buckets
+	 */
+	libewf_compressed_chunk_cache_entry_t **buckets;
+
+	/* The number of buckets
+	 */
+	int number_of_buckets;
+
+	/* The most recently used entry
+	 */
+	libewf_compressed_chunk_cache_entry_t *first_entry;
+
+	/* The least recently used entry
+	 */
+	libewf_compressed_chunk_cache_entry_t *last_entry;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The size of the cached data
+	 */
+	size64_t size;
+
+	/* The maximum size of the cached data
+	 */
+	size64_t maximum_size;
+};
+
+int libewf_compressed_chunk_cache_initialize(
+     libewf_compressed_chunk_cache_t **compressed_chunk_cache,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_compressed_chunk_cache_free(
+     libewf_compressed_chunk_cache_t **compressed_chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_compressed_chunk_cache_remove_entry(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     libewf_compressed_chunk_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_compressed_chunk_cache_free_entry(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     libewf_compressed_chunk_cache_entry_t *entry,
+     libcerror_error_t **error );
+
+int libewf_compressed_chunk_cache_get_data(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t **data,
+     size_t *data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_compressed_chunk_cache_set_data(
+     libewf_compressed_chunk_cache_t *compressed_chunk_cache,
+     uint64_t chunk_index,
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -34,12 +34,18 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_definitions.h"
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 
 /* Compresses data using the compression method
+ * If a compression context is provided its deflate stream is reused
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
@@ -49,18 +55,26 @@ int libewf_compress_data(
      int8_t compression_level,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
-	static char *function                   = "libewf_compress_data";
-	int result                              = 0;
+	static char *function                               = "libewf_compress_data";
+	int result                                          = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-	unsigned int bzip2_compressed_data_size = 0;
-	int bzip2_compression_level             = 0;
+	unsigned int bzip2_compressed_data_size             = 0;
+	int bzip2_compression_level                         = 0;
 #endif
 #if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
-	uLongf zlib_compressed_data_size        = 0;
-	int zlib_compression_level              = 0;
+	z_stream *zlib_stream                               = NULL;
+	uLongf zlib_compressed_data_size                    = 0;
+	int zlib_compression_level                          = 0;
+#endif
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_compressor *libdeflate_compressor = NULL;
+	size_t libdeflate_compressed_data_size              = 0;
+	int libdeflate_compression_level                    = 0;
+	int use_libdeflate                                  = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -161,12 +175,141 @@ int libewf_compress_data(
 		}
 		zlib_compressed_data_size = (uLongf) *compressed_data_size;
 
-		result = compress2(
-			  (Bytef *) compressed_data,
-			  &zlib_compressed_data_size,
-			  (Bytef *) uncompressed_data,
-			  (uLong) uncompressed_data_size,
-			  zlib_compression_level );
+#if defined( HAVE_LIBDEFLATE )
+		if( ( compression_context != NULL )
+		 && ( zlib_compression_level != Z_NO_COMPRESSION ) )
+		{
+			use_libdeflate = libewf_compression_context_use_libdeflate_compression(
+			                  compression_context,
+			                  error );
+
+			if( use_libdeflate == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if libdeflate is used.",
+				 function );
+
+				*compressed_data_size = 0;
+
+				return( -1 );
+			}
+		}
+		if( use_libdeflate != 0 )
+		{
+			/* Level 6 corresponds to the default compression level of zlib
+			 */
+			if( zlib_compression_level == Z_DEFAULT_COMPRESSION )
+			{
+				libdeflate_compression_level = 6;
+			}
+			else
+			{
+				libdeflate_compression_level = zlib_compression_level;
+			}
+			if( libewf_compression_context_get_libdeflate_compressor(
+			     compression_context,
+			     libdeflate_compression_level,
+			     &libdeflate_compressor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve libdeflate compressor.",
+				 function );
+
+				*compressed_data_size = 0;
+
+				return( -1 );
+			}
+			libdeflate_compressed_data_size = libdeflate_zlib_compress(
+			                                   libdeflate_compressor,
+			                                   (void *) uncompressed_data,
+			                                   uncompressed_data_size,
+			                                   (void *) compressed_data,
+			                                   *compressed_data_size );
+
+			/* Map the result onto that of compress2
+			 */
+			if( libdeflate_compressed_data_size == 0 )
+			{
+				result = Z_BUF_ERROR;
+			}
+			else
+			{
+				zlib_compressed_data_size = (uLongf) libdeflate_compressed_data_size;
+
+				result = Z_OK;
+			}
+		}
+		else
+#endif /* defined( HAVE_LIBDEFLATE ) */
+		if( compression_context == NULL )
+		{
+			result = compress2(
+				  (Bytef *) compressed_data,
+				  &zlib_compressed_data_size,
+				  (Bytef *) uncompressed_data,
+				  (uLong) uncompressed_data_size,
+				  zlib_compression_level );
+		}
+		else
+		{
+			if( ( *compressed_data_size > (size_t) UINT_MAX )
+			 || ( uncompressed_data_size > (size_t) UINT_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid data size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_compression_context_get_deflate_stream(
+			     compression_context,
+			     zlib_compression_level,
+			     &zlib_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve deflate stream.",
+				 function );
+
+				*compressed_data_size = 0;
+
+				return( -1 );
+			}
+			zlib_stream->next_in   = (Bytef *) uncompressed_data;
+			zlib_stream->avail_in  = (uInt) uncompressed_data_size;
+			zlib_stream->next_out  = (Bytef *) compressed_data;
+			zlib_stream->avail_out = (uInt) *compressed_data_size;
+
+			result = deflate(
+			          zlib_stream,
+			          Z_FINISH );
+
+			/* Map the result onto that of compress2
+			 */
+			if( result == Z_STREAM_END )
+			{
+				zlib_compressed_data_size = (uLongf) zlib_stream->total_out;
+
+				result = Z_OK;
+			}
+			else if( result == Z_OK )
+			{
+				result = Z_BUF_ERROR;
+			}
+		}
 
 		if( result == Z_OK )
 		{
@@ -193,6 +336,21 @@ int libewf_compress_data(
 			/* Estimate that a factor 2 enlargement should suffice
 			 */
 			*compressed_data_size *= 2;
+#endif
+#if defined( HAVE_LIBDEFLATE )
+			/* The bound of libdeflate can exceed that of zlib
+			 */
+			if( libdeflate_compressor != NULL )
+			{
+				libdeflate_compressed_data_size = libdeflate_zlib_compress_bound(
+				                                   libdeflate_compressor,
+				                                   uncompressed_data_size );
+
+				if( *compressed_data_size < libdeflate_compressed_data_size )
+				{
+					*compressed_data_size = libdeflate_compressed_data_size;
+				}
+			}
 #endif
 			result = 0;
 		}
@@ -365,6 +523,7 @@ int libewf_compress_data(
 }
 
 /* Decompresses data using the compression method
+ * If a compression context is provided its inflate stream is reused
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_decompress_data(
@@ -373,16 +532,24 @@ int libewf_decompress_data(
      uint16_t compression_method,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error )
 {
-	static char *function                     = "libewf_decompress_data";
-	int result                                = 0;
+	static char *function                                   = "libewf_decompress_data";
+	int result                                              = 0;
 
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
-	unsigned int bzip2_uncompressed_data_size = 0;
+	unsigned int bzip2_uncompressed_data_size               = 0;
 #endif
 #if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
-	uLongf zlib_uncompressed_data_size        = 0;
+	z_stream *zlib_stream                                   = NULL;
+	uLongf zlib_uncompressed_data_size                      = 0;
+#endif
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_decompressor *libdeflate_decompressor = NULL;
+	size_t libdeflate_uncompressed_data_size                = 0;
+	enum libdeflate_result libdeflate_result                = LIBDEFLATE_SUCCESS;
+	int use_libdeflate                                      = 0;
 #endif
 
 	if( compressed_data == NULL )
@@ -456,11 +623,146 @@ int libewf_decompress_data(
 		}
 		zlib_uncompressed_data_size = (uLongf) *uncompressed_data_size;
 
-		result = uncompress(
-			  (Bytef *) uncompressed_data,
-			  &zlib_uncompressed_data_size,
-			  (Bytef *) compressed_data,
-			  (uLong) compressed_data_size );
+#if defined( HAVE_LIBDEFLATE )
+		if( compression_context != NULL )
+		{
+			use_libdeflate = libewf_compression_context_use_libdeflate_decompression(
+			                  compression_context,
+			                  error );
+
+			if( use_libdeflate == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if libdeflate is used.",
+				 function );
+
+				*uncompressed_data_size = 0;
+
+				return( -1 );
+			}
+		}
+		if( use_libdeflate != 0 )
+		{
+			if( libewf_compression_context_get_libdeflate_decompressor(
+			     compression_context,
+			     &libdeflate_decompressor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve libdeflate decompressor.",
+				 function );
+
+				*uncompressed_data_size = 0;
+
+				return( -1 );
+			}
+			libdeflate_result = libdeflate_zlib_decompress(
+			                     libdeflate_decompressor,
+			                     (void *) compressed_data,
+			                     compressed_data_size,
+			                     (void *) uncompressed_data,
+			                     *uncompressed_data_size,
+			                     &libdeflate_uncompressed_data_size );
+
+			/* Map the result onto that of uncompress
+			 */
+			if( libdeflate_result == LIBDEFLATE_SUCCESS )
+			{
+				zlib_uncompressed_data_size = (uLongf) libdeflate_uncompressed_data_size;
+
+				result = Z_OK;
+			}
+			else if( libdeflate_result == LIBDEFLATE_INSUFFICIENT_SPACE )
+			{
+				result = Z_BUF_ERROR;
+			}
+			else
+			{
+				result = Z_DATA_ERROR;
+			}
+		}
+		else
+#endif /* defined( HAVE_LIBDEFLATE ) */
+		if( compression_context == NULL )
+		{
+			result = uncompress(
+				  (Bytef *) uncompressed_data,
+				  &zlib_uncompressed_data_size,
+				  (Bytef *) compressed_data,
+				  (uLong) compressed_data_size );
+		}
+		else
+		{
+			if( ( compressed_data_size > (size_t) UINT_MAX )
+			 || ( *uncompressed_data_size > (size_t) UINT_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid data size value exceeds maximum.",
+				 function );
+
+				return( -1 );
+			}
+			if( libewf_compression_context_get_inflate_stream(
+			     compression_context,
+			     &zlib_stream,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve inflate stream.",
+				 function );
+
+				*uncompressed_data_size = 0;
+
+				return( -1 );
+			}
+			zlib_stream->next_in   = (Bytef *) compressed_data;
+			zlib_stream->avail_in  = (uInt) compressed_data_size;
+			zlib_stream->next_out  = (Bytef *) uncompressed_data;
+			zlib_stream->avail_out = (uInt) *uncompressed_data_size;
+
+			result = inflate(
+			          zlib_stream,
+			          Z_FINISH );
+
+			/* Map the result onto that of uncompress, where truncated
+			 * input is considered a data error
+			 */
+			if( result == Z_STREAM_END )
+			{
+				zlib_uncompressed_data_size = (uLongf) zlib_stream->total_out;
+
+				result = Z_OK;
+			}
+			else if( result == Z_NEED_DICT )
+			{
+				result = Z_DATA_ERROR;
+			}
+			else if( ( result == Z_OK )
+			      || ( result == Z_BUF_ERROR ) )
+			{
+				if( ( zlib_stream->avail_in == 0 )
+				 && ( zlib_stream->avail_out != 0 ) )
+				{
+					result = Z_DATA_ERROR;
+				}
+				else
+				{
+					result = Z_BUF_ERROR;
+				}
+			}
+		}
 
 		if( result == Z_OK )
 		{
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_context.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -38,6 +39,7 @@ int libewf_compress_data(
      int8_t compression_level,
      const uint8_t *uncompressed_data,
      size_t uncompressed_data_size,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error );
 
 int libewf_decompress_data(
@@ -46,6 +48,7 @@ int libewf_decompress_data(
      uint16_t compression_method,
      uint8_t *uncompressed_data,
      size_t *uncompressed_data_size,
+     libewf_compression_context_t *compression_context,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
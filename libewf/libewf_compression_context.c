@@ -0,0 +1,852 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_compression_context.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a compression context
+ * Make sure the value compression_context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_initialize";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_context = memory_allocate_structure(
+	                        libewf_compression_context_t );
+
+	if( *compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_context,
+	     0,
+	     sizeof( libewf_compression_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *compression_context != NULL )
+	{
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression context
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_free";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_context != NULL )
+	{
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+		/* The return value of deflateEnd is ignored since it returns
+		 * Z_DATA_ERROR if the stream was not finished
+		 */
+		if( ( *compression_context )->deflate_stream_initialized != 0 )
+		{
+			deflateEnd(
+			 &( ( *compression_context )->deflate_stream ) );
+		}
+		if( ( *compression_context )->inflate_stream_initialized != 0 )
+		{
+			inflateEnd(
+			 &( ( *compression_context )->inflate_stream ) );
+		}
+#endif
+#if defined( HAVE_LIBDEFLATE )
+		if( ( *compression_context )->libdeflate_compressor != NULL )
+		{
+			libdeflate_free_compressor(
+			 ( *compression_context )->libdeflate_compressor );
+		}
+		if( ( *compression_context )->libdeflate_decompressor != NULL )
+		{
+			libdeflate_free_decompressor(
+			 ( *compression_context )->libdeflate_decompressor );
+		}
+#endif
+		memory_free(
+		 *compression_context );
+
+		*compression_context = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the deflate backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_set_deflate_backend(
+     libewf_compression_context_t *compression_context,
+     uint8_t deflate_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_set_deflate_backend";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( deflate_backend != LIBEWF_DEFLATE_BACKEND_DEFAULT )
+	 && ( deflate_backend != LIBEWF_DEFLATE_BACKEND_ZLIB )
+	 && ( deflate_backend != LIBEWF_DEFLATE_BACKEND_LIBDEFLATE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported deflate backend.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBDEFLATE )
+	if( deflate_backend == LIBEWF_DEFLATE_BACKEND_LIBDEFLATE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for libdeflate.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	compression_context->deflate_backend = deflate_backend;
+
+	return( 1 );
+}
+
+/* Determines if libdeflate is used for deflate compression
+ * libdeflate is only used for compression if selected explicitly, since the compressed
+ * data differs from that of zlib and the default should produce the same images
+ * Returns 1 if libdeflate is used, 0 if not or -1 on error
+ */
+int libewf_compression_context_use_libdeflate_compression(
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_use_libdeflate_compression";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( compression_context->deflate_backend == LIBEWF_DEFLATE_BACKEND_LIBDEFLATE )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Determines if libdeflate is used for deflate decompression
+ * libdeflate is used for decompression unless zlib is selected explicitly
+ * Returns 1 if libdeflate is used, 0 if not or -1 on error
+ */
+int libewf_compression_context_use_libdeflate_decompression(
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_use_libdeflate_decompression";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBDEFLATE )
+	if( compression_context->deflate_backend != LIBEWF_DEFLATE_BACKEND_ZLIB )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Retrieves the fill pattern of a previously seen fill encoding
+ * Returns 1 if successful, 0 if no such fill encoding or -1 on error
+ */
+int libewf_compression_context_get_fill_encoding(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *data_size,
+     uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error )
+{
+	libewf_fill_encoding_t *fill_encoding = NULL;
+	static char *function                 = "libewf_compression_context_get_fill_encoding";
+	int fill_encoding_index               = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fill pattern size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( compressed_data_size > (size_t) LIBEWF_MAXIMUM_FILL_ENCODING_SIZE ) )
+	{
+		return( 0 );
+	}
+	for( fill_encoding_index = 0;
+	     fill_encoding_index < LIBEWF_NUMBER_OF_FILL_ENCODINGS;
+	     fill_encoding_index++ )
+	{
+		fill_encoding = &( compression_context->fill_encodings[ fill_encoding_index ] );
+
+		if( fill_encoding->compressed_data_size != compressed_data_size )
+		{
+			continue;
+		}
+		if( memory_compare(
+		     fill_encoding->compressed_data,
+		     compressed_data,
+		     compressed_data_size ) != 0 )
+		{
+			continue;
+		}
+		if( memory_copy(
+		     fill_pattern,
+		     fill_encoding->fill_pattern,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy fill pattern.",
+			 function );
+
+			return( -1 );
+		}
+		*data_size = fill_encoding->data_size;
+
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Sets a fill encoding
+ * The oldest fill encoding is replaced when all fill encodings are in use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_set_fill_encoding(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t data_size,
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error )
+{
+	libewf_fill_encoding_t *fill_encoding = NULL;
+	static char *function                 = "libewf_compression_context_set_fill_encoding";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( compressed_data_size > (size_t) LIBEWF_MAXIMUM_FILL_ENCODING_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid fill pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( fill_pattern_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid fill pattern size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->fill_encoding_index < 0 )
+	 || ( compression_context->fill_encoding_index >= LIBEWF_NUMBER_OF_FILL_ENCODINGS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compression context - fill encoding index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	fill_encoding = &( compression_context->fill_encodings[ compression_context->fill_encoding_index ] );
+
+	if( memory_copy(
+	     fill_encoding->compressed_data,
+	     compressed_data,
+	     compressed_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy compressed data.",
+		 function );
+
+		fill_encoding->compressed_data_size = 0;
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     fill_encoding->fill_pattern,
+	     fill_pattern,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy fill pattern.",
+		 function );
+
+		fill_encoding->compressed_data_size = 0;
+
+		return( -1 );
+	}
+	fill_encoding->compressed_data_size = compressed_data_size;
+	fill_encoding->data_size            = data_size;
+
+	compression_context->fill_encoding_index += 1;
+
+	if( compression_context->fill_encoding_index >= LIBEWF_NUMBER_OF_FILL_ENCODINGS )
+	{
+		compression_context->fill_encoding_index = 0;
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+/* Retrieves a deflate stream that is reset for a new chunk
+ * The deflate stream is initialized on first use or when the compression level changes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_get_deflate_stream(
+     libewf_compression_context_t *compression_context,
+     int compression_level,
+     z_stream **deflate_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_get_deflate_stream";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( deflate_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deflate stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->deflate_stream_initialized != 0 )
+	 && ( compression_context->deflate_stream_level != compression_level ) )
+	{
+		deflateEnd(
+		 &( compression_context->deflate_stream ) );
+
+		compression_context->deflate_stream_initialized = 0;
+	}
+	if( compression_context->deflate_stream_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->deflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear deflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = deflateInit(
+		          &( compression_context->deflate_stream ),
+		          compression_level );
+	}
+	else
+	{
+		result = deflateReset(
+		          &( compression_context->deflate_stream ) );
+	}
+	if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to initialize deflate stream: insufficient memory.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to initialize deflate stream: zlib returned error: %d.",
+		 function,
+		 result );
+
+		if( compression_context->deflate_stream_initialized != 0 )
+		{
+			deflateEnd(
+			 &( compression_context->deflate_stream ) );
+
+			compression_context->deflate_stream_initialized = 0;
+		}
+		return( -1 );
+	}
+	compression_context->deflate_stream_initialized = 1;
+	compression_context->deflate_stream_level       = compression_level;
+
+	*deflate_stream = &( compression_context->deflate_stream );
+
+	return( 1 );
+}
+
+/* Retrieves an inflate stream that is reset for a new chunk
+ * The inflate stream is initialized on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_get_inflate_stream(
+     libewf_compression_context_t *compression_context,
+     z_stream **inflate_stream,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_get_inflate_stream";
+	int result            = 0;
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( inflate_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid inflate stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context->inflate_stream_initialized == 0 )
+	{
+		if( memory_set(
+		     &( compression_context->inflate_stream ),
+		     0,
+		     sizeof( z_stream ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear inflate stream.",
+			 function );
+
+			return( -1 );
+		}
+		result = inflateInit(
+		          &( compression_context->inflate_stream ) );
+	}
+	else
+	{
+		result = inflateReset(
+		          &( compression_context->inflate_stream ) );
+	}
+	if( result == Z_MEM_ERROR )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to initialize inflate stream: insufficient memory.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != Z_OK )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to initialize inflate stream: zlib returned error: %d.",
+		 function,
+		 result );
+
+		if( compression_context->inflate_stream_initialized != 0 )
+		{
+			inflateEnd(
+			 &( compression_context->inflate_stream ) );
+
+			compression_context->inflate_stream_initialized = 0;
+		}
+		return( -1 );
+	}
+	compression_context->inflate_stream_initialized = 1;
+
+	*inflate_stream = &( compression_context->inflate_stream );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* Retrieves a libdeflate compressor
+ * The compressor is allocated on first use or when the compression level changes
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_get_libdeflate_compressor(
+     libewf_compression_context_t *compression_context,
+     int compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_get_libdeflate_compressor";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( compression_context->libdeflate_compressor != NULL )
+	 && ( compression_context->libdeflate_compressor_level != compression_level ) )
+	{
+		libdeflate_free_compressor(
+		 compression_context->libdeflate_compressor );
+
+		compression_context->libdeflate_compressor = NULL;
+	}
+	if( compression_context->libdeflate_compressor == NULL )
+	{
+		compression_context->libdeflate_compressor = libdeflate_alloc_compressor(
+		                                              compression_level );
+
+		if( compression_context->libdeflate_compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate compressor.",
+			 function );
+
+			return( -1 );
+		}
+		compression_context->libdeflate_compressor_level = compression_level;
+	}
+	*compressor = compression_context->libdeflate_compressor;
+
+	return( 1 );
+}
+
+/* Retrieves a libdeflate decompressor
+ * The decompressor is allocated on first use
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_context_get_libdeflate_decompressor(
+     libewf_compression_context_t *compression_context,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_context_get_libdeflate_decompressor";
+
+	if( compression_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
+		 function );
+
+		return( -1 );
+	}
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_context->libdeflate_decompressor == NULL )
+	{
+		compression_context->libdeflate_decompressor = libdeflate_alloc_decompressor();
+
+		if( compression_context->libdeflate_decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create libdeflate decompressor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	*decompressor = compression_context->libdeflate_decompressor;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
@@ -0,0 +1,199 @@
+/*
+ * Compression context functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CONTEXT_H )
+#define _LIBEWF_COMPRESSION_CONTEXT_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+#include <zlib.h>
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_fill_encoding libewf_fill_encoding_t;
+
+/* The fill encoding contains the compressed data of a chunk
+ * that is filled with a 64-bit pattern
+ */
+struct libewf_fill_encoding
+{
+	/* The compressed data
+	 */
+	uint8_t compressed_data[ LIBEWF_MAXIMUM_FILL_ENCODING_SIZE ];
+
+	/* The compressed data size
+	 * a value of 0 indicates the fill encoding is not set
+	 */
+	size_t compressed_data_size;
+
+	/* The (uncompressed) data size
+	 */
+	size_t data_size;
+
+	/* The fill pattern
+	 */
+	uint8_t fill_pattern[ 8 ];
+};
+
+typedef struct libewf_compression_context libewf_compression_context_t;
+
+/* The compression context contains the compression streams that are reused
+ * between chunks, so that the stream state does not need to be allocated per chunk
+ * A compression context can only be used by one thread at a time
+ */
+struct libewf_compression_context
+{
+	/* The deflate backend
+	 */
+	uint8_t deflate_backend;
+
+	/* Value to indicate the deflate stream was initialized
+	 */
+	uint8_t deflate_stream_initialized;
+
+	/* The compression level of the deflate stream
+	 */
+	int deflate_stream_level;
+
+	/* Value to indicate the inflate stream was initialized
+	 */
+	uint8_t inflate_stream_initialized;
+
+	/* The fill encodings of chunks that were previously decompressed
+	 */
+	libewf_fill_encoding_t fill_encodings[ LIBEWF_NUMBER_OF_FILL_ENCODINGS ];
+
+	/* The index of the fill encoding to replace next
+	 */
+	int fill_encoding_index;
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+	/* The deflate stream
+	 */
+	z_stream deflate_stream;
+
+	/* The inflate stream
+	 */
+	z_stream inflate_stream;
+#endif
+
+#if defined( HAVE_LIBDEFLATE )
+	/* The libdeflate compressor
+	 */
+	struct libdeflate_compressor *libdeflate_compressor;
+
+	/* The compression level of the libdeflate compressor
+	 */
+	int libdeflate_compressor_level;
+
+	/* The libdeflate decompressor
+	 */
+	struct libdeflate_decompressor *libdeflate_decompressor;
+#endif
+};
+
+int libewf_compression_context_initialize(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_free(
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_set_deflate_backend(
+     libewf_compression_context_t *compression_context,
+     uint8_t deflate_backend,
+     libcerror_error_t **error );
+
+int libewf_compression_context_use_libdeflate_compression(
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_use_libdeflate_decompression(
+     libewf_compression_context_t *compression_context,
+     libcerror_error_t **error );
+
+int libewf_compression_context_get_fill_encoding(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t *data_size,
+     uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error );
+
+int libewf_compression_context_set_fill_encoding(
+     libewf_compression_context_t *compression_context,
+     const uint8_t *compressed_data,
+     size_t compressed_data_size,
+     size_t data_size,
+     const uint8_t *fill_pattern,
+     size_t fill_pattern_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_ZLIB ) || defined( ZLIB_DLL )
+
+int libewf_compression_context_get_deflate_stream(
+     libewf_compression_context_t *compression_context,
+     int compression_level,
+     z_stream **deflate_stream,
+     libcerror_error_t **error );
+
+int libewf_compression_context_get_inflate_stream(
+     libewf_compression_context_t *compression_context,
+     z_stream **inflate_stream,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) */
+
+#if defined( HAVE_LIBDEFLATE )
+
+int libewf_compression_context_get_libdeflate_compressor(
+     libewf_compression_context_t *compression_context,
+     int compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error );
+
+int libewf_compression_context_get_libdeflate_decompressor(
+     libewf_compression_context_t *compression_context,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -25,10 +25,13 @@
 
 #include "libewf_analytical_data.h"
 #include "libewf_case_data.h"
+#include "libewf_buffer_pool.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_chunk_view.h"
 #include "libewf_compression.h"
+#include "libewf_compression_context.h"
 #include "libewf_debug.h"
 #include "libewf_definitions.h"
 #include "libewf_device_information.h"
@@ -191,8 +194,53 @@ int libewf_handle_initialize(
 
 		goto on_error;
 	}
-	internal_handle->date_format                    = LIBEWF_DATE_FORMAT_CTIME;
-	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	if( libewf_compression_context_initialize(
+	     &( internal_handle->compression_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression context.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_handle->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->chunk_table_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	internal_handle->date_format                         = LIBEWF_DATE_FORMAT_CTIME;
+	internal_handle->maximum_number_of_open_handles      = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->maximum_packed_chunk_table_size     = LIBEWF_DEFAULT_PACKED_CHUNK_TABLE_SIZE;
+	internal_handle->maximum_compressed_chunk_cache_size = LIBEWF_DEFAULT_COMPRESSED_CHUNK_CACHE_SIZE;
+	internal_handle->maximum_read_ahead_buffer_size      = LIBEWF_DEFAULT_MAXIMUM_READ_AHEAD_BUFFER_SIZE;
+	internal_handle->maximum_buffer_pool_size            = LIBEWF_DEFAULT_BUFFER_POOL_SIZE;
 
 	*handle = (libewf_handle_t *) internal_handle;
 
@@ -201,6 +249,33 @@ int libewf_handle_initialize(
 on_error:
 	if( internal_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_handle->chunk_table_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_handle->chunk_table_mutex ),
+			 NULL );
+		}
+		if( internal_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
+		if( internal_handle->compression_context != NULL )
+		{
+			libewf_compression_context_free(
+			 &( internal_handle->compression_context ),
+			 NULL );
+		}
+		if( internal_handle->acquiry_errors != NULL )
+		{
+			libcdata_range_list_free(
+			 &( internal_handle->acquiry_errors ),
+			 NULL,
+			 NULL );
+		}
 		if( internal_handle->tracks != NULL )
 		{
 			libcdata_array_free(
@@ -243,6 +318,7 @@ int libewf_handle_free(
 	libewf_internal_handle_t *internal_handle = NULL;
 	static char *function                     = "libewf_internal_handle_free";
 	int result                                = 1;
+	int number_of_chunk_views                 = 0;
 
 	if( handle == NULL )
 	{
@@ -259,6 +335,32 @@ int libewf_handle_free(
 	{
 		internal_handle = (libewf_internal_handle_t *) *handle;
 
+		if( libewf_internal_handle_get_number_of_chunk_views(
+		     internal_handle,
+		     &number_of_chunk_views,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of chunk views.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_chunk_views > 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk views have not been freed.",
+			 function );
+
+			return( -1 );
+		}
+
 		if( internal_handle->file_io_pool != NULL )
 		{
 			if( libewf_handle_close(
@@ -345,6 +447,63 @@ int libewf_handle_free(
 
 			result = -1;
 		}
+		if( libewf_compression_context_free(
+		     &( internal_handle->compression_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression context.",
+			 function );
+
+			result = -1;
+		}
+		if( internal_handle->index_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( internal_handle->index_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free index file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( internal_handle->chunk_table_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_read_write_lock_free(
+		     &( internal_handle->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 internal_handle );
 	}
@@ -519,6 +678,33 @@ int libewf_handle_clone(
 
 		goto on_error;
 	}
+	if( libewf_compression_context_initialize(
+	     &( internal_destination_handle->compression_context ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_compression_context_set_deflate_backend(
+	     internal_destination_handle->compression_context,
+	     internal_source_handle->deflate_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set deflate backend in destination compression context.",
+		 function );
+
+		goto on_error;
+	}
 	if( internal_source_handle->file_io_pool != NULL )
 	{
 		if( libbfio_pool_clone(
@@ -605,6 +791,23 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
+	if( internal_source_handle->index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_clone(
+		     &( internal_destination_handle->index_file_io_handle ),
+		     internal_source_handle->index_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination index file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( internal_source_handle->chunk_table != NULL )
 	{
 		if( libewf_chunk_table_clone(
@@ -673,6 +876,24 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
+	if( internal_source_handle->chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_initialize(
+		     &( internal_destination_handle->chunk_cache ),
+		     internal_source_handle->chunk_cache->maximum_number_of_entries,
+		     internal_source_handle->chunk_cache->maximum_number_of_recent_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( internal_source_handle->chunk_group != NULL )
 	{
 		if( libewf_chunk_group_clone(
@@ -690,6 +911,28 @@ int libewf_handle_clone(
 			goto on_error;
 		}
 	}
+	if( internal_source_handle->chunk_buffer_pool != NULL )
+	{
+		if( libewf_buffer_pool_initialize(
+		     &( internal_destination_handle->chunk_buffer_pool ),
+		     internal_source_handle->chunk_buffer_pool->buffer_size,
+		     internal_source_handle->chunk_buffer_pool->maximum_number_of_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create destination chunk buffer pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( internal_destination_handle->chunk_table != NULL )
+		{
+			internal_destination_handle->chunk_table->buffer_pool = internal_destination_handle->chunk_buffer_pool;
+		}
+	}
 	if( internal_source_handle->hash_sections != NULL )
 	{
 		if( libewf_hash_sections_clone(
@@ -743,14 +986,73 @@ int libewf_handle_clone(
 		}
 		internal_destination_handle->hash_values_parsed = internal_source_handle->hash_values_parsed;
 	}
-	internal_destination_handle->maximum_number_of_open_handles = internal_source_handle->maximum_number_of_open_handles;
-	internal_destination_handle->date_format                    = internal_source_handle->date_format;
+	internal_destination_handle->maximum_number_of_open_handles        = internal_source_handle->maximum_number_of_open_handles;
+	internal_destination_handle->number_of_chunks_cache_entries        = internal_source_handle->number_of_chunks_cache_entries;
+	internal_destination_handle->cache_size                            = internal_source_handle->cache_size;
+	internal_destination_handle->maximum_number_of_chunk_group_entries = internal_source_handle->maximum_number_of_chunk_group_entries;
+	internal_destination_handle->cache_policy                          = internal_source_handle->cache_policy;
+	internal_destination_handle->maximum_packed_chunk_table_size       = internal_source_handle->maximum_packed_chunk_table_size;
+	internal_destination_handle->maximum_compressed_chunk_cache_size   = internal_source_handle->maximum_compressed_chunk_cache_size;
+	internal_destination_handle->maximum_read_ahead_buffer_size        = internal_source_handle->maximum_read_ahead_buffer_size;
+	internal_destination_handle->maximum_buffer_pool_size              = internal_source_handle->maximum_buffer_pool_size;
+	internal_destination_handle->read_memory_mapped                    = internal_source_handle->read_memory_mapped;
+	internal_destination_handle->async_io_queue_depth                  = internal_source_handle->async_io_queue_depth;
+	internal_destination_handle->deflate_backend                       = internal_source_handle->deflate_backend;
+	internal_destination_handle->date_format                           = internal_source_handle->date_format;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_destination_handle->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_destination_handle->chunk_table_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+	internal_destination_handle->number_of_read_ahead_threads        = internal_source_handle->number_of_read_ahead_threads;
+	internal_destination_handle->maximum_number_of_read_ahead_chunks = internal_source_handle->maximum_number_of_read_ahead_chunks;
+	internal_destination_handle->number_of_compression_threads       = internal_source_handle->number_of_compression_threads;
+	internal_destination_handle->number_of_scan_threads              = internal_source_handle->number_of_scan_threads;
+#endif
+	*destination_handle = (libewf_handle_t *) internal_destination_handle;
 
 	return( 1 );
 
 on_error:
 	if( internal_destination_handle != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_destination_handle->chunk_table_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_destination_handle->chunk_table_mutex ),
+			 NULL );
+		}
+		if( internal_destination_handle->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_destination_handle->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_destination_handle->hash_values != NULL )
 		{
 			libfvalue_table_free(
@@ -769,12 +1071,24 @@ on_error:
 			 &( internal_destination_handle->hash_sections ),
 			 NULL );
 		}
+		if( internal_destination_handle->chunk_buffer_pool != NULL )
+		{
+			libewf_buffer_pool_free(
+			 &( internal_destination_handle->chunk_buffer_pool ),
+			 NULL );
+		}
 		if( internal_destination_handle->chunk_group != NULL )
 		{
 			libewf_chunk_group_free(
 			 &( internal_destination_handle->chunk_group ),
 			 NULL );
 		}
+		if( internal_destination_handle->chunk_cache != NULL )
+		{
+			libewf_chunk_cache_free(
+			 &( internal_destination_handle->chunk_cache ),
+			 NULL );
+		}
 		if( internal_destination_handle->chunks_cache != NULL )
 		{
 			libfcache_cache_free(
@@ -799,6 +1113,12 @@ on_error:
 			 &( internal_destination_handle->chunk_table ),
 			 NULL );
 		}
+		if( internal_destination_handle->index_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( internal_destination_handle->index_file_io_handle ),
+			 NULL );
+		}
 		if( internal_destination_handle->delta_segment_table != NULL )
 		{
 			libewf_segment_table_free(
@@ -829,6 +1149,12 @@ on_error:
 			 &( internal_destination_handle->file_io_pool ),
 			 NULL );
 		}
+		if( internal_destination_handle->compression_context != NULL )
+		{
+			libewf_compression_context_free(
+			 &( internal_destination_handle->compression_context ),
+			 NULL );
+		}
 		if( internal_destination_handle->acquiry_errors != NULL )
 		{
 			libcdata_range_list_free(
@@ -1264,6 +1590,51 @@ int libewf_handle_open(
 			goto on_error;
 		}
 	}
+	/* Memory mapping is only used when reading since the segment files
+	 * are changed when writing or resuming
+	 */
+	if( ( internal_handle->read_memory_mapped != 0 )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
+	{
+		if( libewf_mapped_file_pool_initialize(
+		     &( internal_handle->mapped_file_pool ),
+		     internal_handle->maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mapped file pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Asynchronous IO is only used when reading and when the segment files are not memory mapped
+	 */
+	if( ( internal_handle->async_io_queue_depth > 0 )
+	 && ( internal_handle->mapped_file_pool == NULL )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
+	{
+		/* If asynchronous IO is not available the synchronous reads are used
+		 */
+		if( libewf_async_io_initialize(
+		     &( internal_handle->async_io ),
+		     internal_handle->async_io_queue_depth,
+		     internal_handle->maximum_number_of_open_handles,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create asynchronous IO.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( libewf_handle_open_file_io_pool(
 	     handle,
 	     file_io_pool,
@@ -1284,6 +1655,18 @@ int libewf_handle_open(
 	return( 1 );
 
 on_error:
+	if( internal_handle->async_io != NULL )
+	{
+		libewf_async_io_free(
+		 &( internal_handle->async_io ),
+		 NULL );
+	}
+	if( internal_handle->mapped_file_pool != NULL )
+	{
+		libewf_mapped_file_pool_free(
+		 &( internal_handle->mapped_file_pool ),
+		 NULL );
+	}
 	if( internal_handle->delta_segment_table != NULL )
 	{
 		libewf_segment_table_free(
@@ -1670,26 +2053,83 @@ int libewf_handle_open_wide(
 			goto on_error;
 		}
 	}
-	if( libewf_handle_open_file_io_pool(
-	     handle,
-	     file_io_pool,
-	     access_flags,
-	     error ) != 1 )
+	/* Memory mapping is only used when reading since the segment files
+	 * are changed when writing or resuming
+	 */
+	if( ( internal_handle->read_memory_mapped != 0 )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open handle using a file IO pool.",
-		 function );
-
-		goto on_error;
-	}
+		if( libewf_mapped_file_pool_initialize(
+		     &( internal_handle->mapped_file_pool ),
+		     internal_handle->maximum_number_of_open_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mapped file pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Asynchronous IO is only used when reading and when the segment files are not memory mapped
+	 */
+	if( ( internal_handle->async_io_queue_depth > 0 )
+	 && ( internal_handle->mapped_file_pool == NULL )
+	 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
+	{
+		/* If asynchronous IO is not available the synchronous reads are used
+		 */
+		if( libewf_async_io_initialize(
+		     &( internal_handle->async_io ),
+		     internal_handle->async_io_queue_depth,
+		     internal_handle->maximum_number_of_open_handles,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create asynchronous IO.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_open_file_io_pool(
+	     handle,
+	     file_io_pool,
+	     access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
+
+		goto on_error;
+	}
 	internal_handle->file_io_pool_created_in_library = 1;
 
 	return( 1 );
 
 on_error:
+	if( internal_handle->async_io != NULL )
+	{
+		libewf_async_io_free(
+		 &( internal_handle->async_io ),
+		 NULL );
+	}
+	if( internal_handle->mapped_file_pool != NULL )
+	{
+		libewf_mapped_file_pool_free(
+		 &( internal_handle->mapped_file_pool ),
+		 NULL );
+	}
 	if( internal_handle->delta_segment_table != NULL )
 	{
 		libewf_segment_table_free(
@@ -1719,25 +2159,28 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+/* Creates the chunk groups and chunks caches
+ * The number of cache entries is determined by the cache size and chunk size
+ * Existing caches and the values they contain are replaced
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_file_io_pool(
-     libewf_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
-     int access_flags,
+int libewf_internal_handle_initialize_caches(
+     libewf_internal_handle_t *internal_handle,
      libcerror_error_t **error )
 {
-	libbfio_handle_t *file_io_handle          = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_handle_open_file_io_pool";
-	size64_t segment_file_size                = 0;
-	ssize_t read_count                        = 0;
-	int file_io_pool_entry                    = 0;
-	int number_of_file_io_handles             = 0;
+	libewf_chunk_cache_t *chunk_cache        = NULL;
+	libfcache_cache_t *chunk_groups_cache    = NULL;
+	libfcache_cache_t *chunks_cache          = NULL;
+	static char *function                    = "libewf_internal_handle_initialize_caches";
+	size64_t chunk_group_cache_entry_size    = 0;
+	size64_t chunk_groups_cache_size         = 0;
+	uint64_t number_of_cache_entries         = 0;
+	uint32_t number_of_chunk_group_entries   = 0;
+	int number_of_chunk_groups_cache_entries = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS;
+	int number_of_chunks_cache_entries       = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS;
+	int number_of_recent_entries             = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1748,372 +2191,802 @@ int libewf_handle_open_file_io_pool(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-/* TODO what about segment table and delta segment tables ?
- * They should be created here or in initialize ?
- */
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->file_io_pool != NULL )
+	if( internal_handle->cache_size != 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - file IO pool value already set.",
-		 function );
+		if( internal_handle->media_values->chunk_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - invalid media values - missing chunk size.",
+			 function );
 
-		return( -1 );
-	}
-	if( internal_handle->chunk_table != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk table value already set.",
-		 function );
+			return( -1 );
+		}
+		/* An eighth of the cache size is used for the chunk groups
+		 * and the remainder for the chunks
+		 */
+		chunk_groups_cache_size = internal_handle->cache_size / 8;
 
-		return( -1 );
-	}
-	if( internal_handle->delta_chunks_range_list != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - delta chunks range list value already set.",
-		 function );
+		/* The size of a cached chunk group is determined by its number of table entries
+		 * if the number of table entries is not known, e.g. when writing,
+		 * the maximum number of table entries of the EWF format is assumed
+		 */
+		number_of_chunk_group_entries = internal_handle->maximum_number_of_chunk_group_entries;
 
-		return( -1 );
-	}
-	if( internal_handle->chunk_groups_cache != NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks group cache value already set.",
-		 function );
+		if( number_of_chunk_group_entries == 0 )
+		{
+			number_of_chunk_group_entries = LIBEWF_MAXIMUM_TABLE_ENTRIES_EWF;
+		}
+		chunk_group_cache_entry_size = (size64_t) number_of_chunk_group_entries * LIBEWF_CACHE_ENTRY_SIZE_CHUNK_GROUP_ENTRY;
 
-		return( -1 );
+		number_of_cache_entries = chunk_groups_cache_size / chunk_group_cache_entry_size;
+
+		if( number_of_cache_entries == 0 )
+		{
+			number_of_cache_entries = 1;
+		}
+		else if( number_of_cache_entries > (uint64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES )
+		{
+			number_of_cache_entries = (uint64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES;
+		}
+		number_of_chunk_groups_cache_entries = (int) number_of_cache_entries;
+
+		number_of_cache_entries = ( internal_handle->cache_size - chunk_groups_cache_size )
+		                        / internal_handle->media_values->chunk_size;
+
+		if( number_of_cache_entries == 0 )
+		{
+			number_of_cache_entries = 1;
+		}
+		else if( number_of_cache_entries > (uint64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES )
+		{
+			number_of_cache_entries = (uint64_t) LIBEWF_MAXIMUM_CACHE_ENTRIES;
+		}
+		number_of_chunks_cache_entries = (int) number_of_cache_entries;
 	}
-	if( internal_handle->chunks_cache != NULL )
+	/* The 2Q cache policy is not used when writing, since the chunk data
+	 * in the chunks cache can be changed
+	 */
+	if( ( internal_handle->cache_policy == LIBEWF_CACHE_POLICY_2Q )
+	 && ( internal_handle->write_io_handle == NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunks cache value already set.",
-		 function );
+		/* A quarter of the chunk cache is used for the recent queue
+		 */
+		number_of_recent_entries = number_of_chunks_cache_entries / 4;
 
-		return( -1 );
+		if( number_of_recent_entries == 0 )
+		{
+			number_of_recent_entries = 1;
+		}
 	}
-	if( internal_handle->chunk_group != NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* Make sure the chunks read ahead fit in the chunks cache
+	 * or in the recent queue of the chunk cache
+	 */
+	if( internal_handle->number_of_read_ahead_threads > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk group value already set.",
-		 function );
+		number_of_chunks_cache_entries += internal_handle->maximum_number_of_read_ahead_chunks;
 
-		return( -1 );
+		if( number_of_recent_entries > 0 )
+		{
+			number_of_recent_entries += internal_handle->maximum_number_of_read_ahead_chunks;
+		}
 	}
-	if( internal_handle->hash_sections != NULL )
+#endif
+	if( number_of_recent_entries > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - hash sections value already set.",
-		 function );
+		if( libewf_chunk_cache_initialize(
+		     &chunk_cache,
+		     number_of_chunks_cache_entries,
+		     number_of_recent_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunk cache.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
+		/* The chunks cache then only contains the packed chunks
+		 * that are copied before they are unpacked
+		 */
+		number_of_chunks_cache_entries = LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS;
 	}
-	if( internal_handle->single_files != NULL )
+	if( libfcache_cache_initialize(
+	     &chunk_groups_cache,
+	     number_of_chunk_groups_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - single files value already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( file_io_pool == NULL )
+	if( libfcache_cache_initialize(
+	     &chunks_cache,
+	     number_of_chunks_cache_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunks cache.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	if( internal_handle->chunks_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
-		 function );
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
-		if( libewf_read_io_handle_initialize(
-		     &( internal_handle->read_io_handle ),
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create read IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	if( internal_handle->chunk_cache != NULL )
 	{
-		if( libewf_write_io_handle_initialize(
-		     &( internal_handle->write_io_handle ),
+		if( libewf_chunk_cache_free(
+		     &( internal_handle->chunk_cache ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create write IO handle.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	if( libewf_chunk_table_initialize(
-	     &( internal_handle->chunk_table ),
-	     internal_handle->io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk table.",
-		 function );
+	internal_handle->chunk_groups_cache             = chunk_groups_cache;
+	internal_handle->chunks_cache                   = chunks_cache;
+	internal_handle->chunk_cache                    = chunk_cache;
+	internal_handle->number_of_chunks_cache_entries = number_of_chunks_cache_entries;
+	internal_handle->number_of_cache_hits           = 0;
+	internal_handle->number_of_cache_misses         = 0;
 
-		goto on_error;
-	}
-/* TODO add write support */
-	if( libfdata_range_list_initialize(
-	     &( internal_handle->delta_chunks_range_list ),
-	     (intptr_t *) internal_handle->io_handle,
-	     NULL,
-	     NULL,
-	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfcache_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_chunk_data_read_element_data,
-	     NULL,
-	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-	     error ) != 1 )
+	return( 1 );
+
+on_error:
+	if( chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &chunk_cache,
+		 NULL );
+	}
+	if( chunks_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &chunks_cache,
+		 NULL );
+	}
+	if( chunk_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &chunk_groups_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Initializes the buffer pool of the chunk data buffers
+ * The buffers are sized to contain a chunk and its checksum, hence the chunk size must be known
+ * No buffer pool is created if the maximum buffer pool size is 0
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_buffer_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function         = "libewf_internal_handle_initialize_buffer_pool";
+	size64_t number_of_buffers    = 0;
+	size_t buffer_size            = 0;
+	int maximum_number_of_buffers = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create delta chunks range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunk_groups_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNK_GROUPS,
-	     error ) != 1 )
+	if( internal_handle->chunk_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk groups cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->chunks_cache ),
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
+	/* The buffer pool is not replaced since cached chunk data can reference it
+	 */
+	if( ( internal_handle->chunk_buffer_pool != NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 )
+	 || ( internal_handle->maximum_buffer_pool_size == 0 ) )
+	{
+		return( 1 );
+	}
+	/* Reserve 4 bytes for the checksum
+	 */
+	buffer_size = (size_t) internal_handle->media_values->chunk_size + 4;
+
+	/* The buffer size should be rounded to the next 16-byte increment
+	 */
+	if( ( buffer_size % 16 ) != 0 )
+	{
+		buffer_size += 16;
+	}
+	buffer_size = ( buffer_size / 16 ) * 16;
+
+	number_of_buffers = internal_handle->maximum_buffer_pool_size / buffer_size;
+
+	if( number_of_buffers < 2 )
+	{
+		number_of_buffers = 2;
+	}
+	else if( number_of_buffers > (size64_t) INT_MAX )
+	{
+		number_of_buffers = (size64_t) INT_MAX;
+	}
+	maximum_number_of_buffers = (int) number_of_buffers;
+	if( libewf_buffer_pool_initialize(
+	     &( internal_handle->chunk_buffer_pool ),
+	     buffer_size,
+	     maximum_number_of_buffers,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunks cache.",
+		 "%s: unable to create chunk buffer pool.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_chunk_group_initialize(
-	     &( internal_handle->chunk_group ),
-	     error ) != 1 )
+	internal_handle->chunk_table->buffer_pool = internal_handle->chunk_buffer_pool;
+
+	return( 1 );
+}
+
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle      = NULL;
+	libewf_segment_file_t *segment_file   = NULL;
+	static char *function                 = "libewf_internal_handle_open_file_io_pool";
+	size64_t segment_file_size            = 0;
+	size_t minimum_read_ahead_buffer_size = 0;
+	ssize_t read_count                    = 0;
+	int file_io_pool_entry                = 0;
+	int number_of_file_io_handles         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+/* TODO what about segment table and delta segment tables ?
+ * They should be created here or in initialize ?
+ */
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk group.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_header_values_initialize(
-	     &( internal_handle->header_values ),
-	     error ) != 1 )
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - file IO pool value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_hash_sections_initialize(
-	     &( internal_handle->hash_sections ),
-	     error ) != 1 )
+	if( internal_handle->chunk_table != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create hash sections.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk table value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libewf_single_files_initialize(
-	     &( internal_handle->single_files ),
-	     error ) != 1 )
+	if( internal_handle->delta_chunks_range_list != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create single files.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - delta chunks range list value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks group cache value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
-	     error ) != 1 )
+	if( internal_handle->chunks_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunks cache value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	if( internal_handle->chunk_group != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk group value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - hash sections value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - single files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_flags & ~( LIBEWF_ACCESS_FLAG_READ | LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
 	}
 	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
 	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
 	{
-		if( libbfio_pool_get_number_of_handles(
-		     file_io_pool,
-		     &number_of_file_io_handles,
+		if( libewf_read_io_handle_initialize(
+		     &( internal_handle->read_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve the number of handles in the pool.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		if( libewf_segment_file_initialize(
-		     &segment_file,
-		     internal_handle->io_handle,
+	}
+	if( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( libewf_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create segment file.",
+			 "%s: unable to create write IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		for( file_io_pool_entry = 0;
-		     file_io_pool_entry < number_of_file_io_handles;
-		     file_io_pool_entry++ )
-		{
-			if( libbfio_pool_get_size(
-			     file_io_pool,
-			     file_io_pool_entry,
-			     &segment_file_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve size of file IO pool entry: %d.",
-				 function,
-				 file_io_pool_entry );
+	}
+	if( libewf_chunk_table_initialize(
+	     &( internal_handle->chunk_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->chunk_table->mapped_file_pool = internal_handle->mapped_file_pool;
+
+	/* The packed chunk table is only used when reading since the chunks
+	 * of a chunk group can change when writing or resuming
+	 */
+	if( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	 && ( internal_handle->maximum_packed_chunk_table_size > 0 ) )
+	{
+		if( libewf_chunk_table_initialize_packed_chunk_table(
+		     internal_handle->chunk_table,
+		     internal_handle->maximum_packed_chunk_table_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create packed chunk table.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The compressed chunk cache is only used when reading since the chunks
+	 * can be rewritten when writing or resuming, it is not used when the segment
+	 * files are memory mapped since the compressed data is then read from the mapping
+	 */
+	if( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	 && ( internal_handle->mapped_file_pool == NULL )
+	 && ( internal_handle->maximum_compressed_chunk_cache_size > 0 ) )
+	{
+		if( libewf_chunk_table_initialize_compressed_chunk_cache(
+		     internal_handle->chunk_table,
+		     internal_handle->maximum_compressed_chunk_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compressed chunk cache.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The read-ahead buffer is only used when reading since the segment files
+	 * are changed when writing or resuming, it is not used when the segment
+	 * files are memory mapped
+	 */
+	if( ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 )
+	 && ( internal_handle->mapped_file_pool == NULL )
+	 && ( internal_handle->maximum_read_ahead_buffer_size > 0 ) )
+	{
+		minimum_read_ahead_buffer_size = LIBEWF_DEFAULT_MINIMUM_READ_AHEAD_BUFFER_SIZE;
+
+		if( (size64_t) minimum_read_ahead_buffer_size > internal_handle->maximum_read_ahead_buffer_size )
+		{
+			minimum_read_ahead_buffer_size = (size_t) internal_handle->maximum_read_ahead_buffer_size;
+		}
+		if( libewf_chunk_table_initialize_read_ahead_buffer(
+		     internal_handle->chunk_table,
+		     minimum_read_ahead_buffer_size,
+		     (size_t) internal_handle->maximum_read_ahead_buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead buffer.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->chunk_table->read_ahead_buffer->async_io = internal_handle->async_io;
+	}
+/* TODO add write support */
+	if( libfdata_range_list_initialize(
+	     &( internal_handle->delta_chunks_range_list ),
+	     (intptr_t *) internal_handle->io_handle,
+	     NULL,
+	     NULL,
+	     (int (*)(intptr_t *, intptr_t *, libfdata_list_element_t *, libfcache_cache_t *, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libewf_chunk_data_read_element_data,
+	     NULL,
+	     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create delta chunks range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_internal_handle_initialize_caches(
+	     internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create caches.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_group_initialize(
+	     &( internal_handle->chunk_group ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_header_values_initialize(
+	     &( internal_handle->header_values ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_hash_sections_initialize(
+	     &( internal_handle->hash_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create hash sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_single_files_initialize(
+	     &( internal_handle->single_files ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create single files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 || ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( libbfio_pool_get_number_of_handles(
+		     file_io_pool,
+		     &number_of_file_io_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve the number of handles in the pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_segment_file_initialize(
+		     &segment_file,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment file.",
+			 function );
+
+			goto on_error;
+		}
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_handles;
+		     file_io_pool_entry++ )
+		{
+			if( libbfio_pool_get_size(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve size of file IO pool entry: %d.",
+				 function,
+				 file_io_pool_entry );
 
 				goto on_error;
 			}
+			if( internal_handle->mapped_file_pool != NULL )
+			{
+				if( libewf_mapped_file_pool_set_file_size(
+				     internal_handle->mapped_file_pool,
+				     file_io_pool_entry,
+				     segment_file_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set file size of mapped file: %d.",
+					 function,
+					 file_io_pool_entry );
+
+					goto on_error;
+				}
+			}
 			if( libbfio_pool_get_handle(
 			     file_io_pool,
 			     file_io_pool_entry,
@@ -2246,6 +3119,23 @@ int libewf_handle_open_file_io_pool(
 
 			goto on_error;
 		}
+		if( ( internal_handle->index_file_io_handle != NULL )
+		 && ( ( access_flags & ( LIBEWF_ACCESS_FLAG_WRITE | LIBEWF_ACCESS_FLAG_RESUME ) ) == 0 ) )
+		{
+			if( libewf_internal_handle_open_read_index_file(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
 		if( libewf_handle_open_read_segment_files(
 		     internal_handle,
 		     file_io_pool,
@@ -2322,14 +3212,87 @@ int libewf_handle_open_file_io_pool(
 				goto on_error;
 			}
 		}
-	}
-	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
-	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
-	{
-		if( internal_handle->write_io_handle->values_initialized == 0 )
+		if( internal_handle->index_file != NULL )
 		{
-			if( libewf_write_io_handle_initialize_values(
-			     internal_handle->write_io_handle,
+			if( ( internal_handle->index_file->is_modified != 0 )
+			 && ( ( internal_handle->segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED ) == 0 ) )
+			{
+				/* The segment files can be read without the index file
+				 * hence a failure to write the index file is not considered an error
+				 */
+				if( libewf_index_file_write_file_io_handle(
+				     internal_handle->index_file,
+				     internal_handle->index_file_io_handle,
+				     error ) == -1 )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( ( error != NULL )
+						 && ( *error != NULL ) )
+						{
+							libcnotify_print_error_backtrace(
+							 *error );
+						}
+					}
+#endif
+					libcerror_error_free(
+					 error );
+				}
+			}
+			if( libewf_internal_handle_insert_index_file_packed_chunk_groups(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set packed chunk table from index file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		/* The caches are sized using the chunk size that was read from the segment files
+		 */
+		if( internal_handle->cache_size != 0 )
+		{
+			if( libewf_internal_handle_initialize_caches(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to resize caches.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libewf_internal_handle_initialize_buffer_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize chunk buffer pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_RESUME ) != 0 ) )
+	{
+		if( internal_handle->write_io_handle->values_initialized == 0 )
+		{
+			if( libewf_write_io_handle_initialize_values(
+			     internal_handle->write_io_handle,
 			     internal_handle->io_handle,
 			     internal_handle->media_values,
 			     internal_handle->segment_table,
@@ -2366,6 +3329,68 @@ int libewf_handle_open_file_io_pool(
 			goto on_error;
 		}
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 )
+	 || ( internal_handle->number_of_compression_threads > 0 ) )
+	{
+		if( libcdata_array_initialize(
+		     &( internal_handle->compression_contexts ),
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create pooled compression contexts array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ( internal_handle->number_of_read_ahead_threads > 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( internal_handle->read_ahead_thread_pool ),
+		     NULL,
+		     internal_handle->number_of_read_ahead_threads,
+		     internal_handle->maximum_number_of_read_ahead_chunks,
+		     (int (*)(intptr_t *, void *)) &libewf_internal_handle_read_ahead_chunk,
+		     (void *) internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		internal_handle->read_ahead_offset      = 0;
+		internal_handle->read_ahead_chunk_index = 0;
+		internal_handle->read_ahead_abort       = 0;
+	}
+	if( ( internal_handle->number_of_compression_threads > 0 )
+	 && ( ( access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		if( libewf_internal_handle_initialize_compression_thread_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize compression thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	internal_handle->io_handle->access_flags = access_flags;
 	internal_handle->file_io_pool            = file_io_pool;
 
@@ -2378,6 +3403,21 @@ on_error:
 		 &segment_file,
 		 NULL );
 	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->compression_contexts != NULL )
+	{
+		libcdata_array_free(
+		 &( internal_handle->compression_contexts ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_compression_context_free,
+		 NULL );
+	}
+#endif
+	if( internal_handle->index_file != NULL )
+	{
+		libewf_index_file_free(
+		 &( internal_handle->index_file ),
+		 NULL );
+	}
 	if( internal_handle->single_files != NULL )
 	{
 		libewf_single_files_free(
@@ -2402,6 +3442,12 @@ on_error:
 		 &( internal_handle->chunk_group ),
 		 NULL );
 	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 &( internal_handle->chunk_cache ),
+		 NULL );
+	}
 	if( internal_handle->chunks_cache != NULL )
 	{
 		libfcache_cache_free(
@@ -2441,34 +3487,21 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the section data from a segment file
+/* Reads the index file
+ * Segments in the index file that do not match the size of the segment files are removed
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_read_segment_file_section_data(
+int libewf_internal_handle_open_read_index_file(
      libewf_internal_handle_t *internal_handle,
-     libewf_segment_file_t *segment_file,
-     libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	libewf_header_sections_t *header_sections = NULL;
-	libewf_section_t *section                 = NULL;
-	libfcache_cache_t *sections_cache         = NULL;
-	uint8_t *string_data                      = NULL;
-	static char *function                     = "libewf_handle_open_read_segment_file_section_data";
-	off64_t section_data_offset               = 0;
-	size_t string_data_size                   = 0;
-	ssize_t read_count                        = 0;
-	int initialize_chunk_values               = 0;
-	int header_section_found                  = 0;
-	int number_of_sections                    = 0;
-	int section_index                         = 0;
-	int set_identifier_change                 = 0;
-	int single_files_section_found            = 0;
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-	int known_section                         = 0;
-#endif
+	libewf_index_segment_t *index_segment = NULL;
+	static char *function                 = "libewf_internal_handle_open_read_index_file";
+	size64_t segment_file_size            = 0;
+	uint32_t number_of_segments           = 0;
+	uint32_t segment_number               = 0;
+	int file_io_pool_entry                = 0;
+	int result                            = 0;
 
 	if( internal_handle == NULL )
 	{
@@ -2481,607 +3514,847 @@ int libewf_handle_open_read_segment_file_section_data(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->index_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - index file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( libewf_index_file_initialize(
+	     &( internal_handle->index_file ),
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->media_values == NULL )
+	/* A missing or invalid index file is replaced after the segment files were read
+	 */
+	if( libewf_index_file_read_file_io_handle(
+	     internal_handle->index_file,
+	     internal_handle->index_file_io_handle,
+	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
 
-		return( -1 );
-	}
-	if( internal_handle->single_files == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing single files.",
-		 function );
+		if( libewf_index_file_free(
+		     &( internal_handle->index_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
+			 function );
 
-		return( -1 );
-	}
-	if( segment_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
-		 function );
+			goto on_error;
+		}
+		if( libewf_index_file_initialize(
+		     &( internal_handle->index_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index file.",
+			 function );
 
-		return( -1 );
+			goto on_error;
+		}
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
 		 function );
 
 		goto on_error;
 	}
-	if( libewf_header_sections_initialize(
-	     &header_sections,
+	if( libewf_index_file_set_number_of_segments(
+	     internal_handle->index_file,
+	     number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create header sections.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of segments in index file.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfdata_list_get_number_of_elements(
-	     segment_file->sections_list,
-	     &number_of_sections,
-	     error ) != 1 )
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of sections in the sections list.",
-		 function );
+		result = libewf_index_file_get_segment_by_index(
+		          internal_handle->index_file,
+		          segment_number,
+		          &index_segment,
+		          error );
 
-		goto on_error;
-	}
-	/* Make sure to read the device information section first so we
-	 * have the correct chunk size when reading Lx01 files.
-	 */
-	if( segment_file->device_information_section_index >= 0 )
-	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     segment_file->device_information_section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
 			 function,
-			 segment_file->device_information_section_index );
+			 segment_number );
 
 			goto on_error;
 		}
-		if( section == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing section: %d.",
-			 function,
-			 segment_file->device_information_section_index );
-
-			goto on_error;
+			continue;
 		}
-		if( libewf_segment_file_seek_offset(
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     section->start_offset,
-		     error ) == -1 )
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 segment_file->device_information_section_index,
-			 section->start_offset );
-
-			goto on_error;
-		}
-		read_count = libewf_section_compressed_string_read(
-			      section,
-			      internal_handle->io_handle,
-			      file_io_pool,
-			      file_io_pool_entry,
-			      internal_handle->io_handle->compression_method,
-			      &string_data,
-			      &string_data_size,
-			      error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read device information file object string.",
-			 function );
+			 segment_number );
 
 			goto on_error;
 		}
-		else if( read_count != 0 )
+		if( ( index_segment->segment_file_size != segment_file_size )
+		 || ( index_segment->segment_number != ( segment_number + 1 ) ) )
 		{
-			if( internal_handle->read_io_handle->device_information == NULL )
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
 			{
-				if( libewf_device_information_parse(
-				     string_data,
-				     string_data_size,
-				     internal_handle->media_values,
-				     internal_handle->header_values,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to parse device information.",
-					 function );
-
-					goto on_error;
-				}
-				internal_handle->read_io_handle->device_information      = string_data;
-				internal_handle->read_io_handle->device_information_size = string_data_size;
+				libcnotify_printf(
+				 "%s: segment: %" PRIu32 " does not match index file.\n",
+				 function,
+				 segment_number );
 			}
-			else
+#endif
+			if( libewf_index_file_set_segment_by_index(
+			     internal_handle->index_file,
+			     segment_number,
+			     NULL,
+			     error ) != 1 )
 			{
-				if( ( internal_handle->read_io_handle->device_information_size != string_data_size )
-				 || ( memory_compare(
-				       internal_handle->read_io_handle->device_information,
-				       string_data,
-				       16 ) != 0 ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: device information value mismatch.",
-					 function );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to remove segment: %" PRIu32 " from index file.",
+				 function,
+				 segment_number );
 
-					goto on_error;
-				}
-				memory_free(
-				 string_data );
+				goto on_error;
 			}
-			string_data = NULL;
 		}
 	}
-	for( section_index = 0;
-	     section_index < number_of_sections;
-	     section_index++ )
+	return( 1 );
+
+on_error:
+	if( internal_handle->index_file != NULL )
 	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     section_index,
-		     (intptr_t **) &section,
-		     0,
-		     error ) != 1 )
+		libewf_index_file_free(
+		 &( internal_handle->index_file ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Inserts the packed chunk groups of the index file into the packed chunk table
+ * so that the table sections do not need to be read to locate the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_insert_index_file_packed_chunk_groups(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *index_segment = NULL;
+	static char *function                 = "libewf_internal_handle_insert_index_file_packed_chunk_groups";
+	size64_t segment_file_size            = 0;
+	size64_t storage_media_offset         = 0;
+	size64_t storage_media_size           = 0;
+	uint32_t number_of_segments           = 0;
+	uint32_t segment_number               = 0;
+	int file_io_pool_entry                = 0;
+	int result                            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->chunk_table->packed_chunk_table == NULL )
+	 || ( internal_handle->media_values->chunk_size == 0 ) )
+	{
+		return( 1 );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		result = libewf_segment_table_get_segment_storage_media_size_by_index(
+		          internal_handle->segment_table,
+		          segment_number,
+		          &storage_media_size,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
+			 "%s: unable to retrieve storage media size of segment: %" PRIu32 " from segment table.",
 			 function,
-			 section_index );
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( section == NULL )
+		/* The storage media offset of the segments that follow
+		 * a segment without a storage media size is unknown
+		 */
+		else if( result == 0 )
+		{
+			break;
+		}
+		result = libewf_index_file_get_segment_by_index(
+		          internal_handle->index_file,
+		          segment_number,
+		          &index_segment,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing section: %d.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
 			 function,
-			 section_index );
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( section->data_size != 0 )
+		else if( result != 0 )
 		{
-			section_data_offset = section->start_offset;
-
-			if( segment_file->major_version == 1 )
+			if( libewf_segment_table_get_segment_by_index(
+			     internal_handle->segment_table,
+			     segment_number,
+			     &file_io_pool_entry,
+			     &segment_file_size,
+			     error ) != 1 )
 			{
-				section_data_offset += sizeof( ewf_section_descriptor_v1_t );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+				 function,
+				 segment_number );
+
+				return( -1 );
 			}
-			if( libewf_segment_file_seek_offset(
-			     segment_file,
-			     file_io_pool,
+			if( libewf_index_segment_insert_packed_chunk_groups(
+			     index_segment,
+			     internal_handle->chunk_table->packed_chunk_table,
+			     (uint64_t) ( storage_media_offset / internal_handle->media_values->chunk_size ),
 			     file_io_pool_entry,
-			     section_data_offset,
-			     error ) == -1 )
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert packed chunk groups of segment: %" PRIu32 ".",
 				 function,
-				 section_index,
-				 section_data_offset );
+				 segment_number );
 
-				goto on_error;
+				return( -1 );
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				if( segment_file->major_version == 1 )
-				{
-					libcnotify_printf(
-					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 (char *) section->type_string,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
-				}
-				else if( segment_file->major_version == 2 )
-				{
-					libcnotify_printf(
-					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 section->type,
-					 file_io_pool_entry,
-					 segment_file->current_offset,
-					 segment_file->current_offset );
-				}
-			}
-#endif
 		}
-		if( section->type != 0 )
-		{
-			switch( section->type )
-			{
-				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
-					/* Since we already parsed it nothing to do for the device information section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
-
-				case LIBEWF_SECTION_TYPE_CASE_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
-
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read case data file object string.",
-						 function );
+		storage_media_offset += storage_media_size;
+	}
+	return( 1 );
+}
 
-						goto on_error;
-					}
-					else if( read_count != 0 )
-					{
-						if( internal_handle->read_io_handle->case_data == NULL )
-						{
-							if( libewf_case_data_parse(
-							     string_data,
-							     string_data_size,
-							     internal_handle->media_values,
-							     internal_handle->header_values,
-							     &( internal_handle->io_handle->format ),
-							     error ) != 1 )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-								 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-								 "%s: unable to parse case data.",
-								 function );
+/* Opens a set of EWF file(s) using a Basic File IO (bfio) pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_file_io_pool(
+     libewf_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_open_file_io_pool";
+	int result                                = 0;
 
-								goto on_error;
-							}
-							internal_handle->read_io_handle->case_data      = string_data;
-							internal_handle->read_io_handle->case_data_size = string_data_size;
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-							initialize_chunk_values = 1;
-						}
-						else
-						{
-							if( ( internal_handle->read_io_handle->case_data_size != string_data_size )
-							 || ( memory_compare(
-							       internal_handle->read_io_handle->case_data,
-							       string_data,
-							       16 ) != 0 ) )
-							{
-								libcerror_error_set(
-								 error,
-								 LIBCERROR_ERROR_DOMAIN_INPUT,
-								 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-								 "%s: case data value mismatch.",
-								 function );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-								goto on_error;
-							}
-							memory_free(
-							 string_data );
-						}
-						string_data = NULL;
-					}
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found sectors section in EWF-S01 format.\n",
-							 function );
-						}
-					}
-#endif
-					/* Nothing to do for the sectors section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
+		return( -1 );
+	}
 #endif
-					break;
+	result = libewf_internal_handle_open_file_io_pool(
+	          internal_handle,
+	          file_io_pool,
+	          access_flags,
+	          error );
 
-				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
-					read_count = libewf_segment_file_read_table_section(
-						      segment_file,
-						      section,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->media_values,
-						      internal_handle->chunk_group,
-						      error );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle using a file IO pool.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found error section in EWF-S01 format.\n",
-							 function );
-						}
-					}
+		return( -1 );
+	}
 #endif
-					read_count = libewf_section_error_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->acquiry_errors,
-						      error );
+	return( result );
+}
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+/* Reads the section data from a segment file
+ * The sections of an indexed segment file are retrieved from the index segment,
+ * otherwise the sections are appended to the index segment if provided
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_read_segment_file_section_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error )
+{
+	libewf_header_sections_t *header_sections = NULL;
+	libewf_section_t *section                 = NULL;
+	libfcache_cache_t *sections_cache         = NULL;
+	uint8_t *string_data                      = NULL;
+	static char *function                     = "libewf_handle_open_read_segment_file_section_data";
+	off64_t section_data_offset               = 0;
+	size_t string_data_size                   = 0;
+	ssize_t read_count                        = 0;
+	int initialize_chunk_values               = 0;
+	int header_section_found                  = 0;
+	int number_of_sections                    = 0;
+	int result                                = 0;
+	int section_index                         = 0;
+	int set_identifier_change                 = 0;
+	int single_files_section_found            = 0;
 
-				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
 #if defined( HAVE_VERBOSE_OUTPUT )
-					if( libcnotify_verbose != 0 )
-					{
-						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
-						{
-							libcnotify_printf(
-							 "%s: found session section in EWF-S01 format.\n",
-							 function );
-						}
-					}
+	int known_section                         = 0;
 #endif
-					read_count = libewf_section_session_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->media_values,
-						      internal_handle->sessions,
-						      internal_handle->tracks,
-						      error );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_MD5_HASH:
-					read_count = libewf_section_md5_hash_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      segment_file->major_version,
-						      internal_handle->hash_sections,
-						      error );
+		return( -1 );
+	}
+	if( internal_handle->read_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing read IO handle.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_SHA1_HASH:
-					read_count = libewf_section_sha1_hash_read(
-						      section,
-						      internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-						      internal_handle->hash_sections,
-						      error );
+		return( -1 );
+	}
+	if( internal_handle->single_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing single files.",
+		 function );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
 
-				case LIBEWF_SECTION_TYPE_RESTART_DATA:
-					read_count = libewf_section_compressed_string_read(
-						      section,
-					              internal_handle->io_handle,
-						      file_io_pool,
-						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
-						      &string_data,
-						      &string_data_size,
-						      error );
+		return( -1 );
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
+		 function );
 
-					if( read_count == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read restart data file object string.",
-						 function );
+		goto on_error;
+	}
+	if( libewf_header_sections_initialize(
+	     &header_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create header sections.",
+		 function );
 
-						goto on_error;
-					}
-					if( libewf_restart_data_parse(
-					     string_data,
-					     string_data_size,
-					     error ) != 1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-						 "%s: unable to parse restart data.",
-						 function );
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
+		 function );
 
-						goto on_error;
-					}
-					memory_free(
-					 string_data );
+		goto on_error;
+	}
+	/* Make sure to read the device information section first so we
+	 * have the correct chunk size when reading Lx01 files.
+	 */
+	if( segment_file->device_information_section_index >= 0 )
+	{
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) != 0 )
+		{
+			result = libewf_index_segment_get_section_by_index(
+			          index_segment,
+			          segment_file->device_information_section_index,
+			          &section,
+			          error );
+		}
+		else
+		{
+			result = libfdata_list_get_element_value_by_index(
+			          segment_file->sections_list,
+			          (intptr_t *) file_io_pool,
+			          sections_cache,
+			          segment_file->device_information_section_index,
+			          (intptr_t **) &section,
+			          0,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 segment_file->device_information_section_index );
 
-					string_data = NULL;
+			goto on_error;
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 segment_file->device_information_section_index );
 
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			goto on_error;
+		}
+		if( libewf_segment_file_seek_offset(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     section->start_offset,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+			 function,
+			 segment_file->device_information_section_index,
+			 section->start_offset );
 
-				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			goto on_error;
+		}
+		read_count = libewf_section_compressed_string_read(
+			      section,
+			      internal_handle->io_handle,
+			      file_io_pool,
+			      file_io_pool_entry,
+			      internal_handle->io_handle->compression_method,
+			      &string_data,
+			      &string_data_size,
+			      error );
 
-				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read device information file object string.",
+			 function );
 
-				case LIBEWF_SECTION_TYPE_NEXT:
-					/* Nothing to do for the next section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+			goto on_error;
+		}
+		else if( read_count != 0 )
+		{
+			if( internal_handle->read_io_handle->device_information == NULL )
+			{
+				if( libewf_device_information_parse(
+				     string_data,
+				     string_data_size,
+				     internal_handle->media_values,
+				     internal_handle->header_values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to parse device information.",
+					 function );
 
-				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+					goto on_error;
+				}
+				internal_handle->read_io_handle->device_information      = string_data;
+				internal_handle->read_io_handle->device_information_size = string_data_size;
+			}
+			else
+			{
+				if( ( internal_handle->read_io_handle->device_information_size != string_data_size )
+				 || ( memory_compare(
+				       internal_handle->read_io_handle->device_information,
+				       string_data,
+				       16 ) != 0 ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: device information value mismatch.",
+					 function );
 
-				case LIBEWF_SECTION_TYPE_DONE:
-					/* Nothing to do for the done section
+					goto on_error;
+				}
+				memory_free(
+				 string_data );
+			}
+			string_data = NULL;
+		}
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) != 0 )
+		{
+			result = libewf_index_segment_get_section_by_index(
+			          index_segment,
+			          section_index,
+			          &section,
+			          error );
+		}
+		else
+		{
+			result = libfdata_list_get_element_value_by_index(
+			          segment_file->sections_list,
+			          (intptr_t *) file_io_pool,
+			          sections_cache,
+			          section_index,
+			          (intptr_t **) &section,
+			          0,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		if( ( index_segment != NULL )
+		 && ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 ) )
+		{
+			if( libewf_index_segment_append_section(
+			     index_segment,
+			     section,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append section: %d to index segment.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
+		}
+		if( section->data_size != 0 )
+		{
+			section_data_offset = section->start_offset;
+
+			if( segment_file->major_version == 1 )
+			{
+				section_data_offset += sizeof( ewf_section_descriptor_v1_t );
+			}
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( segment_file->major_version == 1 )
+				{
+					libcnotify_printf(
+					 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 (char *) section->type_string,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+				else if( segment_file->major_version == 2 )
+				{
+					libcnotify_printf(
+					 "%s: reading 0x%08" PRIx32 " section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 section->type,
+					 file_io_pool_entry,
+					 segment_file->current_offset,
+					 segment_file->current_offset );
+				}
+			}
+#endif
+		}
+		if( section->type != 0 )
+		{
+			switch( section->type )
+			{
+				case LIBEWF_SECTION_TYPE_DEVICE_INFORMATION:
+					/* Since we already parsed it nothing to do for the device information section
 					 */
 #if defined( HAVE_VERBOSE_OUTPUT )
 					known_section = 1;
 #endif
 					break;
 
-				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
+				case LIBEWF_SECTION_TYPE_CASE_DATA:
 					read_count = libewf_section_compressed_string_read(
 						      section,
-					              internal_handle->io_handle,
+						      internal_handle->io_handle,
 						      file_io_pool,
 						      file_io_pool_entry,
-					              internal_handle->io_handle->compression_method,
+						      internal_handle->io_handle->compression_method,
 						      &string_data,
 						      &string_data_size,
 						      error );
@@ -3092,30 +4365,57 @@ int libewf_handle_open_read_segment_file_section_data(
 						 error,
 						 LIBCERROR_ERROR_DOMAIN_IO,
 						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read analytical data file object string.",
+						 "%s: unable to read case data file object string.",
 						 function );
 
 						goto on_error;
 					}
 					else if( read_count != 0 )
 					{
-						if( libewf_analytical_data_parse(
-						     string_data,
-						     string_data_size,
-						     error ) != 1 )
+						if( internal_handle->read_io_handle->case_data == NULL )
 						{
-							libcerror_error_set(
-							 error,
-							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-							 "%s: unable to parse analytical data.",
-							 function );
+							if( libewf_case_data_parse(
+							     string_data,
+							     string_data_size,
+							     internal_handle->media_values,
+							     internal_handle->header_values,
+							     &( internal_handle->io_handle->format ),
+							     error ) != 1 )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+								 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+								 "%s: unable to parse case data.",
+								 function );
 
-							goto on_error;
+								goto on_error;
+							}
+							internal_handle->read_io_handle->case_data      = string_data;
+							internal_handle->read_io_handle->case_data_size = string_data_size;
+
+							initialize_chunk_values = 1;
 						}
-						memory_free(
-						 string_data );
+						else
+						{
+							if( ( internal_handle->read_io_handle->case_data_size != string_data_size )
+							 || ( memory_compare(
+							       internal_handle->read_io_handle->case_data,
+							       string_data,
+							       16 ) != 0 ) )
+							{
+								libcerror_error_set(
+								 error,
+								 LIBCERROR_ERROR_DOMAIN_INPUT,
+								 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+								 "%s: case data value mismatch.",
+								 function );
 
+								goto on_error;
+							}
+							memory_free(
+							 string_data );
+						}
 						string_data = NULL;
 					}
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -3123,48 +4423,304 @@ int libewf_handle_open_read_segment_file_section_data(
 #endif
 					break;
 
-				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
+				case LIBEWF_SECTION_TYPE_SECTOR_DATA:
 #if defined( HAVE_VERBOSE_OUTPUT )
-					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
-					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+					if( libcnotify_verbose != 0 )
 					{
-						if( libcnotify_verbose != 0 )
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
 						{
 							libcnotify_printf(
-							 "%s: found single files data section in none logical evidence format.\n",
+							 "%s: found sectors section in EWF-S01 format.\n",
 							 function );
 						}
 					}
 #endif
-					read_count = libewf_section_ltree_read(
+					/* Nothing to do for the sectors section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SECTOR_TABLE:
+					/* The chunk groups of an indexed segment file were read from the index file
+					 */
+					if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 )
+					{
+						read_count = libewf_segment_file_read_table_section(
+							      segment_file,
+							      section,
+							      file_io_pool,
+							      file_io_pool_entry,
+							      internal_handle->media_values,
+							      internal_handle->chunk_group,
+							      error );
+					}
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ERROR_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found error section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_error_read(
 						      section,
 						      internal_handle->io_handle,
 						      file_io_pool,
 						      file_io_pool_entry,
 						      segment_file->major_version,
-						      &( internal_handle->single_files->section_data ),
-						      &( internal_handle->single_files->section_data_size ),
-						      &( internal_handle->single_files->ltree_data ),
-						      &( internal_handle->single_files->ltree_data_size ),
+						      internal_handle->acquiry_errors,
 						      error );
 
-					single_files_section_found = 1;
-
 #if defined( HAVE_VERBOSE_OUTPUT )
 					known_section = 1;
 #endif
 					break;
-			}
-		}
-		else if( section->type_string_length == 4 )
-		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "data",
-			     4 ) == 0 )
-			{
+
+				case LIBEWF_SECTION_TYPE_SESSION_TABLE:
 #if defined( HAVE_VERBOSE_OUTPUT )
-				if( libcnotify_verbose != 0 )
+					if( libcnotify_verbose != 0 )
+					{
+						if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+						{
+							libcnotify_printf(
+							 "%s: found session section in EWF-S01 format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_session_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->media_values,
+						      internal_handle->sessions,
+						      internal_handle->tracks,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_INCREMENT_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MD5_HASH:
+					read_count = libewf_section_md5_hash_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SHA1_HASH:
+					read_count = libewf_section_sha1_hash_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->hash_sections,
+						      error );
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_RESTART_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read restart data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					if( libewf_restart_data_parse(
+					     string_data,
+					     string_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+						 "%s: unable to parse restart data.",
+						 function );
+
+						goto on_error;
+					}
+					memory_free(
+					 string_data );
+
+					string_data = NULL;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ENCRYPTION_KEYS:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_MEMORY_EXTENTS_TABLE:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_NEXT:
+					/* Nothing to do for the next section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_FINAL_INFORMATION:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_DONE:
+					/* Nothing to do for the done section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_ANALYTICAL_DATA:
+					read_count = libewf_section_compressed_string_read(
+						      section,
+					              internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+					              internal_handle->io_handle->compression_method,
+						      &string_data,
+						      &string_data_size,
+						      error );
+
+					if( read_count == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read analytical data file object string.",
+						 function );
+
+						goto on_error;
+					}
+					else if( read_count != 0 )
+					{
+						if( libewf_analytical_data_parse(
+						     string_data,
+						     string_data_size,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+							 "%s: unable to parse analytical data.",
+							 function );
+
+							goto on_error;
+						}
+						memory_free(
+						 string_data );
+
+						string_data = NULL;
+					}
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+
+				case LIBEWF_SECTION_TYPE_SINGLE_FILES_DATA:
+#if defined( HAVE_VERBOSE_OUTPUT )
+					if( ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF1_LOGICAL )
+					 && ( internal_handle->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_EWF2_LOGICAL ) )
+					{
+						if( libcnotify_verbose != 0 )
+						{
+							libcnotify_printf(
+							 "%s: found single files data section in none logical evidence format.\n",
+							 function );
+						}
+					}
+#endif
+					read_count = libewf_section_ltree_read(
+						      section,
+						      internal_handle->io_handle,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      segment_file->major_version,
+						      &( internal_handle->single_files->section_data ),
+						      &( internal_handle->single_files->section_data_size ),
+						      &( internal_handle->single_files->ltree_data ),
+						      &( internal_handle->single_files->ltree_data_size ),
+						      error );
+
+					single_files_section_found = 1;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+			}
+		}
+		else if( section->type_string_length == 4 )
+		{
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "data",
+			     4 ) == 0 )
+			{
+#if defined( HAVE_VERBOSE_OUTPUT )
+				if( libcnotify_verbose != 0 )
 				{
 					if( internal_handle->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
 					{
@@ -3400,13 +4956,16 @@ int libewf_handle_open_read_segment_file_section_data(
 				  (void *) "table2",
 				  6 ) == 0 )
 			{
-				read_count = libewf_segment_file_read_table2_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      internal_handle->chunk_group,
-					      error );
+				if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 )
+				{
+					read_count = libewf_segment_file_read_table2_section(
+						      segment_file,
+						      section,
+						      file_io_pool,
+						      file_io_pool_entry,
+						      internal_handle->chunk_group,
+						      error );
+				}
 
 #if defined( HAVE_VERBOSE_OUTPUT )
 				known_section = 1;
@@ -3752,22 +5311,22 @@ on_error:
 	return( -1 );
 }
 
-/* Opens the segment files for reading
- * Returns 1 if successful or -1 on error
+/* Reads an indexed segment file
+ * Only the file header is read, the sections and chunk groups are retrieved from the index segment
+ * Returns 1 if successful, 0 if the segment file does not match the index segment or -1 on error
  */
-int libewf_handle_open_read_segment_files(
+int libewf_handle_open_read_indexed_segment_file(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libewf_index_segment_t *index_segment,
      libcerror_error_t **error )
 {
 	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_handle_open_read_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	static char *function               = "libewf_handle_open_read_indexed_segment_file";
+	ssize_t read_count                  = 0;
+	int result                          = 1;
 
 	if( internal_handle == NULL )
 	{
@@ -3780,307 +5339,695 @@ int libewf_handle_open_read_segment_files(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	if( internal_handle->index_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing index file.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->read_io_handle == NULL )
+	if( index_segment == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - missing read IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     internal_handle->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from segment table.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( number_of_segments == 0 )
+	read_count = libewf_segment_file_read_file_header(
+		      segment_file,
+		      file_io_pool,
+		      file_io_pool_entry,
+		      error );
+
+	if( read_count < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of segments value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read segment file header.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
+	/* The segment file header is validated against the index file
+	 * since the segment file could have been replaced after the index file was written
+	 */
+	if( ( segment_file->segment_number != ( segment_number + 1 ) )
+	 || ( segment_file->segment_number != index_segment->segment_number )
+	 || ( segment_file->type != internal_handle->index_file->segment_file_type )
+	 || ( segment_file->major_version != internal_handle->index_file->major_version )
+	 || ( segment_file->minor_version != internal_handle->index_file->minor_version ) )
 	{
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
+		result = 0;
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		if( ( segment_file->compression_method != internal_handle->index_file->compression_method )
+		 || ( memory_compare(
+		       segment_file->set_identifier,
+		       internal_handle->index_file->set_identifier,
+		       16 ) != 0 ) )
+		{
+			result = 0;
+		}
+	}
+	if( result == 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: segment file: %" PRIu32 " does not match index segment.\n",
+			 function,
+			 segment_number );
+		}
+#endif
+		if( libewf_segment_file_free(
+		     &segment_file,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment file.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
+		return( 0 );
+	}
+	if( libewf_index_segment_get_segment_file_values(
+	     index_segment,
+	     segment_file,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment file values from index segment.",
+		 function );
+
+		goto on_error;
+	}
+	/* The segment file is validated against the other segment files
+	 * when it is retrieved from the segment table
+	 */
+	if( libewf_segment_table_set_segment_file_by_index(
+	     internal_handle->segment_table,
+	     file_io_pool,
+	     segment_number,
+	     segment_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+		 function,
+		 segment_number );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Scans a segment file, reads its file header and section descriptors
+ * Callback function for the scan thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_scan_segment_file(
+     libewf_segment_file_scan_t *segment_file_scan,
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error            = NULL;
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_scan_segment_file";
+
+	if( segment_file_scan == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file scan.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     internal_handle->io_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	/* The private file IO pool contains a single entry
+	 */
+	if( libewf_segment_file_read_section_descriptors(
+	     segment_file,
+	     segment_file_scan->file_io_pool,
+	     0,
+	     segment_file_scan->segment_file_size,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptors of segment file: %" PRIu32 ".",
+		 function,
+		 segment_file_scan->segment_number );
+
+		goto on_error;
+	}
+	/* Close the file IO handle so that the number of open files
+	 * does not exceed the number of scan threads
+	 */
+	if( libbfio_pool_close_all(
+	     segment_file_scan->file_io_pool,
+	     &error ) != 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	segment_file_scan->segment_file = segment_file;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
 		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_file != NULL )
+	{
+		libewf_segment_file_free(
+		 &segment_file,
+		 NULL );
+	}
+	if( segment_file_scan != NULL )
+	{
+		libbfio_pool_close_all(
+		 segment_file_scan->file_io_pool,
+		 NULL );
+	}
+	return( -1 );
+}
 
-			if( libewf_segment_table_set_maximum_segment_size(
-			     internal_handle->segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
+/* Scans a range of segment files concurrently
+ * Every segment file is read by a worker thread using a clone of its file IO handle
+ * in a private single entry file IO pool, the scanned segment files are stored
+ * in the segment table afterwards.
+ * Segment files that are indexed, that cannot be cloned or that fail to scan
+ * are not stored and are read when retrieved from the segment table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_scan_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle               = NULL;
+	libbfio_handle_t *scan_file_io_handle          = NULL;
+	libcthreads_thread_pool_t *scan_thread_pool    = NULL;
+	libewf_index_segment_t *index_segment          = NULL;
+	libewf_segment_file_scan_t *segment_file_scan  = NULL;
+	libewf_segment_file_scan_t *segment_file_scans = NULL;
+	static char *function                          = "libewf_internal_handle_scan_segment_files";
+	size64_t segment_file_size                     = 0;
+	size_t segment_file_scans_size                 = 0;
+	uint32_t number_of_segment_file_scans          = 0;
+	uint32_t scan_index                            = 0;
+	uint32_t segment_number                        = 0;
+	int file_io_pool_entry                         = 0;
+	int number_of_threads                          = 0;
+	int result                                     = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* A single scan thread or segment file is not worth the overhead of cloning
+	 * the file IO handles, the segment files are read when retrieved from the segment table
+	 */
+	if( ( internal_handle->number_of_scan_threads <= 1 )
+	 || ( number_of_segments == 1 ) )
+	{
+		return( 1 );
+	}
+	segment_file_scans_size = sizeof( libewf_segment_file_scan_t ) * number_of_segments;
+
+	segment_file_scans = (libewf_segment_file_scan_t *) memory_allocate(
+	                                                     segment_file_scans_size );
+
+	if( segment_file_scans == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment file scans.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     segment_file_scans,
+	     0,
+	     segment_file_scans_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment file scans.",
+		 function );
+
+		memory_free(
+		 segment_file_scans );
+
+		return( -1 );
+	}
+	for( segment_number = first_segment_number;
+	     segment_number < ( first_segment_number + number_of_segments );
+	     segment_number++ )
+	{
+		result = 0;
+
+		if( internal_handle->index_file != NULL )
+		{
+			result = libewf_index_file_get_segment_by_index(
+			          internal_handle->index_file,
+			          segment_number,
+			          &index_segment,
+			          error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in segment table.",
-				 function );
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
+				 function,
+				 segment_number );
 
-				return( -1 );
+				goto on_error;
 			}
 		}
-		if( libewf_segment_table_get_segment_file_by_index(
+		/* Indexed segment files do not need to be scanned
+		 */
+		if( result != 0 )
+		{
+			continue;
+		}
+		if( libewf_segment_table_get_segment_by_index(
 		     internal_handle->segment_table,
 		     segment_number,
-		     file_io_pool,
-		     &segment_file,
+		     &file_io_pool_entry,
+		     &segment_file_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
 			 segment_number );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( segment_file == NULL )
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
 			 function,
-			 segment_number );
+			 file_io_pool_entry );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
+		/* File IO handles that cannot be cloned are not scanned
+		 */
+		if( libbfio_handle_clone(
+		     &scan_file_io_handle,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+
+			continue;
+		}
+		segment_file_scan = &( segment_file_scans[ number_of_segment_file_scans ] );
+
+		if( libbfio_pool_initialize(
+		     &( segment_file_scan->file_io_pool ),
+		     1,
+		     LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create scan file IO pool.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( segment_file->segment_number == 1 )
+		if( libbfio_pool_set_handle(
+		     segment_file_scan->file_io_pool,
+		     0,
+		     scan_file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
 		{
-			internal_handle->io_handle->segment_file_type  = segment_file->type;
-			internal_handle->io_handle->major_version      = segment_file->major_version;
-			internal_handle->io_handle->minor_version      = segment_file->minor_version;
-			internal_handle->io_handle->compression_method = segment_file->compression_method;
-
-			if( segment_file->major_version == 2 )
-			{
-				if( memory_copy(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy segment file set identifier to media values.",
-					 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set file IO handle: %d in scan file IO pool.",
+			 function,
+			 file_io_pool_entry );
 
-					return( -1 );
-				}
-			}
+			goto on_error;
 		}
-		else
-		{
-			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
-			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: segment file format version value mismatch.",
-				 function );
+		scan_file_io_handle = NULL;
 
-				return( -1 );
-			}
-			if( internal_handle->io_handle->major_version == 2 )
-			{
-				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file compression method value mismatch.",
-					 function );
+		segment_file_scan->file_io_pool_entry = file_io_pool_entry;
+		segment_file_scan->segment_file_size  = segment_file_size;
+		segment_file_scan->segment_number     = segment_number;
 
-					return( -1 );
-				}
-				if( memory_compare(
-				     internal_handle->media_values->set_identifier,
-				     segment_file->set_identifier,
-				     16 ) != 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_INPUT,
-					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-					 "%s: segment file set identifier value mismatch.",
-					 function );
+		number_of_segment_file_scans++;
+	}
+	/* Indexed segment files and file IO handles that cannot be cloned
+	 * can leave a single segment file to scan
+	 */
+	if( number_of_segment_file_scans > 1 )
+	{
+		number_of_threads = internal_handle->number_of_scan_threads;
 
-					return( -1 );
-				}
-			}
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		if( (uint32_t) number_of_threads > number_of_segment_file_scans )
 		{
-			last_segment_file = 1;
+			number_of_threads = (int) number_of_segment_file_scans;
 		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+		if( libcthreads_thread_pool_create(
+		     &scan_thread_pool,
+		     NULL,
+		     number_of_threads,
+		     (int) number_of_segment_file_scans,
+		     (int (*)(intptr_t *, void *)) &libewf_internal_handle_scan_segment_file,
+		     (void *) internal_handle,
+		     error ) != 1 )
 		{
-/* TODO get key info */
-			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
-			internal_handle->io_handle->is_encrypted = 1;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create scan thread pool.",
+			 function );
+
+			goto on_error;
 		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		for( scan_index = 0;
+		     scan_index < number_of_segment_file_scans;
+		     scan_index++ )
 		{
-			internal_handle->segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+			if( libcthreads_thread_pool_push(
+			     scan_thread_pool,
+			     (intptr_t *) &( segment_file_scans[ scan_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push segment file scan: %" PRIu32 " onto scan thread pool.",
+				 function,
+				 scan_index );
+
+				goto on_error;
+			}
 		}
-		if( libewf_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
+		if( libcthreads_thread_pool_join(
+		     &scan_thread_pool,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join scan thread pool.",
+			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		if( libewf_segment_table_set_segment_storage_media_size_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     segment_file->storage_media_size,
+		for( scan_index = 0;
+		     scan_index < number_of_segment_file_scans;
+		     scan_index++ )
+		{
+			segment_file_scan = &( segment_file_scans[ scan_index ] );
+
+			if( segment_file_scan->segment_file == NULL )
+			{
+				continue;
+			}
+			/* The sections list refers to the entry of the private file IO pool
+			 */
+			if( libewf_segment_file_set_sections_file_io_pool_entry(
+			     segment_file_scan->segment_file,
+			     segment_file_scan->file_io_pool_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set file IO pool entry of segment file: %" PRIu32 ".",
+				 function,
+				 segment_file_scan->segment_number );
+
+				goto on_error;
+			}
+			if( libewf_segment_table_set_segment_file_by_index(
+			     internal_handle->segment_table,
+			     file_io_pool,
+			     segment_file_scan->segment_number,
+			     segment_file_scan->segment_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment file: %" PRIu32 " in segment table.",
+				 function,
+				 segment_file_scan->segment_number );
+
+				goto on_error;
+			}
+			segment_file_scan->segment_file = NULL;
+		}
+	}
+	for( scan_index = 0;
+	     scan_index < number_of_segment_file_scans;
+	     scan_index++ )
+	{
+		if( libbfio_pool_free(
+		     &( segment_file_scans[ scan_index ].file_io_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free scan file IO pool: %" PRIu32 ".",
 			 function,
-			 segment_number );
+			 scan_index );
 
-			return( -1 );
+			goto on_error;
 		}
-		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
-		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
-	if( last_segment_file == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
-		 function );
+	memory_free(
+	 segment_file_scans );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+	return( 1 );
+
+on_error:
+	if( scan_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &scan_thread_pool,
+		 NULL );
+	}
+	if( scan_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &scan_file_io_handle,
+		 NULL );
+	}
+	if( segment_file_scans != NULL )
+	{
+		for( scan_index = 0;
+		     scan_index < number_of_segments;
+		     scan_index++ )
 		{
-			if( ( error != NULL )
-			 && ( *error != NULL ) )
+			segment_file_scan = &( segment_file_scans[ scan_index ] );
+
+			if( segment_file_scan->segment_file != NULL )
 			{
-				libcnotify_print_error_backtrace(
-				 *error );
+				libewf_segment_file_free(
+				 &( segment_file_scan->segment_file ),
+				 NULL );
+			}
+			if( segment_file_scan->file_io_pool != NULL )
+			{
+				libbfio_pool_free(
+				 &( segment_file_scan->file_io_pool ),
+				 NULL );
 			}
 		}
-#endif
-		libcerror_error_free(
-		 error );
-
-		internal_handle->segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		memory_free(
+		 segment_file_scans );
 	}
-	return( 1 );
+	return( -1 );
 }
 
-/* Reads the section data from a delta segment file
+#endif
+
+/* Opens the segment files for reading
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_read_delta_segment_file_section_data(
+int libewf_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
-     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	libewf_section_t *section         = NULL;
-	libfcache_cache_t *sections_cache = NULL;
-	static char *function             = "libewf_handle_open_read_delta_segment_file_section_data";
-	off64_t section_data_offset       = 0;
-	off64_t storage_media_offset      = 0;
-	ssize_t read_count                = 0;
-	uint32_t delta_chunk_index        = 0;
-	uint32_t delta_chunk_size         = 0;
-	int number_of_sections            = 0;
-	int section_index                 = 0;
-
-#if defined( HAVE_VERBOSE_OUTPUT )
-	int known_section                 = 0;
+	libewf_index_segment_t *index_segment          = NULL;
+	libewf_segment_file_t *segment_file            = NULL;
+	static char *function                          = "libewf_handle_open_read_segment_files";
+	size64_t maximum_segment_size                  = 0;
+	size64_t segment_file_size                     = 0;
+	uint32_t maximum_number_of_chunk_group_entries = 0;
+	uint32_t number_of_segments                    = 0;
+	uint32_t segment_number                        = 0;
+	int file_io_pool_entry                         = 0;
+	int last_segment_file                          = 0;
+	int result                                     = 0;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	uint32_t number_of_scan_segments               = 0;
+	uint32_t scan_segment_number                   = 0;
 #endif
 
 	if( internal_handle == NULL )
@@ -4094,267 +6041,536 @@ int libewf_handle_open_read_delta_segment_file_section_data(
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->read_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
-
-		return( -1 );
-	}
-	if( segment_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - missing read IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfcache_cache_initialize(
-	     &sections_cache,
-	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from segment table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_list_get_number_of_elements(
-	     segment_file->sections_list,
-	     &number_of_sections,
-	     error ) != 1 )
+	if( number_of_segments == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of sections in the sections list.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	for( section_index = 0;
-	     section_index < number_of_sections;
-	     section_index++ )
+	internal_handle->maximum_number_of_chunk_group_entries = 0;
+
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
 	{
-		if( libfdata_list_get_element_value_by_index(
-		     segment_file->sections_list,
-		     (intptr_t *) file_io_pool,
-		     sections_cache,
-		     section_index,
-		     (intptr_t **) &section,
-		     0,
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve section: %d from sections list.",
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
 			 function,
-			 section_index );
+			 segment_number );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( section == NULL )
+		if( ( segment_number == 0 )
+		 && ( number_of_segments > 1 ) )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing section: %d.",
-			 function,
-			 section_index );
+			/* Round the maximum segment size to nearest number of KiB
+			 */
+			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
 
-			goto on_error;
+			if( libewf_segment_table_set_maximum_segment_size(
+			     internal_handle->segment_table,
+			     maximum_segment_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum segment size in segment table.",
+				 function );
+
+				return( -1 );
+			}
 		}
-		if( section->data_size != 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The first segment file is read before the other segment files are scanned
+		 * since it determines the segment file type. The segment files are scanned
+		 * in batches that fit in the segment files cache of the segment table
+		 */
+		if( ( internal_handle->number_of_scan_threads > 0 )
+		 && ( segment_number > 0 )
+		 && ( segment_number >= scan_segment_number ) )
 		{
-			section_data_offset = section->start_offset + sizeof( ewf_section_descriptor_v1_t );
+			number_of_scan_segments = number_of_segments - segment_number;
 
-			if( libewf_segment_file_seek_offset(
-			     segment_file,
+			if( number_of_scan_segments > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES )
+			{
+				number_of_scan_segments = LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES;
+			}
+			if( libewf_internal_handle_scan_segment_files(
+			     internal_handle,
 			     file_io_pool,
-			     file_io_pool_entry,
-			     section_data_offset,
-			     error ) == -1 )
+			     segment_number,
+			     number_of_scan_segments,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to scan segment files: %" PRIu32 " to %" PRIu32 ".",
 				 function,
-				 section_index,
-				 section_data_offset );
+				 segment_number,
+				 segment_number + number_of_scan_segments - 1 );
 
-				goto on_error;
+				return( -1 );
 			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			scan_segment_number = segment_number + number_of_scan_segments;
+		}
+#endif
+		index_segment = NULL;
+		result        = 0;
+
+		/* The first segment file is always read to validate the media values of the index file
+		 */
+		if( ( internal_handle->index_file != NULL )
+		 && ( segment_number > 0 ) )
+		{
+			result = libewf_index_file_get_segment_by_index(
+			          internal_handle->index_file,
+			          segment_number,
+			          &index_segment,
+			          error );
+
+			if( result == -1 )
 			{
-				libcnotify_printf(
-				 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
 				 function,
-				 (char *) section->type_string,
-				 file_io_pool_entry,
-				 segment_file->current_offset,
-				 segment_file->current_offset );
+				 segment_number );
+
+				return( -1 );
 			}
-#endif
 		}
-		if( section->type != 0 )
+		if( result != 0 )
 		{
-			switch( section->type )
+			/* A segment file that does not match the index segment is read as if it was not indexed
+			 */
+			result = libewf_handle_open_read_indexed_segment_file(
+			          internal_handle,
+			          file_io_pool,
+			          file_io_pool_entry,
+			          segment_number,
+			          index_segment,
+			          error );
+
+			if( result == -1 )
 			{
-				case LIBEWF_SECTION_TYPE_NEXT:
-					/* Nothing to do for the next section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read indexed segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
 
-				case LIBEWF_SECTION_TYPE_DONE:
-					/* Nothing to do for the done section
-					 */
-#if defined( HAVE_VERBOSE_OUTPUT )
-					known_section = 1;
-#endif
-					break;
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				index_segment = NULL;
 			}
 		}
-		else if( section->type_string_length == 11 )
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
 		{
-			if( memory_compare(
-			     (void *) section->type_string,
-			     (void *) "delta_chunk",
-			     11 ) == 0 )
-			{
-				read_count = libewf_segment_file_read_delta_chunk_section(
-					      segment_file,
-					      section,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      &delta_chunk_index,
-					      &delta_chunk_size,
-					      error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
 
-				if( read_count == -1 )
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number == 1 )
+		{
+			internal_handle->io_handle->segment_file_type  = segment_file->type;
+			internal_handle->io_handle->major_version      = segment_file->major_version;
+			internal_handle->io_handle->minor_version      = segment_file->minor_version;
+			internal_handle->io_handle->compression_method = segment_file->compression_method;
+
+			if( segment_file->major_version == 2 )
+			{
+				if( memory_copy(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) == NULL )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: %s.",
-					 function,
-					 (char *) section->type_string );
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy segment file set identifier to media values.",
+					 function );
 
-					goto on_error;
+					return( -1 );
 				}
-#if defined( HAVE_VERBOSE_OUTPUT )
-				known_section = 1;
-#endif
-				storage_media_offset = (size64_t) delta_chunk_index * internal_handle->media_values->chunk_size;
-
-				if( libfdata_range_list_insert_element(
-				     internal_handle->delta_chunks_range_list,
-				     storage_media_offset,
-				     (size64_t) delta_chunk_size,
-				     file_io_pool_entry,
-				     segment_file->current_offset,
-				     (size64_t) delta_chunk_size,
-				     LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+			}
+		}
+		else
+		{
+			if( ( segment_file->major_version != internal_handle->io_handle->major_version )
+			 || ( segment_file->minor_version != internal_handle->io_handle->minor_version ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: segment file format version value mismatch.",
+				 function );
+
+				return( -1 );
+			}
+			if( internal_handle->io_handle->major_version == 2 )
+			{
+				if( segment_file->compression_method != internal_handle->io_handle->compression_method )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file compression method value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+				if( memory_compare(
+				     internal_handle->media_values->set_identifier,
+				     segment_file->set_identifier,
+				     16 ) != 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_INPUT,
+					 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+					 "%s: segment file set identifier value mismatch.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		{
+			last_segment_file = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED ) != 0 )
+		{
+/* TODO get key info */
+			internal_handle->io_handle->format       = LIBEWF_FORMAT_V2_ENCASE7;
+			internal_handle->io_handle->is_encrypted = 1;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			internal_handle->segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( ( internal_handle->index_file != NULL )
+		 && ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 ) )
+		{
+			if( libewf_index_segment_initialize(
+			     &index_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create index segment: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
+		if( libewf_handle_open_read_segment_file_section_data(
+		     internal_handle,
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			goto on_error;
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) != 0 )
+		{
+			/* The table sections of an indexed segment file are not read
+			 * hence the chunk group values are updated here
+			 */
+			internal_handle->chunk_group->last_chunk_filled         += (int) segment_file->number_of_chunks;
+			internal_handle->chunk_group->previous_last_chunk_filled = internal_handle->chunk_group->last_chunk_filled;
+			internal_handle->chunk_group->last_chunk_compared        = internal_handle->chunk_group->last_chunk_filled;
+		}
+		else if( index_segment != NULL )
+		{
+			if( libewf_index_segment_set_segment_file_values(
+			     index_segment,
+			     segment_file,
+			     segment_file_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set index segment: %" PRIu32 " values.",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			if( libewf_index_segment_read_packed_chunk_groups(
+			     index_segment,
+			     segment_file,
+			     file_io_pool,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read packed chunk groups of index segment: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
+			if( segment_number == 0 )
+			{
+				if( libewf_index_file_set_media_values(
+				     internal_handle->index_file,
+				     internal_handle->io_handle,
+				     internal_handle->media_values,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-					 "%s: unable to insert chunk: %" PRIu32 " in delta chunks range list.",
-					 function,
-					 delta_chunk_index );
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set media values in index file.",
+					 function );
 
 					goto on_error;
 				}
 			}
+			if( libewf_index_file_set_segment_by_index(
+			     internal_handle->index_file,
+			     segment_number,
+			     index_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set segment: %" PRIu32 " in index file.",
+				 function,
+				 segment_number );
+
+				goto on_error;
+			}
 		}
-#if defined( HAVE_VERBOSE_OUTPUT )
-		if( libcnotify_verbose != 0 )
+		index_segment = NULL;
+
+		if( ( segment_file->number_of_chunks > 0 )
+		 && ( internal_handle->media_values->chunk_size != 0 ) )
 		{
-			if( known_section == 0 )
+			if( libewf_segment_file_get_maximum_number_of_chunk_group_entries(
+			     segment_file,
+			     internal_handle->media_values->chunk_size,
+			     &maximum_number_of_chunk_group_entries,
+			     error ) != 1 )
 			{
-				libcnotify_printf(
-				 "%s: unsupported section type: %s.\n",
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve maximum number of chunk group entries of segment file: %" PRIu32 ".",
 				 function,
-				 (char *) section->type_string );
+				 segment_number );
+
+				return( -1 );
+			}
+			if( maximum_number_of_chunk_group_entries > internal_handle->maximum_number_of_chunk_group_entries )
+			{
+				internal_handle->maximum_number_of_chunk_group_entries = maximum_number_of_chunk_group_entries;
 			}
 		}
-#endif
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to set mapped range of element: %" PRIu32 " in segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->read_io_handle->storage_media_size_read += segment_file->storage_media_size;
+		internal_handle->read_io_handle->number_of_chunks_read   += segment_file->number_of_chunks;
 	}
-	if( libfcache_cache_free(
-	     &sections_cache,
-	     error ) != 1 )
+	if( last_segment_file == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sections cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
 		 function );
 
-		goto on_error;
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( ( error != NULL )
+			 && ( *error != NULL ) )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+			}
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		internal_handle->segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
 	}
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
+	if( ( index_segment != NULL )
+	 && ( segment_file != NULL )
+	 && ( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED ) == 0 ) )
 	{
-		libfcache_cache_free(
-		 &sections_cache,
+		libewf_index_segment_free(
+		 &index_segment,
 		 NULL );
 	}
 	return( -1 );
 }
 
-/* Opens the delta segment files for reading
+/* Reads the section data from a delta segment file
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_open_read_delta_segment_files(
+int libewf_handle_open_read_delta_segment_file_section_data(
      libewf_internal_handle_t *internal_handle,
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
      libcerror_error_t **error )
 {
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_handle_open_read_delta_segment_files";
-	size64_t maximum_segment_size       = 0;
-	size64_t segment_file_size          = 0;
-	uint32_t number_of_segments         = 0;
-	uint32_t segment_number             = 0;
-	int file_io_pool_entry              = 0;
-	int last_segment_file               = 0;
+	libewf_section_t *section         = NULL;
+	libfcache_cache_t *sections_cache = NULL;
+	static char *function             = "libewf_handle_open_read_delta_segment_file_section_data";
+	off64_t section_data_offset       = 0;
+	off64_t storage_media_offset      = 0;
+	ssize_t read_count                = 0;
+	uint32_t delta_chunk_index        = 0;
+	uint32_t delta_chunk_size         = 0;
+	int number_of_sections            = 0;
+	int section_index                 = 0;
+
+#if defined( HAVE_VERBOSE_OUTPUT )
+	int known_section                 = 0;
+#endif
 
 	if( internal_handle == NULL )
 	{
@@ -4367,798 +6583,1353 @@ int libewf_handle_open_read_delta_segment_files(
 
 		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->delta_segment_table,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments from delta segment table.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	/* Return if no delta segment files were found
-	 */
-	if( number_of_segments == 0 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
-		return( 1 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
 	}
-	for( segment_number = 0;
-	     segment_number < number_of_segments;
-	     segment_number++ )
-	{
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->delta_segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from delta segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( ( segment_number == 0 )
-		 && ( number_of_segments > 1 ) )
-		{
-			/* Round the maximum segment size to nearest number of KiB
-			 */
-			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
-
-			if( libewf_segment_table_set_maximum_segment_size(
-			     internal_handle->delta_segment_table,
-			     maximum_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-				 "%s: unable to set maximum segment size in delta segment table.",
-				 function );
-
-				return( -1 );
-			}
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->delta_segment_table,
-		     segment_number,
-		     file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from delta segment table.",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-		if( segment_file->segment_number != ( segment_number + 1 ) )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_INPUT,
-			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
-			 function,
-			 segment_file->segment_number,
-			 segment_number + 1 );
-
-			return( -1 );
-		}
-		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
-		{
-			last_segment_file = 1;
-		}
-/* TODO use this function for now ? */
-		if( libewf_handle_open_read_segment_file_section_data(
-		     internal_handle,
-		     segment_file,
-		     file_io_pool,
-		     file_io_pool_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read section data from segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
-
-			return( -1 );
-		}
-	}
-	if( last_segment_file == 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing done section.",
-		 function );
-
-		return( -1 );
-	}
-	return( 1 );
-}
-
-/* Closes the EWF handle
- * Returns 0 if successful or -1 on error
- */
-int libewf_handle_close(
-     libewf_handle_t *handle,
-     libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_close";
-	ssize_t write_count                       = 0;
-	int result                                = 0;
-
-	if( handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( ( internal_handle->write_io_handle != NULL )
-	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
-	{
-		write_count = libewf_handle_write_finalize(
-		               handle,
-		               error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to finalize write.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( internal_handle->file_io_pool_created_in_library != 0 )
-	{
-		if( libbfio_pool_close_all(
-		     internal_handle->file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all file IO pool handles.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO pool.",
-			 function );
-
-			result = -1;
-		}
-		internal_handle->file_io_pool_created_in_library = 0;
-	}
-	internal_handle->file_io_pool = NULL;
-
-	if( libewf_io_handle_clear(
-	     internal_handle->io_handle,
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections cache.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libewf_media_values_clear(
-	     internal_handle->media_values,
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear media values.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of sections in the sections list.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_handle->read_io_handle != NULL )
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
 	{
-		if( libewf_read_io_handle_free(
-		     &( internal_handle->read_io_handle ),
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     sections_cache,
+		     section_index,
+		     (intptr_t **) &section,
+		     0,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free read IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->write_io_handle != NULL )
-	{
-		if( libewf_write_io_handle_free(
-		     &( internal_handle->write_io_handle ),
-		     error ) != 1 )
+		if( section == NULL )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free write IO handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 section_index );
 
-			result = -1;
+			goto on_error;
 		}
-	}
-	if( internal_handle->segment_table != NULL )
-	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->segment_table ),
-		     error ) != 1 )
+		if( section->data_size != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free segment table.",
-			 function );
+			section_data_offset = section->start_offset + sizeof( ewf_section_descriptor_v1_t );
 
-			result = -1;
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: reading %s section data from file IO pool entry: %d at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+				 function,
+				 (char *) section->type_string,
+				 file_io_pool_entry,
+				 segment_file->current_offset,
+				 segment_file->current_offset );
+			}
+#endif
 		}
-	}
-	if( internal_handle->delta_segment_table != NULL )
-	{
-		if( libewf_segment_table_free(
-		     &( internal_handle->delta_segment_table ),
-		     error ) != 1 )
+		if( section->type != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free delta segment table.",
-			 function );
+			switch( section->type )
+			{
+				case LIBEWF_SECTION_TYPE_NEXT:
+					/* Nothing to do for the next section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
 
-			result = -1;
+				case LIBEWF_SECTION_TYPE_DONE:
+					/* Nothing to do for the done section
+					 */
+#if defined( HAVE_VERBOSE_OUTPUT )
+					known_section = 1;
+#endif
+					break;
+			}
 		}
-	}
-	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
-	 */
-	if( internal_handle->chunk_data != NULL )
-	{
-		if( libewf_chunk_data_free(
-		     &( internal_handle->chunk_data ),
-		     error ) != 1 )
+		else if( section->type_string_length == 11 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk data.",
-			 function );
+			if( memory_compare(
+			     (void *) section->type_string,
+			     (void *) "delta_chunk",
+			     11 ) == 0 )
+			{
+				read_count = libewf_segment_file_read_delta_chunk_section(
+					      segment_file,
+					      section,
+					      file_io_pool,
+					      file_io_pool_entry,
+					      &delta_chunk_index,
+					      &delta_chunk_size,
+					      error );
 
-			result = -1;
+				if( read_count == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read section: %s.",
+					 function,
+					 (char *) section->type_string );
+
+					goto on_error;
+				}
+#if defined( HAVE_VERBOSE_OUTPUT )
+				known_section = 1;
+#endif
+				storage_media_offset = (size64_t) delta_chunk_index * internal_handle->media_values->chunk_size;
+
+				if( libfdata_range_list_insert_element(
+				     internal_handle->delta_chunks_range_list,
+				     storage_media_offset,
+				     (size64_t) delta_chunk_size,
+				     file_io_pool_entry,
+				     segment_file->current_offset,
+				     (size64_t) delta_chunk_size,
+				     LIBEWF_RANGE_FLAG_HAS_CHECKSUM,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to insert chunk: %" PRIu32 " in delta chunks range list.",
+					 function,
+					 delta_chunk_index );
+
+					goto on_error;
+				}
+			}
+		}
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			if( known_section == 0 )
+			{
+				libcnotify_printf(
+				 "%s: unsupported section type: %s.\n",
+				 function,
+				 (char *) section->type_string );
+			}
 		}
+#endif
 	}
-	if( internal_handle->chunk_table != NULL )
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
 	{
-		if( libewf_chunk_table_free(
-		     &( internal_handle->chunk_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk table.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_handle->delta_chunks_range_list != NULL )
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
 	{
-		if( libfdata_range_list_free(
-		     &( internal_handle->delta_chunks_range_list ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free delta chunks range list.",
-			 function );
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
 
-			result = -1;
-		}
+/* Opens the delta segment files for reading
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_open_read_delta_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_handle_open_read_delta_segment_files";
+	size64_t maximum_segment_size       = 0;
+	size64_t segment_file_size          = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int file_io_pool_entry              = 0;
+	int last_segment_file               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->chunk_groups_cache != NULL )
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->delta_segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
 	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunk_groups_cache ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments from delta segment table.",
+		 function );
+
+		return( -1 );
+	}
+	/* Return if no delta segment files were found
+	 */
+	if( number_of_segments == 0 )
+	{
+		return( 1 );
+	}
+	for( segment_number = 0;
+	     segment_number < number_of_segments;
+	     segment_number++ )
+	{
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->delta_segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk groups cache.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from delta segment table.",
+			 function,
+			 segment_number );
 
-			result = -1;
+			return( -1 );
+		}
+		if( ( segment_number == 0 )
+		 && ( number_of_segments > 1 ) )
+		{
+			/* Round the maximum segment size to nearest number of KiB
+			 */
+			maximum_segment_size = ( segment_file_size >> 10 ) << 10;
+
+			if( libewf_segment_table_set_maximum_segment_size(
+			     internal_handle->delta_segment_table,
+			     maximum_segment_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum segment size in delta segment table.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->delta_segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from delta segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_LAST ) != 0 )
+		{
+			last_segment_file = 1;
+		}
+/* TODO use this function for now ? */
+		if( libewf_handle_open_read_segment_file_section_data(
+		     internal_handle,
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read section data from segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
 		}
 	}
-	if( internal_handle->chunks_cache != NULL )
+	if( last_segment_file == 0 )
 	{
-		if( libfcache_cache_free(
-		     &( internal_handle->chunks_cache ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing done section.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_internal_handle_close(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_close";
+	ssize_t write_count       = 0;
+	int result                = 0;
+	int number_of_chunk_views = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_get_number_of_chunk_views(
+	     internal_handle,
+	     &number_of_chunk_views,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk views.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_views > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk views have not been freed.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( internal_handle->read_ahead_thread_pool != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunks cache.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
 			 function );
 
-			result = -1;
+			return( -1 );
 		}
-	}
-	if( internal_handle->chunk_group != NULL )
-	{
-		if( libewf_chunk_group_free(
-		     &( internal_handle->chunk_group ),
+		/* Chunks that are still queued are not read ahead
+		 */
+		internal_handle->read_ahead_abort = 1;
+
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->read_ahead_thread_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk group.",
+			 "%s: unable to join read-ahead thread pool.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->hash_sections != NULL )
+	if( internal_handle->compression_thread_pool != NULL )
 	{
-		if( libewf_hash_sections_free(
-		     &( internal_handle->hash_sections ),
+		/* The queued chunks are written before the compression threads are stopped
+		 */
+		if( ( internal_handle->write_io_handle != NULL )
+		 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
+		{
+			if( libewf_internal_handle_write_packed_chunks(
+			     internal_handle,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write packed chunks.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libewf_internal_handle_free_compression_thread_pool(
+		     internal_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash sections.",
+			 "%s: unable to free compression thread pool.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->header_values != NULL )
+	if( internal_handle->compression_contexts != NULL )
 	{
-		if( libfvalue_table_free(
-		     &( internal_handle->header_values ),
+		if( libcdata_array_free(
+		     &( internal_handle->compression_contexts ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_compression_context_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free header values.",
+			 "%s: unable to free pooled compression contexts array.",
 			 function );
 
 			result = -1;
 		}
 	}
-	if( internal_handle->hash_values != NULL )
+#endif
+	if( ( internal_handle->write_io_handle != NULL )
+	 && ( internal_handle->write_io_handle->write_finalized == 0 ) )
 	{
-		if( libfvalue_table_free(
-		     &( internal_handle->hash_values ),
-		     error ) != 1 )
+		write_count = libewf_internal_handle_write_finalize(
+		               internal_handle,
+		               error );
+
+		if( write_count < 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free hash values.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize write.",
 			 function );
 
+			/* The handle state is still freed when the write cannot be finalized
+			 */
 			result = -1;
 		}
 	}
-	if( internal_handle->single_files != NULL )
+	if( internal_handle->file_io_pool_created_in_library != 0 )
 	{
-		if( libewf_single_files_free(
-		     &( internal_handle->single_files ),
+		if( libbfio_pool_close_all(
+		     internal_handle->file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all file IO pool handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->file_io_pool ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free single files.",
+			 "%s: unable to free file IO pool.",
 			 function );
 
 			result = -1;
 		}
+		internal_handle->file_io_pool_created_in_library = 0;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->sessions,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	internal_handle->file_io_pool = NULL;
+
+	if( libewf_io_handle_clear(
+	     internal_handle->io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty sessions array.",
+		 "%s: unable to clear IO handle.",
 		 function );
 
 		result = -1;
 	}
-	if( libcdata_array_empty(
-	     internal_handle->tracks,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	if( libewf_media_values_clear(
+	     internal_handle->media_values,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty tracks array.",
+		 "%s: unable to clear media values.",
 		 function );
 
 		result = -1;
 	}
-	if( libcdata_range_list_empty(
-	     internal_handle->acquiry_errors,
-	     NULL,
-	     error ) != 1 )
+	if( internal_handle->read_io_handle != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to empty acquiry errors range list.",
-		 function );
+		if( libewf_read_io_handle_free(
+		     &( internal_handle->read_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read IO handle.",
+			 function );
 
-		result = -1;
+			result = -1;
+		}
 	}
-/* TODO clear IO handle, segment tables */
-	return( result );
-}
-
-/* Prepares chunk of (media) data after reading it according to the handle settings
- * It applies decompression if necessary and validates the chunk checksum
- * This function should be used after libewf_handle_read_chunk
- * The value chunk_buffer_size contains the size of the chunk
- * Returns the resulting chunk size or -1 on error
- */
-ssize_t libewf_handle_prepare_read_chunk(
-         libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         void *uncompressed_chunk_buffer,
-         size_t *uncompressed_chunk_buffer_size,
-         int8_t is_compressed,
-         uint32_t chunk_checksum,
-         int8_t chunk_io_flags,
-         libcerror_error_t **error )
-{
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_prepare_read_chunk";
-	uint32_t chunk_range_flags                = 0;
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libewf_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
 
-	if( handle == NULL )
+			result = -1;
+		}
+	}
+	if( internal_handle->segment_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
+		if( libewf_segment_table_free(
+		     &( internal_handle->segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segment table.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
+	if( internal_handle->delta_segment_table != NULL )
+	{
+		if( libewf_segment_table_free(
+		     &( internal_handle->delta_segment_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free delta segment table.",
+			 function );
 
-	if( internal_handle->io_handle == NULL )
+			result = -1;
+		}
+	}
+	/* Free the chunk data if it could not be passed to libfcache_cache_set_value_by_index
+	 */
+	if( internal_handle->chunk_data != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
+		if( libewf_chunk_data_free(
+		     &( internal_handle->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( internal_handle->media_values == NULL )
+	if( internal_handle->chunk_table != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		if( libewf_chunk_table_free(
+		     &( internal_handle->chunk_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk table.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( chunk_buffer == NULL )
+	if( internal_handle->delta_chunks_range_list != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
-		 function );
+		if( libfdata_range_list_free(
+		     &( internal_handle->delta_chunks_range_list ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free delta chunks range list.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( uncompressed_chunk_buffer_size == NULL )
+	if( internal_handle->chunk_groups_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid uncompressed chunk buffer size.",
-		 function );
+		if( libfcache_cache_free(
+		     &( internal_handle->chunk_groups_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk groups cache.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( ( chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_IS_PACKED ) != 0 )
+	if( internal_handle->chunks_cache != NULL )
 	{
-		if( is_compressed != 0 )
+		if( libfcache_cache_free(
+		     &( internal_handle->chunks_cache ),
+		     error ) != 1 )
 		{
-			chunk_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks cache.",
+			 function );
+
+			result = -1;
 		}
-		else
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_free(
+		     &( internal_handle->chunk_cache ),
+		     error ) != 1 )
 		{
-			chunk_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk cache.",
+			 function );
 
-			uncompressed_chunk_buffer       = chunk_buffer;
-			*uncompressed_chunk_buffer_size = chunk_buffer_size;
+			result = -1;
 		}
-		if( libewf_chunk_data_unpack_buffer(
-		     uncompressed_chunk_buffer,
-		     uncompressed_chunk_buffer_size,
-		     chunk_buffer,
-		     chunk_buffer_size,
-		     internal_handle->media_values->chunk_size,
-		     internal_handle->io_handle->compression_method,
-		     chunk_range_flags,
-		     chunk_checksum,
-		     chunk_io_flags,
+	}
+	if( internal_handle->chunk_group != NULL )
+	{
+		if( libewf_chunk_group_free(
+		     &( internal_handle->chunk_group ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to unpack chunk buffer.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk group.",
 			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		chunk_io_flags &= ~( LIBEWF_CHUNK_IO_FLAG_IS_PACKED );
 	}
-	else
+	/* The chunk buffer pool is freed after the caches, since freeing these
+	 * releases the chunk data buffers into the chunk buffer pool
+	 */
+	if( internal_handle->chunk_buffer_pool != NULL )
 	{
-		*uncompressed_chunk_buffer_size = chunk_buffer_size;
+		if( libewf_buffer_pool_free(
+		     &( internal_handle->chunk_buffer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk buffer pool.",
+			 function );
+
+			result = -1;
+		}
 	}
-	return( (ssize_t) *uncompressed_chunk_buffer_size );
-}
+	/* The mapped file pool is freed after the chunk table, since the chunk table references it
+	 */
+	if( internal_handle->mapped_file_pool != NULL )
+	{
+		if( libewf_mapped_file_pool_free(
+		     &( internal_handle->mapped_file_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mapped file pool.",
+			 function );
 
-/* Reads a chunk of (media) data from the current offset into a buffer
- * Will read until the requested size is filled or the entire chunk is read
- * The value chunk_checksum is set to a runtime version of the value in the checksum_buffer
- * and is used for uncompressed chunks only
- * The LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET chunk_io_flags is set if the checksum was read into checksum_buffer
- * otherwise the checksum is considered part of the data in the chunk buffer
- * The value chunk_buffer_size contains the size of the chunk buffer
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libewf_handle_read_chunk(
-         libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         int8_t *is_compressed,
-         void *checksum_buffer,
-         uint32_t *chunk_checksum,
-         int8_t *chunk_io_flags,
-         libcerror_error_t **error )
-{
-	libewf_chunk_data_t *chunk_data           = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	uint8_t *chunk_data_buffer                = NULL;
-	static char *function                     = "libewf_handle_read_chunk";
-	off64_t chunk_data_offset                 = 0;
-	size_t data_size                          = 0;
-	size_t read_size                          = 0;
-	uint64_t chunk_index                      = 0;
+			result = -1;
+		}
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		if( libewf_async_io_free(
+		     &( internal_handle->async_io ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free asynchronous IO.",
+			 function );
 
-	if( handle == NULL )
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_sections != NULL )
+	{
+		if( libewf_hash_sections_free(
+		     &( internal_handle->hash_sections ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash sections.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->header_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->header_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free header values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->hash_values != NULL )
+	{
+		if( libfvalue_table_free(
+		     &( internal_handle->hash_values ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free hash values.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->single_files != NULL )
+	{
+		if( libewf_single_files_free(
+		     &( internal_handle->single_files ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free single files.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->index_file != NULL )
+	{
+		if( libewf_index_file_free(
+		     &( internal_handle->index_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     internal_handle->sessions,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty sessions array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->chunk_data != NULL )
+	if( libcdata_array_empty(
+	     internal_handle->tracks,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_sector_range_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty tracks array.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libcdata_range_list_empty(
+	     internal_handle->acquiry_errors,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty acquiry errors range list.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->media_values == NULL )
+/* TODO clear IO handle, segment tables */
+	return( result );
+}
+
+/* Closes the EWF handle
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_handle_close(
+     libewf_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_close";
+	int result                                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer == NULL )
+#endif
+	result = libewf_internal_handle_close(
+	          internal_handle,
+	          error );
+
+	if( result != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( ( chunk_buffer_size == 0 )
-	 || ( chunk_buffer_size > (size_t) SSIZE_MAX ) )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid chunk buffer size value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( is_compressed == NULL )
+#endif
+	return( result );
+}
+
+/* Prepares chunk of (media) data after reading it according to the handle settings
+ * It applies decompression if necessary and validates the chunk checksum
+ * This function should be used after libewf_handle_read_chunk
+ * The value chunk_buffer_size contains the size of the chunk
+ * Returns the resulting chunk size or -1 on error
+ */
+ssize_t libewf_handle_prepare_read_chunk(
+         libewf_handle_t *handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         void *uncompressed_chunk_buffer,
+         size_t *uncompressed_chunk_buffer_size,
+         int8_t is_compressed,
+         uint32_t chunk_checksum,
+         int8_t chunk_io_flags,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_prepare_read_chunk";
+	uint32_t chunk_range_flags                = 0;
+
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid is compressed.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( checksum_buffer == NULL )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid checksum buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_checksum == NULL )
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk checksum.",
+		 "%s: invalid chunk buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_io_flags == NULL )
+	if( uncompressed_chunk_buffer_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk IO flags.",
+		 "%s: invalid uncompressed chunk buffer size.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	if( ( chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_IS_PACKED ) != 0 )
 	{
-		return( 0 );
+		if( is_compressed != 0 )
+		{
+			chunk_range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+		}
+		else
+		{
+			chunk_range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+
+			uncompressed_chunk_buffer       = chunk_buffer;
+			*uncompressed_chunk_buffer_size = chunk_buffer_size;
+		}
+		if( libewf_chunk_data_unpack_buffer(
+		     uncompressed_chunk_buffer,
+		     uncompressed_chunk_buffer_size,
+		     chunk_buffer,
+		     chunk_buffer_size,
+		     internal_handle->media_values->chunk_size,
+		     internal_handle->io_handle->compression_method,
+		     chunk_range_flags,
+		     chunk_checksum,
+		     chunk_io_flags,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk buffer.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_io_flags &= ~( LIBEWF_CHUNK_IO_FLAG_IS_PACKED );
+	}
+	else
+	{
+		*uncompressed_chunk_buffer_size = chunk_buffer_size;
+	}
+	return( (ssize_t) *uncompressed_chunk_buffer_size );
+}
+
+/* Reads a chunk of (media) data from the current offset into a buffer
+ * Will read until the requested size is filled or the entire chunk is read
+ * The value chunk_checksum is set to a runtime version of the value in the checksum_buffer
+ * and is used for uncompressed chunks only
+ * The LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET chunk_io_flags is set if the checksum was read into checksum_buffer
+ * otherwise the checksum is considered part of the data in the chunk buffer
+ * The value chunk_buffer_size contains the size of the chunk buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_chunk(
+         libewf_internal_handle_t *internal_handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         int8_t *is_compressed,
+         void *checksum_buffer,
+         uint32_t *chunk_checksum,
+         int8_t *chunk_io_flags,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	uint8_t *chunk_data_buffer      = NULL;
+	static char *function           = "libewf_internal_handle_read_chunk";
+	off64_t chunk_data_offset       = 0;
+	size_t data_size                = 0;
+	size_t read_size                = 0;
+	uint64_t chunk_index            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_buffer_size == 0 )
+	 || ( chunk_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_compressed == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is compressed.",
+		 function );
+
+		return( -1 );
+	}
+	if( checksum_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid checksum buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_checksum == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk checksum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_io_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk IO flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
 	}
 	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
 
@@ -5175,6 +7946,7 @@ ssize_t libewf_handle_read_chunk(
 	     internal_handle->current_offset,
 	     &chunk_data,
 	     &chunk_data_offset,
+	     internal_handle->compression_context,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -5272,10 +8044,31 @@ ssize_t libewf_handle_read_chunk(
 
 		return( -1 );
 	}
-	if( memory_copy(
-	     chunk_buffer,
-	     chunk_data_buffer,
-	     read_size ) == NULL )
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) != 0 )
+	{
+		if( libewf_chunk_data_fill_buffer(
+		     chunk_data->fill_pattern,
+		     8,
+		     0,
+		     (uint8_t *) chunk_buffer,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill chunk: %" PRIu64 " buffer.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	else if( memory_copy(
+	          chunk_buffer,
+	          chunk_data_buffer,
+	          read_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5304,23 +8097,28 @@ ssize_t libewf_handle_read_chunk(
 	return( (ssize_t) read_size );
 }
 
-/* Reads (media) data at the current offset into a buffer
+/* Reads a chunk of (media) data from the current offset into a buffer
+ * Will read until the requested size is filled or the entire chunk is read
+ * The value chunk_checksum is set to a runtime version of the value in the checksum_buffer
+ * and is used for uncompressed chunks only
+ * The LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET chunk_io_flags is set if the checksum was read into checksum_buffer
+ * otherwise the checksum is considered part of the data in the chunk buffer
+ * The value chunk_buffer_size contains the size of the chunk buffer
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libewf_handle_read_buffer(
+ssize_t libewf_handle_read_chunk(
          libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         int8_t *is_compressed,
+         void *checksum_buffer,
+         uint32_t *chunk_checksum,
+         int8_t *chunk_io_flags,
          libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data           = NULL;
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_read_buffer";
-	off64_t chunk_data_offset                 = 0;
-	uint64_t chunk_index                      = 0;
-	size_t buffer_offset                      = 0;
-	size_t read_size                          = 0;
-	ssize_t total_read_count                  = 0;
+	static char *function                     = "libewf_handle_read_chunk";
+	ssize_t read_count                        = 0;
 
 	if( handle == NULL )
 	{
@@ -5335,273 +8133,362 @@ ssize_t libewf_handle_read_buffer(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+#endif
+	read_count = libewf_internal_handle_read_chunk(
+	              internal_handle,
+	              chunk_buffer,
+	              chunk_buffer_size,
+	              is_compressed,
+	              checksum_buffer,
+	              chunk_checksum,
+	              chunk_io_flags,
+	              error );
+
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk.",
 		 function );
-
-		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data of a single chunk at a specific offset into a buffer
+ * If multi-threading is supported or the 2Q cache policy is used chunk data that still needs
+ * to be unpacked is not unpacked in the cache, instead a copy of the packed chunk data is returned
+ * in packed_chunk_data and 0 is returned, so that it can be unpacked without holding the chunk table mutex
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_from_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_chunk_data_t **packed_chunk_data,
+         off64_t *chunk_data_offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_read_buffer_from_chunk";
+	off64_t chunk_offset            = 0;
+	size_t chunk_data_size          = 0;
+	ssize_t read_count              = 0;
+	uint8_t copy_packed_chunk_data  = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( packed_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid packed chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( chunk_data_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size )
+	if( internal_handle->chunk_cache != NULL )
 	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		result = libewf_chunk_cache_get_chunk_data(
+		          internal_handle->chunk_cache,
+		          chunk_index,
+		          &chunk_data,
+		          error );
 
-	while( buffer_size > 0 )
-	{
-		if( libewf_chunk_table_get_chunk_data_by_offset(
-		     internal_handle->chunk_table,
-		     chunk_index,
-		     internal_handle->io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->delta_chunks_range_list,
-		     internal_handle->chunk_groups_cache,
-		     internal_handle->chunks_cache,
-		     internal_handle->current_offset,
-		     &chunk_data,
-		     &chunk_data_offset,
-		     error ) != 1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk cache.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		if( chunk_data == NULL )
+		else if( result != 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+			internal_handle->number_of_cache_hits += 1;
 
-			return( -1 );
+			*chunk_data_offset = offset - ( (off64_t) chunk_index * internal_handle->media_values->chunk_size );
 		}
-		if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_packed_chunk_data_by_offset(
+		          internal_handle->chunk_table,
+		          chunk_index,
+		          internal_handle->file_io_pool,
+		          internal_handle->segment_table,
+		          internal_handle->delta_chunks_range_list,
+		          internal_handle->chunk_groups_cache,
+		          internal_handle->chunks_cache,
+		          offset,
+		          &chunk_data,
+		          chunk_data_offset,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		read_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( chunk_data->data )[ chunk_data_offset ] ),
-		     read_size ) == NULL )
+		else if( result == 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
-			 function,
-			 chunk_index );
+			/* A missing chunk is read as zero bytes and marked as a checksum error
+			 */
+			chunk_offset    = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+			chunk_data_size = internal_handle->media_values->chunk_size;
 
-			return( -1 );
-		}
-		buffer_offset    += read_size;
-		buffer_size      -= read_size;
-		total_read_count += (ssize_t) read_size;
-		chunk_index      += 1;
+			if( (size64_t) ( chunk_offset + chunk_data_size ) > internal_handle->media_values->media_size )
+			{
+				chunk_data_size = (size_t) ( internal_handle->media_values->media_size - chunk_offset );
+			}
+			*chunk_data_offset = offset - chunk_offset;
+
+			if( ( *chunk_data_offset < 0 )
+			 || ( (size_t) *chunk_data_offset > chunk_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+				 function,
+				 chunk_index );
 
-		internal_handle->current_offset += (off64_t) read_size;
+				return( -1 );
+			}
+			read_count = (ssize_t) ( chunk_data_size - *chunk_data_offset );
 
-		if( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size )
-		{
-			break;
+			if( (size_t) read_count > buffer_size )
+			{
+				read_count = (ssize_t) buffer_size;
+			}
+			if( memory_set(
+			     buffer,
+			     0,
+			     (size_t) read_count ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear chunk: %" PRIu64 " data in buffer.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( libewf_chunk_table_append_chunk_checksum_error(
+			     internal_handle->chunk_table,
+			     internal_handle->media_values,
+			     chunk_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append checksum error.",
+				 function );
+
+				return( -1 );
+			}
+			return( read_count );
 		}
-		if( internal_handle->io_handle->abort != 0 )
+		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) == 0 )
 		{
-			break;
+			internal_handle->number_of_cache_hits += 1;
 		}
-		chunk_data        = NULL;
-		chunk_data_offset = 0;
-	}
-	return( total_read_count );
-}
+		else
+		{
+			internal_handle->number_of_cache_misses += 1;
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libewf_handle_read_buffer_at_offset(
-         libewf_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	static char *function = "libewf_handle_read_buffer_at_offset";
-	ssize_t read_count    = 0;
+			/* A copy of the packed chunk data is returned when the chunk data
+			 * is unpacked without holding the chunk table mutex
+			 * or when it is stored in the chunk cache
+			 */
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			copy_packed_chunk_data = 1;
+#else
+			copy_packed_chunk_data = (uint8_t) ( internal_handle->chunk_cache != NULL );
+#endif
+			if( copy_packed_chunk_data != 0 )
+			{
+				if( libewf_chunk_data_clone(
+				     packed_chunk_data,
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create packed chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
 
-	if( libewf_handle_seek_offset(
-	     handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+					return( -1 );
+				}
+				return( 0 );
+			}
+			if( libewf_chunk_table_unpack_chunk_data(
+			     internal_handle->chunk_table,
+			     chunk_index,
+			     internal_handle->io_handle,
+			     internal_handle->media_values,
+			     chunk_data,
+			     internal_handle->compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to unpack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
 
-		return( -1 );
+				return( -1 );
+			}
+			if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				if( libewf_chunk_table_append_chunk_checksum_error(
+				     internal_handle->chunk_table,
+				     internal_handle->media_values,
+				     offset - *chunk_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append checksum error.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
 	}
-	read_count = libewf_handle_read_buffer(
-	              handle,
+	read_count = libewf_chunk_data_read_buffer(
+	              chunk_data,
+	              *chunk_data_offset,
 	              buffer,
 	              buffer_size,
 	              error );
 
-	if( read_count < 0 )
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
 		return( -1 );
 	}
 	return( read_count );
 }
 
-/* Prepares a chunk of (media) data before writing according to the handle settings
- * This function should be used before libewf_handle_write_chunk
- * The chunk_buffer_size should contain the actual chunk size
- * The function sets the is_compressed, chunk_checksum and chunk_io_flags values
- * The LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET chunk_io_flags is set if the checksum was set in checksum_buffer
- * and needs to be written separately from the chunk data, in case of an uncompressed chunk
- * Returns the resulting chunk size or -1 on error
+/* Reads (media) data of a copy of packed chunk data at a specific offset into a buffer
+ * The chunk data is unpacked without holding the chunk table mutex and afterwards
+ * stored in the chunks cache or chunk cache, which takes over the management of the chunk data
+ * Returns the number of bytes read or -1 on error
  */
-ssize_t libewf_handle_prepare_write_chunk(
-         libewf_handle_t *handle,
-         void *chunk_buffer,
-         size_t chunk_buffer_size,
-         void *compressed_chunk_buffer,
-         size_t *compressed_chunk_buffer_size,
-         int8_t *is_compressed,
-         uint32_t *chunk_checksum,
-         int8_t *chunk_io_flags,
+ssize_t libewf_internal_handle_read_buffer_from_packed_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_chunk_data_t **packed_chunk_data,
+         off64_t chunk_data_offset,
          libcerror_error_t **error )
 {
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_prepare_write_chunk";
-	size_t chunk_padding_size                 = 0;
-	uint64_t chunk_index                      = 0;
-	uint64_t fill_pattern                     = 0;
-	uint32_t chunk_range_flags                = 0;
-	uint8_t compression_flags                 = 0;
-	uint8_t pack_flags                        = 0;
-	int8_t compression_level                  = LIBEWF_COMPRESSION_NONE;
-	int chunk_exists                          = 0;
-	int result                                = 0;
-
-/* TODO chunk data rewrite */
-	size_t compressed_chunk_buffer_offset     = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_internal_handle_read_buffer_from_packed_chunk";
+	ssize_t read_count                                = 0;
+	int result                                        = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5612,295 +8499,755 @@ ssize_t libewf_handle_prepare_write_chunk(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( packed_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( *packed_chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing packed chunk data.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk data is unpacked without holding the chunk table mutex
+	 * hence every reading thread needs its own compression context
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
-	{
+	result = libewf_internal_handle_get_compression_context(
+	          internal_handle,
+	          &compression_context,
+	          error );
+
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve compression context.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	compression_context = internal_handle->compression_context;
+#endif
+	if( libewf_chunk_table_unpack_chunk_data(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->io_handle,
+	     internal_handle->media_values,
+	     *packed_chunk_data,
+	     compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	read_count = libewf_chunk_data_read_buffer(
+	              *packed_chunk_data,
+	              chunk_data_offset,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_internal_handle_release_compression_context(
+	     internal_handle,
+	     &compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
+		 function );
+
+		libcthreads_mutex_release(
+		 internal_handle->chunk_table_mutex,
+		 NULL );
+
+		goto on_error;
+	}
+#endif
+	result = libewf_internal_handle_set_unpacked_chunk_data(
+	          internal_handle,
+	          chunk_index,
+	          offset - chunk_data_offset,
+	          packed_chunk_data,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer == NULL )
+#endif
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Reads the packed data of a chunk for reading the chunk directly into a buffer
+ * If the chunk is compressed the compressed data is read into the packed data, which is allocated
+ * on demand, otherwise the chunk data is read into the buffer and the checksum into chunk_checksum
+ * If the chunk is compressed and the segment file is memory mapped mapped_data is set to the compressed
+ * data in the mapping instead, which must be released using libewf_mapped_file_pool_release_data
+ * The chunk is not read if it is cached, stored in a delta segment file or does not fit the buffer
+ * If multi-threading is supported the chunk table mutex must be held
+ * Returns 1 if successful, 0 if the chunk cannot be read directly or -1 on error
+ */
+int libewf_internal_handle_read_packed_chunk_direct(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t **packed_data,
+     const uint8_t **mapped_data,
+     int *mapped_file_io_pool_entry,
+     size_t *read_size,
+     uint32_t *range_flags,
+     uint32_t *chunk_checksum,
+     libcerror_error_t **error )
+{
+	uint8_t checksum_data[ 4 ];
+
+	libewf_chunk_data_t *chunk_data      = NULL;
+	const uint8_t *compressed_data       = NULL;
+	uint8_t *read_buffer                 = NULL;
+	static char *function                = "libewf_internal_handle_read_packed_chunk_direct";
+	size64_t chunk_data_size             = 0;
+	off64_t chunk_data_offset            = 0;
+	size_t compressed_data_size          = 0;
+	size_t data_size                     = 0;
+	ssize_t read_count                   = 0;
+	uint32_t compressed_data_range_flags = 0;
+	int file_io_pool_entry               = 0;
+	int result                           = 0;
+	uint8_t is_mapped                    = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size > (size_t) SSIZE_MAX )
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed data.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size > (size_t) internal_handle->media_values->chunk_size )
+	if( mapped_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
-		 "%s: invalid chunk buffer size: %" PRIzd " value exceeds media values chunk size: %" PRIu32 ".",
-		 function,
-		 chunk_buffer_size,
-		 internal_handle->media_values->chunk_size );
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped data.",
+		 function );
 
 		return( -1 );
 	}
-	if( compressed_chunk_buffer_size == NULL )
+	if( mapped_file_io_pool_entry == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid compressed chunk buffer size.",
+		 "%s: invalid mapped file IO pool entry.",
 		 function );
 
 		return( -1 );
 	}
-	if( is_compressed == NULL )
+	if( read_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid is compressed.",
+		 "%s: invalid read size.",
 		 function );
 
 		return( -1 );
 	}
-	if( chunk_buffer_size == 0 )
+	if( range_flags == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
 	}
-	if( internal_handle->read_io_handle != NULL )
+	if( chunk_checksum == NULL )
 	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk checksum.",
+		 function );
 
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-		                internal_handle->chunk_table,
-		                chunk_index,
-		                internal_handle->file_io_pool,
-		                internal_handle->segment_table,
-		                internal_handle->chunk_groups_cache,
-		                internal_handle->current_offset,
-				error );
+		return( -1 );
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		result = libewf_chunk_cache_get_chunk_data(
+		          internal_handle->chunk_cache,
+		          chunk_index,
+		          &chunk_data,
+		          error );
 
-		if( chunk_exists == -1 )
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk cache.",
 			 function,
 			 chunk_index );
 
 			return( -1 );
 		}
-		else if( chunk_exists == 0 )
+		else if( result != 0 )
 		{
-			if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-			 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk: %" PRIu64 ".",
-				 function,
-				 chunk_index );
-
-				return( -1 );
-			}
+			return( 0 );
 		}
 	}
-	pack_flags = internal_handle->write_io_handle->pack_flags;
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->delta_chunks_range_list,
+	          internal_handle->chunk_groups_cache,
+	          offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          range_flags,
+	          error );
 
-	if( chunk_exists == 0 )
+	if( result == -1 )
 	{
-		compression_level = internal_handle->io_handle->compression_level;
-		compression_flags = internal_handle->io_handle->compression_flags;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
 
-		if( ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-		 || ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
+		return( -1 );
+	}
+	/* Missing chunks and chunks in delta segment files are read using the chunks cache
+	 */
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( *range_flags & LIBEWF_RANGE_FLAG_IS_DELTA ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( chunk_data_size == 0 )
+	 || ( chunk_data_size > (size64_t) internal_handle->media_values->chunk_size + 4 ) )
+	{
+		return( 0 );
+	}
+	result = libewf_chunk_table_chunk_data_is_cached(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->chunks_cache,
+	          file_io_pool_entry,
+	          chunk_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if chunk: %" PRIu64 " data is cached.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	data_size = (size_t) chunk_data_size;
+
+	if( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		if( *packed_data == NULL )
 		{
-			if( ( chunk_buffer_size % 8 ) == 0 )
+			if( internal_handle->chunk_buffer_pool != NULL )
 			{
-				result = libewf_chunk_data_check_for_64_bit_pattern_fill(
-				          chunk_buffer,
-				          chunk_buffer_size,
-					  &fill_pattern,
-					  error );
-
-				if( result == -1 )
+				if( libewf_buffer_pool_get_buffer(
+				     internal_handle->chunk_buffer_pool,
+				     packed_data,
+				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine if chunk data contains a fill pattern.",
+					 "%s: unable to retrieve packed data from buffer pool.",
 					 function );
 
 					return( -1 );
 				}
-				else if( result != 0 )
+			}
+			else
+			{
+				*packed_data = (uint8_t *) memory_allocate(
+				                            sizeof( uint8_t ) * ( internal_handle->media_values->chunk_size + 4 ) );
+
+				if( *packed_data == NULL )
 				{
-					if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
-					{
-						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-						pack_flags |= LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION;
-					}
-					else if( fill_pattern == 0 )
-					{
-						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
-					}
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create packed data.",
+					 function );
+
+					return( -1 );
 				}
 			}
-			else if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+		}
+		read_buffer = *packed_data;
+
+		if( internal_handle->chunk_table->compressed_chunk_cache != NULL )
+		{
+			result = libewf_compressed_chunk_cache_get_data(
+			          internal_handle->chunk_table->compressed_chunk_cache,
+			          chunk_index,
+			          &compressed_data,
+			          &compressed_data_size,
+			          &compressed_data_range_flags,
+			          error );
+
+			if( result == -1 )
 			{
-				result = libewf_chunk_data_check_for_empty_block(
-				          chunk_buffer,
-				          chunk_buffer_size,
-					  error );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data from compressed chunk cache.",
+				 function,
+				 chunk_index );
 
-				if( result == -1 )
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				if( compressed_data_size > (size_t) ( internal_handle->media_values->chunk_size + 4 ) )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to determine if chunk data is an empty block.",
-					 function );
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: invalid chunk: %" PRIu64 " compressed data size value out of bounds.",
+					 function,
+					 chunk_index );
 
 					return( -1 );
 				}
-				else if( result != 0 )
+				if( memory_copy(
+				     read_buffer,
+				     compressed_data,
+				     compressed_data_size ) == NULL )
 				{
-					if( *( (uint8_t *) chunk_buffer ) == 0 )
-					{
-						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
-						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
-						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
-					}
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy chunk: %" PRIu64 " compressed data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
 				}
+				data_size = compressed_data_size;
 			}
 		}
 	}
-	if( libewf_chunk_data_pack_buffer(
-	     chunk_buffer,
-	     chunk_buffer_size,
-	     compressed_chunk_buffer,
-	     &compressed_chunk_buffer_offset,
-	     compressed_chunk_buffer_size,
-	     internal_handle->media_values->chunk_size,
-	     chunk_buffer_size,
-	     &chunk_padding_size,
-	     internal_handle->io_handle->compression_method,
-	     compression_level,
-	     &chunk_range_flags,
-	     chunk_checksum,
-	     chunk_io_flags,
-	     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-	     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-	     pack_flags,
-	     error ) != 1 )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GENERIC,
-		 "%s: unable to pack chunk buffer.",
-		 function );
+		if( ( *range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+		{
+			if( data_size < 4 )
+			{
+				return( 0 );
+			}
+			data_size -= 4;
+		}
+		if( data_size > buffer_size )
+		{
+			return( 0 );
+		}
+		read_buffer = buffer;
+	}
+	if( ( result == 0 )
+	 && ( internal_handle->chunk_table->mapped_file_pool != NULL ) )
+	{
+		/* The compressed data of the chunk is unpacked directly from the memory mapped segment file
+		 */
+		if( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			result = libewf_mapped_file_pool_get_data(
+			          internal_handle->chunk_table->mapped_file_pool,
+			          internal_handle->file_io_pool,
+			          file_io_pool_entry,
+			          chunk_data_offset,
+			          data_size,
+			          mapped_data,
+			          error );
+
+			if( result == 1 )
+			{
+				*mapped_file_io_pool_entry = file_io_pool_entry;
+			}
+		}
+		else
+		{
+			result = libewf_mapped_file_pool_read_buffer(
+			          internal_handle->chunk_table->mapped_file_pool,
+			          internal_handle->file_io_pool,
+			          file_io_pool_entry,
+			          chunk_data_offset,
+			          read_buffer,
+			          data_size,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data from memory mapped file.",
+			 function,
+			 chunk_index );
 
-		return( -1 );
+			return( -1 );
+		}
+		is_mapped = (uint8_t) result;
 	}
-	if( ( chunk_range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	/* The data of the chunk was not retrieved from the compressed chunk cache
+	 * or a memory mapped segment file
+	 */
+	if( result == 0 )
 	{
-		*is_compressed = 1;
+		if( internal_handle->chunk_table->read_ahead_buffer != NULL )
+		{
+			read_count = libewf_read_ahead_buffer_read_buffer(
+			              internal_handle->chunk_table->read_ahead_buffer,
+			              internal_handle->file_io_pool,
+			              file_io_pool_entry,
+			              chunk_data_offset,
+			              read_buffer,
+			              data_size,
+			              error );
+		}
+		else
+		{
+			if( libbfio_pool_seek_offset(
+			     internal_handle->file_io_pool,
+			     file_io_pool_entry,
+			     chunk_data_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+				 function,
+				 chunk_data_offset,
+				 file_io_pool_entry );
+
+				return( -1 );
+			}
+			read_count = libbfio_pool_read_buffer(
+			              internal_handle->file_io_pool,
+			              file_io_pool_entry,
+			              read_buffer,
+			              data_size,
+			              error );
+		}
+		if( read_count != (ssize_t) data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( ( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		 && ( internal_handle->chunk_table->compressed_chunk_cache != NULL ) )
+		{
+			if( libewf_compressed_chunk_cache_set_data(
+			     internal_handle->chunk_table->compressed_chunk_cache,
+			     chunk_index,
+			     read_buffer,
+			     data_size,
+			     *range_flags,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data in compressed chunk cache.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
 	}
-	else
+	if( ( ( *range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	 && ( ( *range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 ) )
 	{
-		*is_compressed = 0;
+		/* If the chunk data was read from the memory mapped segment file
+		 * the file IO pool entry was not positioned after the chunk data
+		 */
+		if( is_mapped != 0 )
+		{
+			result = libewf_mapped_file_pool_read_buffer(
+			          internal_handle->chunk_table->mapped_file_pool,
+			          internal_handle->file_io_pool,
+			          file_io_pool_entry,
+			          chunk_data_offset + data_size,
+			          checksum_data,
+			          4,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 " checksum from memory mapped file.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			read_count = ( result != 0 ) ? 4 : 0;
+		}
+		else if( internal_handle->chunk_table->read_ahead_buffer != NULL )
+		{
+			read_count = libewf_read_ahead_buffer_read_buffer(
+			              internal_handle->chunk_table->read_ahead_buffer,
+			              internal_handle->file_io_pool,
+			              file_io_pool_entry,
+			              chunk_data_offset + data_size,
+			              checksum_data,
+			              4,
+			              error );
+		}
+		else
+		{
+			read_count = libbfio_pool_read_buffer(
+			              internal_handle->file_io_pool,
+			              file_io_pool_entry,
+			              checksum_data,
+			              4,
+			              error );
+		}
+		if( read_count != (ssize_t) 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " checksum.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 checksum_data,
+		 *chunk_checksum );
 	}
-	return( (ssize_t) *compressed_chunk_buffer_size );
+	*read_size    = data_size;
+	*range_flags &= ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	internal_handle->number_of_cache_misses += 1;
+
+	return( 1 );
 }
 
-/* Writes a chunk of (media) data in EWF format at the current offset
- * the necessary settings of the write values must have been made
- * chunk_buffer_size contains the size of the data within the buffer while
- * data_size contains the size of the actual input data
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Reads (media) data of a single chunk directly into a buffer, bypassing the chunk caches
+ * The chunk is only read directly if the offset is chunk-aligned and the buffer
+ * can contain the entire chunk, otherwise the chunk should be read using
+ * libewf_internal_handle_read_buffer_from_chunk
+ * The packed data is allocated on demand and can be reused for subsequent chunks
+ * Returns the number of bytes read, 0 if the chunk cannot be read directly or -1 on error
  */
-ssize_t libewf_handle_write_chunk(
-         libewf_handle_t *handle,
-         const void *chunk_buffer,
-         size_t chunk_buffer_size,
-         size_t data_size,
-         int8_t is_compressed,
-         void *checksum_buffer,
-         uint32_t chunk_checksum,
-         int8_t chunk_io_flags,
+ssize_t libewf_internal_handle_read_buffer_from_chunk_direct(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         uint8_t **packed_data,
          libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data           = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_chunk";
-	ssize_t write_count                       = 0;
-	uint64_t chunk_index                      = 0;
-	int chunk_exists                          = 0;
+	libewf_compression_context_t *compression_context = NULL;
+	const uint8_t *mapped_data                        = NULL;
+	static char *function                             = "libewf_internal_handle_read_buffer_from_chunk_direct";
+	size_t read_size                                  = 0;
+	ssize_t read_count                                = 0;
+	uint32_t chunk_checksum                           = 0;
+	uint32_t range_flags                              = 0;
+	int mapped_file_io_pool_entry                     = -1;
+	int result                                        = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -5911,8 +9258,6 @@ ssize_t libewf_handle_write_chunk(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
 	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -5924,354 +9269,407 @@ ssize_t libewf_handle_write_chunk(
 
 		return( -1 );
 	}
-	if( internal_handle->chunk_data != NULL )
+	if( internal_handle->media_values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( internal_handle->media_values->chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( ( ( offset % internal_handle->media_values->chunk_size ) != 0 )
+	 || ( buffer_size < (size_t) internal_handle->media_values->chunk_size ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#endif
+	result = libewf_internal_handle_read_packed_chunk_direct(
+	          internal_handle,
+	          chunk_index,
+	          offset,
+	          buffer,
+	          buffer_size,
+	          packed_data,
+	          &mapped_data,
+	          &mapped_file_io_pool_entry,
+	          &read_size,
+	          &range_flags,
+	          &chunk_checksum,
+	          error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk data is unpacked without holding the chunk table mutex
+	 * hence every reading thread needs its own compression context
+	 */
+	if( result == 1 )
+	{
+		result = libewf_internal_handle_get_compression_context(
+		          internal_handle,
+		          &compression_context,
+		          error );
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle == NULL )
+#else
+	compression_context = internal_handle->compression_context;
+#endif
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read packed chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_handle->write_io_handle->values_initialized == 0 )
+	else if( result == 0 )
 	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
+		return( 0 );
+	}
+	read_count = libewf_chunk_data_unpack_into_buffer(
+	              ( mapped_data != NULL ) ? mapped_data : *packed_data,
+	              read_size,
+	              buffer,
+	              ( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 ) ? buffer_size : read_size,
+	              internal_handle->media_values->chunk_size,
+	              internal_handle->io_handle->compression_method,
+	              &range_flags,
+	              chunk_checksum,
+	              compression_context,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( ( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	 && ( internal_handle->io_handle->zero_on_error != 0 ) )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     (size_t) read_count ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to zero chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
 
 			goto on_error;
 		}
 	}
-	if( chunk_buffer == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid chunk buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
 		goto on_error;
 	}
-#if SIZE_OF_SIZE_T > 4
-	if( chunk_buffer_size > (size_t) UINT32_MAX )
+	result = libewf_internal_handle_release_compression_context(
+	          internal_handle,
+	          &compression_context,
+	          error );
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression context.",
 		 function );
-
-		goto on_error;
 	}
 #endif
-	if( data_size > internal_handle->media_values->chunk_size )
+	if( ( result == 1 )
+	 && ( mapped_data != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: data size cannot be larger than maximum chunk size.",
-		 function );
+		result = libewf_mapped_file_pool_release_data(
+		          internal_handle->chunk_table->mapped_file_pool,
+		          mapped_file_io_pool_entry,
+		          error );
 
-		goto on_error;
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	if( chunk_buffer_size == 0 )
-	{
-		return( 0 );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release memory mapped file: %d data.",
+			 function,
+			 mapped_file_io_pool_entry );
+		}
+		else
+		{
+			mapped_data = NULL;
+		}
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + data_size ) >= internal_handle->media_values->media_size ) )
+	if( ( result == 1 )
+	 && ( ( range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 ) )
 	{
-		data_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+		result = libewf_chunk_table_append_chunk_checksum_error(
+		          internal_handle->chunk_table,
+		          internal_handle->media_values,
+		          offset,
+		          error );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: writing chunk: %" PRIu64 " with chunk buffer of size: %" PRIzd " and data of size: %" PRIzd ".\n",
-		 function,
-		 chunk_index,
-		 chunk_buffer_size,
-		 data_size );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
+			 function );
+		}
 	}
-#endif
-	if( libewf_chunk_data_initialize(
-	     &chunk_data,
-	     0,
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk: %" PRIu64 " data.",
-		 function,
-		 chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
 
 		goto on_error;
 	}
-	if( is_compressed != 0 )
+#endif
+	if( result != 1 )
 	{
-		chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+		goto on_error;
 	}
-	else if( ( chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+	return( read_count );
+
+on_error:
+	if( mapped_data != NULL )
 	{
-		/* Check if the chunk and checksum buffers are aligned
-		 * if so write the chunk and checksum at the same time
-		 */
-		if( checksum_buffer == NULL )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     NULL ) == 1 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-			 "%s: invalid checksum buffer.",
-			 function );
+			libewf_mapped_file_pool_release_data(
+			 internal_handle->chunk_table->mapped_file_pool,
+			 mapped_file_io_pool_entry,
+			 NULL );
 
-			goto on_error;
+			libcthreads_mutex_release(
+			 internal_handle->chunk_table_mutex,
+			 NULL );
 		}
-		byte_stream_copy_from_uint32_little_endian(
-		 (uint8_t *) checksum_buffer,
-		 chunk_checksum );
+#else
+		libewf_mapped_file_pool_release_data(
+		 internal_handle->chunk_table->mapped_file_pool,
+		 mapped_file_io_pool_entry,
+		 NULL );
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
 
-		if( checksum_buffer == &( ( (uint8_t *) chunk_buffer )[ chunk_buffer_size ] ) )
-		{
-			chunk_buffer_size += 4;
+/* Sets unpacked chunk data in the chunk cache or the chunks cache
+ * A checksum error is appended if the chunk data is corrupted
+ * If multi-threading is supported the chunk table mutex must be held
+ * The cache takes over the management of the chunk data and chunk data is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_set_unpacked_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_set_unpacked_chunk_data";
 
-			chunk_io_flags &= ~( LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET );
-		}
-		else
-		{
-			byte_stream_copy_to_uint32_little_endian(
-			 (uint8_t *) checksum_buffer,
-			 chunk_data->checksum );
-		}
-		chunk_data->range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
-	}
-	chunk_data->data                = (uint8_t *) chunk_buffer;
-	chunk_data->allocated_data_size = chunk_buffer_size;
-	chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_NON_MANAGED_DATA;
-	chunk_data->chunk_io_flags      = chunk_io_flags;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-	                internal_handle->chunk_table,
-	                chunk_index,
-	                internal_handle->file_io_pool,
-	                internal_handle->segment_table,
-	                internal_handle->chunk_groups_cache,
-	                internal_handle->current_offset,
-			error );
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
 
-	if( chunk_exists == -1 )
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-		 function,
-		 chunk_index );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk data.",
+		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( ( ( *chunk_data )->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
 	{
-		if( chunk_exists == 0 )
+		if( libewf_chunk_table_append_chunk_checksum_error(
+		     internal_handle->chunk_table,
+		     internal_handle->media_values,
+		     chunk_offset,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing chunk: %" PRIu64 ".",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append checksum error.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		if( libewf_chunk_cache_set_chunk_data(
+		     internal_handle->chunk_cache,
+		     chunk_index,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in chunk cache.",
 			 function,
 			 chunk_index );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	else
 	{
-		if( chunk_exists != 0 )
+		if( libewf_chunk_table_set_chunk_data_by_offset(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->delta_chunks_range_list,
+		     internal_handle->chunk_groups_cache,
+		     internal_handle->chunks_cache,
+		     chunk_offset,
+		     *chunk_data,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data in chunks cache.",
 			 function,
 			 chunk_index );
 
-			goto on_error;
+			return( -1 );
 		}
+		/* The chunks cache now manages the chunk data
+		 */
+		*chunk_data = NULL;
 	}
-	if( chunk_exists != 0 )
-	{
-		chunk_data->data_size = data_size;
+	return( 1 );
+}
 
-		chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_DELTA;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 
-		write_count = libewf_write_io_handle_write_existing_chunk(
-		               internal_handle->write_io_handle,
-		               internal_handle->io_handle,
-		               internal_handle->file_io_pool,
-		               internal_handle->media_values,
-		               internal_handle->delta_segment_table,
-		               internal_handle->delta_chunks_range_list,
-			       internal_handle->current_offset,
-		               chunk_index,
-		               chunk_data,
-		               chunk_buffer_size,
-		               error );
-	}
-	else
-	{
-		chunk_data->data_size = chunk_buffer_size;
-
-		write_count = libewf_write_io_handle_write_new_chunk(
-		               internal_handle->write_io_handle,
-		               internal_handle->io_handle,
-		               internal_handle->file_io_pool,
-		               internal_handle->media_values,
-		               internal_handle->segment_table,
-		               internal_handle->header_values,
-		               internal_handle->hash_values,
-		               internal_handle->hash_sections,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               chunk_index,
-		               chunk_data,
-		               data_size,
-		               error );
-	}
-	if( write_count < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write raw chunk data.",
-		 function );
-
-		goto on_error;
-	}
-	internal_handle->current_offset += (off64_t) data_size;
-
-	if( libewf_chunk_data_free(
-	     &chunk_data,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free chunk data.",
-		 function );
-
-		goto on_error;
-	}
-	return( (ssize_t) chunk_buffer_size );
-
-on_error:
-	if( chunk_data != NULL )
-	{
-		libewf_chunk_data_free(
-		 &chunk_data,
-		 NULL );
-	}
-	return( -1 );
-}
-
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Retrieves a compression context for a reading thread
+ * A new compression context is created if none is available
+ * The chunk table mutex must be held by the caller
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libewf_internal_handle_get_compression_context(
+     libewf_internal_handle_t *internal_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
 {
-	libewf_chunk_data_t *chunk_data           = NULL;
-	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_write_buffer";
-	off64_t chunk_data_offset                 = 0;
-	size_t buffer_offset                      = 0;
-	size_t input_data_size                    = 0;
-	size_t write_size                         = 0;
-	ssize_t write_count                       = 0;
-	uint64_t chunk_index                      = 0;
-	int chunk_exists                          = 0;
-	int write_chunk                           = 0;
+	static char *function = "libewf_internal_handle_get_compression_context";
+	int number_of_entries = 0;
 
-	if( handle == NULL )
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -6282,673 +9680,8333 @@ ssize_t libewf_handle_write_buffer(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->io_handle == NULL )
+	if( compression_context == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libcdata_array_get_number_of_entries(
+	     internal_handle->compression_contexts,
+	     &number_of_entries,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of pooled compression contexts.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	if( number_of_entries == 0 )
 	{
-		if( internal_handle->chunk_data != NULL )
+		if( libewf_compression_context_initialize(
+		     compression_context,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression context.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_compression_context_set_deflate_backend(
+		     *compression_context,
+		     internal_handle->deflate_backend,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set deflate backend in compression context.",
 			 function );
 
+			libewf_compression_context_free(
+			 compression_context,
+			 NULL );
+
 			return( -1 );
 		}
+		return( 1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( libcdata_array_get_entry_by_index(
+	     internal_handle->compression_contexts,
+	     number_of_entries - 1,
+	     (intptr_t **) compression_context,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve pooled compression context: %d.",
+		 function,
+		 number_of_entries - 1 );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	/* The entry is cleared before resizing so that the compression context is not freed
+	 */
+	if( libcdata_array_set_entry_by_index(
+	     internal_handle->compression_contexts,
+	     number_of_entries - 1,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set pooled compression context: %d.",
+		 function,
+		 number_of_entries - 1 );
+
+		*compression_context = NULL;
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle == NULL )
+	if( libcdata_array_resize(
+	     internal_handle->compression_contexts,
+	     number_of_entries - 1,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_compression_context_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing subhandle write.",
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize pooled compression contexts array.",
 		 function );
 
+		libewf_compression_context_free(
+		 compression_context,
+		 NULL );
+
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->values_initialized == 0 )
-	{
-		if( libewf_write_io_handle_initialize_values(
-		     internal_handle->write_io_handle,
-		     internal_handle->io_handle,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to initialize write IO handle values.",
-			 function );
+	return( 1 );
+}
 
-			return( -1 );
-		}
-	}
-	if( buffer == NULL )
+/* Returns a compression context of a reading thread so that it can be reused
+ * The chunk table mutex must be held by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_compression_context(
+     libewf_internal_handle_t *internal_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_compression_context";
+	int entry_index       = 0;
+
+	if( internal_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 "%s: invalid handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( compression_context == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression context.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( libcdata_array_append_entry(
+	     internal_handle->compression_contexts,
+	     &entry_index,
+	     (intptr_t *) *compression_context,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append pooled compression context.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-	{
-		return( 0 );
-	}
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
-	{
-		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
-	}
-	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+	/* The array now manages the compression context
+	 */
+	*compression_context = NULL;
 
-	if( chunk_index >= (uint64_t) INT_MAX )
+	return( 1 );
+}
+
+/* Reads and unpacks a chunk ahead of time and stores it in the chunks cache or chunk cache
+ * Callback function for the read-ahead thread pool, frees the chunk index
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead_chunk(
+     uint64_t *chunk_index,
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_chunk_data_t *chunk_data                   = NULL;
+	libewf_chunk_data_t *packed_chunk_data            = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_internal_handle_read_ahead_chunk";
+	off64_t chunk_data_offset                         = 0;
+	off64_t chunk_offset                              = 0;
+	int result                                        = 0;
+
+	if( chunk_index == NULL )
 	{
 		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk index value exceeds maximum.",
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
-	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+		goto on_error;
+	}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     &error ) != 1 )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid chunk data offset value exceeds maximum.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	while( buffer_size > 0 )
+	if( internal_handle->read_ahead_abort == 0 )
 	{
-		/* Check if we are in read and write mode
-		 */
-		if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-		 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+		chunk_offset = (off64_t) *chunk_index * internal_handle->media_values->chunk_size;
+
+		if( internal_handle->chunk_cache != NULL )
 		{
-			chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-			                internal_handle->chunk_table,
-			                chunk_index,
-			                internal_handle->file_io_pool,
-			                internal_handle->segment_table,
-			                internal_handle->chunk_groups_cache,
-			                internal_handle->current_offset,
-					error );
+			/* Chunks that are already in the chunk cache are not read ahead
+			 */
+			result = libewf_chunk_cache_has_chunk_data(
+			          internal_handle->chunk_cache,
+			          *chunk_index,
+			          &error );
 
-			if( chunk_exists == -1 )
+			if( result == -1 )
 			{
 				libcerror_error_set(
-				 error,
+				 &error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+				 "%s: unable to determine if chunk: %" PRIu64 " is in chunk cache.",
 				 function,
-				 chunk_index );
-
-				return( -1 );
+				 *chunk_index );
 			}
-			else if( chunk_exists == 0 )
+		}
+		if( result == 0 )
+		{
+			result = libewf_chunk_table_get_packed_chunk_data_by_offset(
+			          internal_handle->chunk_table,
+			          *chunk_index,
+			          internal_handle->file_io_pool,
+			          internal_handle->segment_table,
+			          internal_handle->delta_chunks_range_list,
+			          internal_handle->chunk_groups_cache,
+			          internal_handle->chunks_cache,
+			          chunk_offset,
+			          &chunk_data,
+			          &chunk_data_offset,
+			          &error );
+
+			if( result == -1 )
 			{
 				libcerror_error_set(
-				 error,
+				 &error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: missing chunk: %" PRIu64 ".",
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " data.",
 				 function,
-				 chunk_index );
-
-				return( -1 );
+				 *chunk_index );
 			}
-			if( ( chunk_data_offset != 0 )
-			 || ( buffer_size < internal_handle->media_values->chunk_size ) )
+			/* Chunks that are missing or already unpacked are not read ahead
+			 */
+			else if( ( result != 0 )
+			      && ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 ) )
 			{
-/* TODO optimize reuse data obtained in libewf_chunk_table_chunk_exists_for_offset */
-				if( libewf_chunk_table_get_chunk_data_by_offset(
-				     internal_handle->chunk_table,
-				     chunk_index,
-				     internal_handle->io_handle,
-				     internal_handle->file_io_pool,
-				     internal_handle->media_values,
-				     internal_handle->segment_table,
-				     internal_handle->delta_chunks_range_list,
-				     internal_handle->chunk_groups_cache,
-				     internal_handle->chunks_cache,
-				     internal_handle->current_offset,
-				     &chunk_data,
-				     &chunk_data_offset,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to read chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				if( chunk_data == NULL )
+				if( libewf_chunk_data_clone(
+				     &packed_chunk_data,
+				     chunk_data,
+				     &error ) != 1 )
 				{
 					libcerror_error_set(
-					 error,
+					 &error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing chunk: %" PRIu64 " data.",
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create packed chunk: %" PRIu64 " data.",
 					 function,
-					 chunk_index );
+					 *chunk_index );
 
-					return( -1 );
+					result = -1;
 				}
-				if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+				else if( libewf_internal_handle_get_compression_context(
+				          internal_handle,
+				          &compression_context,
+				          &error ) != 1 )
 				{
 					libcerror_error_set(
-					 error,
+					 &error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: chunk: %" PRIu64 " offset exceeds data size.",
-					 function,
-					 chunk_index );
-
-					return( -1 );
-				}
-				write_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve compression context.",
+					 function );
 
-				if( write_size > buffer_size )
-				{
-					write_size = buffer_size;
-				}
-				if( write_size == 0 )
-				{
-					break;
-				}
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: updating chunk: %" PRIu64 " data at offset: %" PRIu64 " with size: %" PRIzd ".\n",
-					 function,
-					 chunk_index,
-					 chunk_data_offset,
-					 write_size );
+					result = -1;
 				}
-#endif
 			}
-			else
-			{
-				/* Reserve 4 bytes for the chunk checksum
-				 */
-				if( libewf_chunk_data_initialize(
-				     &chunk_data,
-				     (size_t) internal_handle->media_values->chunk_size + 4,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
 
-					return( -1 );
-				}
-				if( chunk_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
+		goto on_error;
+	}
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( packed_chunk_data != NULL )
+	{
+		if( libewf_chunk_table_unpack_chunk_data(
+		     internal_handle->chunk_table,
+		     *chunk_index,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     packed_chunk_data,
+		     compression_context,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 *chunk_index );
 
-					return( -1 );
-				}
-				if( libewf_chunk_table_set_chunk_data_by_offset(
-				     internal_handle->chunk_table,
-				     chunk_index,
-				     internal_handle->file_io_pool,
-				     internal_handle->segment_table,
-				     internal_handle->delta_chunks_range_list,
-				     internal_handle->chunk_groups_cache,
-				     internal_handle->chunks_cache,
-				     internal_handle->current_offset,
-				     chunk_data,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-					 "%s: unable to set chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
 
-					libewf_chunk_data_free(
-					 &chunk_data,
-					 NULL );
+			goto on_error;
+		}
+		result = libewf_internal_handle_set_unpacked_chunk_data(
+		          internal_handle,
+		          *chunk_index,
+		          chunk_offset,
+		          &packed_chunk_data,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 function,
+			 *chunk_index );
+		}
+		if( libewf_internal_handle_release_compression_context(
+		     internal_handle,
+		     &compression_context,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression context.",
+			 function );
 
-					return( -1 );
-				}
-				/* chunks_cache takes over management of chunk_data
-				 */
-				chunk_data->data_size = internal_handle->media_values->chunk_size;
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
 
-				write_size = chunk_data->data_size;
-			}
-			if( memory_copy(
-			     &( ( chunk_data->data )[ chunk_data_offset ] ),
-			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			     write_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy buffer to chunk data.",
-				 function );
+			goto on_error;
+		}
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	memory_free(
+	 chunk_index );
 
-				return( -1 );
-			}
-			buffer_offset += write_size;
-			buffer_size   -= write_size;
+	return( 1 );
 
-			input_data_size = chunk_data->data_size;
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	if( packed_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &packed_chunk_data,
+		 NULL );
+	}
+	if( chunk_index != NULL )
+	{
+		memory_free(
+		 chunk_index );
+	}
+	return( -1 );
+}
 
-			/* For now ignore the default pack flags when creating a delta chunk
-			 */
-			if( libewf_chunk_data_pack(
-			     chunk_data,
-			     internal_handle->media_values->chunk_size,
-			     LIBEWF_COMPRESSION_METHOD_NONE,
-			     LIBEWF_COMPRESSION_NONE,
-			     0,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-			     LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GENERIC,
-				 "%s: unable to pack chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+/* Schedules the chunks that follow a sequential read to be read ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	uint64_t *chunk_index           = NULL;
+	static char *function           = "libewf_internal_handle_read_ahead";
+	uint64_t first_read_ahead_index = 0;
+	uint64_t last_chunk_index       = 0;
+	uint64_t last_read_ahead_index  = 0;
+	uint64_t number_of_chunks       = 0;
 
-				return( -1 );
-			}
-			chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_DELTA;
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			write_count = libewf_write_io_handle_write_existing_chunk(
-				       internal_handle->write_io_handle,
-				       internal_handle->io_handle,
-				       internal_handle->file_io_pool,
-				       internal_handle->media_values,
-				       internal_handle->delta_segment_table,
-				       internal_handle->delta_chunks_range_list,
-				       internal_handle->current_offset,
-				       chunk_index,
-				       chunk_data,
-				       input_data_size,
-				       error );
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
 
-			if( write_count <= 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write existing chunk.",
-				 function );
+		return( -1 );
+	}
+	if( ( internal_handle->read_ahead_thread_pool == NULL )
+	 || ( read_size == 0 ) )
+	{
+		return( 1 );
+	}
+	last_chunk_index = (uint64_t) ( offset + read_size - 1 ) / internal_handle->media_values->chunk_size;
 
-				return( -1 );
-			}
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == internal_handle->read_ahead_offset )
+	{
+		first_read_ahead_index = internal_handle->read_ahead_chunk_index;
+
+		if( first_read_ahead_index <= last_chunk_index )
+		{
+			first_read_ahead_index = last_chunk_index + 1;
 		}
-		else
+		last_read_ahead_index = last_chunk_index + internal_handle->maximum_number_of_read_ahead_chunks;
+
+		if( last_read_ahead_index >= internal_handle->media_values->number_of_chunks )
 		{
-			if( chunk_index < internal_handle->write_io_handle->number_of_chunks_written )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-				 "%s: chunk: %" PRIu64 " already set.",
-				 function,
-				 chunk_index );
+			last_read_ahead_index = internal_handle->media_values->number_of_chunks - 1;
+		}
+		if( first_read_ahead_index <= last_read_ahead_index )
+		{
+			number_of_chunks = last_read_ahead_index - first_read_ahead_index + 1;
 
-				return( -1 );
-			}
-			if( internal_handle->write_io_handle->write_finalized != 0 )
-			{
-				break;
-			}
-			if( internal_handle->chunk_data == NULL )
+			internal_handle->read_ahead_chunk_index = last_read_ahead_index + 1;
+		}
+	}
+	else
+	{
+		/* On non-sequential access the read-ahead restarts after the current read
+		 */
+		internal_handle->read_ahead_chunk_index = last_chunk_index + 1;
+	}
+	internal_handle->read_ahead_offset = offset + (off64_t) read_size;
+
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunks are pushed without holding the chunk table mutex
+	 * since the push blocks while the read-ahead queue is full
+	 */
+	while( number_of_chunks > 0 )
+	{
+		chunk_index = memory_allocate_structure(
+		               uint64_t );
+
+		if( chunk_index == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk index.",
+			 function );
+
+			return( -1 );
+		}
+		*chunk_index = first_read_ahead_index;
+
+		if( libcthreads_thread_pool_push(
+		     internal_handle->read_ahead_thread_pool,
+		     (intptr_t *) chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %" PRIu64 " onto read-ahead queue.",
+			 function,
+			 first_read_ahead_index );
+
+			memory_free(
+			 chunk_index );
+
+			return( -1 );
+		}
+		first_read_ahead_index += 1;
+		number_of_chunks       -= 1;
+	}
+	return( 1 );
+}
+
+/* Initializes the compression thread pool used to pack chunks when writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_initialize_compression_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_initialize_compression_thread_pool";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->compression_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - compression thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->number_of_compression_threads <= 0 )
+	 || ( internal_handle->number_of_compression_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - number of compression threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->maximum_number_of_compression_jobs = internal_handle->number_of_compression_threads
+	                                                    * LIBEWF_NUMBER_OF_COMPRESSION_JOBS_PER_THREAD;
+
+	internal_handle->compression_jobs = (libewf_compression_job_t **) memory_allocate(
+	                                                                   sizeof( libewf_compression_job_t * ) * internal_handle->maximum_number_of_compression_jobs );
+
+	if( internal_handle->compression_jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression jobs.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_handle->compression_jobs,
+	     0,
+	     sizeof( libewf_compression_job_t * ) * internal_handle->maximum_number_of_compression_jobs ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression jobs.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->first_compression_job_index = 0;
+	internal_handle->number_of_compression_jobs  = 0;
+
+	if( libcthreads_mutex_initialize(
+	     &( internal_handle->compression_jobs_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression jobs mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_handle->compression_jobs_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize compression jobs condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( internal_handle->compression_thread_pool ),
+	     NULL,
+	     internal_handle->number_of_compression_threads,
+	     internal_handle->maximum_number_of_compression_jobs,
+	     (int (*)(intptr_t *, void *)) &libewf_internal_handle_pack_chunk,
+	     (void *) internal_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_handle->compression_jobs_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( internal_handle->compression_jobs_condition ),
+		 NULL );
+	}
+	if( internal_handle->compression_jobs_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( internal_handle->compression_jobs_mutex ),
+		 NULL );
+	}
+	if( internal_handle->compression_jobs != NULL )
+	{
+		memory_free(
+		 internal_handle->compression_jobs );
+
+		internal_handle->compression_jobs = NULL;
+	}
+	internal_handle->maximum_number_of_compression_jobs = 0;
+
+	return( -1 );
+}
+
+/* Frees the compression thread pool
+ * Chunks that were queued but not written are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_free_compression_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error )
+{
+	libewf_compression_job_t *compression_job = NULL;
+	static char *function                     = "libewf_internal_handle_free_compression_thread_pool";
+	int compression_job_index                 = 0;
+	int result                                = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->compression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_handle->compression_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join compression thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->compression_jobs != NULL )
+	{
+		while( internal_handle->number_of_compression_jobs > 0 )
+		{
+			compression_job_index = internal_handle->first_compression_job_index;
+			compression_job       = internal_handle->compression_jobs[ compression_job_index ];
+
+			internal_handle->compression_jobs[ compression_job_index ] = NULL;
+
+			internal_handle->first_compression_job_index = ( compression_job_index + 1 )
+			                                             % internal_handle->maximum_number_of_compression_jobs;
+			internal_handle->number_of_compression_jobs -= 1;
+
+			if( compression_job != NULL )
 			{
-				/* Reserve 4 bytes for the chunk checksum
-				 */
-				if( libewf_chunk_data_initialize(
-				     &( internal_handle->chunk_data ),
-				     (size_t) internal_handle->media_values->chunk_size + 4,
+				if( compression_job->chunk_data != NULL )
+				{
+					if( libewf_chunk_data_free(
+					     &( compression_job->chunk_data ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free chunk: %" PRIu64 " data.",
+						 function,
+						 compression_job->chunk_index );
+
+						result = -1;
+					}
+				}
+				memory_free(
+				 compression_job );
+			}
+		}
+		memory_free(
+		 internal_handle->compression_jobs );
+
+		internal_handle->compression_jobs = NULL;
+	}
+	internal_handle->maximum_number_of_compression_jobs = 0;
+	internal_handle->first_compression_job_index        = 0;
+
+	if( internal_handle->compression_jobs_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( internal_handle->compression_jobs_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression jobs condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->compression_jobs_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( internal_handle->compression_jobs_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression jobs mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Packs the chunk of a compression job
+ * Callback function for the compression thread pool, the compression job remains
+ * managed by the compression jobs queue of the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_pack_chunk(
+     libewf_compression_job_t *compression_job,
+     libewf_internal_handle_t *internal_handle )
+{
+	libcerror_error_t *error                          = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_internal_handle_pack_chunk";
+	int result                                        = 0;
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression job.",
+		 function );
+
+		goto on_error;
+	}
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The compression contexts are shared with the reading threads and are guarded by the chunk table mutex
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libewf_internal_handle_get_compression_context(
+		          internal_handle,
+		          &compression_context,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve compression context.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = libewf_chunk_data_pack(
+		          compression_job->chunk_data,
+		          internal_handle->media_values->chunk_size,
+		          internal_handle->io_handle->compression_method,
+		          internal_handle->io_handle->compression_level,
+		          internal_handle->io_handle->compression_flags,
+		          internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		          internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		          internal_handle->write_io_handle->pack_flags,
+		          compression_context,
+		          &error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 compression_job->chunk_index );
+
+			result = -1;
+		}
+	}
+	if( compression_context != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			if( libewf_internal_handle_release_compression_context(
+			     internal_handle,
+			     &compression_context,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release compression context.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+	}
+	/* The writing thread waits on the result of the compression job hence the result
+	 * needs to be set even if the chunk could not be packed
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_handle->compression_jobs_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab compression jobs mutex.",
+		 function );
+
+		/* The failure is published without the mutex rather than having the writing thread wait forever
+		 */
+		compression_job->result = -1;
+
+		libcthreads_condition_broadcast(
+		 internal_handle->compression_jobs_condition,
+		 NULL );
+
+		goto on_error;
+	}
+	compression_job->result = result;
+
+	if( libcthreads_condition_broadcast(
+	     internal_handle->compression_jobs_condition,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast compression jobs condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->compression_jobs_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release compression jobs mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the packed chunks of the compression jobs in chunk order
+ * Waits for the chunks to be packed until no more than the maximum number of compression jobs remain,
+ * chunks that are already packed are written regardless
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_write_packed_chunks(
+     libewf_internal_handle_t *internal_handle,
+     int maximum_number_of_compression_jobs,
+     libcerror_error_t **error )
+{
+	libewf_compression_job_t *compression_job = NULL;
+	static char *function                     = "libewf_internal_handle_write_packed_chunks";
+	ssize_t write_count                       = 0;
+	int result                                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->compression_jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing compression jobs.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_compression_jobs < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of compression jobs value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_handle->number_of_compression_jobs > 0 )
+	{
+		compression_job = internal_handle->compression_jobs[ internal_handle->first_compression_job_index ];
+
+		if( compression_job == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing compression job: %d.",
+			 function,
+			 internal_handle->first_compression_job_index );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_grab(
+		     internal_handle->compression_jobs_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab compression jobs mutex.",
+			 function );
+
+			return( -1 );
+		}
+		result = 1;
+
+		if( internal_handle->number_of_compression_jobs > maximum_number_of_compression_jobs )
+		{
+			while( compression_job->result == 0 )
+			{
+				if( libcthreads_condition_wait(
+				     internal_handle->compression_jobs_condition,
+				     internal_handle->compression_jobs_mutex,
 				     error ) != 1 )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to wait for compression jobs condition.",
+					 function );
+
+					result = -1;
+
+					break;
+				}
+			}
+		}
+		if( result == 1 )
+		{
+			result = compression_job->result;
+		}
+		if( libcthreads_mutex_release(
+		     internal_handle->compression_jobs_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression jobs mutex.",
+			 function );
+
+			return( -1 );
+		}
+		if( result == 0 )
+		{
+			break;
+		}
+		else if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 compression_job->chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       internal_handle->file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       compression_job->chunk_index,
+			       compression_job->chunk_data,
+			       compression_job->input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk: %" PRIu64 ".",
+			 function,
+			 compression_job->chunk_index );
+
+			return( -1 );
+		}
+		internal_handle->compression_jobs[ internal_handle->first_compression_job_index ] = NULL;
+
+		internal_handle->first_compression_job_index = ( internal_handle->first_compression_job_index + 1 )
+		                                             % internal_handle->maximum_number_of_compression_jobs;
+		internal_handle->number_of_compression_jobs -= 1;
+
+		result = libewf_chunk_data_free(
+		          &( compression_job->chunk_data ),
+		          error );
+
+		memory_free(
+		 compression_job );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Queues a chunk to be packed by the compression threads
+ * The packed chunks that precede it are written first if the compression jobs queue is full
+ * The compression job takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_queue_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error )
+{
+	libewf_compression_job_t *compression_job = NULL;
+	static char *function                     = "libewf_internal_handle_queue_chunk";
+	int compression_job_index                 = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->compression_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing compression thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure there is room in the compression jobs queue
+	 */
+	if( libewf_internal_handle_write_packed_chunks(
+	     internal_handle,
+	     internal_handle->maximum_number_of_compression_jobs - 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write packed chunks.",
+		 function );
+
+		return( -1 );
+	}
+	compression_job = memory_allocate_structure(
+	                   libewf_compression_job_t );
+
+	if( compression_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression job.",
+		 function );
+
+		return( -1 );
+	}
+	compression_job->chunk_index     = chunk_index;
+	compression_job->chunk_data      = *chunk_data;
+	compression_job->input_data_size = input_data_size;
+	compression_job->result          = 0;
+
+	if( libcthreads_thread_pool_push(
+	     internal_handle->compression_thread_pool,
+	     (intptr_t *) compression_job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push chunk: %" PRIu64 " onto compression queue.",
+		 function,
+		 chunk_index );
+
+		memory_free(
+		 compression_job );
+
+		return( -1 );
+	}
+	/* The compression job is only accessed by the compression thread until its result is set
+	 */
+	compression_job_index = ( internal_handle->first_compression_job_index + internal_handle->number_of_compression_jobs )
+	                      % internal_handle->maximum_number_of_compression_jobs;
+
+	internal_handle->compression_jobs[ compression_job_index ] = compression_job;
+
+	internal_handle->number_of_compression_jobs += 1;
+
+	/* The compression job now manages the chunk data
+	 */
+	*chunk_data = NULL;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* Reads (media) data at a specific offset into a buffer
+ * This function does not change the current offset
+ * If multi-threading is supported this function can be called concurrently
+ * while holding the read/write lock for reading
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_buffer_at_offset(
+         libewf_internal_handle_t *internal_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *packed_chunk_data = NULL;
+	uint8_t *packed_data                   = NULL;
+	static char *function                  = "libewf_internal_handle_read_buffer_at_offset";
+	off64_t chunk_data_offset              = 0;
+	uint64_t chunk_index                   = 0;
+	size_t buffer_offset                   = 0;
+	ssize_t read_count                     = 0;
+	ssize_t total_read_count               = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_handle->media_values->media_size )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - offset );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+
+	while( buffer_size > 0 )
+	{
+		/* Whole chunks that are not cached are unpacked directly into the buffer
+		 * so that large reads do not need to copy the data and do not evict the cache
+		 */
+		read_count = libewf_internal_handle_read_buffer_from_chunk_direct(
+		              internal_handle,
+		              chunk_index,
+		              offset,
+		              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		              buffer_size,
+		              &packed_data,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data directly.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		else if( read_count > 0 )
+		{
+			buffer_offset    += (size_t) read_count;
+			buffer_size      -= (size_t) read_count;
+			total_read_count += read_count;
+			offset           += (off64_t) read_count;
+			chunk_index      += 1;
+
+			if( (size64_t) offset >= internal_handle->media_values->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+			continue;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		read_count = libewf_internal_handle_read_buffer_from_chunk(
+		              internal_handle,
+		              chunk_index,
+		              offset,
+		              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		              buffer_size,
+		              &packed_chunk_data,
+		              &chunk_data_offset,
+		              error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( packed_chunk_data != NULL )
+		{
+			read_count = libewf_internal_handle_read_buffer_from_packed_chunk(
+			              internal_handle,
+			              chunk_index,
+			              offset,
+			              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			              buffer_size,
+			              &packed_chunk_data,
+			              chunk_data_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read packed chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset    += (size_t) read_count;
+		buffer_size      -= (size_t) read_count;
+		total_read_count += read_count;
+		offset           += (off64_t) read_count;
+		chunk_index      += 1;
+
+		if( (size64_t) offset >= internal_handle->media_values->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+		chunk_data_offset = 0;
+	}
+	if( packed_data != NULL )
+	{
+		if( internal_handle->chunk_buffer_pool != NULL )
+		{
+			if( libewf_buffer_pool_release_buffer(
+			     internal_handle->chunk_buffer_pool,
+			     &packed_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release packed data to buffer pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			memory_free(
+			 packed_data );
+		}
+	}
+	return( total_read_count );
+
+on_error:
+	if( packed_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &packed_chunk_data,
+		 NULL );
+	}
+	if( packed_data != NULL )
+	{
+		if( internal_handle->chunk_buffer_pool != NULL )
+		{
+			libewf_buffer_pool_release_buffer(
+			 internal_handle->chunk_buffer_pool,
+			 &packed_data,
+			 NULL );
+		}
+		else
+		{
+			memory_free(
+			 packed_data );
+		}
+	}
+	return( -1 );
+}
+
+/* Reads (media) data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset(
+	              internal_handle,
+	              buffer,
+	              buffer_size,
+	              internal_handle->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	else if( libewf_internal_handle_read_ahead(
+	          internal_handle,
+	          internal_handle->current_offset,
+	          (size_t) read_count,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to read ahead.",
+		 function );
+
+		read_count = -1;
+	}
+#endif
+	else
+	{
+		internal_handle->current_offset += (off64_t) read_count;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * The current offset is set to the end of the data read
+ * If multi-threading is supported this function can be called concurrently
+ * from multiple threads on the same handle
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_buffer_at_offset(
+         libewf_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_buffer_at_offset(
+	              internal_handle,
+	              buffer,
+	              buffer_size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	else if( libcthreads_mutex_grab(
+	          internal_handle->chunk_table_mutex,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		read_count = -1;
+	}
+#endif
+	else
+	{
+		internal_handle->current_offset = offset + (off64_t) read_count;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			read_count = -1;
+		}
+#endif
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( read_count > 0 )
+	{
+		if( libewf_internal_handle_read_ahead(
+		     internal_handle,
+		     offset,
+		     (size_t) read_count,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to read ahead.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Retrieves the chunk data of a chunk at a specific offset for referencing
+ * Unpacked chunk data is referenced, otherwise a copy of the packed chunk data is returned
+ * in packed_chunk_data, so that it can be unpacked without holding the chunk table mutex
+ * If multi-threading is supported the chunk table mutex must be held
+ * Returns 1 if successful, 0 if no such chunk or -1 on error
+ */
+int libewf_internal_handle_reference_cached_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_t **packed_chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	static char *function                = "libewf_internal_handle_reference_cached_chunk_data";
+	int result                           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_cache != NULL )
+	{
+		result = libewf_chunk_cache_get_chunk_data(
+		          internal_handle->chunk_cache,
+		          chunk_index,
+		          &safe_chunk_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data from chunk cache.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			*chunk_data_offset = offset - ( (off64_t) chunk_index * internal_handle->media_values->chunk_size );
+		}
+	}
+	if( result == 0 )
+	{
+		result = libewf_chunk_table_get_packed_chunk_data_by_offset(
+		          internal_handle->chunk_table,
+		          chunk_index,
+		          internal_handle->file_io_pool,
+		          internal_handle->segment_table,
+		          internal_handle->delta_chunks_range_list,
+		          internal_handle->chunk_groups_cache,
+		          internal_handle->chunks_cache,
+		          offset,
+		          &safe_chunk_data,
+		          chunk_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( ( safe_chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ) != 0 )
+		{
+			internal_handle->number_of_cache_misses += 1;
+
+			if( libewf_chunk_data_clone(
+			     packed_chunk_data,
+			     safe_chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create packed chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			return( 1 );
+		}
+	}
+	internal_handle->number_of_cache_hits += 1;
+
+	/* A chunk that contains a fill pattern has no data that can be referenced
+	 */
+	if( libewf_chunk_data_expand_fill(
+	     safe_chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to expand fill pattern of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	safe_chunk_data->number_of_references += 1;
+
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+}
+
+/* Retrieves the unpacked chunk data of a chunk at a specific offset and references it
+ * The chunk data is not freed while it is referenced, even if it is removed from the cache
+ * The chunk data of a missing chunk is not cached and only referenced by the caller
+ * Use libewf_internal_handle_release_referenced_chunk_data to release the reference
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_referenced_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *packed_chunk_data            = NULL;
+	libewf_chunk_data_t *safe_chunk_data              = NULL;
+	libewf_compression_context_t *compression_context = NULL;
+	static char *function                             = "libewf_internal_handle_get_referenced_chunk_data";
+	off64_t chunk_offset                              = 0;
+	int result                                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_reference_cached_chunk_data(
+	          internal_handle,
+	          chunk_index,
+	          offset,
+	          &safe_chunk_data,
+	          &packed_chunk_data,
+	          chunk_data_offset,
+	          error );
+
+	if( result == 0 )
+	{
+		/* A missing chunk is read as zero bytes and marked as a checksum error
+		 */
+		result = libewf_chunk_table_append_chunk_checksum_error(
+		          internal_handle->chunk_table,
+		          internal_handle->media_values,
+		          chunk_offset,
+		          error );
+
+		if( result == 1 )
+		{
+			result = 0;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The chunk data is unpacked without holding the chunk table mutex
+	 * hence every reading thread needs its own compression context
+	 */
+	if( ( result == 1 )
+	 && ( packed_chunk_data != NULL ) )
+	{
+		result = libewf_internal_handle_get_compression_context(
+		          internal_handle,
+		          &compression_context,
+		          error );
+	}
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	compression_context = internal_handle->compression_context;
+#endif
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libewf_chunk_table_create_missing_chunk_data(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->media_values,
+		     &safe_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create missing chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		*chunk_data_offset = offset - chunk_offset;
+	}
+	else if( packed_chunk_data != NULL )
+	{
+		if( libewf_chunk_table_unpack_chunk_data(
+		     internal_handle->chunk_table,
+		     chunk_index,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     packed_chunk_data,
+		     compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		/* A chunk that contains a fill pattern has no data that can be referenced
+		 */
+		if( libewf_chunk_data_expand_fill(
+		     packed_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to expand fill pattern of chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = libewf_internal_handle_release_compression_context(
+		          internal_handle,
+		          &compression_context,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release compression context.",
+			 function );
+		}
+		else
+#endif
+		{
+			/* The reference is added before the cache takes over the management of the chunk data
+			 */
+			packed_chunk_data->number_of_references += 1;
+
+			safe_chunk_data = packed_chunk_data;
+
+			result = libewf_internal_handle_set_unpacked_chunk_data(
+			          internal_handle,
+			          chunk_index,
+			          chunk_offset,
+			          &packed_chunk_data,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				/* If the cache did not take over the management of the chunk data
+				 * it is only referenced by packed_chunk_data
+				 */
+				if( packed_chunk_data != NULL )
+				{
+					packed_chunk_data->number_of_references -= 1;
+
+					safe_chunk_data = NULL;
+				}
+			}
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result != 1 )
+		{
+			goto on_error;
+		}
+	}
+	*chunk_data = safe_chunk_data;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( compression_context != NULL )
+	{
+		libewf_compression_context_free(
+		 &compression_context,
+		 NULL );
+	}
+#endif
+	if( packed_chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &packed_chunk_data,
+		 NULL );
+	}
+	if( safe_chunk_data != NULL )
+	{
+		libewf_internal_handle_release_referenced_chunk_data(
+		 internal_handle,
+		 &safe_chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a reference to chunk data retrieved by libewf_internal_handle_get_referenced_chunk_data
+ * The chunk data is freed if it is no longer referenced or cached
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_referenced_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_referenced_chunk_data";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_data_free(
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk data.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases the reference to chunk data of a chunk view
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_release_chunk_view_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_release_chunk_view_data";
+	int result            = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_chunk_data_free(
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release chunk data.",
+		 function );
+
+		result = -1;
+	}
+	/* The chunk view no longer references the handle, even if releasing the chunk data failed
+	 */
+	if( internal_handle->number_of_chunk_views > 0 )
+	{
+		internal_handle->number_of_chunk_views -= 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of chunk views that have not been freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_get_number_of_chunk_views(
+     libewf_internal_handle_t *internal_handle,
+     int *number_of_chunk_views,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_get_number_of_chunk_views";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_views == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of chunk views.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_chunk_views = internal_handle->number_of_chunk_views;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a view of the (media) data at a specific offset
+ * The data points to the data of the chunk that contains the offset and remains
+ * valid until the chunk view is freed, the data size is limited to the end of the chunk
+ * The chunk view must be freed before the handle is closed, freed or written to,
+ * these functions fail while chunk views remain
+ * Returns 1 if successful, 0 if the offset is beyond the end of the media data or -1 on error
+ */
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_chunk_view";
+	off64_t chunk_data_offset                 = 0;
+	uint64_t chunk_index                      = 0;
+	size_t safe_data_size                     = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	chunk_index = offset / internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_get_referenced_chunk_data(
+	     internal_handle,
+	     chunk_index,
+	     offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		result = -1;
+	}
+	else if( ( chunk_data->data == NULL )
+	      || ( chunk_data_offset < 0 )
+	      || ( (size_t) chunk_data_offset >= chunk_data->data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+		 function,
+		 chunk_index );
+
+		result = -1;
+	}
+	else
+	{
+		safe_data_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+		if( (size64_t) safe_data_size > ( internal_handle->media_values->media_size - offset ) )
+		{
+			safe_data_size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The number of chunk views is protected by the chunk table mutex
+		 */
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+		else
+#endif
+		{
+			if( libewf_chunk_view_initialize(
+			     chunk_view,
+			     internal_handle,
+			     chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create chunk view.",
+				 function );
+
+				result = -1;
+			}
+			else
+			{
+				*data      = &( chunk_data->data[ chunk_data_offset ] );
+				*data_size = safe_data_size;
+
+				/* The chunk view now manages the reference to the chunk data
+				 */
+				chunk_data = NULL;
+
+				internal_handle->number_of_chunk_views += 1;
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+		}
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_internal_handle_release_referenced_chunk_data(
+		 internal_handle,
+		 &chunk_data,
+		 NULL );
+	}
+	if( ( result == -1 )
+	 && ( *chunk_view != NULL ) )
+	{
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libewf_chunk_view_free(
+		 chunk_view,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Compares the offsets of two read requests
+ * Callback function for sorting the read requests
+ * Returns -1 if the first offset is smaller, 1 if the first offset is larger or 0 if equal
+ */
+int libewf_internal_handle_compare_read_requests(
+     const void *first_read_request,
+     const void *second_read_request )
+{
+	off64_t first_offset  = ( *( (const libewf_read_request_t **) first_read_request ) )->offset;
+	off64_t second_offset = ( *( (const libewf_read_request_t **) second_read_request ) )->offset;
+
+	if( first_offset < second_offset )
+	{
+		return( -1 );
+	}
+	else if( first_offset > second_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Reads the compressed data of the chunks of multiple read requests into the compressed chunk cache
+ * using asynchronous IO, so that the reads of these chunks are in flight at once
+ * Only chunks that are compressed and not cached are read, up to half the size of the compressed chunk cache
+ * The read requests should be sorted by offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_handle_prefetch_chunks(
+     libewf_internal_handle_t *internal_handle,
+     const libewf_read_request_t **read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error )
+{
+	libewf_async_io_request_t *async_io_requests = NULL;
+	const libewf_read_request_t *read_request    = NULL;
+	const uint8_t *compressed_data               = NULL;
+	uint64_t *chunk_indexes                      = NULL;
+	uint32_t *chunk_range_flags                  = NULL;
+	uint8_t *prefetch_data                       = NULL;
+	static char *function                        = "libewf_internal_handle_prefetch_chunks";
+	size64_t chunk_data_size                     = 0;
+	size64_t maximum_prefetch_size               = 0;
+	size64_t prefetch_size                       = 0;
+	size_t compressed_data_size                  = 0;
+	size_t maximum_chunk_data_size               = 0;
+	off64_t chunk_data_offset                    = 0;
+	off64_t end_offset                           = 0;
+	uint64_t chunk_index                         = 0;
+	uint64_t next_chunk_index                    = 0;
+	uint32_t compressed_data_range_flags         = 0;
+	uint32_t range_flags                         = 0;
+	int file_io_pool_entry                       = 0;
+	int maximum_number_of_chunks                 = 0;
+	int number_of_chunks                         = 0;
+	int read_request_index                       = 0;
+	int request_index                            = 0;
+	int result                                   = 1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->async_io == NULL )
+	 || ( internal_handle->chunk_table->compressed_chunk_cache == NULL ) )
+	{
+		return( 1 );
+	}
+	/* Chunks prefetched in the same call should not evict each other from the compressed chunk cache
+	 */
+	maximum_prefetch_size   = internal_handle->chunk_table->compressed_chunk_cache->maximum_size / 2;
+	maximum_chunk_data_size = (size_t) internal_handle->media_values->chunk_size + 4;
+
+	if( maximum_prefetch_size < (size64_t) maximum_chunk_data_size )
+	{
+		return( 1 );
+	}
+	if( ( maximum_prefetch_size / maximum_chunk_data_size ) > LIBEWF_ASYNC_IO_MAXIMUM_NUMBER_OF_PREFETCH_CHUNKS )
+	{
+		maximum_number_of_chunks = LIBEWF_ASYNC_IO_MAXIMUM_NUMBER_OF_PREFETCH_CHUNKS;
+	}
+	else
+	{
+		maximum_number_of_chunks = (int) ( maximum_prefetch_size / maximum_chunk_data_size );
+	}
+	async_io_requests = (libewf_async_io_request_t *) memory_allocate(
+	                                                   sizeof( libewf_async_io_request_t ) * maximum_number_of_chunks );
+
+	if( async_io_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create asynchronous IO requests.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_indexes = (uint64_t *) memory_allocate(
+	                              sizeof( uint64_t ) * maximum_number_of_chunks );
+
+	if( chunk_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk indexes.",
+		 function );
+
+		goto on_error;
+	}
+	chunk_range_flags = (uint32_t *) memory_allocate(
+	                                  sizeof( uint32_t ) * maximum_number_of_chunks );
+
+	if( chunk_range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk range flags.",
+		 function );
+
+		goto on_error;
+	}
+	prefetch_data = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * maximum_chunk_data_size * maximum_number_of_chunks );
+
+	if( prefetch_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create prefetch data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		read_request = read_requests[ read_request_index ];
+
+		if( ( read_request->size == 0 )
+		 || ( (size64_t) read_request->offset >= internal_handle->media_values->media_size ) )
+		{
+			continue;
+		}
+		end_offset = read_request->offset + (off64_t) read_request->size;
+
+		if( (size64_t) end_offset > internal_handle->media_values->media_size )
+		{
+			end_offset = (off64_t) internal_handle->media_values->media_size;
+		}
+		chunk_index = (uint64_t) read_request->offset / internal_handle->media_values->chunk_size;
+
+		/* The read requests are sorted hence chunks shared with the previous read request are skipped
+		 */
+		if( chunk_index < next_chunk_index )
+		{
+			chunk_index = next_chunk_index;
+		}
+		while( (off64_t) ( chunk_index * internal_handle->media_values->chunk_size ) < end_offset )
+		{
+			next_chunk_index = chunk_index + 1;
+
+			result = libewf_chunk_table_get_chunk_range_by_offset(
+			          internal_handle->chunk_table,
+			          chunk_index,
+			          internal_handle->file_io_pool,
+			          internal_handle->segment_table,
+			          internal_handle->delta_chunks_range_list,
+			          internal_handle->chunk_groups_cache,
+			          (off64_t) ( chunk_index * internal_handle->media_values->chunk_size ),
+			          &file_io_pool_entry,
+			          &chunk_data_offset,
+			          &chunk_data_size,
+			          &range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+				 function,
+				 chunk_index );
+
+				break;
+			}
+			/* Missing chunks, chunks in delta segment files and uncompressed chunks are not prefetched
+			 */
+			if( ( result == 0 )
+			 || ( ( range_flags & LIBEWF_RANGE_FLAG_IS_DELTA ) != 0 )
+			 || ( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+			 || ( chunk_data_size == 0 )
+			 || ( chunk_data_size > (size64_t) maximum_chunk_data_size ) )
+			{
+				result = 1;
+
+				chunk_index++;
+
+				continue;
+			}
+			result = libewf_chunk_table_chunk_data_is_cached(
+			          internal_handle->chunk_table,
+			          chunk_index,
+			          internal_handle->chunks_cache,
+			          file_io_pool_entry,
+			          chunk_data_offset,
+			          error );
+
+			if( result == 0 )
+			{
+				result = libewf_compressed_chunk_cache_get_data(
+				          internal_handle->chunk_table->compressed_chunk_cache,
+				          chunk_index,
+				          &compressed_data,
+				          &compressed_data_size,
+				          &compressed_data_range_flags,
+				          error );
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if chunk: %" PRIu64 " data is cached.",
+				 function,
+				 chunk_index );
+
+				break;
+			}
+			else if( result != 0 )
+			{
+				chunk_index++;
+
+				continue;
+			}
+			if( ( prefetch_size + chunk_data_size ) > maximum_prefetch_size )
+			{
+				break;
+			}
+			prefetch_size += chunk_data_size;
+
+			async_io_requests[ number_of_chunks ].file_io_pool_entry = file_io_pool_entry;
+			async_io_requests[ number_of_chunks ].offset             = chunk_data_offset;
+			async_io_requests[ number_of_chunks ].buffer             = &( prefetch_data[ number_of_chunks * maximum_chunk_data_size ] );
+			async_io_requests[ number_of_chunks ].size               = (size_t) chunk_data_size;
+			async_io_requests[ number_of_chunks ].read_size          = 0;
+
+			chunk_indexes[ number_of_chunks ]     = chunk_index;
+			chunk_range_flags[ number_of_chunks ] = range_flags;
+
+			number_of_chunks++;
+
+			if( number_of_chunks >= maximum_number_of_chunks )
+			{
+				result = libewf_async_io_read_requests(
+				          internal_handle->async_io,
+				          internal_handle->file_io_pool,
+				          async_io_requests,
+				          number_of_chunks,
+				          error );
+
+				if( result == 1 )
+				{
+					for( request_index = 0;
+					     request_index < number_of_chunks;
+					     request_index++ )
+					{
+						if( async_io_requests[ request_index ].read_size != async_io_requests[ request_index ].size )
+						{
+							continue;
+						}
+						result = libewf_compressed_chunk_cache_set_data(
+						          internal_handle->chunk_table->compressed_chunk_cache,
+						          chunk_indexes[ request_index ],
+						          async_io_requests[ request_index ].buffer,
+						          async_io_requests[ request_index ].size,
+						          chunk_range_flags[ request_index ],
+						          error );
+
+						if( result == -1 )
+						{
+							break;
+						}
+						result = 1;
+					}
+				}
+				if( result != 1 )
+				{
+					break;
+				}
+				number_of_chunks = 0;
+			}
+			chunk_index++;
+		}
+		if( ( result != 1 )
+		 || ( ( prefetch_size + maximum_chunk_data_size ) > maximum_prefetch_size ) )
+		{
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( number_of_chunks > 0 ) )
+	{
+		result = libewf_async_io_read_requests(
+		          internal_handle->async_io,
+		          internal_handle->file_io_pool,
+		          async_io_requests,
+		          number_of_chunks,
+		          error );
+
+		if( result == 1 )
+		{
+			for( request_index = 0;
+			     request_index < number_of_chunks;
+			     request_index++ )
+			{
+				if( async_io_requests[ request_index ].read_size != async_io_requests[ request_index ].size )
+				{
+					continue;
+				}
+				result = libewf_compressed_chunk_cache_set_data(
+				          internal_handle->chunk_table->compressed_chunk_cache,
+				          chunk_indexes[ request_index ],
+				          async_io_requests[ request_index ].buffer,
+				          async_io_requests[ request_index ].size,
+				          chunk_range_flags[ request_index ],
+				          error );
+
+				if( result == -1 )
+				{
+					break;
+				}
+				result = 1;
+			}
+		}
+	}
+	/* If the segment files cannot be read asynchronously the chunks are read synchronously when requested
+	 */
+	if( result == 0 )
+	{
+		result = 1;
+	}
+	else if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to prefetch chunks.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	memory_free(
+	 prefetch_data );
+	memory_free(
+	 chunk_range_flags );
+	memory_free(
+	 chunk_indexes );
+	memory_free(
+	 async_io_requests );
+
+	return( result );
+
+on_error:
+	if( prefetch_data != NULL )
+	{
+		memory_free(
+		 prefetch_data );
+	}
+	if( chunk_range_flags != NULL )
+	{
+		memory_free(
+		 chunk_range_flags );
+	}
+	if( chunk_indexes != NULL )
+	{
+		memory_free(
+		 chunk_indexes );
+	}
+	if( async_io_requests != NULL )
+	{
+		memory_free(
+		 async_io_requests );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data for multiple read requests
+ * The read requests are handled in offset order, so that the segment files are read in offset order
+ * and the chunk data of a chunk shared by consecutive read requests is only unpacked once
+ * The read size of every read request is set to the number of bytes read into its buffer,
+ * which is 0 for a read request that starts beyond the end of the media data
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         libewf_read_request_t *read_requests,
+         int number_of_read_requests,
+         libcerror_error_t **error )
+{
+	libewf_read_request_t **sorted_read_requests       = NULL;
+	libewf_read_request_t *read_request                = NULL;
+	libewf_chunk_data_t *chunk_data                    = NULL;
+	static char *function                              = "libewf_internal_handle_read_vector";
+	off64_t chunk_data_offset                          = 0;
+	off64_t chunk_offset                               = 0;
+	off64_t offset                                     = 0;
+	uint64_t chunk_index                               = 0;
+	uint64_t referenced_chunk_index                    = 0;
+	size_t buffer_offset                               = 0;
+	size_t read_size                                   = 0;
+	size_t request_size                                = 0;
+	ssize_t read_count                                 = 0;
+	ssize_t total_read_count                           = 0;
+	uint8_t is_sorted                                  = 1;
+	int read_request_index                             = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_read_requests < 0 )
+	 || ( (size_t) number_of_read_requests > ( (size_t) SSIZE_MAX / sizeof( libewf_read_request_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of read requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_requests == 0 )
+	{
+		return( 0 );
+	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		read_request = &( read_requests[ read_request_index ] );
+
+		if( read_request->offset < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid read request: %d - offset value out of bounds.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		if( read_request->size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid read request: %d - size value exceeds maximum.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		if( ( read_request->buffer == NULL )
+		 && ( read_request->size > 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid read request: %d - missing buffer.",
+			 function,
+			 read_request_index );
+
+			return( -1 );
+		}
+		if( ( read_request_index > 0 )
+		 && ( read_request->offset < read_requests[ read_request_index - 1 ].offset ) )
+		{
+			is_sorted = 0;
+		}
+		read_request->read_size = 0;
+	}
+	sorted_read_requests = (libewf_read_request_t **) memory_allocate(
+	                                                         sizeof( libewf_read_request_t * ) * number_of_read_requests );
+
+	if( sorted_read_requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sorted read requests.",
+		 function );
+
+		goto on_error;
+	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		sorted_read_requests[ read_request_index ] = &( read_requests[ read_request_index ] );
+	}
+	if( is_sorted == 0 )
+	{
+		qsort(
+		 (void *) sorted_read_requests,
+		 (size_t) number_of_read_requests,
+		 sizeof( libewf_read_request_t * ),
+		 &libewf_internal_handle_compare_read_requests );
+	}
+	if( internal_handle->async_io != NULL )
+	{
+		if( libewf_internal_handle_prefetch_chunks(
+		     internal_handle,
+		     (const libewf_read_request_t **) sorted_read_requests,
+		     number_of_read_requests,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to prefetch chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( read_request_index = 0;
+	     read_request_index < number_of_read_requests;
+	     read_request_index++ )
+	{
+		read_request = sorted_read_requests[ read_request_index ];
+
+		if( (size64_t) read_request->offset >= internal_handle->media_values->media_size )
+		{
+			continue;
+		}
+		offset       = read_request->offset;
+		request_size = read_request->size;
+
+		if( (size64_t) request_size > ( internal_handle->media_values->media_size - offset ) )
+		{
+			request_size = (size_t) ( internal_handle->media_values->media_size - offset );
+		}
+		/* Read requests that span entire chunks are read without referencing the chunk data
+		 * so that the chunks can be unpacked directly into the buffer
+		 */
+		if( request_size >= (size_t) internal_handle->media_values->chunk_size )
+		{
+			read_count = libewf_internal_handle_read_buffer_at_offset(
+			              internal_handle,
+			              read_request->buffer,
+			              request_size,
+			              offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			read_request->read_size = (size_t) read_count;
+			total_read_count       += read_count;
+
+			continue;
+		}
+		buffer_offset = 0;
+
+		while( buffer_offset < request_size )
+		{
+			chunk_index  = offset / internal_handle->media_values->chunk_size;
+			chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+			if( ( chunk_data == NULL )
+			 || ( referenced_chunk_index != chunk_index ) )
+			{
+				if( chunk_data != NULL )
+				{
+					if( libewf_internal_handle_release_referenced_chunk_data(
+					     internal_handle,
+					     &chunk_data,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to release chunk: %" PRIu64 " data.",
+						 function,
+						 referenced_chunk_index );
+
+						goto on_error;
+					}
+				}
+				if( libewf_internal_handle_get_referenced_chunk_data(
+				     internal_handle,
+				     chunk_index,
+				     chunk_offset,
+				     &chunk_data,
+				     &chunk_data_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+				referenced_chunk_index = chunk_index;
+			}
+			chunk_data_offset = offset - chunk_offset;
+
+			if( ( chunk_data->data == NULL )
+			 || ( (size_t) chunk_data_offset >= chunk_data->data_size ) )
+			{
+				break;
+			}
+			read_size = chunk_data->data_size - (size_t) chunk_data_offset;
+
+			if( read_size > ( request_size - buffer_offset ) )
+			{
+				read_size = request_size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( read_request->buffer[ buffer_offset ] ),
+			     &( chunk_data->data[ chunk_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			buffer_offset    += read_size;
+			offset           += (off64_t) read_size;
+			total_read_count += (ssize_t) read_size;
+		}
+		read_request->read_size = buffer_offset;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( chunk_data != NULL )
+	{
+		if( libewf_internal_handle_release_referenced_chunk_data(
+		     internal_handle,
+		     &chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk: %" PRIu64 " data.",
+			 function,
+			 referenced_chunk_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 sorted_read_requests );
+
+	return( total_read_count );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_internal_handle_release_referenced_chunk_data(
+		 internal_handle,
+		 &chunk_data,
+		 NULL );
+	}
+	if( sorted_read_requests != NULL )
+	{
+		memory_free(
+		 sorted_read_requests );
+	}
+	return( -1 );
+}
+
+/* Reads (media) data for multiple read requests
+ * Every read request contains an offset, a size and a buffer to read into
+ * The read size of every read request is set to the number of bytes read into its buffer
+ * The current offset is not changed
+ * Returns the total number of bytes read or -1 on error
+ */
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         libewf_read_request_t *read_requests,
+         int number_of_read_requests,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_read_vector";
+	ssize_t read_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libewf_internal_handle_read_vector(
+	              internal_handle,
+	              read_requests,
+	              number_of_read_requests,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read vector.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Prepares a chunk of (media) data before writing according to the handle settings
+ * This function should be used before libewf_handle_write_chunk
+ * The chunk_buffer_size should contain the actual chunk size
+ * The function sets the is_compressed, chunk_checksum and chunk_io_flags values
+ * The LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET chunk_io_flags is set if the checksum was set in checksum_buffer
+ * and needs to be written separately from the chunk data, in case of an uncompressed chunk
+ * Returns the resulting chunk size or -1 on error
+ */
+ssize_t libewf_handle_prepare_write_chunk(
+         libewf_handle_t *handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         void *compressed_chunk_buffer,
+         size_t *compressed_chunk_buffer_size,
+         int8_t *is_compressed,
+         uint32_t *chunk_checksum,
+         int8_t *chunk_io_flags,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_prepare_write_chunk";
+	size_t chunk_padding_size                 = 0;
+	uint64_t chunk_index                      = 0;
+	uint64_t fill_pattern                     = 0;
+	uint32_t chunk_range_flags                = 0;
+	uint8_t compression_flags                 = 0;
+	uint8_t pack_flags                        = 0;
+	int8_t compression_level                  = LIBEWF_COMPRESSION_NONE;
+	int chunk_exists                          = 0;
+	int result                                = 0;
+
+/* TODO chunk data rewrite */
+	size_t compressed_chunk_buffer_offset     = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer_size > (size_t) internal_handle->media_values->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+		 "%s: invalid chunk buffer size: %" PRIzd " value exceeds media values chunk size: %" PRIu32 ".",
+		 function,
+		 chunk_buffer_size,
+		 internal_handle->media_values->chunk_size );
+
+		return( -1 );
+	}
+	if( compressed_chunk_buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_compressed == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is compressed.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( internal_handle->read_io_handle != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+		                internal_handle->chunk_table,
+		                chunk_index,
+		                internal_handle->file_io_pool,
+		                internal_handle->segment_table,
+		                internal_handle->chunk_groups_cache,
+		                internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( chunk_exists == 0 )
+		{
+			if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+			 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+		}
+	}
+	pack_flags = internal_handle->write_io_handle->pack_flags;
+
+	if( chunk_exists == 0 )
+	{
+		compression_level = internal_handle->io_handle->compression_level;
+		compression_flags = internal_handle->io_handle->compression_flags;
+
+		if( ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+		 || ( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
+		{
+			if( ( chunk_buffer_size % 8 ) == 0 )
+			{
+				result = libewf_chunk_data_check_for_64_bit_pattern_fill(
+				          chunk_buffer,
+				          chunk_buffer_size,
+					  &fill_pattern,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if chunk data contains a fill pattern.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
+					{
+						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+						pack_flags |= LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION;
+					}
+					else if( fill_pattern == 0 )
+					{
+						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+					}
+				}
+			}
+			else if( ( compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
+			{
+				result = libewf_chunk_data_check_for_empty_block(
+				          chunk_buffer,
+				          chunk_buffer_size,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if chunk data is an empty block.",
+					 function );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					if( *( (uint8_t *) chunk_buffer ) == 0 )
+					{
+						pack_flags &= ~( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+						pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+						pack_flags |= LIBEWF_PACK_FLAG_USE_EMPTY_BLOCK_COMPRESSION;
+					}
+				}
+			}
+		}
+	}
+	if( libewf_chunk_data_pack_buffer(
+	     chunk_buffer,
+	     chunk_buffer_size,
+	     compressed_chunk_buffer,
+	     &compressed_chunk_buffer_offset,
+	     compressed_chunk_buffer_size,
+	     internal_handle->media_values->chunk_size,
+	     chunk_buffer_size,
+	     &chunk_padding_size,
+	     internal_handle->io_handle->compression_method,
+	     compression_level,
+	     &chunk_range_flags,
+	     chunk_checksum,
+	     chunk_io_flags,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+	     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+	     pack_flags,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		*is_compressed = 1;
+	}
+	else
+	{
+		*is_compressed = 0;
+	}
+	return( (ssize_t) *compressed_chunk_buffer_size );
+}
+
+/* Writes a chunk of (media) data in EWF format at the current offset
+ * the necessary settings of the write values must have been made
+ * chunk_buffer_size contains the size of the data within the buffer while
+ * data_size contains the size of the actual input data
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_chunk(
+         libewf_internal_handle_t *internal_handle,
+         const void *chunk_buffer,
+         size_t chunk_buffer_size,
+         size_t data_size,
+         int8_t is_compressed,
+         void *checksum_buffer,
+         uint32_t chunk_checksum,
+         int8_t chunk_io_flags,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_write_chunk";
+	ssize_t write_count             = 0;
+	uint64_t chunk_index            = 0;
+	int chunk_exists                = 0;
+	int number_of_chunk_views       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_get_number_of_chunk_views(
+	     internal_handle,
+	     &number_of_chunk_views,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk views.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_views > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk views have not been freed.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			goto on_error;
+		}
+		if( libewf_internal_handle_initialize_buffer_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize chunk buffer pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( chunk_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if SIZE_OF_SIZE_T > 4
+	if( chunk_buffer_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk buffer size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( data_size > internal_handle->media_values->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: data size cannot be larger than maximum chunk size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( chunk_buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + data_size ) >= internal_handle->media_values->media_size ) )
+	{
+		data_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing chunk: %" PRIu64 " with chunk buffer of size: %" PRIzd " and data of size: %" PRIzd ".\n",
+		 function,
+		 chunk_index,
+		 chunk_buffer_size,
+		 data_size );
+	}
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The queued chunks are written first so that the chunks are written in order
+	 */
+	if( internal_handle->compression_thread_pool != NULL )
+	{
+		if( libewf_internal_handle_write_packed_chunks(
+		     internal_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( libewf_chunk_data_initialize(
+	     &chunk_data,
+	     0,
+	     internal_handle->chunk_buffer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	if( is_compressed != 0 )
+	{
+		chunk_data->range_flags = LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	}
+	else if( ( chunk_io_flags & LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET ) != 0 )
+	{
+		/* Check if the chunk and checksum buffers are aligned
+		 * if so write the chunk and checksum at the same time
+		 */
+		if( checksum_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid checksum buffer.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 (uint8_t *) checksum_buffer,
+		 chunk_checksum );
+
+		if( checksum_buffer == &( ( (uint8_t *) chunk_buffer )[ chunk_buffer_size ] ) )
+		{
+			chunk_buffer_size += 4;
+
+			chunk_io_flags &= ~( LIBEWF_CHUNK_IO_FLAG_CHECKSUM_SET );
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 (uint8_t *) checksum_buffer,
+			 chunk_data->checksum );
+		}
+		chunk_data->range_flags = LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	chunk_data->data                = (uint8_t *) chunk_buffer;
+	chunk_data->allocated_data_size = chunk_buffer_size;
+	chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_NON_MANAGED_DATA;
+	chunk_data->chunk_io_flags      = chunk_io_flags;
+
+	chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+	                internal_handle->chunk_table,
+	                chunk_index,
+	                internal_handle->file_io_pool,
+	                internal_handle->segment_table,
+	                internal_handle->chunk_groups_cache,
+	                internal_handle->current_offset,
+			error );
+
+	if( chunk_exists == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( chunk_exists == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing chunk: %" PRIu64 ".",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( chunk_exists != 0 )
+	{
+		chunk_data->data_size = data_size;
+
+		chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_DELTA;
+
+		write_count = libewf_write_io_handle_write_existing_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               internal_handle->file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->delta_segment_table,
+		               internal_handle->delta_chunks_range_list,
+			       internal_handle->current_offset,
+		               chunk_index,
+		               chunk_data,
+		               chunk_buffer_size,
+		               error );
+	}
+	else
+	{
+		chunk_data->data_size = chunk_buffer_size;
+
+		write_count = libewf_write_io_handle_write_new_chunk(
+		               internal_handle->write_io_handle,
+		               internal_handle->io_handle,
+		               internal_handle->file_io_pool,
+		               internal_handle->media_values,
+		               internal_handle->segment_table,
+		               internal_handle->header_values,
+		               internal_handle->hash_values,
+		               internal_handle->hash_sections,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               chunk_index,
+		               chunk_data,
+		               data_size,
+		               error );
+	}
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write raw chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_handle->current_offset += (off64_t) data_size;
+
+	if( libewf_chunk_data_free(
+	     &chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) chunk_buffer_size );
+
+on_error:
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a chunk of (media) data in EWF format at the current offset
+ * the necessary settings of the write values must have been made
+ * chunk_buffer_size contains the size of the data within the buffer while
+ * data_size contains the size of the actual input data
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_chunk(
+         libewf_handle_t *handle,
+         const void *chunk_buffer,
+         size_t chunk_buffer_size,
+         size_t data_size,
+         int8_t is_compressed,
+         void *checksum_buffer,
+         uint32_t chunk_checksum,
+         int8_t chunk_io_flags,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_chunk";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_chunk(
+	               internal_handle,
+	               chunk_buffer,
+	               chunk_buffer_size,
+	               data_size,
+	               is_compressed,
+	               checksum_buffer,
+	               chunk_checksum,
+	               chunk_io_flags,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write chunk.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_buffer(
+         libewf_internal_handle_t *internal_handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data   = NULL;
+	static char *function             = "libewf_internal_handle_write_buffer";
+	off64_t chunk_data_offset         = 0;
+	size_t buffer_offset              = 0;
+	size_t input_data_size            = 0;
+	size_t write_size                 = 0;
+	ssize_t write_count               = 0;
+	uint64_t chunk_index              = 0;
+	uint64_t number_of_chunks_written = 0;
+	int chunk_exists                  = 0;
+	int write_chunk                   = 0;
+	int number_of_chunk_views         = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_get_number_of_chunk_views(
+	     internal_handle,
+	     &number_of_chunk_views,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk views.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_views > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk views have not been freed.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing subhandle write.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->values_initialized == 0 )
+	{
+		if( libewf_write_io_handle_initialize_values(
+		     internal_handle->write_io_handle,
+		     internal_handle->io_handle,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize write IO handle values.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_internal_handle_initialize_buffer_pool(
+		     internal_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize chunk buffer pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+	{
+		return( 0 );
+	}
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( (size64_t) ( internal_handle->current_offset + buffer_size ) >= internal_handle->media_values->media_size ) )
+	{
+		buffer_size = (size_t) ( internal_handle->media_values->media_size - internal_handle->current_offset );
+	}
+	chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+	if( chunk_index >= (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data_offset = chunk_index * internal_handle->media_values->chunk_size;
+	chunk_data_offset = internal_handle->current_offset - chunk_data_offset;
+
+	if( chunk_data_offset >= (off64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk data offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_size > 0 )
+	{
+		/* Check if we are in read and write mode
+		 */
+		if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+		 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+		{
+			chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+			                internal_handle->chunk_table,
+			                chunk_index,
+			                internal_handle->file_io_pool,
+			                internal_handle->segment_table,
+			                internal_handle->chunk_groups_cache,
+			                internal_handle->current_offset,
+					error );
+
+			if( chunk_exists == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			else if( chunk_exists == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( ( chunk_data_offset != 0 )
+			 || ( buffer_size < internal_handle->media_values->chunk_size ) )
+			{
+/* TODO optimize reuse data obtained in libewf_chunk_table_chunk_exists_for_offset */
+				if( libewf_chunk_table_get_chunk_data_by_offset(
+				     internal_handle->chunk_table,
+				     chunk_index,
+				     internal_handle->io_handle,
+				     internal_handle->file_io_pool,
+				     internal_handle->media_values,
+				     internal_handle->segment_table,
+				     internal_handle->delta_chunks_range_list,
+				     internal_handle->chunk_groups_cache,
+				     internal_handle->chunks_cache,
+				     internal_handle->current_offset,
+				     &chunk_data,
+				     &chunk_data_offset,
+				     internal_handle->compression_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to read chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				/* A chunk that contains a fill pattern needs to be expanded before it can be modified
+				 */
+				if( libewf_chunk_data_expand_fill(
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to expand chunk: %" PRIu64 " fill pattern.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( (off64_t) chunk_data_offset > (off64_t) chunk_data->data_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+					 "%s: chunk: %" PRIu64 " offset exceeds data size.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				write_size = (size_t) ( chunk_data->data_size - chunk_data_offset );
+
+				if( write_size > buffer_size )
+				{
+					write_size = buffer_size;
+				}
+				if( write_size == 0 )
+				{
+					break;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: updating chunk: %" PRIu64 " data at offset: %" PRIu64 " with size: %" PRIzd ".\n",
+					 function,
+					 chunk_index,
+					 chunk_data_offset,
+					 write_size );
+				}
+#endif
+			}
+			else
+			{
+				/* Reserve 4 bytes for the chunk checksum
+				 */
+				if( libewf_chunk_data_initialize(
+				     &chunk_data,
+				     (size_t) internal_handle->media_values->chunk_size + 4,
+				     internal_handle->chunk_buffer_pool,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( chunk_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: missing chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+				if( libewf_chunk_table_set_chunk_data_by_offset(
+				     internal_handle->chunk_table,
+				     chunk_index,
+				     internal_handle->file_io_pool,
+				     internal_handle->segment_table,
+				     internal_handle->delta_chunks_range_list,
+				     internal_handle->chunk_groups_cache,
+				     internal_handle->chunks_cache,
+				     internal_handle->current_offset,
+				     chunk_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					libewf_chunk_data_free(
+					 &chunk_data,
+					 NULL );
+
+					return( -1 );
+				}
+				/* chunks_cache takes over management of chunk_data
+				 */
+				chunk_data->data_size = internal_handle->media_values->chunk_size;
+
+				write_size = chunk_data->data_size;
+			}
+			if( memory_copy(
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_offset += write_size;
+			buffer_size   -= write_size;
+
+			input_data_size = chunk_data->data_size;
+
+			/* For now ignore the default pack flags when creating a delta chunk
+			 */
+			if( libewf_chunk_data_pack(
+			     chunk_data,
+			     internal_handle->media_values->chunk_size,
+			     LIBEWF_COMPRESSION_METHOD_NONE,
+			     LIBEWF_COMPRESSION_NONE,
+			     0,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+			     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+			     LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+			     internal_handle->compression_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to pack chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_DELTA;
+
+			write_count = libewf_write_io_handle_write_existing_chunk(
+				       internal_handle->write_io_handle,
+				       internal_handle->io_handle,
+				       internal_handle->file_io_pool,
+				       internal_handle->media_values,
+				       internal_handle->delta_segment_table,
+				       internal_handle->delta_chunks_range_list,
+				       internal_handle->current_offset,
+				       chunk_index,
+				       chunk_data,
+				       input_data_size,
+				       error );
+
+			if( write_count <= 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write existing chunk.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			number_of_chunks_written = internal_handle->write_io_handle->number_of_chunks_written;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			/* The queued chunks directly follow the chunks written
+			 */
+			number_of_chunks_written += (uint64_t) internal_handle->number_of_compression_jobs;
+#endif
+			if( chunk_index < number_of_chunks_written )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+				 "%s: chunk: %" PRIu64 " already set.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( internal_handle->write_io_handle->write_finalized != 0 )
+			{
+				break;
+			}
+			if( internal_handle->chunk_data == NULL )
+			{
+				/* Reserve 4 bytes for the chunk checksum
+				 */
+				if( libewf_chunk_data_initialize(
+				     &( internal_handle->chunk_data ),
+				     (size_t) internal_handle->media_values->chunk_size + 4,
+				     internal_handle->chunk_buffer_pool,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create chunk: %" PRIu64 " data.",
+					 function,
+					 chunk_index );
+
+					return( -1 );
+				}
+			}
+			if( internal_handle->chunk_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: internal handle - missing chunk: %" PRIu64 " data.",
+				 function,
+				 chunk_index );
+
+				return( -1 );
+			}
+			if( chunk_data_offset > internal_handle->media_values->chunk_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: chunk offset exceeds chunk data size.",
+				 function );
+
+				return( -1 );
+			}
+			write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+
+			if( write_size > buffer_size )
+			{
+				write_size = buffer_size;
+			}
+			if( write_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to chunk data.",
+				 function );
+
+				return( -1 );
+			}
+			internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+
+			buffer_offset += write_size;
+			buffer_size   -= write_size;
+
+			if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
+			{
+				write_chunk = 1;
+			}
+			else if( ( internal_handle->media_values->media_size != 0 )
+			      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
+			{
+				write_chunk = 1;
+			}
+			else
+			{
+				write_chunk = 0;
+			}
+			if( write_chunk != 0 )
+			{
+				input_data_size = internal_handle->chunk_data->data_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+				if( internal_handle->compression_thread_pool != NULL )
+				{
+					/* The chunk is packed by a compression thread and written in chunk order
+					 */
+					if( libewf_internal_handle_queue_chunk(
+					     internal_handle,
+					     chunk_index,
+					     &( internal_handle->chunk_data ),
+					     input_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to queue chunk: %" PRIu64 " to be packed.",
+						 function,
+						 chunk_index );
+
+						return( -1 );
+					}
+				}
+				else
+#endif
+				{
+					if( libewf_chunk_data_pack(
+					     internal_handle->chunk_data,
+					     internal_handle->media_values->chunk_size,
+					     internal_handle->io_handle->compression_method,
+					     internal_handle->io_handle->compression_level,
+					     internal_handle->io_handle->compression_flags,
+					     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+					     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+					     internal_handle->write_io_handle->pack_flags,
+					     internal_handle->compression_context,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GENERIC,
+						 "%s: unable to pack chunk: %" PRIu64 " data.",
+						 function,
+						 chunk_index );
+
+						return( -1 );
+					}
+					write_count = libewf_write_io_handle_write_new_chunk(
+						       internal_handle->write_io_handle,
+						       internal_handle->io_handle,
+						       internal_handle->file_io_pool,
+						       internal_handle->media_values,
+						       internal_handle->segment_table,
+						       internal_handle->header_values,
+						       internal_handle->hash_values,
+						       internal_handle->hash_sections,
+						       internal_handle->sessions,
+						       internal_handle->tracks,
+						       internal_handle->acquiry_errors,
+						       chunk_index,
+						       internal_handle->chunk_data,
+						       input_data_size,
+						       error );
+
+					if( write_count <= 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write new chunk.",
+						 function );
+
+						return( -1 );
+					}
+					if( libewf_chunk_data_free(
+					     &( internal_handle->chunk_data ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free chunk data.",
+						 function );
+
+						return( -1 );
+					}
+				}
+			}
+		}
+		chunk_index      += 1;
+		chunk_data_offset = 0;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( ( internal_handle->media_values->media_size != 0 )
+		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes (media) data at the current offset
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_buffer(
+	               internal_handle,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at a specific offset,
+ * the necessary settings of the write values must have been made
+ * Will initialize write if necessary
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libewf_handle_write_buffer_at_offset(
+         libewf_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libewf_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		write_count = -1;
+	}
+	else
+	{
+		write_count = libewf_internal_handle_write_buffer(
+		               internal_handle,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_internal_handle_write_finalize(
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_internal_handle_write_finalize";
+	size64_t segment_file_size          = 0;
+	size_t input_data_size              = 0;
+	ssize_t write_count                 = 0;
+	ssize_t write_finalize_count        = 0;
+	uint64_t chunk_index                = 0;
+	uint32_t number_of_segments         = 0;
+	uint32_t segment_number             = 0;
+	int chunk_exists                    = 0;
+	int file_io_pool_entry              = -1;
+	int number_of_chunk_views           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_internal_handle_get_number_of_chunk_views(
+	     internal_handle,
+	     &number_of_chunk_views,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk views.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_views > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk views have not been freed.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		if( internal_handle->chunk_data != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: invalid handle - chunk data set.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle->write_finalized != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The queued chunks precede the remaining chunk data
+	 */
+	if( internal_handle->compression_thread_pool != NULL )
+	{
+		if( libewf_internal_handle_write_packed_chunks(
+		     internal_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunks.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( internal_handle->chunk_data != NULL )
+	{
+		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+
+		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
+				internal_handle->chunk_table,
+				chunk_index,
+				internal_handle->file_io_pool,
+				internal_handle->segment_table,
+				internal_handle->chunk_groups_cache,
+				internal_handle->current_offset,
+				error );
+
+		if( chunk_exists == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( chunk_exists != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: chunk: %" PRIu64 " already exists.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		input_data_size = internal_handle->chunk_data->data_size;
+
+		if( libewf_chunk_data_pack(
+		     internal_handle->chunk_data,
+		     internal_handle->media_values->chunk_size,
+		     internal_handle->io_handle->compression_method,
+		     internal_handle->io_handle->compression_level,
+		     internal_handle->io_handle->compression_flags,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
+		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
+		     internal_handle->write_io_handle->pack_flags,
+		     internal_handle->compression_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to pack chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		write_count = libewf_write_io_handle_write_new_chunk(
+			       internal_handle->write_io_handle,
+			       internal_handle->io_handle,
+			       internal_handle->file_io_pool,
+			       internal_handle->media_values,
+			       internal_handle->segment_table,
+			       internal_handle->header_values,
+			       internal_handle->hash_values,
+			       internal_handle->hash_sections,
+			       internal_handle->sessions,
+			       internal_handle->tracks,
+			       internal_handle->acquiry_errors,
+			       chunk_index,
+			       internal_handle->chunk_data,
+			       input_data_size,
+			       error );
+
+		if( write_count <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write new chunk.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+
+		if( libfcache_cache_set_value_by_index(
+		     internal_handle->chunks_cache,
+		     chunk_index % internal_handle->number_of_chunks_cache_entries,
+		     0,
+		     internal_handle->current_offset,
+		     0,
+		     (intptr_t *) internal_handle->chunk_data,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
+		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set chunk: %" PRIu64 " data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* chunks_cache takes over management of chunk_data
+		 */
+		internal_handle->chunk_data = NULL;
+	}
+	/* Check if all media data has been written
+	 */
+	if( ( internal_handle->media_values->media_size != 0 )
+	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	{
+		return( write_finalize_count );
+	}
+	if( libewf_segment_table_get_number_of_segments(
+	     internal_handle->segment_table,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments == 0 )
+	{
+		/* No segment file needs to be created
+		 */
+/* TODO clean up this logic: when is this triggered? */
+		if( internal_handle->media_values->media_size != 0 )
+		{
+			return( write_finalize_count );
+		}
+		/* Create the segment file if required
+		 */
+		if( libewf_write_io_handle_create_segment_file(
+		     internal_handle->io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->segment_table,
+		     internal_handle->io_handle->segment_file_type,
+		     0,
+		     internal_handle->write_io_handle->maximum_number_of_segments,
+		     internal_handle->media_values->set_identifier,
+		     &file_io_pool_entry,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create segment file: 0.",
+			 function );
+
+			return( -1 );
+		}
+		write_count = libewf_segment_file_write_start(
+		               segment_file,
+		               internal_handle->file_io_pool,
+		               file_io_pool_entry,
+		               &( internal_handle->write_io_handle->case_data ),
+		               &( internal_handle->write_io_handle->case_data_size ),
+		               &( internal_handle->write_io_handle->device_information ),
+		               &( internal_handle->write_io_handle->device_information_size ),
+		               &( internal_handle->write_io_handle->data_section ),
+		               internal_handle->media_values,
+		               internal_handle->header_values,
+		               internal_handle->write_io_handle->timestamp,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write segment file: 0 start.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	else
+	{
+		segment_number = number_of_segments - 1;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     internal_handle->segment_table,
+		     segment_number,
+		     internal_handle->file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+	}
+	/* Set segment file to the correct offset if write is resumed
+	 */
+	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     internal_handle->file_io_pool,
+		     file_io_pool_entry,
+		     internal_handle->write_io_handle->resume_segment_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
+			 function,
+			 internal_handle->write_io_handle->resume_segment_file_offset,
+			 segment_number );
+
+			return( -1 );
+		}
+		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+	}
+	/* Check if the last segment file is still open for writing
+	 */
+	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	{
+		/* Check if chunks section needs to be corrected
+		 */
+		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
+		{
+			write_count = libewf_write_io_handle_write_chunks_section_end(
+			               internal_handle->write_io_handle,
+			               internal_handle->io_handle,
+				       internal_handle->file_io_pool,
+				       file_io_pool_entry,
+			               segment_file,
+			               error );
+
+			if( write_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunks section end.",
+				 function );
+
+				return( -1 );
+			}
+			write_finalize_count += write_count;
+		}
+		/* Close the segment file
+		 */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: closing last segment file.\n",
+			 function );
+		}
+#endif
+		write_count = libewf_segment_file_write_close(
+		               segment_file,
+		               internal_handle->file_io_pool,
+		               file_io_pool_entry,
+		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
+		               1,
+		               internal_handle->hash_sections,
+		               internal_handle->hash_values,
+		               internal_handle->media_values,
+		               internal_handle->sessions,
+		               internal_handle->tracks,
+		               internal_handle->acquiry_errors,
+		               &( internal_handle->write_io_handle->data_section ),
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to close segment file.",
+			 function );
+
+			return( -1 );
+		}
+		write_finalize_count += write_count;
+	}
+	/* Correct the media values if streamed write was used
+	 */
+	if( internal_handle->media_values->media_size == 0 )
+	{
+		/* Determine the media values
+		 */
+		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
+		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
+		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
+
+		/* Flush the section write caches
+		 */
+		if( internal_handle->write_io_handle->case_data != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->case_data );
+
+			internal_handle->write_io_handle->case_data      = NULL;
+			internal_handle->write_io_handle->case_data_size = 0;
+		}
+		if( internal_handle->write_io_handle->device_information != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->device_information );
+
+			internal_handle->write_io_handle->device_information      = NULL;
+			internal_handle->write_io_handle->device_information_size = 0;
+		}
+		if( internal_handle->write_io_handle->data_section != NULL )
+		{
+			memory_free(
+			 internal_handle->write_io_handle->data_section );
+
+			internal_handle->write_io_handle->data_section = NULL;
+		}
+		/* Correct the sections in the segment files
+		 */
+		if( libewf_write_io_handle_finalize_write_sections_corrections(
+		     internal_handle->write_io_handle,
+		     internal_handle->file_io_pool,
+		     internal_handle->media_values,
+		     internal_handle->segment_table,
+		     internal_handle->header_values,
+		     internal_handle->hash_values,
+		     internal_handle->hash_sections,
+		     internal_handle->sessions,
+		     internal_handle->tracks,
+		     internal_handle->acquiry_errors,
+		     error ) != 1 )
+
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sections corrections to segment files.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	internal_handle->write_io_handle->write_finalized = 1;
+
+	return( write_finalize_count );
+}
+
+/* Finalizes the write by correcting the EWF the meta data in the segment files
+ * This function is required after write from stream
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_handle_write_finalize(
+         libewf_handle_t *handle,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_write_finalize";
+	ssize_t write_count                       = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libewf_internal_handle_write_finalize(
+	               internal_handle,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to finalize write.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - chunk data set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_handle->media_values->media_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking media data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libewf_handle_seek_offset(
+         libewf_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libewf_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_offset(
+     libewf_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Determines if a chunk is sparse, that is it only contains 0-byte values
+ * Only the chunk data of chunks that use a pattern fill or that are compressed
+ * to the size of a fill encoding is read, other chunks are considered not sparse
+ * If multi-threading is supported the chunk table mutex must be held
+ * Returns 1 if the chunk is sparse, 0 if not or -1 on error
+ */
+int libewf_internal_handle_chunk_is_sparse(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *chunk_data = NULL;
+	static char *function           = "libewf_internal_handle_chunk_is_sparse";
+	size64_t chunk_data_size        = 0;
+	off64_t chunk_data_offset       = 0;
+	off64_t chunk_offset            = 0;
+	uint32_t range_flags            = 0;
+	uint8_t pattern_index           = 0;
+	int file_io_pool_entry          = 0;
+	int result                      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_offset = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	result = libewf_chunk_table_get_chunk_range_by_offset(
+	          internal_handle->chunk_table,
+	          chunk_index,
+	          internal_handle->file_io_pool,
+	          internal_handle->segment_table,
+	          internal_handle->delta_chunks_range_list,
+	          internal_handle->chunk_groups_cache,
+	          chunk_offset,
+	          &file_io_pool_entry,
+	          &chunk_data_offset,
+	          &chunk_data_size,
+	          &range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " range.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	/* A missing chunk is read as zero bytes but also reported as a checksum error
+	 * hence it is not considered sparse
+	 */
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & ( LIBEWF_RANGE_FLAG_IS_DELTA | LIBEWF_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) == 0 )
+	{
+		if( ( internal_handle->io_handle->compression_method != LIBEWF_COMPRESSION_METHOD_DEFLATE )
+		 || ( chunk_data_size > (size64_t) LIBEWF_MAXIMUM_FILL_ENCODING_SIZE ) )
+		{
+			return( 0 );
+		}
+	}
+	if( libewf_chunk_table_get_chunk_data_by_offset(
+	     internal_handle->chunk_table,
+	     chunk_index,
+	     internal_handle->io_handle,
+	     internal_handle->file_io_pool,
+	     internal_handle->media_values,
+	     internal_handle->segment_table,
+	     internal_handle->delta_chunks_range_list,
+	     internal_handle->chunk_groups_cache,
+	     internal_handle->chunks_cache,
+	     chunk_offset,
+	     &chunk_data,
+	     &chunk_data_offset,
+	     internal_handle->compression_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk: %" PRIu64 " data.",
+		 function,
+		 chunk_index );
+
+		return( -1 );
+	}
+	if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_IS_FILL ) == 0 )
+	{
+		return( 0 );
+	}
+	for( pattern_index = 0;
+	     pattern_index < 8;
+	     pattern_index++ )
+	{
+		if( chunk_data->fill_pattern[ pattern_index ] != 0 )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the next range of (media) data that is not sparse
+ * A sparse range only contains 0-byte values, for example unallocated
+ * regions of the media, which can be skipped when exporting or mounting
+ * The ranges are determined per chunk using the chunk table and the
+ * pattern fill and empty-block encodings, hence most chunks are not read
+ * At most LIBEWF_MAXIMUM_DATA_RANGE_SCAN_CHUNKS chunks are scanned per call, if no data
+ * was found in the scanned chunks the data offset is set to the end of the scanned chunks
+ * and the data size to 0, a data range that continues beyond the scanned chunks is truncated
+ * Returns 1 if successful, 0 if no more data or -1 on error
+ */
+int libewf_internal_handle_get_next_data_range(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libewf_internal_handle_get_next_data_range";
+	off64_t data_range_end    = 0;
+	off64_t data_range_start  = 0;
+	uint64_t chunk_index      = 0;
+	uint64_t last_chunk_index = 0;
+	uint64_t number_of_chunks = 0;
+	uint8_t is_sparse         = 1;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->media_values->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->media_values->media_size )
+	{
+		return( 0 );
+	}
+	number_of_chunks = internal_handle->media_values->media_size / internal_handle->media_values->chunk_size;
+
+	if( ( internal_handle->media_values->media_size % internal_handle->media_values->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	chunk_index = (uint64_t) offset / internal_handle->media_values->chunk_size;
+
+	/* The number of scanned chunks is limited so that a call does not need
+	 * to walk the entire chunk table of a large image
+	 */
+	last_chunk_index = chunk_index + LIBEWF_MAXIMUM_DATA_RANGE_SCAN_CHUNKS;
+
+	if( last_chunk_index > number_of_chunks )
+	{
+		last_chunk_index = number_of_chunks;
+	}
+	/* Determine the start of the data range by skipping the sparse chunks
+	 * and afterwards the end of the data range by skipping the non-sparse chunks
+	 */
+	while( chunk_index < last_chunk_index )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		result = libewf_internal_handle_chunk_is_sparse(
+		          internal_handle,
+		          chunk_index,
+		          error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunk table mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if chunk: %" PRIu64 " is sparse.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		if( is_sparse != 0 )
+		{
+			if( result == 0 )
+			{
+				data_range_start = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+				if( data_range_start < offset )
+				{
+					data_range_start = offset;
+				}
+				is_sparse = 0;
+			}
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+		chunk_index++;
+
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	data_range_end = (off64_t) chunk_index * internal_handle->media_values->chunk_size;
+
+	if( (size64_t) data_range_end > internal_handle->media_values->media_size )
+	{
+		data_range_end = (off64_t) internal_handle->media_values->media_size;
+	}
+	if( is_sparse != 0 )
+	{
+		if( chunk_index >= number_of_chunks )
+		{
+			return( 0 );
+		}
+		/* No data was found in the scanned chunks, the caller continues at the data offset
+		 */
+		data_range_start = data_range_end;
+	}
+	*data_offset = data_range_start;
+	*data_size   = (size64_t) ( data_range_end - data_range_start );
+
+	return( 1 );
+}
+
+/* Retrieves the next range of (media) data that is not sparse
+ * A sparse range only contains 0-byte values and does not need to be read
+ * The data offset is set to the start of the data range at or after the offset
+ * The number of chunks scanned per call is limited, if no data was found in the scanned
+ * chunks the data size is 0 and the data offset is the offset to continue the scan from
+ * Returns 1 if successful, 0 if no more data or -1 on error
+ */
+int libewf_handle_get_next_data_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_next_data_range";
+	int result                                = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_internal_handle_get_next_data_range(
+	          internal_handle,
+	          offset,
+	          data_offset,
+	          data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data range at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_maximum_number_of_open_handles(
+     libewf_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The file IO pool can be in use by the read-ahead threads
+		 */
+		if( libcthreads_mutex_grab(
+		     internal_handle->chunk_table_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( result == 1 )
+		{
+			if( libbfio_pool_set_maximum_number_of_open_handles(
+			     internal_handle->file_io_pool,
+			     maximum_number_of_open_handles,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set maximum number of open handles in file IO handle.",
+				 function );
+
+				result = -1;
+			}
+			else if( internal_handle->mapped_file_pool != NULL )
+			{
+				if( libewf_mapped_file_pool_set_maximum_number_of_mapped_files(
+				     internal_handle->mapped_file_pool,
+				     maximum_number_of_open_handles,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set maximum number of mapped files in mapped file pool.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( ( result == 1 )
+			 && ( internal_handle->async_io != NULL ) )
+			{
+				if( libewf_async_io_set_maximum_number_of_open_files(
+				     internal_handle->async_io,
+				     maximum_number_of_open_handles,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set maximum number of open files in asynchronous IO.",
+					 function );
+
+					result = -1;
+				}
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the cache size
+ * A cache size of 0 represents the default cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_cache_size(
+     libewf_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*cache_size = internal_handle->cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the cache size
+ * The cache size is the number of bytes used by the chunk groups and chunks caches
+ * A cache size of 0 represents the default cache size
+ * The caches of a handle that is open for reading are resized, which empties them
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_cache_size";
+	size64_t previous_cache_size              = 0;
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	previous_cache_size         = internal_handle->cache_size;
+	internal_handle->cache_size = cache_size;
+
+	if( internal_handle->file_io_pool != NULL )
+	{
+		/* The caches of a handle opened for writing can contain chunk groups
+		 * that have not been written yet
+		 */
+		if( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_WRITE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+			 "%s: cache size cannot be changed while the handle is open for writing.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		/* The caches can be in use by the read-ahead threads
+		 */
+		else if( libcthreads_mutex_grab(
+		          internal_handle->chunk_table_mutex,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunk table mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		else
+		{
+			if( libewf_internal_handle_initialize_caches(
+			     internal_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to resize caches.",
+				 function );
+
+				result = -1;
+			}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_handle->chunk_table_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release chunk table mutex.",
+				 function );
+
+				result = -1;
+			}
+#endif
+		}
+		if( result != 1 )
+		{
+			internal_handle->cache_size = previous_cache_size;
+		}
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the cache policy
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_cache_policy(
+     libewf_handle_t *handle,
+     uint8_t *cache_policy,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_cache_policy";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( cache_policy == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache policy.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*cache_policy = internal_handle->cache_policy;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the cache policy
+ * The cache policy must be set before the handle is opened
+ * The 2Q cache policy is only used when the handle is opened for reading only
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_cache_policy(
+     libewf_handle_t *handle,
+     uint8_t cache_policy,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_cache_policy";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( ( cache_policy != LIBEWF_CACHE_POLICY_DIRECT )
+	 && ( cache_policy != LIBEWF_CACHE_POLICY_2Q ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cache policy.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: cache policy cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->cache_policy = cache_policy;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the packed chunk table
+ * A size of 0 represents the packed chunk table is not used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_packed_chunk_table_size(
+     libewf_handle_t *handle,
+     size64_t *packed_chunk_table_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_packed_chunk_table_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( packed_chunk_table_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*packed_chunk_table_size = internal_handle->maximum_packed_chunk_table_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the packed chunk table
+ * A size of 0 disables the packed chunk table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_packed_chunk_table_size(
+     libewf_handle_t *handle,
+     size64_t packed_chunk_table_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_packed_chunk_table_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: packed chunk table size cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->maximum_packed_chunk_table_size = packed_chunk_table_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the compressed chunk cache
+ * A size of 0 represents the compressed chunk cache is not used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_compressed_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *compressed_chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_compressed_chunk_cache_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( compressed_chunk_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed chunk cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*compressed_chunk_cache_size = internal_handle->maximum_compressed_chunk_cache_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the compressed chunk cache
+ * A size of 0 disables the compressed chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_compressed_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t compressed_chunk_cache_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_compressed_chunk_cache_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: compressed chunk cache size cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->maximum_compressed_chunk_cache_size = compressed_chunk_cache_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the read-ahead buffer
+ * A size of 0 represents the read-ahead buffer is not used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_read_ahead_buffer_size(
+     libewf_handle_t *handle,
+     size64_t *read_ahead_buffer_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_read_ahead_buffer_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( read_ahead_buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*read_ahead_buffer_size = internal_handle->maximum_read_ahead_buffer_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the read-ahead buffer
+ * The read-ahead buffer is used for sequential reads of the segment files
+ * A size of 0 disables the read-ahead buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_ahead_buffer_size(
+     libewf_handle_t *handle,
+     size64_t read_ahead_buffer_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_ahead_buffer_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: read-ahead buffer size cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else if( read_ahead_buffer_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid read-ahead buffer size value exceeds maximum.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->maximum_read_ahead_buffer_size = read_ahead_buffer_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the maximum size of the buffer pool
+ * A size of 0 represents the buffer pool is not used
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_buffer_pool_size(
+     libewf_handle_t *handle,
+     size64_t *buffer_pool_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_buffer_pool_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( buffer_pool_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer pool size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*buffer_pool_size = internal_handle->maximum_buffer_pool_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the buffer pool
+ * The buffer pool keeps unused chunk data buffers for reuse
+ * A size of 0 disables the buffer pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_buffer_pool_size(
+     libewf_handle_t *handle,
+     size64_t buffer_pool_size,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_buffer_pool_size";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: buffer pool size cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else if( buffer_pool_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer pool size value exceeds maximum.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->maximum_buffer_pool_size = buffer_pool_size;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-					return( -1 );
-				}
-			}
-			if( internal_handle->chunk_data == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: internal handle - missing chunk: %" PRIu64 " data.",
-				 function,
-				 chunk_index );
+/* Retrieves the value to indicate if the segment files are read memory mapped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_read_memory_mapped(
+     libewf_handle_t *handle,
+     uint8_t *read_memory_mapped,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_read_memory_mapped";
 
-				return( -1 );
-			}
-			if( chunk_data_offset > internal_handle->media_values->chunk_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-				 "%s: chunk offset exceeds chunk data size.",
-				 function );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-				return( -1 );
-			}
-			write_size = (size_t) ( internal_handle->media_values->chunk_size - chunk_data_offset );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			if( write_size > buffer_size )
-			{
-				write_size = buffer_size;
-			}
-			if( write_size == 0 )
-			{
-				break;
-			}
-			if( memory_copy(
-			     &( ( internal_handle->chunk_data->data )[ chunk_data_offset ] ),
-			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-			     write_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy buffer to chunk data.",
-				 function );
+	if( read_memory_mapped == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read memory mapped.",
+		 function );
 
-				return( -1 );
-			}
-			internal_handle->chunk_data->data_size = (size_t) ( chunk_data_offset + write_size );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			buffer_offset += write_size;
-			buffer_size   -= write_size;
+		return( -1 );
+	}
+#endif
+	*read_memory_mapped = internal_handle->read_memory_mapped;
 
-			if( internal_handle->chunk_data->data_size == internal_handle->media_values->chunk_size )
-			{
-				write_chunk = 1;
-			}
-			else if( ( internal_handle->media_values->media_size != 0 )
-			      && ( ( (size64_t) internal_handle->current_offset + write_size ) == internal_handle->media_values->media_size ) )
-			{
-				write_chunk = 1;
-			}
-			else
-			{
-				write_chunk = 0;
-			}
-			if( write_chunk != 0 )
-			{
-				input_data_size = internal_handle->chunk_data->data_size;
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-				if( libewf_chunk_data_pack(
-				     internal_handle->chunk_data,
-				     internal_handle->media_values->chunk_size,
-				     internal_handle->io_handle->compression_method,
-				     internal_handle->io_handle->compression_level,
-				     internal_handle->io_handle->compression_flags,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-				     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-				     internal_handle->write_io_handle->pack_flags,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GENERIC,
-					 "%s: unable to pack chunk: %" PRIu64 " data.",
-					 function,
-					 chunk_index );
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
 
-					return( -1 );
-				}
-				write_count = libewf_write_io_handle_write_new_chunk(
-					       internal_handle->write_io_handle,
-					       internal_handle->io_handle,
-					       internal_handle->file_io_pool,
-					       internal_handle->media_values,
-					       internal_handle->segment_table,
-					       internal_handle->header_values,
-					       internal_handle->hash_values,
-					       internal_handle->hash_sections,
-					       internal_handle->sessions,
-					       internal_handle->tracks,
-					       internal_handle->acquiry_errors,
-					       chunk_index,
-					       internal_handle->chunk_data,
-					       input_data_size,
-					       error );
-
-				if( write_count <= 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_WRITE_FAILED,
-					 "%s: unable to write new chunk.",
-					 function );
+/* Sets the value to indicate if the segment files should be read memory mapped
+ * Memory mapping is only used when the handle is opened read-only using
+ * libewf_handle_open or libewf_handle_open_wide, the number of segment files
+ * that are mapped at the same time is bound by the maximum number of open handles
+ * The segment files must not be truncated while mapped since this raises SIGBUS
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_read_memory_mapped(
+     libewf_handle_t *handle,
+     uint8_t read_memory_mapped,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_read_memory_mapped";
+	int result                                = 1;
 
-					return( -1 );
-				}
-				if( libewf_chunk_data_free(
-				     &( internal_handle->chunk_data ),
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-					 "%s: unable to free chunk data.",
-					 function );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-					return( -1 );
-				}
-			}
-		}
-		chunk_index      += 1;
-		chunk_data_offset = 0;
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-		internal_handle->current_offset += (off64_t) write_size;
+#if !defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_SUPPORT )
+	if( read_memory_mapped != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: memory mapped files not supported.",
+		 function );
 
-		if( ( internal_handle->media_values->media_size != 0 )
-		 && ( (size64_t) internal_handle->current_offset >= internal_handle->media_values->media_size ) )
-		{
-			break;
-		}
-		if( internal_handle->io_handle->abort != 0 )
-		{
-			break;
-		}
+		return( -1 );
 	}
-	return( (ssize_t) buffer_offset );
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: read memory mapped cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_handle->read_memory_mapped = read_memory_mapped;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Retrieves the asynchronous IO queue depth
+ * A queue depth of 0 represents asynchronous IO is not used
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_buffer_at_offset(
-         libewf_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libewf_handle_get_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error )
 {
-	static char *function = "libewf_handle_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_async_io_queue_depth";
 
-	if( libewf_handle_seek_offset(
-	     handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( queue_depth == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid queue depth.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libewf_handle_write_buffer(
-	               handle,
-	               buffer,
-	               buffer_size,
-	               error );
+#endif
+	*queue_depth = internal_handle->async_io_queue_depth;
 
-	if( write_count < 0 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
+#endif
+	return( 1 );
 }
 
-/* Finalizes the write by correcting the EWF the meta data in the segment files
- * This function is required after write from stream
- * Returns the number of bytes written or -1 on error
+/* Sets the asynchronous IO queue depth
+ * Asynchronous IO is only used when the handle is opened read-only using
+ * libewf_handle_open or libewf_handle_open_wide and the segment files are not read memory mapped
+ * A queue depth of 0 disables asynchronous IO
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libewf_handle_write_finalize(
-         libewf_handle_t *handle,
-         libcerror_error_t **error )
+int libewf_handle_set_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error )
 {
 	libewf_internal_handle_t *internal_handle = NULL;
-	libewf_segment_file_t *segment_file       = NULL;
-	static char *function                     = "libewf_handle_write_finalize";
-	size64_t segment_file_size                = 0;
-	size_t input_data_size                    = 0;
-	ssize_t write_count                       = 0;
-	ssize_t write_finalize_count              = 0;
-	uint64_t chunk_index                      = 0;
-	uint32_t number_of_segments               = 0;
-	uint32_t segment_number                   = 0;
-	int chunk_exists                          = 0;
-	int file_io_pool_entry                    = -1;
+	static char *function                     = "libewf_handle_set_async_io_queue_depth";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -6963,499 +18021,374 @@ ssize_t libewf_handle_write_finalize(
 	}
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
+	if( ( queue_depth < 0 )
+	 || ( queue_depth > LIBEWF_ASYNC_IO_MAXIMUM_QUEUE_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+#if !defined( HAVE_LIBEWF_ASYNC_IO_SUPPORT )
+	if( queue_depth != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: asynchronous IO not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		if( internal_handle->chunk_data != NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: invalid handle - chunk data set.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( internal_handle->write_io_handle == NULL )
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing write IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+#endif
+	if( internal_handle->file_io_pool != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: asynchronous IO queue depth cannot be changed while the handle is open.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+	else
+	{
+		internal_handle->async_io_queue_depth = queue_depth;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->write_io_handle->write_finalized != 0 )
-	{
-		return( 0 );
-	}
-	if( ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_READ ) != 0 )
-	 && ( ( internal_handle->io_handle->access_flags & LIBEWF_ACCESS_FLAG_RESUME ) == 0 ) )
-	{
-		return( 0 );
-	}
-	if( internal_handle->chunk_data != NULL )
-	{
-		chunk_index = internal_handle->current_offset / internal_handle->media_values->chunk_size;
+#endif
+	return( result );
+}
 
-		chunk_exists = libewf_chunk_table_chunk_exists_for_offset(
-				internal_handle->chunk_table,
-				chunk_index,
-				internal_handle->file_io_pool,
-				internal_handle->segment_table,
-				internal_handle->chunk_groups_cache,
-				internal_handle->current_offset,
-				error );
+/* Retrieves the deflate backend
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_deflate_backend(
+     libewf_handle_t *handle,
+     uint8_t *deflate_backend,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_deflate_backend";
 
-		if( chunk_exists == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to determine if the chunk: %" PRIu64 " exists.",
-			 function,
-			 chunk_index );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
-		if( chunk_exists != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-			 "%s: chunk: %" PRIu64 " already exists.",
-			 function,
-			 chunk_index );
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
 
-			return( -1 );
-		}
-		input_data_size = internal_handle->chunk_data->data_size;
+	if( deflate_backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid deflate backend.",
+		 function );
 
-		if( libewf_chunk_data_pack(
-		     internal_handle->chunk_data,
-		     internal_handle->media_values->chunk_size,
-		     internal_handle->io_handle->compression_method,
-		     internal_handle->io_handle->compression_level,
-		     internal_handle->io_handle->compression_flags,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block,
-		     internal_handle->write_io_handle->compressed_zero_byte_empty_block_size,
-		     internal_handle->write_io_handle->pack_flags,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GENERIC,
-			 "%s: unable to pack chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
-		write_count = libewf_write_io_handle_write_new_chunk(
-			       internal_handle->write_io_handle,
-			       internal_handle->io_handle,
-			       internal_handle->file_io_pool,
-			       internal_handle->media_values,
-			       internal_handle->segment_table,
-			       internal_handle->header_values,
-			       internal_handle->hash_values,
-			       internal_handle->hash_sections,
-			       internal_handle->sessions,
-			       internal_handle->tracks,
-			       internal_handle->acquiry_errors,
-			       chunk_index,
-			       internal_handle->chunk_data,
-			       input_data_size,
-			       error );
+		return( -1 );
+	}
+#endif
+	*deflate_backend = internal_handle->deflate_backend;
 
-		if( write_count <= 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write new chunk.",
-			 function );
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
 
-		if( libfcache_cache_set_value_by_index(
-		     internal_handle->chunks_cache,
-		     chunk_index % LIBEWF_MAXIMUM_CACHE_ENTRIES_CHUNKS,
-		     0,
-		     internal_handle->current_offset,
-		     0,
-		     (intptr_t *) internal_handle->chunk_data,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_chunk_data_free,
-		     LIBFCACHE_CACHE_VALUE_FLAG_MANAGED,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set chunk: %" PRIu64 " data.",
-			 function,
-			 chunk_index );
+/* Sets the deflate backend
+ * The deflate backend must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_deflate_backend(
+     libewf_handle_t *handle,
+     uint8_t deflate_backend,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_set_deflate_backend";
+	int result                                = 1;
 
-			return( -1 );
-		}
-		/* chunks_cache takes over management of chunk_data
-		 */
-		internal_handle->chunk_data = NULL;
-	}
-	/* Check if all media data has been written
-	 */
-	if( ( internal_handle->media_values->media_size != 0 )
-	 && ( internal_handle->write_io_handle->input_write_count < (ssize64_t) internal_handle->media_values->media_size ) )
+	if( handle == NULL )
 	{
-		return( write_finalize_count );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
 	}
-	if( libewf_segment_table_get_number_of_segments(
-	     internal_handle->segment_table,
-	     &number_of_segments,
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_segments == 0 )
+#endif
+	if( internal_handle->file_io_pool != NULL )
 	{
-		/* No segment file needs to be created
-		 */
-/* TODO clean up this logic: when is this triggered? */
-		if( internal_handle->media_values->media_size != 0 )
-		{
-			return( write_finalize_count );
-		}
-		/* Create the segment file if required
-		 */
-		if( libewf_write_io_handle_create_segment_file(
-		     internal_handle->io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->segment_table,
-		     internal_handle->io_handle->segment_file_type,
-		     0,
-		     internal_handle->write_io_handle->maximum_number_of_segments,
-		     internal_handle->media_values->set_identifier,
-		     &file_io_pool_entry,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to create segment file: 0.",
-			 function );
-
-			return( -1 );
-		}
-		write_count = libewf_segment_file_write_start(
-		               segment_file,
-		               internal_handle->file_io_pool,
-		               file_io_pool_entry,
-		               &( internal_handle->write_io_handle->case_data ),
-		               &( internal_handle->write_io_handle->case_data_size ),
-		               &( internal_handle->write_io_handle->device_information ),
-		               &( internal_handle->write_io_handle->device_information_size ),
-		               &( internal_handle->write_io_handle->data_section ),
-		               internal_handle->media_values,
-		               internal_handle->header_values,
-		               internal_handle->write_io_handle->timestamp,
-		               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: deflate backend cannot be changed while the handle is open.",
+		 function );
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write segment file: 0 start.",
-			 function );
+		result = -1;
+	}
+	else if( libewf_compression_context_set_deflate_backend(
+	          internal_handle->compression_context,
+	          deflate_backend,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set deflate backend in compression context.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		result = -1;
 	}
 	else
 	{
-		segment_number = number_of_segments - 1;
+		internal_handle->deflate_backend = deflate_backend;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		if( libewf_segment_table_get_segment_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     &file_io_pool_entry,
-		     &segment_file_size,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+		return( -1 );
+	}
+#endif
+	return( result );
+}
 
-			return( -1 );
-		}
-		if( libewf_segment_table_get_segment_file_by_index(
-		     internal_handle->segment_table,
-		     segment_number,
-		     internal_handle->file_io_pool,
-		     &segment_file,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve segment file: %" PRIu32 " from segment table.",
-			 function,
-			 segment_number );
+/* Retrieves the cache statistics
+ * The number of hits is the number of chunks that were read from the cache
+ * and the number of misses the number of chunks that needed to be unpacked
+ * The statistics are reset when the caches are created or resized
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libewf_internal_handle_t *internal_handle = NULL;
+	static char *function                     = "libewf_handle_get_cache_statistics";
 
-			return( -1 );
-		}
-		if( segment_file == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing segment file: %" PRIu32 ".",
-			 function,
-			 segment_number );
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	/* Set segment file to the correct offset if write is resumed
-	 */
-	if( internal_handle->write_io_handle->resume_segment_file_offset > 0 )
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( number_of_hits == NULL )
 	{
-		if( libbfio_pool_seek_offset(
-		     internal_handle->file_io_pool,
-		     file_io_pool_entry,
-		     internal_handle->write_io_handle->resume_segment_file_offset,
-		     SEEK_SET,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to seek resume segment file offset: %" PRIi64 " in segment file: %" PRIu32 ".",
-			 function,
-			 internal_handle->write_io_handle->resume_segment_file_offset,
-			 segment_number );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
 
-			return( -1 );
-		}
-		internal_handle->write_io_handle->resume_segment_file_offset = 0;
+		return( -1 );
 	}
-	/* Check if the last segment file is still open for writing
-	 */
-	if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_WRITE_OPEN ) != 0 )
+	if( number_of_misses == NULL )
 	{
-		/* Check if chunks section needs to be corrected
-		 */
-		if( internal_handle->write_io_handle->chunks_section_offset != 0 )
-		{
-			write_count = libewf_write_io_handle_write_chunks_section_end(
-			               internal_handle->write_io_handle,
-			               internal_handle->io_handle,
-				       internal_handle->file_io_pool,
-				       file_io_pool_entry,
-			               segment_file,
-			               error );
-
-			if( write_count == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write chunks section end.",
-				 function );
-
-				return( -1 );
-			}
-			write_finalize_count += write_count;
-		}
-		/* Close the segment file
-		 */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: closing last segment file.\n",
-			 function );
-		}
-#endif
-		write_count = libewf_segment_file_write_close(
-		               segment_file,
-		               internal_handle->file_io_pool,
-		               file_io_pool_entry,
-		               internal_handle->write_io_handle->number_of_chunks_written_to_segment_file,
-		               1,
-		               internal_handle->hash_sections,
-		               internal_handle->hash_values,
-		               internal_handle->media_values,
-		               internal_handle->sessions,
-		               internal_handle->tracks,
-		               internal_handle->acquiry_errors,
-		               &( internal_handle->write_io_handle->data_section ),
-		               error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
 
-		if( write_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to close segment file.",
-			 function );
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-			return( -1 );
-		}
-		write_finalize_count += write_count;
+		return( -1 );
 	}
-	/* Correct the media values if streamed write was used
+	/* The statistics are updated by concurrent reads while holding the chunk table mutex
 	 */
-	if( internal_handle->media_values->media_size == 0 )
+	if( libcthreads_mutex_grab(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
 	{
-		/* Determine the media values
-		 */
-		internal_handle->media_values->number_of_chunks  = internal_handle->write_io_handle->number_of_chunks_written;
-		internal_handle->media_values->number_of_sectors = (uint64_t) ( internal_handle->write_io_handle->input_write_count / internal_handle->media_values->bytes_per_sector );
-		internal_handle->media_values->media_size        = (size64_t) internal_handle->write_io_handle->input_write_count;
-
-		/* Flush the section write caches
-		 */
-		if( internal_handle->write_io_handle->case_data != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->case_data );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunk table mutex.",
+		 function );
 
-			internal_handle->write_io_handle->case_data      = NULL;
-			internal_handle->write_io_handle->case_data_size = 0;
-		}
-		if( internal_handle->write_io_handle->device_information != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->device_information );
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
 
-			internal_handle->write_io_handle->device_information      = NULL;
-			internal_handle->write_io_handle->device_information_size = 0;
-		}
-		if( internal_handle->write_io_handle->data_section != NULL )
-		{
-			memory_free(
-			 internal_handle->write_io_handle->data_section );
+		return( -1 );
+	}
+#endif
+	*number_of_hits   = internal_handle->number_of_cache_hits;
+	*number_of_misses = internal_handle->number_of_cache_misses;
 
-			internal_handle->write_io_handle->data_section = NULL;
-		}
-		/* Correct the sections in the segment files
-		 */
-		if( libewf_write_io_handle_finalize_write_sections_corrections(
-		     internal_handle->write_io_handle,
-		     internal_handle->file_io_pool,
-		     internal_handle->media_values,
-		     internal_handle->segment_table,
-		     internal_handle->header_values,
-		     internal_handle->hash_values,
-		     internal_handle->hash_sections,
-		     internal_handle->sessions,
-		     internal_handle->tracks,
-		     internal_handle->acquiry_errors,
-		     error ) != 1 )
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     internal_handle->chunk_table_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunk table mutex.",
+		 function );
 
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write sections corrections to segment files.",
-			 function );
+		libcthreads_read_write_lock_release_for_read(
+		 internal_handle->read_write_lock,
+		 NULL );
 
-			return( -1 );
-		}
+		return( -1 );
 	}
-	internal_handle->write_io_handle->write_finalized = 1;
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-	return( write_finalize_count );
+		return( -1 );
+	}
+#endif
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Sets the read-ahead values
+ * The read-ahead values must be set before the handle is opened
+ * Returns 1 if successful or -1 on error
  */
-off64_t libewf_handle_seek_offset(
-         libewf_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     int maximum_number_of_chunks,
+     libcerror_error_t **error )
 {
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_seek_offset";
+#endif
+	static char *function                     = "libewf_handle_set_read_ahead_values";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7468,97 +18401,113 @@ off64_t libewf_handle_seek_offset(
 
 		return( -1 );
 	}
-	internal_handle = (libewf_internal_handle_t *) handle;
-
-	if( internal_handle->chunk_data != NULL )
+	if( number_of_threads < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - chunk data set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values == NULL )
+	if( ( maximum_number_of_chunks < 0 )
+	 || ( maximum_number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_CHUNKS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing media values.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of chunks value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->media_values->chunk_size == 0 )
+#if !defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - invalid media values - missing chunk size.",
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+#else
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_handle->media_values->media_size;
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: read-ahead values cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	else
 	{
-		libcnotify_printf(
-		 "%s: seeking media data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		if( maximum_number_of_chunks == 0 )
+		{
+			maximum_number_of_chunks = 2 * number_of_threads;
+
+			if( maximum_number_of_chunks > LIBEWF_MAXIMUM_READ_AHEAD_CHUNKS )
+			{
+				maximum_number_of_chunks = LIBEWF_MAXIMUM_READ_AHEAD_CHUNKS;
+			}
+		}
+		internal_handle->number_of_read_ahead_threads        = number_of_threads;
+		internal_handle->maximum_number_of_read_ahead_chunks = maximum_number_of_chunks;
 	}
-#endif
-	if( offset < 0 )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Sets the number of threads used to scan the segment files when the handle is opened
+ * The number of scan threads must be set before the handle is opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_get_offset(
+int libewf_handle_set_number_of_scan_threads(
      libewf_handle_t *handle,
-     off64_t *offset,
+     int number_of_threads,
      libcerror_error_t **error )
 {
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_get_offset";
+#endif
+	static char *function                     = "libewf_handle_set_number_of_scan_threads";
+	int result                                = 1;
 
 	if( handle == NULL )
 	{
@@ -7571,68 +18520,184 @@ int libewf_handle_get_offset(
 
 		return( -1 );
 	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#else
 	internal_handle = (libewf_internal_handle_t *) handle;
 
-	if( offset == NULL )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	*offset = internal_handle->current_offset;
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: number of scan threads cannot be changed while the handle is open.",
+		 function );
 
-	return( 1 );
+		result = -1;
+	}
+	else
+	{
+		/* No more threads are used than segment files fit in the segment files cache
+		 */
+		if( number_of_threads > LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES )
+		{
+			number_of_threads = LIBEWF_MAXIMUM_CACHE_ENTRIES_SEGMENT_FILES;
+		}
+		internal_handle->number_of_scan_threads = number_of_threads;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
+/* Sets the number of threads used to pack the chunks when writing
+ * The chunks are packed concurrently and written in chunk order, hence the segment files
+ * are identical to those written without compression threads
+ * The number of compression threads must be set before the handle is opened
  * Returns 1 if successful or -1 on error
  */
-int libewf_handle_set_maximum_number_of_open_handles(
+int libewf_handle_set_number_of_compression_threads(
      libewf_handle_t *handle,
-     int maximum_number_of_open_handles,
+     int number_of_threads,
      libcerror_error_t **error )
 {
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	libewf_internal_handle_t *internal_handle = NULL;
-	static char *function                     = "libewf_handle_set_maximum_number_of_open_handles";
+#endif
+	static char *function                     = "libewf_handle_set_number_of_compression_threads";
+	int result                                = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
 
-	if( handle == NULL )
+		return( -1 );
+	}
+#if !defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
 		 function );
 
 		return( -1 );
 	}
+#else
 	internal_handle = (libewf_internal_handle_t *) handle;
 
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
 	if( internal_handle->file_io_pool != NULL )
 	{
-		if( libbfio_pool_set_maximum_number_of_open_handles(
-		     internal_handle->file_io_pool,
-		     maximum_number_of_open_handles,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: number of compression threads cannot be changed while the handle is open.",
+		 function );
 
-			return( -1 );
+		result = -1;
+	}
+	else
+	{
+		if( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS )
+		{
+			number_of_threads = LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS;
 		}
+		internal_handle->number_of_compression_threads = number_of_threads;
 	}
-	internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-	return( 1 );
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
 /* Determine if the segment files are corrupted
@@ -7892,6 +18957,141 @@ int libewf_handle_set_segment_filename(
 	return( 1 );
 }
 
+/* Sets the index filename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *index_file_io_handle          = NULL;
+	libbfio_handle_t *previous_index_file_io_handle = NULL;
+	libewf_internal_handle_t *internal_handle       = NULL;
+	static char *function                           = "libewf_handle_set_index_filename";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libbfio_file_initialize(
+	     &index_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     index_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: index filename cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		previous_index_file_io_handle = internal_handle->index_file_io_handle;
+
+		internal_handle->index_file_io_handle = index_file_io_handle;
+
+		/* The previous index file IO handle is freed after the lock is released
+		 */
+		index_file_io_handle = previous_index_file_io_handle;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &index_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	if( index_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &index_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
 /* Retrieves the segment filename size
@@ -8073,6 +19273,141 @@ int libewf_handle_set_segment_filename_wide(
 	return( 1 );
 }
 
+/* Sets the index filename
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *index_file_io_handle          = NULL;
+	libbfio_handle_t *previous_index_file_io_handle = NULL;
+	libewf_internal_handle_t *internal_handle       = NULL;
+	static char *function                           = "libewf_handle_set_index_filename_wide";
+	int result                                      = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libewf_internal_handle_t *) handle;
+
+	if( libbfio_file_initialize(
+	     &index_file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     index_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set index filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( internal_handle->file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: index filename cannot be changed while the handle is open.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		previous_index_file_io_handle = internal_handle->index_file_io_handle;
+
+		internal_handle->index_file_io_handle = index_file_io_handle;
+
+		/* The previous index file IO handle is freed after the lock is released
+		 */
+		index_file_io_handle = previous_index_file_io_handle;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	if( index_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &index_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free index file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	if( index_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &index_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
 #endif
 
 /* Retrieves the maximum segment file size
@@ -9143,6 +20478,7 @@ int libewf_internal_handle_get_media_values(
 			     internal_handle->current_offset,
 			     &chunk_data,
 			     &chunk_data_offset,
+			     internal_handle->compression_context,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -9178,6 +20514,7 @@ int libewf_internal_handle_get_media_values(
 			     chunk_data,
 			     internal_handle->media_values->chunk_size,
 			     internal_handle->io_handle->compression_method,
+			     internal_handle->compression_context,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
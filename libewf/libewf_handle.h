@@ -25,20 +25,28 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_async_io.h"
+#include "libewf_buffer_pool.h"
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
+#include "libewf_compression_context.h"
 #include "libewf_extern.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
 #include "libewf_libfcache.h"
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
+#include "libewf_mapped_file_pool.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
+#include "libewf_segment_file.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
@@ -56,6 +64,35 @@
 extern "C" {
 #endif
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_compression_job libewf_compression_job_t;
+
+/* The compression job contains a chunk that is packed by a compression thread
+ * The packed chunks are written in chunk order by the writing thread
+ */
+struct libewf_compression_job
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* The result of packing the chunk data
+	 * 1 if packed, -1 on error or 0 if not yet packed
+	 */
+	int result;
+};
+
+#endif
+
 typedef struct libewf_internal_handle libewf_internal_handle_t;
 
 struct libewf_internal_handle
@@ -112,6 +149,14 @@ struct libewf_internal_handle
 	 */
 	libewf_segment_table_t *delta_segment_table;
 
+	/* The index file IO handle
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
+
 	/* The chunk table
 	 */
 	libewf_chunk_table_t *chunk_table;
@@ -128,6 +173,72 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The number of chunks cache entries
+	 */
+	int number_of_chunks_cache_entries;
+
+	/* The cache size, 0 represents the default cache size
+	 */
+	size64_t cache_size;
+
+	/* The maximum number of (table) entries of a chunk group
+	 * this is used to determine the size of a cached chunk group
+	 */
+	uint32_t maximum_number_of_chunk_group_entries;
+
+	/* The cache policy
+	 */
+	uint8_t cache_policy;
+
+	/* The chunk cache
+	 * only used by the 2Q cache policy, the chunks cache then only contains packed chunks
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The number of chunks that were read from the cache
+	 */
+	uint64_t number_of_cache_hits;
+
+	/* The number of chunks that were not read from the cache
+	 */
+	uint64_t number_of_cache_misses;
+
+	/* The maximum size of the packed chunk table, 0 represents the packed chunk table is not used
+	 */
+	size64_t maximum_packed_chunk_table_size;
+
+	/* The maximum size of the compressed chunk cache, 0 represents the compressed chunk cache is not used
+	 */
+	size64_t maximum_compressed_chunk_cache_size;
+
+	/* The maximum size of the segment file read-ahead buffer, 0 represents the read-ahead buffer is not used
+	 */
+	size64_t maximum_read_ahead_buffer_size;
+
+	/* The maximum size of the unused chunk buffers that are kept for reuse, 0 represents the buffer pool is not used
+	 */
+	size64_t maximum_buffer_pool_size;
+
+	/* The buffer pool of the chunk data buffers
+	 */
+	libewf_buffer_pool_t *chunk_buffer_pool;
+
+	/* Value to indicate if the segment files should be read memory mapped
+	 */
+	uint8_t read_memory_mapped;
+
+	/* The pool of the memory mapped segment files
+	 */
+	libewf_mapped_file_pool_t *mapped_file_pool;
+
+	/* The asynchronous IO queue depth, 0 represents asynchronous IO is not used
+	 */
+	int async_io_queue_depth;
+
+	/* The asynchronous IO
+	 */
+	libewf_async_io_t *async_io;
+
 	/* The chunk group
 	 */
 	libewf_chunk_group_t *chunk_group;
@@ -163,8 +274,130 @@ struct libewf_internal_handle
 	/* The single files
 	 */
 	libewf_single_files_t *single_files;
+
+	/* The deflate backend
+	 */
+	uint8_t deflate_backend;
+
+	/* The compression context
+	 */
+	libewf_compression_context_t *compression_context;
+
+	/* The number of chunk views that have not been freed
+	 */
+	int number_of_chunk_views;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The chunk table mutex
+	 * serializes access to the chunk table, the caches and the file IO pool
+	 * when reading concurrently
+	 */
+	libcthreads_mutex_t *chunk_table_mutex;
+
+	/* The read-ahead thread pool
+	 */
+	libcthreads_thread_pool_t *read_ahead_thread_pool;
+
+	/* The number of read-ahead threads
+	 */
+	int number_of_read_ahead_threads;
+
+	/* The maximum number of chunks to read ahead
+	 */
+	int maximum_number_of_read_ahead_chunks;
+
+	/* The offset at which the next sequential read is expected
+	 */
+	off64_t read_ahead_offset;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t read_ahead_chunk_index;
+
+	/* Value to indicate the read-ahead should be aborted
+	 */
+	uint8_t read_ahead_abort;
+
+	/* The compression contexts that are available to the reading threads
+	 */
+	libcdata_array_t *compression_contexts;
+
+	/* The number of threads used to scan the segment files when opening
+	 */
+	int number_of_scan_threads;
+
+	/* The number of threads used to pack chunks when writing
+	 */
+	int number_of_compression_threads;
+
+	/* The compression thread pool
+	 */
+	libcthreads_thread_pool_t *compression_thread_pool;
+
+	/* The compression jobs mutex
+	 */
+	libcthreads_mutex_t *compression_jobs_mutex;
+
+	/* The compression jobs condition
+	 * signalled when a compression thread has packed a chunk
+	 */
+	libcthreads_condition_t *compression_jobs_condition;
+
+	/* The compression jobs, a circular queue of the chunks in chunk order
+	 * that are packed or being packed but not yet written
+	 */
+	libewf_compression_job_t **compression_jobs;
+
+	/* The maximum number of compression jobs
+	 */
+	int maximum_number_of_compression_jobs;
+
+	/* The index of the first compression job
+	 */
+	int first_compression_job_index;
+
+	/* The number of compression jobs
+	 */
+	int number_of_compression_jobs;
+#endif
 };
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_segment_file_scan libewf_segment_file_scan_t;
+
+/* The segment file scan contains the values of a segment file
+ * that is scanned by a worker thread when the segment files are opened
+ */
+struct libewf_segment_file_scan
+{
+	/* The (private) file IO pool
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The segment file
+	 */
+	libewf_segment_file_t *segment_file;
+};
+
+#endif
+
 LIBEWF_EXTERN \
 int libewf_handle_initialize(
      libewf_handle_t **handle,
@@ -204,6 +437,28 @@ int libewf_handle_open_wide(
      libcerror_error_t **error );
 #endif
 
+int libewf_internal_handle_initialize_caches(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_buffer_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_insert_index_file_packed_chunk_groups(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_open_file_io_pool(
      libewf_handle_t *handle,
@@ -216,8 +471,32 @@ int libewf_handle_open_read_segment_file_section_data(
      libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
+     libewf_index_segment_t *index_segment,
      libcerror_error_t **error );
 
+int libewf_handle_open_read_indexed_segment_file(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint32_t segment_number,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_scan_segment_file(
+     libewf_segment_file_scan_t *segment_file_scan,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_scan_segment_files(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint32_t first_segment_number,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+#endif
+
 int libewf_handle_open_read_segment_files(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -235,6 +514,10 @@ int libewf_handle_open_read_delta_segment_files(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
+int libewf_internal_handle_close(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_close(
      libewf_handle_t *handle,
@@ -252,6 +535,16 @@ ssize_t libewf_handle_prepare_read_chunk(
          int8_t chunk_io_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_chunk(
+         libewf_internal_handle_t *internal_handle,
+         void *chunk_buffer,
+         size_t chunk_buffer_size,
+         int8_t *is_compressed,
+         void *checksum_buffer,
+         uint32_t *chunk_checksum,
+         int8_t *chunk_io_flags,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_chunk(
          libewf_handle_t *handle,
@@ -263,6 +556,111 @@ ssize_t libewf_handle_read_chunk(
          int8_t *chunk_io_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_read_buffer_from_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_chunk_data_t **packed_chunk_data,
+         off64_t *chunk_data_offset,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_from_packed_chunk(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libewf_chunk_data_t **packed_chunk_data,
+         off64_t chunk_data_offset,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_read_packed_chunk_direct(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint8_t **packed_data,
+     const uint8_t **mapped_data,
+     int *mapped_file_io_pool_entry,
+     size_t *read_size,
+     uint32_t *range_flags,
+     uint32_t *chunk_checksum,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_from_chunk_direct(
+         libewf_internal_handle_t *internal_handle,
+         uint64_t chunk_index,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         uint8_t **packed_data,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_set_unpacked_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t chunk_offset,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_get_compression_context(
+     libewf_internal_handle_t *internal_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_release_compression_context(
+     libewf_internal_handle_t *internal_handle,
+     libewf_compression_context_t **compression_context,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_chunk(
+     uint64_t *chunk_index,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_initialize_compression_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_free_compression_thread_pool(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_pack_chunk(
+     libewf_compression_job_t *compression_job,
+     libewf_internal_handle_t *internal_handle );
+
+int libewf_internal_handle_write_packed_chunks(
+     libewf_internal_handle_t *internal_handle,
+     int maximum_number_of_compression_jobs,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_queue_chunk(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t input_data_size,
+     libcerror_error_t **error );
+
+#endif
+
+ssize_t libewf_internal_handle_read_buffer_at_offset(
+         libewf_internal_handle_t *internal_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
@@ -278,6 +676,70 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_reference_cached_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     libewf_chunk_data_t **packed_chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_referenced_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     off64_t offset,
+     libewf_chunk_data_t **chunk_data,
+     off64_t *chunk_data_offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_release_referenced_chunk_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_release_chunk_view_data(
+     libewf_internal_handle_t *internal_handle,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_number_of_chunk_views(
+     libewf_internal_handle_t *internal_handle,
+     int *number_of_chunk_views,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libewf_chunk_view_t **chunk_view,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_compare_read_requests(
+     const void *first_read_request,
+     const void *second_read_request );
+
+int libewf_internal_handle_prefetch_chunks(
+     libewf_internal_handle_t *internal_handle,
+     const libewf_read_request_t **read_requests,
+     int number_of_read_requests,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_vector(
+         libewf_internal_handle_t *internal_handle,
+         libewf_read_request_t *read_requests,
+         int number_of_read_requests,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_vector(
+         libewf_handle_t *handle,
+         libewf_read_request_t *read_requests,
+         int number_of_read_requests,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_prepare_write_chunk(
          libewf_handle_t *handle,
@@ -290,6 +752,17 @@ ssize_t libewf_handle_prepare_write_chunk(
          int8_t *chunk_io_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_chunk(
+         libewf_internal_handle_t *internal_handle,
+         const void *chunk_buffer,
+         size_t chunk_buffer_size,
+         size_t data_size,
+         int8_t is_compressed,
+         void *checksum_buffer,
+         uint32_t chunk_checksum,
+         int8_t chunk_io_flags,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_chunk(
          libewf_handle_t *handle,
@@ -302,6 +775,12 @@ ssize_t libewf_handle_write_chunk(
          int8_t chunk_io_flags,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_buffer(
+         libewf_internal_handle_t *internal_handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_buffer(
          libewf_handle_t *handle,
@@ -317,11 +796,21 @@ ssize_t libewf_handle_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_finalize(
+         libewf_internal_handle_t *internal_handle,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_finalize(
          libewf_handle_t *handle,
          libcerror_error_t **error );
 
+off64_t libewf_internal_handle_seek_offset(
+         libewf_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 off64_t libewf_handle_seek_offset(
          libewf_handle_t *handle,
@@ -335,12 +824,166 @@ int libewf_handle_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+int libewf_internal_handle_chunk_is_sparse(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_next_data_range(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_next_data_range(
+     libewf_handle_t *handle,
+     off64_t offset,
+     off64_t *data_offset,
+     size64_t *data_size,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_set_maximum_number_of_open_handles(
      libewf_handle_t *handle,
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_size(
+     libewf_handle_t *handle,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_size(
+     libewf_handle_t *handle,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_policy(
+     libewf_handle_t *handle,
+     uint8_t *cache_policy,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_policy(
+     libewf_handle_t *handle,
+     uint8_t cache_policy,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_packed_chunk_table_size(
+     libewf_handle_t *handle,
+     size64_t *packed_chunk_table_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_packed_chunk_table_size(
+     libewf_handle_t *handle,
+     size64_t packed_chunk_table_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_compressed_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t *compressed_chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_compressed_chunk_cache_size(
+     libewf_handle_t *handle,
+     size64_t compressed_chunk_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_ahead_buffer_size(
+     libewf_handle_t *handle,
+     size64_t *read_ahead_buffer_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_buffer_size(
+     libewf_handle_t *handle,
+     size64_t read_ahead_buffer_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_buffer_pool_size(
+     libewf_handle_t *handle,
+     size64_t *buffer_pool_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_buffer_pool_size(
+     libewf_handle_t *handle,
+     size64_t buffer_pool_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_read_memory_mapped(
+     libewf_handle_t *handle,
+     uint8_t *read_memory_mapped,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_memory_mapped(
+     libewf_handle_t *handle,
+     uint8_t read_memory_mapped,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int *queue_depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_async_io_queue_depth(
+     libewf_handle_t *handle,
+     int queue_depth,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_deflate_backend(
+     libewf_handle_t *handle,
+     uint8_t *deflate_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_deflate_backend(
+     libewf_handle_t *handle,
+     uint8_t deflate_backend,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_read_ahead_values(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     int maximum_number_of_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_scan_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -393,6 +1036,22 @@ int libewf_handle_set_segment_filename_wide(
      libcerror_error_t **error );
 #endif
 
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+#endif
+
 LIBEWF_EXTERN \
 int libewf_handle_get_maximum_segment_size(
      libewf_handle_t *handle,
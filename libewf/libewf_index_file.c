@@ -0,0 +1,1209 @@
+/*
+ * Index file functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_definitions.h"
+#include "libewf_index_file.h"
+#include "libewf_index_segment.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_media_values.h"
+
+#include "ewfx_index.h"
+
+const uint8_t ewfx_index_file_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x58, 0x49, 0x4e, 0x44, 0x58 };
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *index_file )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+	int result            = 1;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *index_file )->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( result );
+}
+
+/* Sets the number of segments
+ * The segments are removed if the number of segments changed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_number_of_segments(
+     libewf_index_file_t *index_file,
+     uint32_t number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_index_file_set_number_of_segments";
+	int current_number_of_segments = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_segments > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of segments value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &current_number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( current_number_of_segments == (int) number_of_segments )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_empty(
+	     index_file->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_resize(
+	     index_file->segments_array,
+	     (int) number_of_segments,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize segments array.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->is_modified = 1;
+
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * The index segment is managed by the index file
+ * Returns 1 if successful, 0 if the segment is not indexed or -1 on error
+ */
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_segment_by_index";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_file->segments_array,
+	     (int) segment_index,
+	     (intptr_t **) index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segments array.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	if( *index_segment == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Sets a specific segment
+ * The index file takes over management of the index segment and
+ * frees the index segment that was previously set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *previous_index_segment = NULL;
+	static char *function                          = "libewf_index_file_set_segment_by_index";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_index > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid segment index value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_file->segments_array,
+	     (int) segment_index,
+	     (intptr_t **) &previous_index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from segments array.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_set_entry_by_index(
+	     index_file->segments_array,
+	     (int) segment_index,
+	     (intptr_t *) index_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set segment: %" PRIu32 " in segments array.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	index_file->is_modified = 1;
+
+	if( previous_index_segment != NULL )
+	{
+		if( libewf_index_segment_free(
+		     &previous_index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the media values the index file applies to
+ * The segments are removed if the media values differ from those in the index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_set_media_values(
+     libewf_index_file_t *index_file,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_index_file_set_media_values";
+	int number_of_segments = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media values.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( index_file->segment_file_type == io_handle->segment_file_type )
+	 && ( index_file->major_version == io_handle->major_version )
+	 && ( index_file->minor_version == io_handle->minor_version )
+	 && ( index_file->compression_method == io_handle->compression_method )
+	 && ( index_file->chunk_size == media_values->chunk_size )
+	 && ( memory_compare(
+	       index_file->set_identifier,
+	       media_values->set_identifier,
+	       16 ) == 0 ) )
+	{
+		return( 1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     index_file->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_resize(
+	     index_file->segments_array,
+	     number_of_segments,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     index_file->set_identifier,
+	     media_values->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->segment_file_type  = io_handle->segment_file_type;
+	index_file->major_version      = io_handle->major_version;
+	index_file->minor_version      = io_handle->minor_version;
+	index_file->compression_method = io_handle->compression_method;
+	index_file->chunk_size         = media_values->chunk_size;
+	index_file->is_modified        = 1;
+
+	return( 1 );
+}
+
+/* Reads the index file using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *index_segment = NULL;
+	uint8_t *index_file_data              = NULL;
+	static char *function                 = "libewf_index_file_read_file_io_handle";
+	size64_t index_file_size              = 0;
+	size_t data_offset                    = 0;
+	size_t data_size                      = 0;
+	ssize_t read_count                    = 0;
+	uint32_t calculated_checksum          = 0;
+	uint32_t format_version               = 0;
+	uint32_t number_of_segments           = 0;
+	uint32_t segment_index                = 0;
+	uint32_t stored_checksum              = 0;
+	int file_io_handle_is_open            = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = 1;
+
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &index_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve index file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( index_file_size < (size64_t) ( sizeof( ewfx_index_file_header_t ) + 4 ) )
+	 || ( index_file_size > (size64_t) LIBEWF_MAXIMUM_INDEX_FILE_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid index file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	index_file_data = (uint8_t *) memory_allocate(
+	                               (size_t) index_file_size );
+
+	if( index_file_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek index file offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              index_file_data,
+	              (size_t) index_file_size,
+	              error );
+
+	if( read_count != (ssize_t) index_file_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index file data.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = 0;
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	data_size = (size_t) index_file_size - 4;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( index_file_data[ data_size ] ),
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_file_data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_CHECKSUM_MISMATCH,
+		 "%s: checksum does not match (stored: 0x%08" PRIx32 ", calculated: 0x%08" PRIx32 ").",
+		 function,
+		 stored_checksum,
+		 calculated_checksum );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     ( (ewfx_index_file_header_t *) index_file_data )->signature,
+	     ewfx_index_file_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported index file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->format_version,
+	 format_version );
+
+	if( format_version != LIBEWF_INDEX_FILE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported index file format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->number_of_segments,
+	 number_of_segments );
+
+	index_file->segment_file_type = ( (ewfx_index_file_header_t *) index_file_data )->segment_file_type;
+	index_file->major_version     = ( (ewfx_index_file_header_t *) index_file_data )->major_version;
+	index_file->minor_version     = ( (ewfx_index_file_header_t *) index_file_data )->minor_version;
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->compression_method,
+	 index_file->compression_method );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->chunk_size,
+	 index_file->chunk_size );
+
+	if( memory_copy(
+	     index_file->set_identifier,
+	     ( (ewfx_index_file_header_t *) index_file_data )->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	/* Every segment is stored with at least a segment header
+	 */
+	if( (size_t) number_of_segments > ( ( data_size - sizeof( ewfx_index_file_header_t ) ) / sizeof( ewfx_index_segment_header_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_index_file_set_number_of_segments(
+	     index_file,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewfx_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libewf_index_segment_initialize(
+		     &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create index segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		read_count = libewf_index_segment_read_data(
+		              index_segment,
+		              &( index_file_data[ data_offset ] ),
+		              data_size - data_offset,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read index segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		data_offset += (size_t) read_count;
+
+		if( libewf_index_file_set_segment_by_index(
+		     index_file,
+		     segment_index,
+		     index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set index segment: %" PRIu32 ".",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		index_segment = NULL;
+	}
+	if( data_offset != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: index file size value mismatch.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 index_file_data );
+
+	index_file->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	if( index_segment != NULL )
+	{
+		libewf_index_segment_free(
+		 &index_segment,
+		 NULL );
+	}
+	if( index_file_data != NULL )
+	{
+		memory_free(
+		 index_file_data );
+	}
+	if( file_io_handle_is_open != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index file using a Basic File IO (bfio) handle
+ * Returns 1 if successful, 0 if not all segments are indexed or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libewf_index_segment_t *index_segment = NULL;
+	uint8_t *index_file_data              = NULL;
+	static char *function                 = "libewf_index_file_write_file_io_handle";
+	size_t data_offset                    = 0;
+	size_t data_size                      = 0;
+	size_t segment_data_size              = 0;
+	ssize_t write_count                   = 0;
+	uint32_t calculated_checksum          = 0;
+	int file_io_handle_is_open            = 0;
+	int number_of_segments                = 0;
+	int segment_index                     = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		goto on_error;
+	}
+	data_size = sizeof( ewfx_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d from segments array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( index_segment == NULL )
+		{
+			return( 0 );
+		}
+		if( libewf_index_segment_get_data_size(
+		     index_segment,
+		     &segment_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data size of segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		data_size += segment_data_size;
+
+		if( data_size > (size_t) ( LIBEWF_MAXIMUM_INDEX_FILE_SIZE - 4 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid index file size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	index_file_data = (uint8_t *) memory_allocate(
+	                               data_size + 4 );
+
+	if( index_file_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     index_file_data,
+	     0,
+	     sizeof( ewfx_index_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     ( (ewfx_index_file_header_t *) index_file_data )->signature,
+	     ewfx_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->format_version,
+	 LIBEWF_INDEX_FILE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->number_of_segments,
+	 (uint32_t) number_of_segments );
+
+	( (ewfx_index_file_header_t *) index_file_data )->segment_file_type = index_file->segment_file_type;
+	( (ewfx_index_file_header_t *) index_file_data )->major_version     = index_file->major_version;
+	( (ewfx_index_file_header_t *) index_file_data )->minor_version     = index_file->minor_version;
+
+	byte_stream_copy_from_uint16_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->compression_method,
+	 index_file->compression_method );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_file_header_t *) index_file_data )->chunk_size,
+	 index_file->chunk_size );
+
+	if( memory_copy(
+	     ( (ewfx_index_file_header_t *) index_file_data )->set_identifier,
+	     index_file->set_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy set identifier.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewfx_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &index_segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d from segments array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		write_count = libewf_index_segment_write_data(
+		               index_segment,
+		               &( index_file_data[ data_offset ] ),
+		               data_size - data_offset,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write index segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		data_offset += (size_t) write_count;
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_file_data,
+	     data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( index_file_data[ data_size ] ),
+	 calculated_checksum );
+
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open index file.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = 1;
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               index_file_data,
+	               data_size + 4,
+	               error );
+
+	if( write_count != (ssize_t) ( data_size + 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index file data.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = 0;
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close index file.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 index_file_data );
+
+	index_file->is_modified = 0;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_is_open != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	if( index_file_data != NULL )
+	{
+		memory_free(
+		 index_file_data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,129 @@
+/*
+ * Index file functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_index_segment.h"
+#include "libewf_io_handle.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_media_values.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewfx_index_file_signature[ 8 ];
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+/* The index file is a sidecar file that stores the sections and chunk groups
+ * of the segment files, so that these do not need to be determined again
+ * by reading all section descriptors and table sections when the segment files are opened
+ */
+struct libewf_index_file
+{
+	/* The segment file type
+	 */
+	uint8_t segment_file_type;
+
+	/* The segment file major version
+	 */
+	uint8_t major_version;
+
+	/* The segment file minor version
+	 */
+	uint8_t minor_version;
+
+	/* The compression method
+	 */
+	uint16_t compression_method;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The set identifier
+	 */
+	uint8_t set_identifier[ 16 ];
+
+	/* The segments array
+	 * contains NULL for segment files that are not indexed
+	 */
+	libcdata_array_t *segments_array;
+
+	/* Value to indicate the index file was modified since it was read
+	 */
+	uint8_t is_modified;
+};
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_number_of_segments(
+     libewf_index_file_t *index_file,
+     uint32_t number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_segment_by_index(
+     libewf_index_file_t *index_file,
+     uint32_t segment_index,
+     libewf_index_segment_t *index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_set_media_values(
+     libewf_index_file_t *index_file,
+     libewf_io_handle_t *io_handle,
+     libewf_media_values_t *media_values,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
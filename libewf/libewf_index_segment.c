@@ -0,0 +1,1911 @@
+/*
+ * Index segment functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_index_segment.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcstring.h"
+#include "libewf_libfcache.h"
+#include "libewf_libfdata.h"
+#include "libewf_packed_chunk_table.h"
+#include "libewf_section.h"
+#include "libewf_segment_file.h"
+
+#include "ewf_section.h"
+#include "ewfx_index.h"
+
+/* Creates an index segment
+ * Make sure the value index_segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_initialize(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_initialize";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_segment = memory_allocate_structure(
+	                  libewf_index_segment_t );
+
+	if( *index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_segment,
+	     0,
+	     sizeof( libewf_index_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index segment.",
+		 function );
+
+		memory_free(
+		 *index_segment );
+
+		*index_segment = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *index_segment )->sections_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sections array.",
+		 function );
+
+		goto on_error;
+	}
+	( *index_segment )->device_information_section_index = -1;
+
+	return( 1 );
+
+on_error:
+	if( *index_segment != NULL )
+	{
+		memory_free(
+		 *index_segment );
+
+		*index_segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_free(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_free";
+	int chunk_group_index = 0;
+	int result            = 1;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_segment != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *index_segment )->sections_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_section_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sections array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *index_segment )->chunk_groups != NULL )
+		{
+			memory_free(
+			 ( *index_segment )->chunk_groups );
+		}
+		if( ( *index_segment )->packed_chunk_groups != NULL )
+		{
+			for( chunk_group_index = 0;
+			     chunk_group_index < ( *index_segment )->number_of_packed_chunk_groups;
+			     chunk_group_index++ )
+			{
+				if( libewf_packed_chunk_group_free(
+				     &( ( *index_segment )->packed_chunk_groups[ chunk_group_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free packed chunk group: %d.",
+					 function,
+					 chunk_group_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *index_segment )->packed_chunk_groups );
+		}
+		memory_free(
+		 *index_segment );
+
+		*index_segment = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of sections
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_get_number_of_sections(
+     libewf_index_segment_t *index_segment,
+     int *number_of_sections,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_get_number_of_sections";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_segment->sections_array,
+	     number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sections array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific section
+ * The section is managed by the index segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_get_section_by_index(
+     libewf_index_segment_t *index_segment,
+     int section_index,
+     libewf_section_t **section,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_segment_get_section_by_index";
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_segment->sections_array,
+	     section_index,
+	     (intptr_t **) section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve section: %d from sections array.",
+		 function,
+		 section_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a copy of a section
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_append_section(
+     libewf_index_segment_t *index_segment,
+     libewf_section_t *section,
+     libcerror_error_t **error )
+{
+	libewf_section_t *section_copy = NULL;
+	static char *function          = "libewf_index_segment_append_section";
+	int entry_index                = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_section_clone(
+	     &section_copy,
+	     section,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section copy.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     index_segment->sections_array,
+	     &entry_index,
+	     (intptr_t *) section_copy,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append section to sections array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( section_copy != NULL )
+	{
+		libewf_section_free(
+		 &section_copy,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the sections list, the chunk groups list and related values of a segment file
+ * The segment file file header should have been read and its lists should be empty
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_get_segment_file_values(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_index_chunk_group_t *chunk_group = NULL;
+	libewf_section_t *section               = NULL;
+	static char *function                   = "libewf_index_segment_get_segment_file_values";
+	off64_t section_descriptor_offset       = 0;
+	size_t section_descriptor_size          = 0;
+	int chunk_group_index                   = 0;
+	int element_index                       = 0;
+	int number_of_sections                  = 0;
+	int section_index                       = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->major_version == 1 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v1_t );
+	}
+	else if( segment_file->major_version == 2 )
+	{
+		section_descriptor_size = sizeof( ewf_section_descriptor_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid segment file - unsupported major version.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_segment->sections_array,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sections array.",
+		 function );
+
+		return( -1 );
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_segment->sections_array,
+		     section_index,
+		     (intptr_t **) &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections array.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		/* The section descriptor is stored in front of the section data in EWF version 1
+		 * and at the end of the section data in EWF version 2
+		 */
+		if( segment_file->major_version == 1 )
+		{
+			section_descriptor_offset = section->start_offset;
+		}
+		else
+		{
+			section_descriptor_offset = section->end_offset - section_descriptor_size;
+		}
+		if( libfdata_list_append_element(
+		     segment_file->sections_list,
+		     &element_index,
+		     file_io_pool_entry,
+		     section_descriptor_offset,
+		     (size64_t) section_descriptor_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section: %d to sections list.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		chunk_group = &( index_segment->chunk_groups[ chunk_group_index ] );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     chunk_group->data_offset,
+		     chunk_group->data_size,
+		     chunk_group->range_flags,
+		     chunk_group->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk group: %d to chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+	}
+	segment_file->device_information_section_index = index_segment->device_information_section_index;
+	segment_file->last_section_offset              = index_segment->last_section_offset;
+	segment_file->storage_media_size               = index_segment->storage_media_size;
+	segment_file->number_of_chunks                 = index_segment->number_of_chunks;
+	segment_file->flags                           |= index_segment->segment_file_flags | LIBEWF_SEGMENT_FILE_FLAG_IS_INDEXED;
+
+	return( 1 );
+}
+
+/* Sets the index segment values from a segment file
+ * The sections are not copied, use libewf_index_segment_append_section for these
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_set_segment_file_values(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_chunk_group_t *chunk_groups = NULL;
+	static char *function                    = "libewf_index_segment_set_segment_file_values";
+	size_t chunk_groups_size                 = 0;
+	int chunk_group_file_io_pool_entry       = 0;
+	int chunk_group_index                    = 0;
+	int number_of_chunk_groups               = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->chunk_groups != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment - chunk groups value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunk groups list.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_chunk_groups > 0 )
+	{
+		chunk_groups_size = sizeof( libewf_index_chunk_group_t ) * number_of_chunk_groups;
+
+		if( chunk_groups_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid chunk groups size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_groups = (libewf_index_chunk_group_t *) memory_allocate(
+		                                               chunk_groups_size );
+
+		if( chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+		for( chunk_group_index = 0;
+		     chunk_group_index < number_of_chunk_groups;
+		     chunk_group_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     segment_file->chunk_groups_list,
+			     chunk_group_index,
+			     &chunk_group_file_io_pool_entry,
+			     &( chunk_groups[ chunk_group_index ].data_offset ),
+			     &( chunk_groups[ chunk_group_index ].data_size ),
+			     &( chunk_groups[ chunk_group_index ].range_flags ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk group: %d from chunk groups list.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			if( libfdata_list_get_mapped_size_by_index(
+			     segment_file->chunk_groups_list,
+			     chunk_group_index,
+			     &( chunk_groups[ chunk_group_index ].storage_media_size ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped size of chunk group: %d from chunk groups list.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+		}
+	}
+	index_segment->segment_file_size                = segment_file_size;
+	index_segment->segment_number                   = segment_file->segment_number;
+	index_segment->device_information_section_index = segment_file->device_information_section_index;
+	index_segment->last_section_offset              = segment_file->last_section_offset;
+	index_segment->storage_media_size               = segment_file->storage_media_size;
+	index_segment->number_of_chunks                 = segment_file->number_of_chunks;
+	index_segment->chunk_groups                     = chunk_groups;
+	index_segment->number_of_chunk_groups           = number_of_chunk_groups;
+
+	index_segment->segment_file_flags = segment_file->flags
+	                                  & ( LIBEWF_SEGMENT_FILE_FLAG_IS_LAST
+	                                    | LIBEWF_SEGMENT_FILE_FLAG_IS_ENCRYPTED
+	                                    | LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED );
+
+	return( 1 );
+
+on_error:
+	if( chunk_groups != NULL )
+	{
+		memory_free(
+		 chunk_groups );
+	}
+	return( -1 );
+}
+
+/* Reads the chunk groups of a segment file and sets the packed chunk groups
+ * Chunk groups that cannot be read or packed are not stored in the index segment,
+ * the chunks of these chunk groups are read from the table sections instead
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_read_packed_chunk_groups(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_group_t *packed_chunk_group = NULL;
+	libfcache_cache_t *chunk_groups_cache           = NULL;
+	libfdata_list_t *chunks_list                    = NULL;
+	static char *function                           = "libewf_index_segment_read_packed_chunk_groups";
+	size64_t mapped_offset                          = 0;
+	size64_t mapped_size                            = 0;
+	size_t packed_chunk_groups_size                 = 0;
+	int chunk_group_index                           = 0;
+	int number_of_chunk_groups                      = 0;
+	int result                                      = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->packed_chunk_groups != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment - packed chunk groups value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle->chunk_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunk groups list.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_chunk_groups <= 0 )
+	{
+		return( 1 );
+	}
+	packed_chunk_groups_size = sizeof( libewf_packed_chunk_group_t * ) * number_of_chunk_groups;
+
+	if( packed_chunk_groups_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid packed chunk groups size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	index_segment->packed_chunk_groups = (libewf_packed_chunk_group_t **) memory_allocate(
+	                                                                       packed_chunk_groups_size );
+
+	if( index_segment->packed_chunk_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed chunk groups.",
+		 function );
+
+		goto on_error;
+	}
+	/* A single cache entry suffices since every chunk group is read once
+	 */
+	if( libfcache_cache_initialize(
+	     &chunk_groups_cache,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk groups cache.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size of chunk group: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		result = libfdata_list_get_element_value_by_index(
+		          segment_file->chunk_groups_list,
+		          (intptr_t *) file_io_pool,
+		          chunk_groups_cache,
+		          chunk_group_index,
+		          (intptr_t **) &chunks_list,
+		          0,
+		          error );
+
+		/* The table sections are otherwise only read on demand, hence a chunk group
+		 * that cannot be read is not considered an error here
+		 */
+		if( result != 1 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				if( ( error != NULL )
+				 && ( *error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+			}
+#endif
+			libcerror_error_free(
+			 error );
+		}
+		else if( chunks_list != NULL )
+		{
+			if( libewf_packed_chunk_group_initialize(
+			     &packed_chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create packed chunk group.",
+				 function );
+
+				goto on_error;
+			}
+			result = libewf_packed_chunk_group_set_chunks_list(
+			          packed_chunk_group,
+			          (uint64_t) ( mapped_offset / segment_file->io_handle->chunk_size ),
+			          chunks_list,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set chunks list of chunk group: %d in packed chunk group.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				if( libewf_packed_chunk_group_free(
+				     &packed_chunk_group,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free packed chunk group.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				index_segment->packed_chunk_groups[ index_segment->number_of_packed_chunk_groups ] = packed_chunk_group;
+
+				index_segment->number_of_packed_chunk_groups += 1;
+
+				packed_chunk_group = NULL;
+			}
+		}
+		mapped_offset += mapped_size;
+	}
+	if( libfcache_cache_free(
+	     &chunk_groups_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk groups cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( packed_chunk_group != NULL )
+	{
+		libewf_packed_chunk_group_free(
+		 &packed_chunk_group,
+		 NULL );
+	}
+	if( chunk_groups_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &chunk_groups_cache,
+		 NULL );
+	}
+	if( index_segment->packed_chunk_groups != NULL )
+	{
+		while( index_segment->number_of_packed_chunk_groups > 0 )
+		{
+			index_segment->number_of_packed_chunk_groups -= 1;
+
+			libewf_packed_chunk_group_free(
+			 &( index_segment->packed_chunk_groups[ index_segment->number_of_packed_chunk_groups ] ),
+			 NULL );
+		}
+		memory_free(
+		 index_segment->packed_chunk_groups );
+
+		index_segment->packed_chunk_groups = NULL;
+	}
+	return( -1 );
+}
+
+/* Inserts the packed chunk groups into the packed chunk table
+ * The packed chunk table takes over management of the packed chunk groups,
+ * the packed chunk groups that are not inserted are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_insert_packed_chunk_groups(
+     libewf_index_segment_t *index_segment,
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t first_chunk_index,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_group_t *packed_chunk_group = NULL;
+	static char *function                           = "libewf_index_segment_insert_packed_chunk_groups";
+	int chunk_group_index                           = 0;
+	int result                                      = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_packed_chunk_groups;
+	     chunk_group_index++ )
+	{
+		packed_chunk_group = index_segment->packed_chunk_groups[ chunk_group_index ];
+
+		index_segment->packed_chunk_groups[ chunk_group_index ] = NULL;
+
+		if( packed_chunk_group == NULL )
+		{
+			continue;
+		}
+		packed_chunk_group->first_chunk_index += first_chunk_index;
+		packed_chunk_group->file_io_pool_entry = file_io_pool_entry;
+
+		result = libewf_packed_chunk_table_insert_chunk_group(
+		          packed_chunk_table,
+		          packed_chunk_group,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert packed chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libewf_packed_chunk_group_free(
+			     &packed_chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free packed chunk group: %d.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+		}
+		packed_chunk_group = NULL;
+	}
+	index_segment->number_of_packed_chunk_groups = 0;
+
+	return( 1 );
+
+on_error:
+	if( packed_chunk_group != NULL )
+	{
+		libewf_packed_chunk_group_free(
+		 &packed_chunk_group,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the index segment data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_segment_get_data_size(
+     libewf_index_segment_t *index_segment,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_index_segment_get_data_size";
+	size_t packed_chunk_group_size = 0;
+	int chunk_group_index          = 0;
+	int number_of_sections         = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_segment->sections_array,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sections array.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( ewfx_index_segment_header_t )
+	           + ( sizeof( ewfx_index_section_t ) * (size_t) number_of_sections )
+	           + ( sizeof( ewfx_index_chunk_group_t ) * (size_t) index_segment->number_of_chunk_groups );
+
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_packed_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libewf_packed_chunk_group_get_data_size(
+		     index_segment->packed_chunk_groups[ chunk_group_index ],
+		     &packed_chunk_group_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data size of packed chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+		*data_size += packed_chunk_group_size;
+	}
+	return( 1 );
+}
+
+/* Reads the index segment data
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_index_segment_read_data(
+         libewf_index_segment_t *index_segment,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	libewf_index_chunk_group_t *chunk_group         = NULL;
+	libewf_packed_chunk_group_t *packed_chunk_group = NULL;
+	libewf_section_t *section                       = NULL;
+	static char *function                           = "libewf_index_segment_read_data";
+	size_t data_offset                              = 0;
+	ssize_t read_count                              = 0;
+	uint64_t value_64bit                            = 0;
+	uint32_t device_information_section_index       = 0;
+	uint32_t number_of_chunk_groups                 = 0;
+	uint32_t number_of_packed_chunk_groups          = 0;
+	uint32_t number_of_sections                     = 0;
+	uint32_t value_32bit                            = 0;
+	int chunk_group_index                           = 0;
+	int entry_index                                 = 0;
+	int section_index                               = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->chunk_groups != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment - chunk groups value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( index_segment->packed_chunk_groups != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index segment - packed chunk groups value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewfx_index_segment_header_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->segment_file_size,
+	 index_segment->segment_file_size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->segment_number,
+	 index_segment->segment_number );
+
+	index_segment->segment_file_flags = ( (ewfx_index_segment_header_t *) data )->segment_file_flags;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->device_information_section_index,
+	 device_information_section_index );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_sections,
+	 number_of_sections );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_packed_chunk_groups,
+	 number_of_packed_chunk_groups );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->last_section_offset,
+	 value_64bit );
+
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid last section offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	index_segment->last_section_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->storage_media_size,
+	 index_segment->storage_media_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_chunks,
+	 index_segment->number_of_chunks );
+
+	data_offset = sizeof( ewfx_index_segment_header_t );
+
+	if( ( (size_t) number_of_sections > ( ( data_size - data_offset ) / sizeof( ewfx_index_section_t ) ) )
+	 || ( number_of_sections > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sections value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( device_information_section_index == 0xffffffffUL )
+	{
+		index_segment->device_information_section_index = -1;
+	}
+	else if( device_information_section_index < number_of_sections )
+	{
+		index_segment->device_information_section_index = (int) device_information_section_index;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid device information section index value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	for( section_index = 0;
+	     section_index < (int) number_of_sections;
+	     section_index++ )
+	{
+		if( libewf_section_initialize(
+		     &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create section: %d.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->type,
+		 section->type );
+
+		if( memory_copy(
+		     section->type_string,
+		     ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->type_string,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set type string of section: %d.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		section->type_string[ 16 ] = 0;
+
+		section->type_string_length = libcstring_narrow_string_length(
+		                               (char *) section->type_string );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_flags,
+		 section->data_flags );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->start_offset,
+		 value_64bit );
+
+		if( value_64bit > (uint64_t) INT64_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section: %d start offset value out of bounds.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		section->start_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->end_offset,
+		 value_64bit );
+
+		if( ( value_64bit > (uint64_t) INT64_MAX )
+		 || ( value_64bit < (uint64_t) section->start_offset ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid section: %d end offset value out of bounds.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		section->end_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->size,
+		 section->size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_size,
+		 section->data_size );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->padding_size,
+		 section->padding_size );
+
+		if( memory_copy(
+		     section->data_integrity_hash,
+		     ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_integrity_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to set data integrity hash of section: %d.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		data_offset += sizeof( ewfx_index_section_t );
+
+		if( libcdata_array_append_entry(
+		     index_segment->sections_array,
+		     &entry_index,
+		     (intptr_t *) section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append section: %d to sections array.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		section = NULL;
+	}
+	if( ( (size_t) number_of_chunk_groups > ( ( data_size - data_offset ) / sizeof( ewfx_index_chunk_group_t ) ) )
+	 || ( number_of_chunk_groups > (uint32_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk groups value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_chunk_groups > 0 )
+	{
+		index_segment->chunk_groups = (libewf_index_chunk_group_t *) memory_allocate(
+		                                                              sizeof( libewf_index_chunk_group_t ) * (size_t) number_of_chunk_groups );
+
+		if( index_segment->chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+		index_segment->number_of_chunk_groups = (int) number_of_chunk_groups;
+
+		for( chunk_group_index = 0;
+		     chunk_group_index < (int) number_of_chunk_groups;
+		     chunk_group_index++ )
+		{
+			chunk_group = &( index_segment->chunk_groups[ chunk_group_index ] );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->data_offset,
+			 value_64bit );
+
+			if( value_64bit > (uint64_t) INT64_MAX )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid chunk group: %d data offset value out of bounds.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			chunk_group->data_offset = (off64_t) value_64bit;
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->data_size,
+			 chunk_group->data_size );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->storage_media_size,
+			 chunk_group->storage_media_size );
+
+			byte_stream_copy_to_uint32_little_endian(
+			 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->range_flags,
+			 value_32bit );
+
+			chunk_group->range_flags = value_32bit;
+
+			data_offset += sizeof( ewfx_index_chunk_group_t );
+		}
+	}
+	/* Every packed chunk group is stored with at least a packed chunk group descriptor
+	 */
+	if( ( number_of_packed_chunk_groups > number_of_chunk_groups )
+	 || ( (size_t) number_of_packed_chunk_groups > ( ( data_size - data_offset ) / sizeof( ewfx_index_packed_chunk_group_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of packed chunk groups value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_packed_chunk_groups > 0 )
+	{
+		index_segment->packed_chunk_groups = (libewf_packed_chunk_group_t **) memory_allocate(
+		                                                                       sizeof( libewf_packed_chunk_group_t * ) * (size_t) number_of_packed_chunk_groups );
+
+		if( index_segment->packed_chunk_groups == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create packed chunk groups.",
+			 function );
+
+			goto on_error;
+		}
+		for( chunk_group_index = 0;
+		     chunk_group_index < (int) number_of_packed_chunk_groups;
+		     chunk_group_index++ )
+		{
+			if( libewf_packed_chunk_group_initialize(
+			     &packed_chunk_group,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create packed chunk group: %d.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			read_count = libewf_packed_chunk_group_read_data(
+			              packed_chunk_group,
+			              &( data[ data_offset ] ),
+			              data_size - data_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read packed chunk group: %d.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			data_offset += (size_t) read_count;
+
+			if( ( packed_chunk_group->first_chunk_index > index_segment->number_of_chunks )
+			 || ( (uint64_t) packed_chunk_group->number_of_chunks > ( index_segment->number_of_chunks - packed_chunk_group->first_chunk_index ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid packed chunk group: %d first chunk index value out of bounds.",
+				 function,
+				 chunk_group_index );
+
+				goto on_error;
+			}
+			index_segment->packed_chunk_groups[ chunk_group_index ] = packed_chunk_group;
+
+			index_segment->number_of_packed_chunk_groups += 1;
+
+			packed_chunk_group = NULL;
+		}
+	}
+	return( (ssize_t) data_offset );
+
+on_error:
+	if( packed_chunk_group != NULL )
+	{
+		libewf_packed_chunk_group_free(
+		 &packed_chunk_group,
+		 NULL );
+	}
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the index segment data
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_index_segment_write_data(
+         libewf_index_segment_t *index_segment,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	libewf_index_chunk_group_t *chunk_group = NULL;
+	libewf_section_t *section               = NULL;
+	static char *function                   = "libewf_index_segment_write_data";
+	size_t data_offset                      = 0;
+	size_t required_data_size               = 0;
+	ssize_t write_count                     = 0;
+	int chunk_group_index                   = 0;
+	int number_of_sections                  = 0;
+	int section_index                       = 0;
+
+	if( index_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_index_segment_get_data_size(
+	     index_segment,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     required_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_segment->sections_array,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from sections array.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->segment_file_size,
+	 index_segment->segment_file_size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->segment_number,
+	 index_segment->segment_number );
+
+	( (ewfx_index_segment_header_t *) data )->segment_file_flags = index_segment->segment_file_flags;
+
+	if( index_segment->device_information_section_index < 0 )
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_segment_header_t *) data )->device_information_section_index,
+		 0xffffffffUL );
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_segment_header_t *) data )->device_information_section_index,
+		 (uint32_t) index_segment->device_information_section_index );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_sections,
+	 (uint32_t) number_of_sections );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_chunk_groups,
+	 (uint32_t) index_segment->number_of_chunk_groups );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_packed_chunk_groups,
+	 (uint32_t) index_segment->number_of_packed_chunk_groups );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->last_section_offset,
+	 (uint64_t) index_segment->last_section_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->storage_media_size,
+	 index_segment->storage_media_size );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_segment_header_t *) data )->number_of_chunks,
+	 index_segment->number_of_chunks );
+
+	data_offset = sizeof( ewfx_index_segment_header_t );
+
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_segment->sections_array,
+		     section_index,
+		     (intptr_t **) &section,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections array.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		if( section == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing section: %d.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->type,
+		 section->type );
+
+		if( memory_copy(
+		     ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->type_string,
+		     section->type_string,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy type string of section: %d.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_flags,
+		 section->data_flags );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->start_offset,
+		 (uint64_t) section->start_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->end_offset,
+		 (uint64_t) section->end_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->size,
+		 section->size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_size,
+		 section->data_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->padding_size,
+		 section->padding_size );
+
+		if( memory_copy(
+		     ( (ewfx_index_section_t *) &( data[ data_offset ] ) )->data_integrity_hash,
+		     section->data_integrity_hash,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data integrity hash of section: %d.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		data_offset += sizeof( ewfx_index_section_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		chunk_group = &( index_segment->chunk_groups[ chunk_group_index ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->data_offset,
+		 (uint64_t) chunk_group->data_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->data_size,
+		 chunk_group->data_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->storage_media_size,
+		 chunk_group->storage_media_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewfx_index_chunk_group_t *) &( data[ data_offset ] ) )->range_flags,
+		 chunk_group->range_flags );
+
+		data_offset += sizeof( ewfx_index_chunk_group_t );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < index_segment->number_of_packed_chunk_groups;
+	     chunk_group_index++ )
+	{
+		write_count = libewf_packed_chunk_group_write_data(
+		               index_segment->packed_chunk_groups[ chunk_group_index ],
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               error );
+
+		if( write_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write packed chunk group: %d.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( (ssize_t) data_offset );
+}
+
@@ -0,0 +1,189 @@
+/*
+ * Index segment functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_SEGMENT_H )
+#define _LIBEWF_INDEX_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_packed_chunk_table.h"
+#include "libewf_section.h"
+#include "libewf_segment_file.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_index_chunk_group libewf_index_chunk_group_t;
+
+struct libewf_index_chunk_group
+{
+	/* The data offset
+	 */
+	off64_t data_offset;
+
+	/* The data size
+	 */
+	size64_t data_size;
+
+	/* The storage media size
+	 */
+	size64_t storage_media_size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+};
+
+typedef struct libewf_index_segment libewf_index_segment_t;
+
+/* The index segment contains the values of a segment file
+ * that are otherwise determined by reading all its section descriptors
+ * and table sections
+ */
+struct libewf_index_segment
+{
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The segment file flags
+	 */
+	uint8_t segment_file_flags;
+
+	/* The device information section index
+	 */
+	int device_information_section_index;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The storage media size (in the segment file)
+	 */
+	size64_t storage_media_size;
+
+	/* The number of chunks (in the segment file)
+	 */
+	uint64_t number_of_chunks;
+
+	/* The sections array
+	 */
+	libcdata_array_t *sections_array;
+
+	/* The chunk groups
+	 */
+	libewf_index_chunk_group_t *chunk_groups;
+
+	/* The number of chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* The packed chunk groups
+	 * the first chunk index is relative to the first chunk of the segment file
+	 */
+	libewf_packed_chunk_group_t **packed_chunk_groups;
+
+	/* The number of packed chunk groups
+	 */
+	int number_of_packed_chunk_groups;
+};
+
+int libewf_index_segment_initialize(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_segment_free(
+     libewf_index_segment_t **index_segment,
+     libcerror_error_t **error );
+
+int libewf_index_segment_get_number_of_sections(
+     libewf_index_segment_t *index_segment,
+     int *number_of_sections,
+     libcerror_error_t **error );
+
+int libewf_index_segment_get_section_by_index(
+     libewf_index_segment_t *index_segment,
+     int section_index,
+     libewf_section_t **section,
+     libcerror_error_t **error );
+
+int libewf_index_segment_append_section(
+     libewf_index_segment_t *index_segment,
+     libewf_section_t *section,
+     libcerror_error_t **error );
+
+int libewf_index_segment_get_segment_file_values(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_index_segment_set_segment_file_values(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_index_segment_read_packed_chunk_groups(
+     libewf_index_segment_t *index_segment,
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libewf_index_segment_insert_packed_chunk_groups(
+     libewf_index_segment_t *index_segment,
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t first_chunk_index,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_index_segment_get_data_size(
+     libewf_index_segment_t *index_segment,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_index_segment_read_data(
+         libewf_index_segment_t *index_segment,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_index_segment_write_data(
+         libewf_index_segment_t *index_segment,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
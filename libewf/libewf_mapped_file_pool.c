@@ -0,0 +1,935 @@
+/*
+ * Mapped file pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_MMAN_H )
+#include <sys/mman.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_mapped_file_pool.h"
+
+/* Creates a mapped file pool
+ * Make sure the value mapped_file_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_initialize(
+     libewf_mapped_file_pool_t **mapped_file_pool,
+     int maximum_number_of_mapped_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_initialize";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mapped_file_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mapped file pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_mapped_files < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of mapped files value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*mapped_file_pool = memory_allocate_structure(
+	                     libewf_mapped_file_pool_t );
+
+	if( *mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *mapped_file_pool,
+	     0,
+	     sizeof( libewf_mapped_file_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mapped file pool.",
+		 function );
+
+		memory_free(
+		 *mapped_file_pool );
+
+		*mapped_file_pool = NULL;
+
+		return( -1 );
+	}
+	( *mapped_file_pool )->maximum_number_of_mapped_files = maximum_number_of_mapped_files;
+
+	return( 1 );
+}
+
+/* Frees a mapped file pool
+ * The files that are still mapped are unmapped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_free(
+     libewf_mapped_file_pool_t **mapped_file_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_free";
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *mapped_file_pool != NULL )
+	{
+		if( ( *mapped_file_pool )->mapped_files != NULL )
+		{
+			for( entry_index = 0;
+			     entry_index < ( *mapped_file_pool )->number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *mapped_file_pool )->mapped_files[ entry_index ].data == NULL )
+				{
+					continue;
+				}
+				if( libewf_mapped_file_pool_unmap_file(
+				     *mapped_file_pool,
+				     entry_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to unmap file: %d.",
+					 function,
+					 entry_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *mapped_file_pool )->mapped_files );
+		}
+		memory_free(
+		 *mapped_file_pool );
+
+		*mapped_file_pool = NULL;
+	}
+	return( result );
+}
+
+/* Sets the maximum number of mapped files
+ * A value of 0 represents no maximum
+ * If more files are mapped, the least recently used files are unmapped when the next file is mapped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_set_maximum_number_of_mapped_files(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int maximum_number_of_mapped_files,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_set_maximum_number_of_mapped_files";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_mapped_files < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of mapped files value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_file_pool->maximum_number_of_mapped_files = maximum_number_of_mapped_files;
+
+	return( 1 );
+}
+
+/* Resizes the mapped files to contain at least the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_resize(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int number_of_entries,
+     libcerror_error_t **error )
+{
+	libewf_mapped_file_t *mapped_files = NULL;
+	static char *function              = "libewf_mapped_file_pool_resize";
+	size_t mapped_files_size           = 0;
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_entries <= 0 )
+	 || ( number_of_entries >= INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries <= mapped_file_pool->number_of_entries )
+	{
+		return( 1 );
+	}
+	mapped_files_size = sizeof( libewf_mapped_file_t ) * number_of_entries;
+
+	mapped_files = (libewf_mapped_file_t *) memory_reallocate(
+	                                         mapped_file_pool->mapped_files,
+	                                         mapped_files_size );
+
+	if( mapped_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize mapped files.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_file_pool->mapped_files = mapped_files;
+
+	if( memory_set(
+	     &( mapped_file_pool->mapped_files[ mapped_file_pool->number_of_entries ] ),
+	     0,
+	     sizeof( libewf_mapped_file_t ) * ( number_of_entries - mapped_file_pool->number_of_entries ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear mapped files.",
+		 function );
+
+		return( -1 );
+	}
+	mapped_file_pool->number_of_entries = number_of_entries;
+
+	return( 1 );
+}
+
+/* Sets the file size of a file IO pool entry
+ * The file size is the size of the file when it was opened, if set a file
+ * of which the size has changed is not mapped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_set_file_size(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     size64_t file_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_set_file_size";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_mapped_file_pool_resize(
+	     mapped_file_pool,
+	     file_io_pool_entry + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize mapped files.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mapped file: %d - file is already mapped.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	mapped_file_pool->mapped_files[ file_io_pool_entry ].file_size = file_size;
+
+	return( 1 );
+}
+
+/* Maps the file of a file IO pool entry
+ * If the maximum number of mapped files is reached, the least recently used
+ * mapped file that is not referenced is unmapped
+ * Returns 1 if successful, 0 if the file cannot be mapped or -1 on error
+ */
+int libewf_mapped_file_pool_map_file(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_SUPPORT )
+	struct stat file_stat;
+
+	libbfio_handle_t *file_io_handle = NULL;
+	char *filename                   = NULL;
+	void *data                       = NULL;
+	size_t filename_size             = 0;
+	uint64_t last_access_count       = 0;
+	int entry_index                  = 0;
+	int file_descriptor              = -1;
+	int open_flags                   = O_RDONLY;
+	int unmap_entry_index            = -1;
+#endif
+	static char *function            = "libewf_mapped_file_pool_map_file";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= ( INT_MAX - 1 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_SUPPORT )
+	if( libewf_mapped_file_pool_resize(
+	     mapped_file_pool,
+	     file_io_pool_entry + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize mapped files.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].data != NULL )
+	{
+		return( 1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].cannot_be_mapped != 0 )
+	{
+		return( 0 );
+	}
+	/* The maximum number of mapped files can have been lowered
+	 * hence multiple mapped files can need to be unmapped
+	 */
+	while( ( mapped_file_pool->maximum_number_of_mapped_files > 0 )
+	    && ( mapped_file_pool->number_of_mapped_files >= mapped_file_pool->maximum_number_of_mapped_files ) )
+	{
+		unmap_entry_index = -1;
+
+		for( entry_index = 0;
+		     entry_index < mapped_file_pool->number_of_entries;
+		     entry_index++ )
+		{
+			if( ( mapped_file_pool->mapped_files[ entry_index ].data == NULL )
+			 || ( mapped_file_pool->mapped_files[ entry_index ].number_of_references > 0 ) )
+			{
+				continue;
+			}
+			if( ( unmap_entry_index == -1 )
+			 || ( mapped_file_pool->mapped_files[ entry_index ].last_access_count < last_access_count ) )
+			{
+				unmap_entry_index = entry_index;
+				last_access_count = mapped_file_pool->mapped_files[ entry_index ].last_access_count;
+			}
+		}
+		/* All mapped files are in use, the data is read from the file IO pool instead
+		 */
+		if( unmap_entry_index == -1 )
+		{
+			return( 0 );
+		}
+		if( libewf_mapped_file_pool_unmap_file(
+		     mapped_file_pool,
+		     unmap_entry_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to unmap file: %d.",
+			 function,
+			 unmap_entry_index );
+
+			return( -1 );
+		}
+	}
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name_size(
+	     file_io_handle,
+	     &filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( filename_size == 0 )
+	 || ( filename_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	filename = (char *) memory_allocate(
+	                     sizeof( char ) * filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_get_name(
+	     file_io_handle,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( O_CLOEXEC )
+	/* Prevent the file descriptor to remain open across an execve
+	 */
+	open_flags |= O_CLOEXEC;
+#endif
+	file_descriptor = open(
+	                   filename,
+	                   open_flags );
+
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	/* If the file cannot be mapped its data is read from the file IO pool instead
+	 */
+	if( file_descriptor == -1 )
+	{
+		mapped_file_pool->mapped_files[ file_io_pool_entry ].cannot_be_mapped = 1;
+
+		return( 0 );
+	}
+	/* A file that was truncated or extended after it was opened is not mapped
+	 * since accessing a mapping beyond the end of a file raises SIGBUS
+	 */
+	if( ( fstat(
+	       file_descriptor,
+	       &file_stat ) != 0 )
+	 || ( file_stat.st_size <= 0 )
+	 || ( (uint64_t) file_stat.st_size > (uint64_t) SSIZE_MAX )
+	 || ( ( mapped_file_pool->mapped_files[ file_io_pool_entry ].file_size != 0 )
+	  && ( (size64_t) file_stat.st_size != mapped_file_pool->mapped_files[ file_io_pool_entry ].file_size ) ) )
+	{
+		close(
+		 file_descriptor );
+
+		mapped_file_pool->mapped_files[ file_io_pool_entry ].cannot_be_mapped = 1;
+
+		return( 0 );
+	}
+	data = mmap(
+	        NULL,
+	        (size_t) file_stat.st_size,
+	        PROT_READ,
+	        MAP_SHARED,
+	        file_descriptor,
+	        0 );
+
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+	if( data == MAP_FAILED )
+	{
+		mapped_file_pool->mapped_files[ file_io_pool_entry ].cannot_be_mapped = 1;
+
+		return( 0 );
+	}
+	mapped_file_pool->mapped_files[ file_io_pool_entry ].data      = (uint8_t *) data;
+	mapped_file_pool->mapped_files[ file_io_pool_entry ].data_size = (size_t) file_stat.st_size;
+
+	mapped_file_pool->number_of_mapped_files += 1;
+
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Unmaps the file of a file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_unmap_file(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_unmap_file";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= mapped_file_pool->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].number_of_references > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapped file: %d - data is still referenced.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].data != NULL )
+	{
+#if defined( HAVE_LIBEWF_MEMORY_MAPPED_FILE_SUPPORT )
+		if( munmap(
+		     mapped_file_pool->mapped_files[ file_io_pool_entry ].data,
+		     mapped_file_pool->mapped_files[ file_io_pool_entry ].data_size ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to unmap file: %d.",
+			 function,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+#endif
+		mapped_file_pool->mapped_files[ file_io_pool_entry ].data      = NULL;
+		mapped_file_pool->mapped_files[ file_io_pool_entry ].data_size = 0;
+
+		mapped_file_pool->number_of_mapped_files -= 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves a pointer to the mapped data of a file IO pool entry at a specific offset
+ * The file is mapped if necessary. The data remains valid and the file remains mapped
+ * until the data is released using libewf_mapped_file_pool_release_data
+ * Returns 1 if successful, 0 if the data is not available or -1 on error
+ */
+int libewf_mapped_file_pool_get_data(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     libcerror_error_t **error )
+{
+	libewf_mapped_file_t *mapped_file = NULL;
+	static char *function             = "libewf_mapped_file_pool_get_data";
+	int result                        = 0;
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_mapped_file_pool_map_file(
+	          mapped_file_pool,
+	          file_io_pool,
+	          file_io_pool_entry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to map file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	mapped_file = &( mapped_file_pool->mapped_files[ file_io_pool_entry ] );
+
+	if( ( (size64_t) offset > (size64_t) mapped_file->data_size )
+	 || ( size > ( mapped_file->data_size - (size_t) offset ) ) )
+	{
+		return( 0 );
+	}
+	mapped_file_pool->access_count += 1;
+
+	mapped_file->last_access_count     = mapped_file_pool->access_count;
+	mapped_file->number_of_references += 1;
+
+	*data = &( mapped_file->data[ offset ] );
+
+	return( 1 );
+}
+
+/* Releases a reference to the mapped data of a file IO pool entry
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_mapped_file_pool_release_data(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_mapped_file_pool_release_data";
+
+	if( mapped_file_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mapped file pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( file_io_pool_entry >= mapped_file_pool->number_of_entries ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( mapped_file_pool->mapped_files[ file_io_pool_entry ].number_of_references <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mapped file: %d - number of references value out of bounds.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	mapped_file_pool->mapped_files[ file_io_pool_entry ].number_of_references -= 1;
+
+	return( 1 );
+}
+
+/* Reads data of a file IO pool entry at a specific offset from the mapped file
+ * Returns 1 if successful, 0 if the data is not available or -1 on error
+ */
+int libewf_mapped_file_pool_read_buffer(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *data   = NULL;
+	static char *function = "libewf_mapped_file_pool_read_buffer";
+	int result            = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_mapped_file_pool_get_data(
+	          mapped_file_pool,
+	          file_io_pool,
+	          file_io_pool_entry,
+	          offset,
+	          buffer_size,
+	          &data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped data of file: %d at offset: %" PRIi64 ".",
+		 function,
+		 file_io_pool_entry,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     buffer,
+	     data,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy mapped data.",
+		 function );
+
+		result = -1;
+	}
+	if( libewf_mapped_file_pool_release_data(
+	     mapped_file_pool,
+	     file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mapped data of file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		result = -1;
+	}
+	return( result );
+}
+
@@ -0,0 +1,162 @@
+/*
+ * Mapped file pool functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_MAPPED_FILE_POOL_H )
+#define _LIBEWF_MAPPED_FILE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define HAVE_LIBEWF_MEMORY_MAPPED_FILE_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_mapped_file libewf_mapped_file_t;
+
+struct libewf_mapped_file
+{
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size_t data_size;
+
+	/* The file size, 0 if not set
+	 */
+	size64_t file_size;
+
+	/* The number of references to the mapped data
+	 */
+	int number_of_references;
+
+	/* The last access count
+	 */
+	uint64_t last_access_count;
+
+	/* Value to indicate the file cannot be mapped
+	 */
+	uint8_t cannot_be_mapped;
+};
+
+typedef struct libewf_mapped_file_pool libewf_mapped_file_pool_t;
+
+/* The mapped file pool maps the files of a file IO pool read-only into memory
+ * on demand, so that their data can be accessed without reading it
+ * All the entries of the file IO pool must be libbfio file handles
+ */
+struct libewf_mapped_file_pool
+{
+	/* The mapped files
+	 * the mapped file of a file IO pool entry is stored at the index of the entry
+	 */
+	libewf_mapped_file_t *mapped_files;
+
+	/* The number of mapped files entries
+	 */
+	int number_of_entries;
+
+	/* The number of files that are mapped
+	 */
+	int number_of_mapped_files;
+
+	/* The maximum number of files that are mapped, 0 represents no maximum
+	 */
+	int maximum_number_of_mapped_files;
+
+	/* The access count
+	 */
+	uint64_t access_count;
+};
+
+int libewf_mapped_file_pool_initialize(
+     libewf_mapped_file_pool_t **mapped_file_pool,
+     int maximum_number_of_mapped_files,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_free(
+     libewf_mapped_file_pool_t **mapped_file_pool,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_set_maximum_number_of_mapped_files(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int maximum_number_of_mapped_files,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_resize(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int number_of_entries,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_set_file_size(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     size64_t file_size,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_map_file(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_unmap_file(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_get_data(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     size_t size,
+     const uint8_t **data,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_release_data(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_mapped_file_pool_read_buffer(
+     libewf_mapped_file_pool_t *mapped_file_pool,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
@@ -0,0 +1,1492 @@
+/*
+ * Packed chunk table functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libfdata.h"
+#include "libewf_packed_chunk_table.h"
+
+#include "ewfx_index.h"
+
+/* The range flags that can be stored in a packed chunk group
+ * The tainted and corrupted flags are not stored since they are not retained
+ * by the chunk data that is read
+ */
+#define LIBEWF_PACKED_CHUNK_GROUP_SUPPORTED_RANGE_FLAGS \
+	( LIBEWF_RANGE_FLAG_IS_COMPRESSED | LIBEWF_RANGE_FLAG_HAS_CHECKSUM | LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED )
+
+/* Creates a packed chunk group
+ * Make sure the value packed_chunk_group is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_group_initialize(
+     libewf_packed_chunk_group_t **packed_chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_group_initialize";
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_group != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid packed chunk group value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*packed_chunk_group = memory_allocate_structure(
+	                       libewf_packed_chunk_group_t );
+
+	if( *packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *packed_chunk_group,
+	     0,
+	     sizeof( libewf_packed_chunk_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear packed chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *packed_chunk_group != NULL )
+	{
+		memory_free(
+		 *packed_chunk_group );
+
+		*packed_chunk_group = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a packed chunk group
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_group_free(
+     libewf_packed_chunk_group_t **packed_chunk_group,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_group_free";
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_group != NULL )
+	{
+		if( ( *packed_chunk_group )->sizes != NULL )
+		{
+			memory_free(
+			 ( *packed_chunk_group )->sizes );
+		}
+		if( ( *packed_chunk_group )->offsets != NULL )
+		{
+			memory_free(
+			 ( *packed_chunk_group )->offsets );
+		}
+		if( ( *packed_chunk_group )->flags != NULL )
+		{
+			memory_free(
+			 ( *packed_chunk_group )->flags );
+		}
+		memory_free(
+		 *packed_chunk_group );
+
+		*packed_chunk_group = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the packed chunk group from the chunks list of a chunk group
+ * Returns 1 if successful, 0 if the chunks list cannot be packed or -1 on error
+ */
+int libewf_packed_chunk_group_set_chunks_list(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     uint64_t first_chunk_index,
+     libfdata_list_t *chunks_list,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_packed_chunk_group_set_chunks_list";
+	size64_t chunk_data_size     = 0;
+	size64_t maximum_data_size   = 0;
+	size_t flags_size            = 0;
+	size_t offsets_size          = 0;
+	size_t sizes_size            = 0;
+	off64_t chunk_data_offset    = 0;
+	off64_t data_offset          = 0;
+	off64_t relative_offset      = 0;
+	uint32_t range_flags         = 0;
+	uint8_t chunk_flags          = 0;
+	uint8_t sizes_entry_size     = 0;
+	int element_index            = 0;
+	int file_io_pool_entry       = 0;
+	int first_file_io_pool_entry = 0;
+	int number_of_elements       = 0;
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_group->sizes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid packed chunk group - sizes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     chunks_list,
+	     &number_of_elements,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from chunks list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_elements <= 0 )
+	{
+		return( 0 );
+	}
+	/* Determine if the chunks are stored contiguously and the size of the sizes entries
+	 */
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     chunks_list,
+		     element_index,
+		     &file_io_pool_entry,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunks list.",
+			 function,
+			 element_index );
+
+			return( -1 );
+		}
+		if( ( range_flags & ~( LIBEWF_PACKED_CHUNK_GROUP_SUPPORTED_RANGE_FLAGS ) ) != 0 )
+		{
+			return( 0 );
+		}
+		if( ( chunk_data_size == 0 )
+		 || ( chunk_data_size > (size64_t) UINT32_MAX ) )
+		{
+			return( 0 );
+		}
+		if( element_index == 0 )
+		{
+			first_file_io_pool_entry = file_io_pool_entry;
+			data_offset              = chunk_data_offset;
+			relative_offset          = 0;
+		}
+		else if( ( file_io_pool_entry != first_file_io_pool_entry )
+		      || ( chunk_data_offset != ( data_offset + relative_offset ) ) )
+		{
+			return( 0 );
+		}
+		relative_offset += (off64_t) chunk_data_size;
+
+		if( relative_offset > (off64_t) UINT32_MAX )
+		{
+			return( 0 );
+		}
+		if( chunk_data_size > maximum_data_size )
+		{
+			maximum_data_size = chunk_data_size;
+		}
+	}
+	if( maximum_data_size <= (size64_t) UINT16_MAX )
+	{
+		sizes_entry_size = 2;
+	}
+	else
+	{
+		sizes_entry_size = 4;
+	}
+	sizes_size   = (size_t) number_of_elements * sizes_entry_size;
+	offsets_size = sizeof( uint32_t )
+	             * ( ( ( number_of_elements - 1 ) / LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ) + 1 );
+	flags_size   = ( (size_t) number_of_elements + 3 ) / 4;
+
+	packed_chunk_group->sizes = (uint8_t *) memory_allocate(
+	                                         sizes_size );
+
+	if( packed_chunk_group->sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sizes.",
+		 function );
+
+		goto on_error;
+	}
+	packed_chunk_group->offsets = (uint32_t *) memory_allocate(
+	                                            offsets_size );
+
+	if( packed_chunk_group->offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create offsets.",
+		 function );
+
+		goto on_error;
+	}
+	packed_chunk_group->flags = (uint8_t *) memory_allocate(
+	                                         flags_size );
+
+	if( packed_chunk_group->flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     packed_chunk_group->flags,
+	     0,
+	     flags_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear flags.",
+		 function );
+
+		goto on_error;
+	}
+	relative_offset = 0;
+
+	for( element_index = 0;
+	     element_index < number_of_elements;
+	     element_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     chunks_list,
+		     element_index,
+		     &file_io_pool_entry,
+		     &chunk_data_offset,
+		     &chunk_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunks list.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( ( element_index % LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ) == 0 )
+		{
+			packed_chunk_group->offsets[ element_index / LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ] = (uint32_t) relative_offset;
+		}
+		if( sizes_entry_size == 2 )
+		{
+			( (uint16_t *) packed_chunk_group->sizes )[ element_index ] = (uint16_t) chunk_data_size;
+		}
+		else
+		{
+			( (uint32_t *) packed_chunk_group->sizes )[ element_index ] = (uint32_t) chunk_data_size;
+		}
+		chunk_flags = 0;
+
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			chunk_flags |= LIBEWF_PACKED_CHUNK_FLAG_IS_COMPRESSED;
+		}
+		if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+		{
+			chunk_flags |= LIBEWF_PACKED_CHUNK_FLAG_HAS_CHECKSUM;
+		}
+		packed_chunk_group->flags[ element_index / 4 ] |= (uint8_t) ( chunk_flags << ( ( element_index % 4 ) * 2 ) );
+
+		relative_offset += (off64_t) chunk_data_size;
+	}
+	packed_chunk_group->first_chunk_index  = first_chunk_index;
+	packed_chunk_group->number_of_chunks   = (uint32_t) number_of_elements;
+	packed_chunk_group->file_io_pool_entry = first_file_io_pool_entry;
+	packed_chunk_group->data_offset        = data_offset;
+	packed_chunk_group->sizes_entry_size   = sizes_entry_size;
+	packed_chunk_group->size               = sizeof( libewf_packed_chunk_group_t )
+	                                       + sizes_size
+	                                       + offsets_size
+	                                       + flags_size;
+
+	return( 1 );
+
+on_error:
+	if( packed_chunk_group->flags != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->flags );
+
+		packed_chunk_group->flags = NULL;
+	}
+	if( packed_chunk_group->offsets != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->offsets );
+
+		packed_chunk_group->offsets = NULL;
+	}
+	if( packed_chunk_group->sizes != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->sizes );
+
+		packed_chunk_group->sizes = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the location of a specific chunk
+ * Returns 1 if successful, 0 if the chunk is not part of the packed chunk group or -1 on error
+ */
+int libewf_packed_chunk_group_get_chunk_by_index(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function    = "libewf_packed_chunk_group_get_chunk_by_index";
+	uint32_t element_index   = 0;
+	uint32_t relative_offset = 0;
+	uint32_t size            = 0;
+	uint32_t size_index      = 0;
+	uint8_t chunk_flags      = 0;
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( packed_chunk_group->sizes == NULL )
+	 || ( packed_chunk_group->offsets == NULL )
+	 || ( packed_chunk_group->flags == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid packed chunk group - missing values.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index < packed_chunk_group->first_chunk_index )
+	 || ( ( chunk_index - packed_chunk_group->first_chunk_index ) >= (uint64_t) packed_chunk_group->number_of_chunks ) )
+	{
+		return( 0 );
+	}
+	element_index   = (uint32_t) ( chunk_index - packed_chunk_group->first_chunk_index );
+	size_index      = element_index - ( element_index % LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL );
+	relative_offset = packed_chunk_group->offsets[ element_index / LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ];
+
+	/* The offset is determined from the nearest stored offset and the sizes of the chunks in between
+	 */
+	while( size_index <= element_index )
+	{
+		if( packed_chunk_group->sizes_entry_size == 2 )
+		{
+			size = ( (uint16_t *) packed_chunk_group->sizes )[ size_index ];
+		}
+		else
+		{
+			size = ( (uint32_t *) packed_chunk_group->sizes )[ size_index ];
+		}
+		if( size_index < element_index )
+		{
+			relative_offset += size;
+		}
+		size_index++;
+	}
+	chunk_flags = ( packed_chunk_group->flags[ element_index / 4 ] >> ( ( element_index % 4 ) * 2 ) ) & 0x03;
+
+	*file_io_pool_entry = packed_chunk_group->file_io_pool_entry;
+	*chunk_data_offset  = packed_chunk_group->data_offset + relative_offset;
+	*chunk_data_size    = (size64_t) size;
+	*range_flags        = 0;
+
+	if( ( chunk_flags & LIBEWF_PACKED_CHUNK_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_IS_COMPRESSED;
+	}
+	if( ( chunk_flags & LIBEWF_PACKED_CHUNK_FLAG_HAS_CHECKSUM ) != 0 )
+	{
+		*range_flags |= LIBEWF_RANGE_FLAG_HAS_CHECKSUM;
+	}
+	return( 1 );
+}
+
+/* Retrieves the size of the packed chunk group data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_group_get_data_size(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_group_get_data_size";
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	*data_size = sizeof( ewfx_index_packed_chunk_group_t )
+	           + ( (size_t) packed_chunk_group->number_of_chunks * packed_chunk_group->sizes_entry_size )
+	           + ( ( (size_t) packed_chunk_group->number_of_chunks + 3 ) / 4 );
+
+	return( 1 );
+}
+
+/* Reads the packed chunk group data
+ * The file IO pool entry is not stored in the data and is set to 0
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_packed_chunk_group_read_data(
+         libewf_packed_chunk_group_t *packed_chunk_group,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	static char *function      = "libewf_packed_chunk_group_read_data";
+	size_t data_offset         = 0;
+	size_t flags_size          = 0;
+	size_t offsets_size        = 0;
+	size_t sizes_size          = 0;
+	uint64_t first_chunk_index = 0;
+	uint64_t relative_offset   = 0;
+	uint64_t value_64bit       = 0;
+	uint32_t chunk_data_size   = 0;
+	uint32_t element_index     = 0;
+	uint32_t number_of_chunks  = 0;
+	uint8_t sizes_entry_size   = 0;
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_group->sizes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid packed chunk group - sizes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < sizeof( ewfx_index_packed_chunk_group_t ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->first_chunk_index,
+	 first_chunk_index );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->data_offset,
+	 value_64bit );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->number_of_chunks,
+	 number_of_chunks );
+
+	sizes_entry_size = ( (ewfx_index_packed_chunk_group_t *) data )->sizes_entry_size;
+
+	if( value_64bit > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( sizes_entry_size != 2 )
+	 && ( sizes_entry_size != 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sizes entry size: %" PRIu8 ".",
+		 function,
+		 sizes_entry_size );
+
+		goto on_error;
+	}
+	data_offset = sizeof( ewfx_index_packed_chunk_group_t );
+
+	/* Every chunk is stored with its size and 2 bits of flags
+	 */
+	if( ( number_of_chunks == 0 )
+	 || ( (size_t) number_of_chunks > ( ( data_size - data_offset ) / sizes_entry_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	sizes_size   = (size_t) number_of_chunks * sizes_entry_size;
+	offsets_size = sizeof( uint32_t )
+	             * ( ( ( number_of_chunks - 1 ) / LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ) + 1 );
+	flags_size   = ( (size_t) number_of_chunks + 3 ) / 4;
+
+	if( flags_size > ( data_size - data_offset - sizes_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	packed_chunk_group->sizes = (uint8_t *) memory_allocate(
+	                                         sizes_size );
+
+	if( packed_chunk_group->sizes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sizes.",
+		 function );
+
+		goto on_error;
+	}
+	packed_chunk_group->offsets = (uint32_t *) memory_allocate(
+	                                            offsets_size );
+
+	if( packed_chunk_group->offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create offsets.",
+		 function );
+
+		goto on_error;
+	}
+	packed_chunk_group->flags = (uint8_t *) memory_allocate(
+	                                         flags_size );
+
+	if( packed_chunk_group->flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create flags.",
+		 function );
+
+		goto on_error;
+	}
+	/* The offsets are not stored in the data and are determined from the sizes
+	 */
+	for( element_index = 0;
+	     element_index < number_of_chunks;
+	     element_index++ )
+	{
+		if( sizes_entry_size == 2 )
+		{
+			byte_stream_copy_to_uint16_little_endian(
+			 &( data[ data_offset ] ),
+			 chunk_data_size );
+
+			( (uint16_t *) packed_chunk_group->sizes )[ element_index ] = (uint16_t) chunk_data_size;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( data[ data_offset ] ),
+			 chunk_data_size );
+
+			( (uint32_t *) packed_chunk_group->sizes )[ element_index ] = chunk_data_size;
+		}
+		data_offset += sizes_entry_size;
+
+		if( ( chunk_data_size == 0 )
+		 || ( relative_offset > (uint64_t) UINT32_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk: %" PRIu32 " data size value out of bounds.",
+			 function,
+			 element_index );
+
+			goto on_error;
+		}
+		if( ( element_index % LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ) == 0 )
+		{
+			packed_chunk_group->offsets[ element_index / LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL ] = (uint32_t) relative_offset;
+		}
+		relative_offset += chunk_data_size;
+	}
+	if( ( relative_offset > (uint64_t) UINT32_MAX )
+	 || ( relative_offset > (uint64_t) ( INT64_MAX - value_64bit ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data sizes value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     packed_chunk_group->flags,
+	     &( data[ data_offset ] ),
+	     flags_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy flags.",
+		 function );
+
+		goto on_error;
+	}
+	data_offset += flags_size;
+
+	packed_chunk_group->first_chunk_index  = first_chunk_index;
+	packed_chunk_group->number_of_chunks   = number_of_chunks;
+	packed_chunk_group->file_io_pool_entry = 0;
+	packed_chunk_group->data_offset        = (off64_t) value_64bit;
+	packed_chunk_group->sizes_entry_size   = sizes_entry_size;
+	packed_chunk_group->size               = sizeof( libewf_packed_chunk_group_t )
+	                                       + sizes_size
+	                                       + offsets_size
+	                                       + flags_size;
+
+	return( (ssize_t) data_offset );
+
+on_error:
+	if( packed_chunk_group->flags != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->flags );
+
+		packed_chunk_group->flags = NULL;
+	}
+	if( packed_chunk_group->offsets != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->offsets );
+
+		packed_chunk_group->offsets = NULL;
+	}
+	if( packed_chunk_group->sizes != NULL )
+	{
+		memory_free(
+		 packed_chunk_group->sizes );
+
+		packed_chunk_group->sizes = NULL;
+	}
+	return( -1 );
+}
+
+/* Writes the packed chunk group data
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t libewf_packed_chunk_group_write_data(
+         libewf_packed_chunk_group_t *packed_chunk_group,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libewf_packed_chunk_group_write_data";
+	size_t data_offset        = 0;
+	size_t flags_size         = 0;
+	size_t required_data_size = 0;
+	uint32_t element_index    = 0;
+
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( packed_chunk_group->sizes == NULL )
+	 || ( packed_chunk_group->flags == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid packed chunk group - missing values.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_packed_chunk_group_get_data_size(
+	     packed_chunk_group,
+	     &required_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < required_data_size )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( ewfx_index_packed_chunk_group_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->first_chunk_index,
+	 packed_chunk_group->first_chunk_index );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->data_offset,
+	 (uint64_t) packed_chunk_group->data_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 ( (ewfx_index_packed_chunk_group_t *) data )->number_of_chunks,
+	 packed_chunk_group->number_of_chunks );
+
+	( (ewfx_index_packed_chunk_group_t *) data )->sizes_entry_size = packed_chunk_group->sizes_entry_size;
+
+	data_offset = sizeof( ewfx_index_packed_chunk_group_t );
+
+	for( element_index = 0;
+	     element_index < packed_chunk_group->number_of_chunks;
+	     element_index++ )
+	{
+		if( packed_chunk_group->sizes_entry_size == 2 )
+		{
+			byte_stream_copy_from_uint16_little_endian(
+			 &( data[ data_offset ] ),
+			 ( (uint16_t *) packed_chunk_group->sizes )[ element_index ] );
+		}
+		else
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( data[ data_offset ] ),
+			 ( (uint32_t *) packed_chunk_group->sizes )[ element_index ] );
+		}
+		data_offset += packed_chunk_group->sizes_entry_size;
+	}
+	flags_size = ( (size_t) packed_chunk_group->number_of_chunks + 3 ) / 4;
+
+	if( memory_copy(
+	     &( data[ data_offset ] ),
+	     packed_chunk_group->flags,
+	     flags_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy flags.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset += flags_size;
+
+	return( (ssize_t) data_offset );
+}
+
+/* Creates a packed chunk table
+ * Make sure the value packed_chunk_table is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_table_initialize(
+     libewf_packed_chunk_table_t **packed_chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_table_initialize";
+
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid packed chunk table value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*packed_chunk_table = memory_allocate_structure(
+	                       libewf_packed_chunk_table_t );
+
+	if( *packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create packed chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *packed_chunk_table,
+	     0,
+	     sizeof( libewf_packed_chunk_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear packed chunk table.",
+		 function );
+
+		goto on_error;
+	}
+	( *packed_chunk_table )->size         = sizeof( libewf_packed_chunk_table_t );
+	( *packed_chunk_table )->maximum_size = maximum_size;
+
+	return( 1 );
+
+on_error:
+	if( *packed_chunk_table != NULL )
+	{
+		memory_free(
+		 *packed_chunk_table );
+
+		*packed_chunk_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a packed chunk table
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_packed_chunk_table_free(
+     libewf_packed_chunk_table_t **packed_chunk_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_packed_chunk_table_free";
+	int chunk_group_index = 0;
+	int result            = 1;
+
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( *packed_chunk_table != NULL )
+	{
+		if( ( *packed_chunk_table )->chunk_groups != NULL )
+		{
+			for( chunk_group_index = 0;
+			     chunk_group_index < ( *packed_chunk_table )->number_of_chunk_groups;
+			     chunk_group_index++ )
+			{
+				if( libewf_packed_chunk_group_free(
+				     &( ( ( *packed_chunk_table )->chunk_groups )[ chunk_group_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free packed chunk group: %d.",
+					 function,
+					 chunk_group_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *packed_chunk_table )->chunk_groups );
+		}
+		memory_free(
+		 *packed_chunk_table );
+
+		*packed_chunk_table = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the location of a specific chunk
+ * Returns 1 if successful, 0 if the chunk is not in the packed chunk table or -1 on error
+ */
+int libewf_packed_chunk_table_get_chunk_by_index(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_group_t *packed_chunk_group = NULL;
+	static char *function                           = "libewf_packed_chunk_table_get_chunk_by_index";
+	int first_chunk_group_index                     = 0;
+	int last_chunk_group_index                      = 0;
+	int chunk_group_index                           = 0;
+	int result                                      = 0;
+
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	first_chunk_group_index = 0;
+	last_chunk_group_index  = packed_chunk_table->number_of_chunk_groups - 1;
+
+	while( first_chunk_group_index <= last_chunk_group_index )
+	{
+		chunk_group_index  = first_chunk_group_index + ( ( last_chunk_group_index - first_chunk_group_index ) / 2 );
+		packed_chunk_group = packed_chunk_table->chunk_groups[ chunk_group_index ];
+
+		if( chunk_index < packed_chunk_group->first_chunk_index )
+		{
+			last_chunk_group_index = chunk_group_index - 1;
+		}
+		else if( ( chunk_index - packed_chunk_group->first_chunk_index ) >= (uint64_t) packed_chunk_group->number_of_chunks )
+		{
+			first_chunk_group_index = chunk_group_index + 1;
+		}
+		else
+		{
+			result = libewf_packed_chunk_group_get_chunk_by_index(
+			          packed_chunk_group,
+			          chunk_index,
+			          file_io_pool_entry,
+			          chunk_data_offset,
+			          chunk_data_size,
+			          range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve chunk: %" PRIu64 " from packed chunk group: %d.",
+				 function,
+				 chunk_index,
+				 chunk_group_index );
+
+				return( -1 );
+			}
+			break;
+		}
+	}
+	return( result );
+}
+
+/* Inserts a packed chunk group into the packed chunk table
+ * The packed chunk table takes over management of the packed chunk group when it is inserted
+ * Returns 1 if successful, 0 if the packed chunk group was not inserted or -1 on error
+ */
+int libewf_packed_chunk_table_insert_chunk_group(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_group_t **reallocation       = NULL;
+	libewf_packed_chunk_group_t *existing_chunk_group = NULL;
+	static char *function                            = "libewf_packed_chunk_table_insert_chunk_group";
+	size_t chunk_groups_size                         = 0;
+	int chunk_group_index                            = 0;
+	int first_chunk_group_index                      = 0;
+	int last_chunk_group_index                       = 0;
+	int number_of_allocated_chunk_groups             = 0;
+	int shift_chunk_group_index                      = 0;
+
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_group == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk group.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_group->number_of_chunks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid packed chunk group - number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Chunk groups that do not fit in the maximum size are not inserted
+	 */
+	if( ( packed_chunk_table->size + packed_chunk_group->size + sizeof( libewf_packed_chunk_group_t * ) ) > packed_chunk_table->maximum_size )
+	{
+		return( 0 );
+	}
+	/* Determine the index at which the chunk group is inserted
+	 */
+	first_chunk_group_index = 0;
+	last_chunk_group_index  = packed_chunk_table->number_of_chunk_groups - 1;
+
+	while( first_chunk_group_index <= last_chunk_group_index )
+	{
+		chunk_group_index    = first_chunk_group_index + ( ( last_chunk_group_index - first_chunk_group_index ) / 2 );
+		existing_chunk_group = packed_chunk_table->chunk_groups[ chunk_group_index ];
+
+		if( packed_chunk_group->first_chunk_index < existing_chunk_group->first_chunk_index )
+		{
+			last_chunk_group_index = chunk_group_index - 1;
+		}
+		else if( ( packed_chunk_group->first_chunk_index - existing_chunk_group->first_chunk_index ) >= (uint64_t) existing_chunk_group->number_of_chunks )
+		{
+			first_chunk_group_index = chunk_group_index + 1;
+		}
+		else
+		{
+			/* The chunk group was already inserted
+			 */
+			return( 0 );
+		}
+	}
+	chunk_group_index = first_chunk_group_index;
+
+	/* Chunk groups that overlap with the next chunk group are not inserted
+	 */
+	if( ( chunk_group_index < packed_chunk_table->number_of_chunk_groups )
+	 && ( ( packed_chunk_table->chunk_groups[ chunk_group_index ]->first_chunk_index - packed_chunk_group->first_chunk_index ) < (uint64_t) packed_chunk_group->number_of_chunks ) )
+	{
+		return( 0 );
+	}
+	if( packed_chunk_table->number_of_chunk_groups >= packed_chunk_table->number_of_allocated_chunk_groups )
+	{
+		if( packed_chunk_table->number_of_allocated_chunk_groups == 0 )
+		{
+			number_of_allocated_chunk_groups = 64;
+		}
+		else
+		{
+			number_of_allocated_chunk_groups = packed_chunk_table->number_of_allocated_chunk_groups * 2;
+		}
+		chunk_groups_size = sizeof( libewf_packed_chunk_group_t * ) * number_of_allocated_chunk_groups;
+
+		reallocation = (libewf_packed_chunk_group_t **) memory_reallocate(
+		                                                 packed_chunk_table->chunk_groups,
+		                                                 chunk_groups_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize packed chunk groups.",
+			 function );
+
+			return( -1 );
+		}
+		packed_chunk_table->chunk_groups                     = reallocation;
+		packed_chunk_table->number_of_allocated_chunk_groups = number_of_allocated_chunk_groups;
+	}
+	for( shift_chunk_group_index = packed_chunk_table->number_of_chunk_groups;
+	     shift_chunk_group_index > chunk_group_index;
+	     shift_chunk_group_index-- )
+	{
+		packed_chunk_table->chunk_groups[ shift_chunk_group_index ] = packed_chunk_table->chunk_groups[ shift_chunk_group_index - 1 ];
+	}
+	packed_chunk_table->chunk_groups[ chunk_group_index ] = packed_chunk_group;
+
+	packed_chunk_table->number_of_chunk_groups += 1;
+	packed_chunk_table->size                   += packed_chunk_group->size + sizeof( libewf_packed_chunk_group_t * );
+
+	return( 1 );
+}
+
+/* Inserts the chunks list of a chunk group into the packed chunk table
+ * Returns 1 if successful, 0 if the chunks list was not inserted or -1 on error
+ */
+int libewf_packed_chunk_table_insert_chunks_list(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t first_chunk_index,
+     libfdata_list_t *chunks_list,
+     libcerror_error_t **error )
+{
+	libewf_packed_chunk_group_t *packed_chunk_group = NULL;
+	static char *function                           = "libewf_packed_chunk_table_insert_chunks_list";
+	int result                                      = 0;
+
+	if( packed_chunk_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid packed chunk table.",
+		 function );
+
+		return( -1 );
+	}
+	if( packed_chunk_table->size >= packed_chunk_table->maximum_size )
+	{
+		return( 0 );
+	}
+	if( libewf_packed_chunk_group_initialize(
+	     &packed_chunk_group,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create packed chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	result = libewf_packed_chunk_group_set_chunks_list(
+	          packed_chunk_group,
+	          first_chunk_index,
+	          chunks_list,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set chunks list in packed chunk group.",
+		 function );
+
+		goto on_error;
+	}
+	/* Chunk groups that cannot be packed are not inserted
+	 */
+	if( result != 0 )
+	{
+		result = libewf_packed_chunk_table_insert_chunk_group(
+		          packed_chunk_table,
+		          packed_chunk_group,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to insert packed chunk group.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		if( libewf_packed_chunk_group_free(
+		     &packed_chunk_group,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free packed chunk group.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( packed_chunk_group != NULL )
+	{
+		libewf_packed_chunk_group_free(
+		 &packed_chunk_group,
+		 NULL );
+	}
+	return( -1 );
+}
+
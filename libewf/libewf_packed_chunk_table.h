@@ -0,0 +1,187 @@
+/*
+ * Packed chunk table functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PACKED_CHUNK_TABLE_H )
+#define _LIBEWF_PACKED_CHUNK_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+#include "libewf_libfdata.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_packed_chunk_group libewf_packed_chunk_group_t;
+
+/* The packed chunk group contains the locations of the chunks of a single table
+ * The chunks of a packed chunk group are stored contiguously, hence only
+ * the chunk data sizes are stored and the offsets are derived from them
+ */
+struct libewf_packed_chunk_group
+{
+	/* The index of the first chunk
+	 */
+	uint64_t first_chunk_index;
+
+	/* The number of chunks
+	 */
+	uint32_t number_of_chunks;
+
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The data offset of the first chunk
+	 */
+	off64_t data_offset;
+
+	/* The chunk data sizes
+	 * contains 2 or 4 bytes per chunk depending on the sizes entry size
+	 */
+	uint8_t *sizes;
+
+	/* The sizes entry size
+	 */
+	uint8_t sizes_entry_size;
+
+	/* The offsets, relative to the data offset, of every
+	 * LIBEWF_PACKED_CHUNK_GROUP_OFFSETS_INTERVAL-th chunk
+	 */
+	uint32_t *offsets;
+
+	/* The chunk flags
+	 * contains 2 bits per chunk
+	 */
+	uint8_t *flags;
+
+	/* The size of the packed chunk group in memory
+	 */
+	size_t size;
+};
+
+int libewf_packed_chunk_group_initialize(
+     libewf_packed_chunk_group_t **packed_chunk_group,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_group_free(
+     libewf_packed_chunk_group_t **packed_chunk_group,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_group_set_chunks_list(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     uint64_t first_chunk_index,
+     libfdata_list_t *chunks_list,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_group_get_chunk_by_index(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_group_get_data_size(
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+ssize_t libewf_packed_chunk_group_read_data(
+         libewf_packed_chunk_group_t *packed_chunk_group,
+         const uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+ssize_t libewf_packed_chunk_group_write_data(
+         libewf_packed_chunk_group_t *packed_chunk_group,
+         uint8_t *data,
+         size_t data_size,
+         libcerror_error_t **error );
+
+typedef struct libewf_packed_chunk_table libewf_packed_chunk_table_t;
+
+/* The packed chunk table contains the locations of the chunks of the chunk groups
+ * that were read, so that these do not need to be read again when the chunk groups
+ * are no longer cached. The packed chunk table uses a bounded amount of memory
+ */
+struct libewf_packed_chunk_table
+{
+	/* The packed chunk groups
+	 * sorted by their first chunk index
+	 */
+	libewf_packed_chunk_group_t **chunk_groups;
+
+	/* The number of packed chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* The number of allocated packed chunk groups
+	 */
+	int number_of_allocated_chunk_groups;
+
+	/* The size of the packed chunk table in memory
+	 */
+	size64_t size;
+
+	/* The maximum size of the packed chunk table in memory
+	 */
+	size64_t maximum_size;
+};
+
+int libewf_packed_chunk_table_initialize(
+     libewf_packed_chunk_table_t **packed_chunk_table,
+     size64_t maximum_size,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_table_free(
+     libewf_packed_chunk_table_t **packed_chunk_table,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_table_get_chunk_by_index(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t chunk_index,
+     int *file_io_pool_entry,
+     off64_t *chunk_data_offset,
+     size64_t *chunk_data_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_table_insert_chunk_group(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     libewf_packed_chunk_group_t *packed_chunk_group,
+     libcerror_error_t **error );
+
+int libewf_packed_chunk_table_insert_chunks_list(
+     libewf_packed_chunk_table_t *packed_chunk_table,
+     uint64_t first_chunk_index,
+     libfdata_list_t *chunks_list,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
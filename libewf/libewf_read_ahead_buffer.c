@@ -0,0 +1,505 @@
+/*
+ * Read-ahead buffer functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_async_io.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+#include "libewf_read_ahead_buffer.h"
+
+/* Creates a read-ahead buffer
+ * Make sure the value read_ahead_buffer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_buffer_initialize(
+     libewf_read_ahead_buffer_t **read_ahead_buffer,
+     size_t minimum_read_ahead_size,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_buffer_initialize";
+
+	if( read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead_buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_read_ahead_size == 0 )
+	 || ( maximum_read_ahead_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum read-ahead size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( minimum_read_ahead_size == 0 )
+	 || ( minimum_read_ahead_size > maximum_read_ahead_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid minimum read-ahead size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead_buffer = memory_allocate_structure(
+	                      libewf_read_ahead_buffer_t );
+
+	if( *read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     *read_ahead_buffer,
+	     0,
+	     sizeof( libewf_read_ahead_buffer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead buffer.",
+		 function );
+
+		memory_free(
+		 *read_ahead_buffer );
+
+		*read_ahead_buffer = NULL;
+
+		return( -1 );
+	}
+	( *read_ahead_buffer )->file_io_pool_entry      = -1;
+	( *read_ahead_buffer )->last_file_io_pool_entry = -1;
+	( *read_ahead_buffer )->read_ahead_size         = minimum_read_ahead_size;
+	( *read_ahead_buffer )->minimum_read_ahead_size = minimum_read_ahead_size;
+	( *read_ahead_buffer )->maximum_read_ahead_size = maximum_read_ahead_size;
+
+	return( 1 );
+}
+
+/* Frees a read-ahead buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_buffer_free(
+     libewf_read_ahead_buffer_t **read_ahead_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_buffer_free";
+
+	if( read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead_buffer != NULL )
+	{
+		if( ( *read_ahead_buffer )->data != NULL )
+		{
+			memory_free(
+			 ( *read_ahead_buffer )->data );
+		}
+		memory_free(
+		 *read_ahead_buffer );
+
+		*read_ahead_buffer = NULL;
+	}
+	return( 1 );
+}
+
+/* Fills the read-ahead buffer with the data of a file IO pool entry at a specific offset
+ * The number of bytes read is the current read-ahead size or less at the end of the file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_read_ahead_buffer_fill(
+     libewf_read_ahead_buffer_t *read_ahead_buffer,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_buffer_fill";
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	read_ahead_buffer->file_io_pool_entry = -1;
+	read_ahead_buffer->data_offset        = 0;
+	read_ahead_buffer->data_size          = 0;
+
+	if( read_ahead_buffer->read_ahead_size > read_ahead_buffer->allocated_data_size )
+	{
+		/* The data is replaced hence it does not need to be preserved
+		 */
+		if( read_ahead_buffer->data != NULL )
+		{
+			memory_free(
+			 read_ahead_buffer->data );
+
+			read_ahead_buffer->data                = NULL;
+			read_ahead_buffer->allocated_data_size = 0;
+		}
+		read_ahead_buffer->data = (uint8_t *) memory_allocate(
+		                                       sizeof( uint8_t ) * read_ahead_buffer->read_ahead_size );
+
+		if( read_ahead_buffer->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			return( -1 );
+		}
+		read_ahead_buffer->allocated_data_size = read_ahead_buffer->read_ahead_size;
+	}
+	/* The block is read with multiple reads in flight at once if asynchronous IO is available
+	 */
+	if( read_ahead_buffer->async_io != NULL )
+	{
+		result = libewf_async_io_read_buffer(
+		          read_ahead_buffer->async_io,
+		          file_io_pool,
+		          file_io_pool_entry,
+		          offset,
+		          read_ahead_buffer->data,
+		          read_ahead_buffer->read_ahead_size,
+		          &read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " in file IO pool entry: %d asynchronously.",
+			 function,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		read_count = (ssize_t) read_size;
+	}
+	if( result == 0 )
+	{
+		if( libbfio_pool_seek_offset(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+		read_count = libbfio_pool_read_buffer(
+		              file_io_pool,
+		              file_io_pool_entry,
+		              read_ahead_buffer->data,
+		              read_ahead_buffer->read_ahead_size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " in file IO pool entry: %d.",
+			 function,
+			 offset,
+			 file_io_pool_entry );
+
+			return( -1 );
+		}
+	}
+	read_ahead_buffer->file_io_pool_entry = file_io_pool_entry;
+	read_ahead_buffer->data_offset        = offset;
+	read_ahead_buffer->data_size          = (size_t) read_count;
+
+	return( 1 );
+}
+
+/* Reads data of a file IO pool entry at a specific offset
+ * If the data is in the read-ahead buffer it is copied from the read-ahead buffer,
+ * otherwise if the reads are sequential the read-ahead buffer is filled first
+ * and if not the data is read from the file IO pool entry directly
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libewf_read_ahead_buffer_read_buffer(
+         libewf_read_ahead_buffer_t *read_ahead_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_read_ahead_buffer_read_buffer";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+	int is_sequential     = 0;
+
+	if( read_ahead_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry == read_ahead_buffer->last_file_io_pool_entry )
+	 && ( offset == read_ahead_buffer->last_read_end_offset ) )
+	{
+		is_sequential = 1;
+
+		if( read_ahead_buffer->number_of_sequential_reads < LIBEWF_READ_AHEAD_BUFFER_SEQUENTIAL_THRESHOLD )
+		{
+			read_ahead_buffer->number_of_sequential_reads += 1;
+		}
+	}
+	else
+	{
+		read_ahead_buffer->number_of_sequential_reads = 0;
+		read_ahead_buffer->read_ahead_size            = read_ahead_buffer->minimum_read_ahead_size;
+	}
+	read_ahead_buffer->last_file_io_pool_entry = file_io_pool_entry;
+	read_ahead_buffer->last_read_end_offset    = offset + buffer_size;
+
+	if( ( file_io_pool_entry == read_ahead_buffer->file_io_pool_entry )
+	 && ( offset >= read_ahead_buffer->data_offset )
+	 && ( (size64_t) ( offset - read_ahead_buffer->data_offset ) <= (size64_t) read_ahead_buffer->data_size ) )
+	{
+		data_offset = (size_t) ( offset - read_ahead_buffer->data_offset );
+
+		if( buffer_size <= ( read_ahead_buffer->data_size - data_offset ) )
+		{
+			if( memory_copy(
+			     buffer,
+			     &( read_ahead_buffer->data[ data_offset ] ),
+			     buffer_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data from read-ahead buffer.",
+				 function );
+
+				return( -1 );
+			}
+			return( (ssize_t) buffer_size );
+		}
+		/* The read continues at or beyond the end of the data of the read-ahead
+		 * buffer hence the next block of data is read with a larger read-ahead size
+		 */
+		if( is_sequential != 0 )
+		{
+			if( read_ahead_buffer->read_ahead_size <= ( read_ahead_buffer->maximum_read_ahead_size / 2 ) )
+			{
+				read_ahead_buffer->read_ahead_size *= 2;
+			}
+			else
+			{
+				read_ahead_buffer->read_ahead_size = read_ahead_buffer->maximum_read_ahead_size;
+			}
+		}
+	}
+	if( ( read_ahead_buffer->number_of_sequential_reads >= LIBEWF_READ_AHEAD_BUFFER_SEQUENTIAL_THRESHOLD )
+	 && ( buffer_size < read_ahead_buffer->read_ahead_size ) )
+	{
+		if( libewf_read_ahead_buffer_fill(
+		     read_ahead_buffer,
+		     file_io_pool,
+		     file_io_pool_entry,
+		     offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to fill read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		read_count = (ssize_t) buffer_size;
+
+		if( buffer_size > read_ahead_buffer->data_size )
+		{
+			read_count = (ssize_t) read_ahead_buffer->data_size;
+		}
+		if( memory_copy(
+		     buffer,
+		     read_ahead_buffer->data,
+		     (size_t) read_count ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		return( read_count );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              buffer,
+	              buffer_size,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " in file IO pool entry: %d.",
+		 function,
+		 offset,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
@@ -0,0 +1,126 @@
+/*
+ * Read-ahead buffer functions
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_READ_AHEAD_BUFFER_H )
+#define _LIBEWF_READ_AHEAD_BUFFER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_async_io.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_read_ahead_buffer libewf_read_ahead_buffer_t;
+
+/* The read-ahead buffer detects sequential reads of segment file data and
+ * then reads a large block of the segment file at once, from which
+ * the subsequent reads are served. The read-ahead size grows, up to
+ * the maximum, while the reads remain sequential
+ */
+struct libewf_read_ahead_buffer
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The allocated data size
+	 */
+	size_t allocated_data_size;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The file IO pool entry of the data, -1 if the data is not set
+	 */
+	int file_io_pool_entry;
+
+	/* The offset of the data in the file IO pool entry
+	 */
+	off64_t data_offset;
+
+	/* The file IO pool entry of the last read
+	 */
+	int last_file_io_pool_entry;
+
+	/* The offset directly after the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The current read-ahead size
+	 */
+	size_t read_ahead_size;
+
+	/* The minimum read-ahead size
+	 */
+	size_t minimum_read_ahead_size;
+
+	/* The maximum read-ahead size
+	 */
+	size_t maximum_read_ahead_size;
+
+	/* The asynchronous IO used to fill the read-ahead buffer
+	 * if set the read-ahead buffer does not manage it
+	 */
+	libewf_async_io_t *async_io;
+};
+
+int libewf_read_ahead_buffer_initialize(
+     libewf_read_ahead_buffer_t **read_ahead_buffer,
+     size_t minimum_read_ahead_size,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_buffer_free(
+     libewf_read_ahead_buffer_t **read_ahead_buffer,
+     libcerror_error_t **error );
+
+int libewf_read_ahead_buffer_fill(
+     libewf_read_ahead_buffer_t *read_ahead_buffer,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t libewf_read_ahead_buffer_read_buffer(
+         libewf_read_ahead_buffer_t *read_ahead_buffer,
+         libbfio_pool_t *file_io_pool,
+         int file_io_pool_entry,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif
+
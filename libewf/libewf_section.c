@@ -1769,6 +1769,7 @@ ssize_t libewf_section_compressed_string_read(
 	          compression_method,
 	          *uncompressed_string,
 	          uncompressed_string_size,
+	          NULL,
 	          error );
 
 	while( ( result == 0 )
@@ -1799,6 +1800,7 @@ ssize_t libewf_section_compressed_string_read(
 		          compression_method,
 		          *uncompressed_string,
 		          uncompressed_string_size,
+		          NULL,
 		          error );
 
 		if( number_of_attempts >= 3 )
@@ -1987,6 +1989,7 @@ ssize_t libewf_section_write_compressed_string(
 	          compression_level,
 	          uncompressed_string,
 	          uncompressed_string_size,
+	          NULL,
 	          error );
 
 	if( result == 0 )
@@ -2050,6 +2053,7 @@ ssize_t libewf_section_write_compressed_string(
 		          compression_level,
 		          uncompressed_string,
 		          uncompressed_string_size,
+		          NULL,
 		          error );
 	}
 	if( result != 1 )
@@ -6140,57 +6140,46 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a segment file
- * Callback function for the segment files list
+/* Reads the file header and section descriptors of a segment file
+ * The section descriptors are added to the sections list
  * Returns 1 if successful or -1 on error
  */
-int libewf_segment_file_read_element_data(
-     libewf_io_handle_t *io_handle,
+int libewf_segment_file_read_section_descriptors(
+     libewf_segment_file_t *segment_file,
      libbfio_pool_t *file_io_pool,
-     libfdata_list_element_t *element,
-     libfcache_cache_t *cache,
      int file_io_pool_entry,
-     off64_t segment_file_offset,
      size64_t segment_file_size,
-     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	libewf_section_t *section           = NULL;
-	libewf_segment_file_t *segment_file = NULL;
-	static char *function               = "libewf_segment_file_read_element_data";
-	ssize_t read_count                  = 0;
-	int element_index                   = 0;
-	int last_section                    = 0;
-	int section_index                   = 0;
+	libewf_section_t *section   = NULL;
+	static char *function       = "libewf_segment_file_read_section_descriptors";
+	off64_t segment_file_offset = 0;
+	ssize_t read_count          = 0;
+	int element_index           = 0;
+	int last_section            = 0;
+	int section_index           = 0;
 
-	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
-	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
-
-	if( io_handle == NULL )
+	if( segment_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid segment file.",
 		 function );
 
 		return( -1 );
 	}
-	if( libewf_segment_file_initialize(
-	     &segment_file,
-	     io_handle,
-	     error ) != 1 )
+	if( segment_file->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create segment file.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	read_count = libewf_segment_file_read_file_header(
 		      segment_file,
@@ -6225,13 +6214,13 @@ int libewf_segment_file_read_element_data(
 
 		goto on_error;
 	}
-	if( ( io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
+	if( ( segment_file->io_handle->segment_file_type == LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART )
 	 && ( segment_file->type == LIBEWF_SEGMENT_FILE_TYPE_EWF1 ) )
 	{
 		segment_file->type = LIBEWF_SEGMENT_FILE_TYPE_EWF1_SMART;
 	}
-	else if( ( io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
-	      && ( io_handle->segment_file_type != segment_file->type ) )
+	else if( ( segment_file->io_handle->segment_file_type != LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED )
+	      && ( segment_file->io_handle->segment_file_type != segment_file->type ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -6493,6 +6482,170 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
+	return( 1 );
+
+on_error:
+	if( section != NULL )
+	{
+		libewf_section_free(
+		 &section,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the file IO pool entry of the sections in the sections list
+ * This is used when the section descriptors were read using a different file IO pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_set_sections_file_io_pool_entry(
+     libewf_segment_file_t *segment_file,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function          = "libewf_segment_file_set_sections_file_io_pool_entry";
+	size64_t section_size          = 0;
+	off64_t section_offset         = 0;
+	uint32_t section_flags         = 0;
+	int number_of_sections         = 0;
+	int section_file_io_pool_entry = 0;
+	int section_index              = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->sections_list,
+		     section_index,
+		     &section_file_io_pool_entry,
+		     &section_offset,
+		     &section_size,
+		     &section_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_set_element_by_index(
+		     segment_file->sections_list,
+		     section_index,
+		     file_io_pool_entry,
+		     section_offset,
+		     section_size,
+		     section_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set section: %d in sections list.",
+			 function,
+			 section_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a segment file
+ * Callback function for the segment files list
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_element_data(
+     libewf_io_handle_t *io_handle,
+     libbfio_pool_t *file_io_pool,
+     libfdata_list_element_t *element,
+     libfcache_cache_t *cache,
+     int file_io_pool_entry,
+     off64_t segment_file_offset LIBEWF_ATTRIBUTE_UNUSED,
+     size64_t segment_file_size,
+     uint32_t element_flags LIBEWF_ATTRIBUTE_UNUSED,
+     uint8_t read_flags LIBEWF_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_file_read_element_data";
+
+	LIBEWF_UNREFERENCED_PARAMETER( segment_file_offset )
+	LIBEWF_UNREFERENCED_PARAMETER( element_flags )
+	LIBEWF_UNREFERENCED_PARAMETER( read_flags )
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_initialize(
+	     &segment_file,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segment file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_segment_file_read_section_descriptors(
+	     segment_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     segment_file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read section descriptors.",
+		 function );
+
+		goto on_error;
+	}
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -6514,12 +6667,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( section != NULL )
-	{
-		libewf_section_free(
-		 &section,
-		 NULL );
-	}
 	if( segment_file != NULL )
 	{
 		libewf_segment_file_free(
@@ -7324,3 +7471,108 @@ int libewf_segment_file_get_chunk_group_by_offset(
 	return( result );
 }
 
+/* Retrieves the maximum number of (table) entries of the chunk groups
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_get_maximum_number_of_chunk_group_entries(
+     libewf_segment_file_t *segment_file,
+     size32_t chunk_size,
+     uint32_t *maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function        = "libewf_segment_file_get_maximum_number_of_chunk_group_entries";
+	size64_t maximum_mapped_size = 0;
+	size64_t mapped_size         = 0;
+	uint64_t number_of_entries   = 0;
+	int chunk_group_index        = 0;
+	int number_of_chunk_groups   = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of chunk groups.",
+		 function );
+
+		return( -1 );
+	}
+	/* The mapped size of a chunk group is the number of entries multiplied by the chunk size
+	 */
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk group: %d mapped size.",
+			 function,
+			 chunk_group_index );
+
+			return( -1 );
+		}
+		if( mapped_size > maximum_mapped_size )
+		{
+			maximum_mapped_size = mapped_size;
+		}
+	}
+	number_of_entries = maximum_mapped_size / chunk_size;
+
+	if( ( maximum_mapped_size % chunk_size ) != 0 )
+	{
+		number_of_entries += 1;
+	}
+	if( number_of_entries > (uint64_t) UINT32_MAX )
+	{
+		number_of_entries = (uint64_t) UINT32_MAX;
+	}
+	*maximum_number_of_entries = (uint32_t) number_of_entries;
+
+	return( 1 );
+}
+
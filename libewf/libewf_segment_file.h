@@ -381,6 +381,18 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_section_descriptors(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_set_sections_file_io_pool_entry(
+     libewf_segment_file_t *segment_file,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -439,6 +451,12 @@ int libewf_segment_file_get_chunk_group_by_offset(
      libfdata_list_t **chunks_list,
      libcerror_error_t **error );
 
+int libewf_segment_file_get_maximum_number_of_chunk_group_entries(
+     libewf_segment_file_t *segment_file,
+     size32_t chunk_size,
+     uint32_t *maximum_number_of_entries,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -36,13 +36,39 @@
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libewf_handle {}		libewf_handle_t;
 typedef struct libewf_file_entry {}	libewf_file_entry_t;
+typedef struct libewf_chunk_view {}	libewf_chunk_view_t;
 
 #else
 typedef intptr_t libewf_handle_t;
 typedef intptr_t libewf_file_entry_t;
+typedef intptr_t libewf_chunk_view_t;
 
 #endif
 
+/* The read request, used to read multiple buffers at once
+ */
+typedef struct libewf_read_request libewf_read_request_t;
+
+struct libewf_read_request
+{
+	/* The (media) data offset
+	 */
+	off64_t offset;
+
+	/* The size of the data to read
+	 */
+	size_t size;
+
+	/* The buffer to read the data into
+	 */
+	uint8_t *buffer;
+
+	/* The number of bytes read into the buffer, set when the read request is read
+	 * this is less than the size if the read request extends beyond the end of the media data
+	 */
+	size_t read_size;
+};
+
 #endif /* defined( HAVE_LOCAL_LIBEWF ) */
 
 /* The largest primary (or scalar) available
@@ -778,6 +778,7 @@ int libewf_write_io_handle_initialize_values(
 				  compression_level,
 				  zero_byte_empty_block,
 				  (size_t) media_values->chunk_size,
+				  NULL,
 				  error );
 
 			/* Check if the compressed buffer was too small
@@ -834,6 +835,7 @@ int libewf_write_io_handle_initialize_values(
 					  compression_level,
 					  zero_byte_empty_block,
 					  (size_t) media_values->chunk_size,
+					  NULL,
 					  error );
 			}
 			if( result != 1 )
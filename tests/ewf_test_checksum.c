@@ -0,0 +1,340 @@
+/*
+ * Library checksum testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_unused.h"
+
+/* The checksum functions are internal functions of the library
+ * which can only be tested if the library does not hide them
+ */
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+#define EWF_TEST_CHECKSUM_INTERNAL
+
+#include "../libewf/libewf_checksum.h"
+#include "../libewf/libewf_definitions.h"
+#endif
+
+/* The Adler-32 is tested for every size up to 3 times the 5552 bytes
+ * after which the modulo calculation is needed, plus the maximum alignment offset
+ * and the size of a SIMD block
+ */
+#define EWF_TEST_CHECKSUM_MAXIMUM_SIZE		( ( 3 * 5552 ) + 64 )
+#define EWF_TEST_CHECKSUM_MAXIMUM_OFFSET	31
+
+#if defined( EWF_TEST_CHECKSUM_INTERNAL )
+
+typedef int (*ewf_test_checksum_adler32_function_t)(
+             uint32_t *checksum_value,
+             const uint8_t *buffer,
+             size_t size,
+             uint32_t initial_value,
+             libcerror_error_t **error );
+
+/* Updates an Adler-32 with a single byte
+ * This is the definition of the Adler-32 and is used as the reference
+ * Returns the updated Adler-32
+ */
+uint32_t ewf_test_checksum_adler32_update(
+          uint32_t checksum_value,
+          uint8_t byte_value )
+{
+	uint32_t lower_word = checksum_value & 0xffff;
+	uint32_t upper_word = ( checksum_value >> 16 ) & 0xffff;
+
+	lower_word = ( lower_word + byte_value ) % 0xfff1;
+	upper_word = ( upper_word + lower_word ) % 0xfff1;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Tests an Adler-32 function against the reference for every size up to the maximum size
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_checksum_adler32(
+     const char *kernel_name,
+     ewf_test_checksum_adler32_function_t adler32_function,
+     const uint8_t *buffer,
+     size_t buffer_offset,
+     uint32_t initial_value )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t checksum_value  = 0;
+	uint32_t reference_value = 0;
+	size_t size              = 0;
+	int result               = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing Adler-32 %s kernel with offset: %" PRIzu " and initial value: 0x%08" PRIx32 "\t",
+	 kernel_name,
+	 buffer_offset,
+	 initial_value );
+
+	reference_value = initial_value;
+
+	for( size = 0;
+	     size <= EWF_TEST_CHECKSUM_MAXIMUM_SIZE;
+	     size++ )
+	{
+		if( size > 0 )
+		{
+			reference_value = ewf_test_checksum_adler32_update(
+			                   reference_value,
+			                   buffer[ buffer_offset + size - 1 ] );
+		}
+		if( adler32_function(
+		     &checksum_value,
+		     &( buffer[ buffer_offset ] ),
+		     size,
+		     initial_value,
+		     &error ) != 1 )
+		{
+			result = -1;
+
+			break;
+		}
+		if( checksum_value != reference_value )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in Adler-32 of size: %" PRIzu " ( 0x%08" PRIx32 " != 0x%08" PRIx32 " ).\n",
+			 size,
+			 checksum_value,
+			 reference_value );
+
+			result = 0;
+
+			break;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Tests an Adler-32 function for all the buffer offsets and initial values
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_checksum_adler32_kernel(
+     const char *kernel_name,
+     ewf_test_checksum_adler32_function_t adler32_function,
+     const uint8_t *buffer )
+{
+	/* The initial values contain the largest valid lower and upper word values
+	 */
+	uint32_t initial_values[ 4 ] = { 0x00000001UL, 0x00000000UL, 0x12345678UL, 0xfff0fff0UL };
+	size_t buffer_offsets[ 4 ]   = { 0, 1, 15, EWF_TEST_CHECKSUM_MAXIMUM_OFFSET };
+	int initial_value_index      = 0;
+	int offset_index             = 0;
+	int result                   = 0;
+
+	for( offset_index = 0;
+	     offset_index < 4;
+	     offset_index++ )
+	{
+		for( initial_value_index = 0;
+		     initial_value_index < 4;
+		     initial_value_index++ )
+		{
+			result = ewf_test_checksum_adler32(
+			          kernel_name,
+			          adler32_function,
+			          buffer,
+			          buffer_offsets[ offset_index ],
+			          initial_values[ initial_value_index ] );
+
+			if( result != 1 )
+			{
+				return( result );
+			}
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( EWF_TEST_CHECKSUM_INTERNAL ) */
+
+/* The main program
+ */
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+{
+#if defined( EWF_TEST_CHECKSUM_INTERNAL )
+	uint8_t *buffer       = NULL;
+	size_t buffer_index   = 0;
+	size_t buffer_size    = 0;
+	uint32_t random_value = 0x2545f491UL;
+
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+	int kernel            = 0;
+#endif
+#endif
+
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if !defined( EWF_TEST_CHECKSUM_INTERNAL )
+	fprintf(
+	 stdout,
+	 "Internal functions not available, checksum not tested.\n" );
+
+	return( EXIT_SUCCESS );
+#else
+	buffer_size = EWF_TEST_CHECKSUM_MAXIMUM_SIZE + EWF_TEST_CHECKSUM_MAXIMUM_OFFSET;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	/* The first part of the buffer contains 0xff bytes, which causes the
+	 * largest intermediate sums, the remainder contains pseudo random bytes
+	 */
+	for( buffer_index = 0;
+	     buffer_index < buffer_size;
+	     buffer_index++ )
+	{
+		if( buffer_index < ( 2 * 5552 ) )
+		{
+			buffer[ buffer_index ] = 0xff;
+		}
+		else
+		{
+			random_value = ( random_value * 1103515245UL ) + 12345;
+
+			buffer[ buffer_index ] = (uint8_t) ( random_value >> 16 );
+		}
+	}
+	if( ewf_test_checksum_adler32_kernel(
+	     "scalar",
+	     &libewf_checksum_calculate_adler32_scalar,
+	     buffer ) != 1 )
+	{
+		goto on_error;
+	}
+#if defined( HAVE_ADLER32 ) && ( defined( HAVE_ZLIB ) || defined( ZLIB_DLL ) )
+	if( ewf_test_checksum_adler32_kernel(
+	     "zlib",
+	     &libewf_checksum_calculate_adler32_zlib,
+	     buffer ) != 1 )
+	{
+		goto on_error;
+	}
+#endif
+#if defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD )
+	kernel = libewf_checksum_get_adler32_kernel();
+
+	if( ( kernel == LIBEWF_ADLER32_KERNEL_SSSE3 )
+	 || ( kernel == LIBEWF_ADLER32_KERNEL_AVX2 ) )
+	{
+		if( ewf_test_checksum_adler32_kernel(
+		     "SSSE3",
+		     &libewf_checksum_calculate_adler32_ssse3,
+		     buffer ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "SSSE3 not supported by the CPU, Adler-32 SSSE3 kernel not tested.\n" );
+	}
+	if( kernel == LIBEWF_ADLER32_KERNEL_AVX2 )
+	{
+		if( ewf_test_checksum_adler32_kernel(
+		     "AVX2",
+		     &libewf_checksum_calculate_adler32_avx2,
+		     buffer ) != 1 )
+		{
+			goto on_error;
+		}
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "AVX2 not supported by the CPU, Adler-32 AVX2 kernel not tested.\n" );
+	}
+#endif /* defined( LIBEWF_CHECKSUM_HAVE_X86_SIMD ) */
+
+	if( ewf_test_checksum_adler32_kernel(
+	     "default",
+	     &libewf_checksum_calculate_adler32,
+	     buffer ) != 1 )
+	{
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( EXIT_FAILURE );
+#endif /* !defined( EWF_TEST_CHECKSUM_INTERNAL ) */
+}
+
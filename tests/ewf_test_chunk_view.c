@@ -0,0 +1,921 @@
+/*
+ * Library chunk view testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_chunk_view generate verbose output
+#define EWF_TEST_CHUNK_VIEW_VERBOSE
+ */
+
+/* The chunk size of the written image, which is the default chunk size
+ */
+#define EWF_TEST_CHUNK_VIEW_CHUNK_SIZE		( 64 * 512 )
+#define EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS	16
+#define EWF_TEST_CHUNK_VIEW_MEDIA_SIZE		( EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS * EWF_TEST_CHUNK_VIEW_CHUNK_SIZE )
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the buffers contain partial chunks
+ */
+#define EWF_TEST_CHUNK_VIEW_BUFFER_SIZE		5000
+
+/* The maximum length of the filename of the written image
+ */
+#define EWF_TEST_CHUNK_VIEW_MAXIMUM_FILENAME_LENGTH	1024
+
+/* Generates the media data
+ * Every fourth chunk contains zero bytes and every fourth chunk after that
+ * contains a 64-bit pattern, so that these chunks are stored as fill chunks
+ */
+void ewf_test_chunk_view_generate_data(
+      uint8_t *data,
+      size_t data_size )
+{
+	uint32_t value     = 0x12345678UL;
+	size_t chunk_index = 0;
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		chunk_index = data_offset / EWF_TEST_CHUNK_VIEW_CHUNK_SIZE;
+
+		if( ( chunk_index % 4 ) == 0 )
+		{
+			data[ data_offset ] = 0;
+		}
+		else if( ( chunk_index % 4 ) == 1 )
+		{
+			data[ data_offset ] = (uint8_t) ( 0xf0 | ( data_offset % 8 ) );
+		}
+		else
+		{
+			value = ( value * 1103515245UL ) + 12345UL;
+
+			data[ data_offset ] = (uint8_t) ( value >> 16 );
+		}
+	}
+}
+
+/* Writes the media data to an EWF file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_view_write(
+     const libcstring_system_character_t *filename,
+     const uint8_t *data,
+     size_t data_size )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	ssize_t write_count     = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set media size.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     LIBEWF_COMPRESSION_FAST,
+	     LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set compression values.\n" );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               data,
+	               data_size,
+	               &error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the EWF file with a cache of a single chunk
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_chunk_view_open(
+     libcstring_system_character_t *filename,
+     int access_flags,
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+	size32_t chunk_size   = 0;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	/* A cache size of 1 byte is rounded up to a cache of a single chunk
+	 * so that every chunk that is read evicts the previous chunk
+	 */
+	if( libewf_handle_set_cache_size(
+	     *handle,
+	     1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set cache size.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     &filename,
+	     1,
+	     access_flags,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     &filename,
+	     1,
+	     access_flags,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     *handle,
+	     &chunk_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk size.\n" );
+
+		goto on_error;
+	}
+	if( chunk_size != EWF_TEST_CHUNK_VIEW_CHUNK_SIZE )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported chunk size: %" PRIu32 ".\n",
+		 chunk_size );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( *handle != NULL )
+	{
+		libewf_handle_close(
+		 *handle,
+		 NULL );
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves a chunk view and compares its data with the expected data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_view_get(
+     libewf_handle_t *handle,
+     off64_t offset,
+     const uint8_t *expected_data,
+     const uint8_t **data,
+     libewf_chunk_view_t **chunk_view )
+{
+	libewf_error_t *error = NULL;
+	size_t data_size      = 0;
+	size_t expected_size  = 0;
+	int result            = 0;
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          offset,
+	          data,
+	          &data_size,
+	          chunk_view,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve chunk view at offset: %" PRIi64 ".\n",
+		 offset );
+
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	/* The data of a chunk view is limited to the end of the chunk
+	 */
+	expected_size = EWF_TEST_CHUNK_VIEW_CHUNK_SIZE - (size_t) ( offset % EWF_TEST_CHUNK_VIEW_CHUNK_SIZE );
+
+	if( ( *data == NULL )
+	 || ( data_size != expected_size ) )
+	{
+		return( 0 );
+	}
+	if( memory_compare(
+	     *data,
+	     &( expected_data[ offset ] ),
+	     data_size ) != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests that the data of chunk views remains valid while the chunks are evicted from the cache
+ * and that the handle cannot be closed or freed while chunk views remain
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_view_pinning(
+     libcstring_system_character_t *filename,
+     const uint8_t *expected_data )
+{
+	libewf_chunk_view_t *chunk_views[ EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS ];
+	const uint8_t *chunk_view_data[ EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS ];
+
+	libewf_chunk_view_t *chunk_view = NULL;
+	libewf_handle_t *handle         = NULL;
+	const uint8_t *data             = NULL;
+	uint8_t *buffer                 = NULL;
+	off64_t offset                  = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	int chunk_index                 = 0;
+	int result                      = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing chunk views across cache eviction\t" );
+
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		chunk_views[ chunk_index ]     = NULL;
+		chunk_view_data[ chunk_index ] = NULL;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      EWF_TEST_CHUNK_VIEW_BUFFER_SIZE );
+
+	if( buffer == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create buffer.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_chunk_view_open(
+	     filename,
+	     LIBEWF_OPEN_READ,
+	     &handle ) != 1 )
+	{
+		goto on_error;
+	}
+	/* The offsets within the chunks vary so that views start within the chunk
+	 */
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		offset = ( (off64_t) chunk_index * EWF_TEST_CHUNK_VIEW_CHUNK_SIZE )
+		       + ( ( chunk_index % 3 ) * 1000 );
+
+		result = ewf_test_chunk_view_get(
+		          handle,
+		          offset,
+		          expected_data,
+		          &( chunk_view_data[ chunk_index ] ),
+		          &( chunk_views[ chunk_index ] ) );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Invalid chunk view of chunk: %d.\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	/* Reading all the data evicts the chunks from the cache
+	 */
+	for( offset = 0;
+	     offset < (off64_t) EWF_TEST_CHUNK_VIEW_MEDIA_SIZE;
+	     offset += read_count )
+	{
+		read_size = EWF_TEST_CHUNK_VIEW_BUFFER_SIZE;
+
+		if( ( EWF_TEST_CHUNK_VIEW_MEDIA_SIZE - offset ) < (off64_t) read_size )
+		{
+			read_size = (size_t) ( EWF_TEST_CHUNK_VIEW_MEDIA_SIZE - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              offset,
+		              NULL );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIi64 ".\n",
+			 offset );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( expected_data[ offset ] ),
+		     read_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		offset = ( (off64_t) chunk_index * EWF_TEST_CHUNK_VIEW_CHUNK_SIZE )
+		       + ( ( chunk_index % 3 ) * 1000 );
+
+		if( memory_compare(
+		     chunk_view_data[ chunk_index ],
+		     &( expected_data[ offset ] ),
+		     EWF_TEST_CHUNK_VIEW_CHUNK_SIZE - ( ( chunk_index % 3 ) * 1000 ) ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Data of chunk view of chunk: %d changed.\n",
+			 chunk_index );
+
+			result = 0;
+		}
+	}
+	/* A chunk view beyond the end of the media data is not available
+	 */
+	if( ewf_test_chunk_view_get(
+	     handle,
+	     (off64_t) EWF_TEST_CHUNK_VIEW_MEDIA_SIZE,
+	     expected_data,
+	     &data,
+	     &chunk_view ) != 0 )
+	{
+		result = 0;
+	}
+	if( chunk_view != NULL )
+	{
+		libewf_chunk_view_free(
+		 &chunk_view,
+		 NULL );
+	}
+	/* The handle cannot be closed or freed while chunk views remain
+	 */
+	if( libewf_handle_close(
+	     handle,
+	     NULL ) != -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Handle closed while chunk views remain.\n" );
+
+		goto on_error;
+	}
+	if( ( libewf_handle_free(
+	       &handle,
+	       NULL ) != -1 )
+	 || ( handle == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Handle freed while chunk views remain.\n" );
+
+		goto on_error;
+	}
+	/* The handle remains usable after the close failed
+	 */
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              EWF_TEST_CHUNK_VIEW_BUFFER_SIZE,
+	              0,
+	              NULL );
+
+	if( read_count != (ssize_t) EWF_TEST_CHUNK_VIEW_BUFFER_SIZE )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to read buffer after close failed.\n" );
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		if( libewf_chunk_view_free(
+		     &( chunk_views[ chunk_index ] ),
+		     NULL ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to free chunk view of chunk: %d.\n",
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_close(
+	     handle,
+	     NULL ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     NULL ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffer );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_CHUNK_VIEW_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		if( chunk_views[ chunk_index ] != NULL )
+		{
+			libewf_chunk_view_free(
+			 &( chunk_views[ chunk_index ] ),
+			 NULL );
+		}
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* Tests that the handle cannot be written to while chunk views remain
+ * The data is written to a delta segment file
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_chunk_view_write_refusal(
+     libcstring_system_character_t *filename,
+     const uint8_t *expected_data )
+{
+	uint8_t buffer[ 512 ];
+
+	libewf_chunk_view_t *chunk_view = NULL;
+	libewf_handle_t *handle         = NULL;
+	const uint8_t *data             = NULL;
+	ssize_t read_count              = 0;
+	ssize_t write_count             = 0;
+	int result                      = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing write refusal while chunk views remain\t" );
+
+	if( memory_set(
+	     buffer,
+	     'X',
+	     512 ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set buffer.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_chunk_view_open(
+	     filename,
+	     LIBEWF_OPEN_READ_WRITE,
+	     &handle ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_chunk_view_get(
+	     handle,
+	     EWF_TEST_CHUNK_VIEW_CHUNK_SIZE * 2,
+	     expected_data,
+	     &data,
+	     &chunk_view ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Invalid chunk view.\n" );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer_at_offset(
+	               handle,
+	               buffer,
+	               512,
+	               EWF_TEST_CHUNK_VIEW_CHUNK_SIZE * 2,
+	               NULL );
+
+	if( write_count != -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Handle written to while chunk views remain.\n" );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     &( expected_data[ EWF_TEST_CHUNK_VIEW_CHUNK_SIZE * 2 ] ),
+	     EWF_TEST_CHUNK_VIEW_CHUNK_SIZE ) != 0 )
+	{
+		result = 0;
+	}
+	if( libewf_chunk_view_free(
+	     &chunk_view,
+	     NULL ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free chunk view.\n" );
+
+		goto on_error;
+	}
+	/* The handle can be written to after the chunk views were freed
+	 */
+	write_count = libewf_handle_write_buffer_at_offset(
+	               handle,
+	               buffer,
+	               512,
+	               EWF_TEST_CHUNK_VIEW_CHUNK_SIZE * 2,
+	               NULL );
+
+	if( write_count != 512 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write buffer after chunk views were freed.\n" );
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              512,
+	              EWF_TEST_CHUNK_VIEW_CHUNK_SIZE * 2,
+	              NULL );
+
+	if( ( read_count != 512 )
+	 || ( buffer[ 0 ] != 'X' )
+	 || ( buffer[ 511 ] != 'X' ) )
+	{
+		result = 0;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     NULL ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     NULL ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( chunk_view != NULL )
+	{
+		libewf_chunk_view_free(
+		 &chunk_view,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t filename[ EWF_TEST_CHUNK_VIEW_MAXIMUM_FILENAME_LENGTH ];
+
+	uint8_t *expected_data = NULL;
+	int print_count        = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target basename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_CHUNK_VIEW_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+	print_count = libcstring_system_string_sprintf(
+	               filename,
+	               EWF_TEST_CHUNK_VIEW_MAXIMUM_FILENAME_LENGTH,
+	               _LIBCSTRING_SYSTEM_STRING( "%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+	               _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	               argv[ 1 ] );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= EWF_TEST_CHUNK_VIEW_MAXIMUM_FILENAME_LENGTH ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set filename.\n" );
+
+		goto on_error;
+	}
+	expected_data = (uint8_t *) memory_allocate(
+	                             EWF_TEST_CHUNK_VIEW_MEDIA_SIZE );
+
+	if( expected_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create expected data.\n" );
+
+		goto on_error;
+	}
+	ewf_test_chunk_view_generate_data(
+	 expected_data,
+	 EWF_TEST_CHUNK_VIEW_MEDIA_SIZE );
+
+	if( ewf_test_chunk_view_write(
+	     argv[ 1 ],
+	     expected_data,
+	     EWF_TEST_CHUNK_VIEW_MEDIA_SIZE ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write EWF file.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_chunk_view_pinning(
+	     filename,
+	     expected_data ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_chunk_view_write_refusal(
+	     filename,
+	     expected_data ) != 1 )
+	{
+		goto on_error;
+	}
+	memory_free(
+	 expected_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,565 @@
+/*
+ * Library deflate backend testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_deflate_backend generate verbose output
+#define EWF_TEST_DEFLATE_BACKEND_VERBOSE
+ */
+
+/* The chunk size of the written image, which is the default chunk size
+ */
+#define EWF_TEST_DEFLATE_BACKEND_CHUNK_SIZE		( 64 * 512 )
+#define EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_CHUNKS	32
+#define EWF_TEST_DEFLATE_BACKEND_MEDIA_SIZE		( EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_CHUNKS * EWF_TEST_DEFLATE_BACKEND_CHUNK_SIZE )
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the buffers contain partial chunks
+ */
+#define EWF_TEST_DEFLATE_BACKEND_BUFFER_SIZE		5000
+
+/* The maximum length of the filename of the written image
+ */
+#define EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH	1024
+
+#if defined( HAVE_LIBDEFLATE )
+#define EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_BACKENDS	3
+#else
+#define EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_BACKENDS	2
+#endif
+
+/* The deflate backends, the libdeflate backend is only available
+ * if libewf was built with libdeflate
+ */
+uint8_t ewf_test_deflate_backends[ EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_BACKENDS ] = {
+	LIBEWF_DEFLATE_BACKEND_ZLIB,
+	LIBEWF_DEFLATE_BACKEND_DEFAULT,
+#if defined( HAVE_LIBDEFLATE )
+	LIBEWF_DEFLATE_BACKEND_LIBDEFLATE
+#endif
+};
+
+#define EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_COMPRESSION_LEVELS	2
+
+int8_t ewf_test_deflate_backend_compression_levels[ EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_COMPRESSION_LEVELS ] = {
+	LIBEWF_COMPRESSION_FAST,
+	LIBEWF_COMPRESSION_BEST };
+
+/* Generates the media data
+ * The chunks alternate between zero bytes, text-like data that compresses well,
+ * data with a low entropy that compresses somewhat and random data that
+ * does not compress and is stored uncompressed
+ */
+void ewf_test_deflate_backend_generate_data(
+      uint8_t *data,
+      size_t data_size )
+{
+	uint32_t value     = 0x12345678UL;
+	size_t chunk_index = 0;
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		chunk_index = data_offset / EWF_TEST_DEFLATE_BACKEND_CHUNK_SIZE;
+
+		value = ( value * 1103515245UL ) + 12345UL;
+
+		if( ( chunk_index % 4 ) == 0 )
+		{
+			data[ data_offset ] = 0;
+		}
+		else if( ( chunk_index % 4 ) == 1 )
+		{
+			data[ data_offset ] = (uint8_t) ( 'a' + ( ( data_offset / 7 ) + chunk_index ) % 26 );
+		}
+		else if( ( chunk_index % 4 ) == 2 )
+		{
+			data[ data_offset ] = (uint8_t) ( value >> 28 );
+		}
+		else
+		{
+			data[ data_offset ] = (uint8_t) ( value >> 16 );
+		}
+	}
+}
+
+/* Writes the media data to an EWF file using a specific deflate backend
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_deflate_backend_write(
+     const libcstring_system_character_t *filename,
+     uint8_t deflate_backend,
+     int8_t compression_level,
+     const uint8_t *data,
+     size_t data_size )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	ssize_t write_count     = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_deflate_backend(
+	     handle,
+	     deflate_backend,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set deflate backend.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set media size.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     0,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set compression values.\n" );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               data,
+	               data_size,
+	               &error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the media data from an EWF file using a specific deflate backend
+ * and compares it with the expected data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_deflate_backend_read(
+     libcstring_system_character_t *filename,
+     uint8_t deflate_backend,
+     const uint8_t *expected_data,
+     size_t expected_data_size )
+{
+	uint8_t buffer[ EWF_TEST_DEFLATE_BACKEND_BUFFER_SIZE ];
+
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	size64_t media_size     = 0;
+	size_t data_offset      = 0;
+	size_t read_size        = 0;
+	ssize_t read_count      = 0;
+	int result              = 1;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_deflate_backend(
+	     handle,
+	     deflate_backend,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set deflate backend.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	if( media_size != (size64_t) expected_data_size )
+	{
+		result = 0;
+	}
+	while( ( result == 1 )
+	    && ( data_offset < expected_data_size ) )
+	{
+		read_size = EWF_TEST_DEFLATE_BACKEND_BUFFER_SIZE;
+
+		if( ( expected_data_size - data_offset ) < read_size )
+		{
+			read_size = expected_data_size - data_offset;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              (off64_t) data_offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIzd ".\n",
+			 data_offset );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     buffer,
+		     &( expected_data[ data_offset ] ),
+		     read_size ) != 0 )
+		{
+			result = 0;
+		}
+		data_offset += read_size;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcstring_system_character_t basename[ EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH ];
+	libcstring_system_character_t filename[ EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH ];
+
+	uint8_t *expected_data  = NULL;
+	int compression_index   = 0;
+	int print_count         = 0;
+	int read_backend_index  = 0;
+	int result              = 0;
+	int write_backend_index = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target basename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_DEFLATE_BACKEND_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+#if !defined( HAVE_LIBDEFLATE )
+	fprintf(
+	 stdout,
+	 "libdeflate support not available, libdeflate backend not tested.\n" );
+#endif
+	expected_data = (uint8_t *) memory_allocate(
+	                             EWF_TEST_DEFLATE_BACKEND_MEDIA_SIZE );
+
+	if( expected_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create expected data.\n" );
+
+		goto on_error;
+	}
+	ewf_test_deflate_backend_generate_data(
+	 expected_data,
+	 EWF_TEST_DEFLATE_BACKEND_MEDIA_SIZE );
+
+	for( compression_index = 0;
+	     compression_index < EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_COMPRESSION_LEVELS;
+	     compression_index++ )
+	{
+		for( write_backend_index = 0;
+		     write_backend_index < EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_BACKENDS;
+		     write_backend_index++ )
+		{
+			print_count = libcstring_system_string_sprintf(
+			               basename,
+			               EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH,
+			               _LIBCSTRING_SYSTEM_STRING( "%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+			               _LIBCSTRING_SYSTEM_STRING( "_%d_%d" ),
+			               argv[ 1 ],
+			               (int) ewf_test_deflate_backends[ write_backend_index ],
+			               compression_index );
+
+			if( ( print_count < 0 )
+			 || ( print_count >= ( EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH - 4 ) ) )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set basename.\n" );
+
+				goto on_error;
+			}
+			print_count = libcstring_system_string_sprintf(
+			               filename,
+			               EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH,
+			               _LIBCSTRING_SYSTEM_STRING( "%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+			               _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+			               basename );
+
+			if( ( print_count < 0 )
+			 || ( print_count >= EWF_TEST_DEFLATE_BACKEND_MAXIMUM_FILENAME_LENGTH ) )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to set filename.\n" );
+
+				goto on_error;
+			}
+			if( ewf_test_deflate_backend_write(
+			     basename,
+			     ewf_test_deflate_backends[ write_backend_index ],
+			     ewf_test_deflate_backend_compression_levels[ compression_index ],
+			     expected_data,
+			     EWF_TEST_DEFLATE_BACKEND_MEDIA_SIZE ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to write EWF file.\n" );
+
+				goto on_error;
+			}
+			/* The image written by every backend should read back identically through every backend
+			 */
+			for( read_backend_index = 0;
+			     read_backend_index < EWF_TEST_DEFLATE_BACKEND_NUMBER_OF_BACKENDS;
+			     read_backend_index++ )
+			{
+				fprintf(
+				 stdout,
+				 "Testing compression level: %" PRIi8 " written with backend: %" PRIu8 " read with backend: %" PRIu8 "\t",
+				 ewf_test_deflate_backend_compression_levels[ compression_index ],
+				 ewf_test_deflate_backends[ write_backend_index ],
+				 ewf_test_deflate_backends[ read_backend_index ] );
+
+				result = ewf_test_deflate_backend_read(
+				          filename,
+				          ewf_test_deflate_backends[ read_backend_index ],
+				          expected_data,
+				          EWF_TEST_DEFLATE_BACKEND_MEDIA_SIZE );
+
+				if( result != 1 )
+				{
+					fprintf(
+					 stdout,
+					 "(FAIL)\n" );
+
+					goto on_error;
+				}
+				fprintf(
+				 stdout,
+				 "(PASS)\n" );
+			}
+		}
+	}
+	memory_free(
+	 expected_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,714 @@
+/*
+ * Library next data range testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_next_data_range generate verbose output
+#define EWF_TEST_NEXT_DATA_RANGE_VERBOSE
+ */
+
+/* A chunk of a single sector keeps the images small while they contain
+ * more chunks than are scanned in a single call
+ */
+#define EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE		512
+
+/* The maximum number of chunks scanned per call, which corresponds
+ * to LIBEWF_MAXIMUM_DATA_RANGE_SCAN_CHUNKS
+ */
+#define EWF_TEST_NEXT_DATA_RANGE_SCAN_CHUNKS		16384
+
+#define EWF_TEST_NEXT_DATA_RANGE_NUMBER_OF_CHUNKS	20020
+
+#define EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE		( EWF_TEST_NEXT_DATA_RANGE_NUMBER_OF_CHUNKS * EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE )
+
+/* The maximum length of the filename of the written image
+ */
+#define EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH	1024
+
+#define EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_DATA	'd'
+#define EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_PATTERN	'p'
+#define EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_ZERO	'z'
+
+typedef struct ewf_test_next_data_range_run ewf_test_next_data_range_run_t;
+
+struct ewf_test_next_data_range_run
+{
+	/* The first chunk
+	 */
+	uint64_t first_chunk;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The chunk type
+	 */
+	uint8_t chunk_type;
+};
+
+/* The layout of the media data
+ * The zero chunks that follow chunk 14 exceed the number of chunks scanned in a single call
+ */
+ewf_test_next_data_range_run_t ewf_test_next_data_range_runs[ 8 ] = {
+	{ 0, 4, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_DATA },
+	{ 4, 6, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_ZERO },
+	{ 10, 2, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_PATTERN },
+	{ 12, 1, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_ZERO },
+	{ 13, 1, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_DATA },
+	{ 14, 20000, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_ZERO },
+	{ 20014, 2, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_DATA },
+	{ 20016, 4, EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_ZERO } };
+
+typedef struct ewf_test_next_data_range_expected ewf_test_next_data_range_expected_t;
+
+struct ewf_test_next_data_range_expected
+{
+	/* The data offset in chunks
+	 */
+	uint64_t data_offset;
+
+	/* The data size in chunks, 0 if the scan continues at the data offset
+	 */
+	uint64_t data_size;
+};
+
+/* The data ranges of the compressed images
+ * Only the compressed zero chunks are sparse, the pattern chunks contain data
+ */
+ewf_test_next_data_range_expected_t ewf_test_next_data_range_expected_compressed[ 5 ] = {
+	{ 0, 4 },
+	{ 10, 2 },
+	{ 13, 1 },
+	{ 14 + EWF_TEST_NEXT_DATA_RANGE_SCAN_CHUNKS, 0 },
+	{ 20014, 2 } };
+
+/* The data ranges of the uncompressed image
+ * Uncompressed chunks are never sparse hence the data range is truncated to the scanned chunks
+ */
+ewf_test_next_data_range_expected_t ewf_test_next_data_range_expected_uncompressed[ 2 ] = {
+	{ 0, EWF_TEST_NEXT_DATA_RANGE_SCAN_CHUNKS },
+	{ EWF_TEST_NEXT_DATA_RANGE_SCAN_CHUNKS, EWF_TEST_NEXT_DATA_RANGE_NUMBER_OF_CHUNKS - EWF_TEST_NEXT_DATA_RANGE_SCAN_CHUNKS } };
+
+/* Generates the media data
+ */
+void ewf_test_next_data_range_generate_data(
+      uint8_t *data,
+      size_t data_size )
+{
+	uint32_t value       = 0x12345678UL;
+	uint64_t chunk_index = 0;
+	size_t data_offset   = 0;
+	int run_index        = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		chunk_index = data_offset / EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE;
+
+		while( ( run_index < 7 )
+		    && ( chunk_index >= ewf_test_next_data_range_runs[ run_index + 1 ].first_chunk ) )
+		{
+			run_index++;
+		}
+		switch( ewf_test_next_data_range_runs[ run_index ].chunk_type )
+		{
+			case EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_DATA:
+				value = ( value * 1103515245UL ) + 12345UL;
+
+				data[ data_offset ] = (uint8_t) ( value >> 16 );
+				break;
+
+			case EWF_TEST_NEXT_DATA_RANGE_CHUNK_TYPE_PATTERN:
+				data[ data_offset ] = (uint8_t) ( 0xf0 | ( data_offset % 8 ) );
+				break;
+
+			default:
+				data[ data_offset ] = 0;
+				break;
+		}
+	}
+}
+
+/* Writes the media data to an EWF file
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_next_data_range_write(
+     const libcstring_system_character_t *filename,
+     const uint8_t *data,
+     size_t data_size,
+     int8_t compression_level,
+     uint8_t compression_flags )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	ssize_t write_count     = 0;
+
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_media_size(
+	     handle,
+	     (size64_t) data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set media size.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_sectors_per_chunk(
+	     handle,
+	     EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE / 512,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set sectors per chunk.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_compression_values(
+	     handle,
+	     compression_level,
+	     compression_flags,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set compression values.\n" );
+
+		goto on_error;
+	}
+	write_count = libewf_handle_write_buffer(
+	               handle,
+	               data,
+	               data_size,
+	               &error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests retrieving the data ranges of an EWF file
+ * The data outside the data ranges must only contain 0-byte values
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_next_data_range(
+     libcstring_system_character_t *filename,
+     const uint8_t *expected_data,
+     ewf_test_next_data_range_expected_t *expected_ranges,
+     int number_of_expected_ranges )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *data           = NULL;
+	off64_t data_offset     = 0;
+	off64_t offset          = 0;
+	size64_t data_size      = 0;
+	ssize_t read_count      = 0;
+	int range_index         = 0;
+	int result              = 1;
+	int scan_result         = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing next data range of: %" PRIs_LIBCSTRING_SYSTEM "\t",
+	 filename );
+
+	data = (uint8_t *) memory_allocate(
+	                    EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE ) == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to clear data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	/* Only the data ranges are read, the remaining data is expected to be sparse
+	 */
+	while( range_index <= number_of_expected_ranges )
+	{
+		scan_result = libewf_handle_get_next_data_range(
+		               handle,
+		               offset,
+		               &data_offset,
+		               &data_size,
+		               &error );
+
+		if( scan_result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve next data range at offset: %" PRIi64 ".\n",
+			 offset );
+
+			goto on_error;
+		}
+		else if( scan_result == 0 )
+		{
+			break;
+		}
+		if( ( range_index >= number_of_expected_ranges )
+		 || ( data_offset != (off64_t) ( expected_ranges[ range_index ].data_offset * EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE ) )
+		 || ( data_size != ( expected_ranges[ range_index ].data_size * EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE ) ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected data range: %d at offset: %" PRIi64 " of size: %" PRIu64 ".\n",
+			 range_index,
+			 data_offset,
+			 data_size );
+
+			result = 0;
+
+			break;
+		}
+		if( data_size > 0 )
+		{
+			read_count = libewf_handle_read_buffer_at_offset(
+			              handle,
+			              &( data[ data_offset ] ),
+			              (size_t) data_size,
+			              data_offset,
+			              &error );
+
+			if( read_count != (ssize_t) data_size )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to read data range at offset: %" PRIi64 ".\n",
+				 data_offset );
+
+				goto on_error;
+			}
+		}
+		/* A data size of 0 indicates that the scan continues at the data offset
+		 */
+		offset = data_offset + (off64_t) data_size;
+
+		range_index++;
+	}
+	if( range_index != number_of_expected_ranges )
+	{
+		result = 0;
+	}
+	if( memory_compare(
+	     data,
+	     expected_data,
+	     EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE ) != 0 )
+	{
+		result = 0;
+	}
+	/* The data range of an offset within a data chunk starts at the offset
+	 */
+	if( libewf_handle_get_next_data_range(
+	     handle,
+	     100,
+	     &data_offset,
+	     &data_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve next data range at offset: 100.\n" );
+
+		goto on_error;
+	}
+	if( ( data_offset != 100 )
+	 || ( data_size != ( ( expected_ranges[ 0 ].data_size * EWF_TEST_NEXT_DATA_RANGE_CHUNK_SIZE ) - 100 ) ) )
+	{
+		result = 0;
+	}
+	/* There is no data range beyond the end of the media data
+	 */
+	if( libewf_handle_get_next_data_range(
+	     handle,
+	     EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE,
+	     &data_offset,
+	     &data_size,
+	     &error ) != 0 )
+	{
+		result = 0;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* Writes an EWF file and tests retrieving its data ranges
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_next_data_range_image(
+     const libcstring_system_character_t *basename,
+     const libcstring_system_character_t *name,
+     const uint8_t *expected_data,
+     int8_t compression_level,
+     uint8_t compression_flags,
+     ewf_test_next_data_range_expected_t *expected_ranges,
+     int number_of_expected_ranges )
+{
+	libcstring_system_character_t filename[ EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH ];
+
+	int print_count = 0;
+
+	print_count = libcstring_system_string_sprintf(
+	               filename,
+	               EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH,
+	               _LIBCSTRING_SYSTEM_STRING( "%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+	               _LIBCSTRING_SYSTEM_STRING( "_%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM ),
+	               basename,
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= ( EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH - 4 ) ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set filename.\n" );
+
+		return( -1 );
+	}
+	if( ewf_test_next_data_range_write(
+	     filename,
+	     expected_data,
+	     EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE,
+	     compression_level,
+	     compression_flags ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to write EWF file.\n" );
+
+		return( -1 );
+	}
+	print_count = libcstring_system_string_sprintf(
+	               filename,
+	               EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH,
+	               _LIBCSTRING_SYSTEM_STRING( "%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+	               _LIBCSTRING_SYSTEM_STRING( "_%" ) _LIBCSTRING_SYSTEM_STRING( PRIs_LIBCSTRING_SYSTEM )
+	               _LIBCSTRING_SYSTEM_STRING( ".E01" ),
+	               basename,
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( print_count >= EWF_TEST_NEXT_DATA_RANGE_MAXIMUM_FILENAME_LENGTH ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set filename.\n" );
+
+		return( -1 );
+	}
+	return( ewf_test_next_data_range(
+	         filename,
+	         expected_data,
+	         expected_ranges,
+	         number_of_expected_ranges ) );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	uint8_t *expected_data = NULL;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target basename.\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_NEXT_DATA_RANGE_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+	expected_data = (uint8_t *) memory_allocate(
+	                             EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE );
+
+	if( expected_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create expected data.\n" );
+
+		goto on_error;
+	}
+	ewf_test_next_data_range_generate_data(
+	 expected_data,
+	 EWF_TEST_NEXT_DATA_RANGE_MEDIA_SIZE );
+
+	/* The pattern chunks of the compressed image are stored as fill chunks
+	 * while those of the empty-block compressed image are stored uncompressed
+	 */
+	if( ewf_test_next_data_range_image(
+	     argv[ 1 ],
+	     _LIBCSTRING_SYSTEM_STRING( "compressed" ),
+	     expected_data,
+	     LIBEWF_COMPRESSION_FAST,
+	     LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	     ewf_test_next_data_range_expected_compressed,
+	     5 ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_next_data_range_image(
+	     argv[ 1 ],
+	     _LIBCSTRING_SYSTEM_STRING( "empty_block" ),
+	     expected_data,
+	     LIBEWF_COMPRESSION_NONE,
+	     LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	     ewf_test_next_data_range_expected_compressed,
+	     5 ) != 1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_next_data_range_image(
+	     argv[ 1 ],
+	     _LIBCSTRING_SYSTEM_STRING( "uncompressed" ),
+	     expected_data,
+	     LIBEWF_COMPRESSION_NONE,
+	     0,
+	     ewf_test_next_data_range_expected_uncompressed,
+	     2 ) != 1 )
+	{
+		goto on_error;
+	}
+	memory_free(
+	 expected_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	return( EXIT_FAILURE );
+}
+
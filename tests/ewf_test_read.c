@@ -20,6 +20,8 @@
  */
 
 #include <common.h>
+#include <memory.h>
+#include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
 #include <stdlib.h>
@@ -39,6 +41,8 @@
 
 #define EWF_TEST_READ_BUFFER_SIZE	4096
 
+#define EWF_TEST_READ_NUMBER_OF_READ_REQUESTS	7
+
 /* Tests libewf_handle_seek_offset
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -352,6 +356,213 @@ int ewf_test_seek_offset_and_read_buffer(
 	return( result );
 }
 
+/* Tests libewf_handle_read_vector
+ * The read requests are unsorted, overlap, span multiple chunks and extend beyond the media size
+ * The data of every read request is compared with that of libewf_handle_read_buffer_at_offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_vector(
+     libewf_handle_t *handle,
+     size64_t media_size )
+{
+	libewf_read_request_t read_requests[ EWF_TEST_READ_NUMBER_OF_READ_REQUESTS ];
+
+	uint8_t *expected_buffer = NULL;
+	libewf_error_t *error    = NULL;
+	off64_t offset           = 0;
+	size64_t expected_size   = 0;
+	size64_t total_size      = 0;
+	ssize_t read_count       = 0;
+	int read_request_index   = 0;
+	int result               = 0;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing reading vector of %d read requests\t",
+	 EWF_TEST_READ_NUMBER_OF_READ_REQUESTS );
+
+	if( memory_set(
+	     read_requests,
+	     0,
+	     sizeof( libewf_read_request_t ) * EWF_TEST_READ_NUMBER_OF_READ_REQUESTS ) == NULL )
+	{
+		return( -1 );
+	}
+	offset = 0;
+
+	if( media_size > 100 )
+	{
+		offset = (off64_t) ( media_size - 100 );
+	}
+	read_requests[ 0 ].offset = (off64_t) ( media_size / 3 );
+	read_requests[ 0 ].size   = EWF_TEST_READ_BUFFER_SIZE;
+	read_requests[ 1 ].offset = 0;
+	read_requests[ 1 ].size   = 1000;
+	read_requests[ 2 ].offset = 500;
+	read_requests[ 2 ].size   = 3000;
+	read_requests[ 3 ].offset = offset;
+	read_requests[ 3 ].size   = EWF_TEST_READ_BUFFER_SIZE;
+	read_requests[ 4 ].offset = (off64_t) ( media_size + 10 );
+	read_requests[ 4 ].size   = 512;
+	read_requests[ 5 ].offset = (off64_t) ( media_size / 5 );
+	read_requests[ 5 ].size   = 16 * EWF_TEST_READ_BUFFER_SIZE;
+	read_requests[ 6 ].offset = (off64_t) ( media_size / 3 ) + 1;
+	read_requests[ 6 ].size   = 10;
+
+	for( read_request_index = 0;
+	     read_request_index < EWF_TEST_READ_NUMBER_OF_READ_REQUESTS;
+	     read_request_index++ )
+	{
+		read_requests[ read_request_index ].buffer = (uint8_t *) memory_allocate(
+		                                                          read_requests[ read_request_index ].size );
+
+		if( read_requests[ read_request_index ].buffer == NULL )
+		{
+			result = -1;
+
+			goto on_error;
+		}
+	}
+	expected_buffer = (uint8_t *) memory_allocate(
+	                               16 * EWF_TEST_READ_BUFFER_SIZE );
+
+	if( expected_buffer == NULL )
+	{
+		result = -1;
+
+		goto on_error;
+	}
+	read_count = libewf_handle_read_vector(
+	              handle,
+	              read_requests,
+	              EWF_TEST_READ_NUMBER_OF_READ_REQUESTS,
+	              &error );
+
+	if( read_count < 0 )
+	{
+		goto on_error;
+	}
+	result = 1;
+
+	for( read_request_index = 0;
+	     read_request_index < EWF_TEST_READ_NUMBER_OF_READ_REQUESTS;
+	     read_request_index++ )
+	{
+		expected_size = 0;
+
+		if( (size64_t) read_requests[ read_request_index ].offset < media_size )
+		{
+			expected_size = media_size - read_requests[ read_request_index ].offset;
+
+			if( expected_size > (size64_t) read_requests[ read_request_index ].size )
+			{
+				expected_size = (size64_t) read_requests[ read_request_index ].size;
+			}
+		}
+		if( (size64_t) read_requests[ read_request_index ].read_size != expected_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unexpected read size: %" PRIzu " of read request: %d\n",
+			 read_requests[ read_request_index ].read_size,
+			 read_request_index );
+
+			result = 0;
+
+			break;
+		}
+		total_size += expected_size;
+
+		if( expected_size == 0 )
+		{
+			continue;
+		}
+		if( libewf_handle_read_buffer_at_offset(
+		     handle,
+		     expected_buffer,
+		     (size_t) expected_size,
+		     read_requests[ read_request_index ].offset,
+		     &error ) != (ssize_t) expected_size )
+		{
+			result = -1;
+
+			break;
+		}
+		if( memory_compare(
+		     read_requests[ read_request_index ].buffer,
+		     expected_buffer,
+		     (size_t) expected_size ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Mismatch in data of read request: %d\n",
+			 read_request_index );
+
+			result = 0;
+
+			break;
+		}
+	}
+	if( ( result == 1 )
+	 && ( (size64_t) read_count != total_size ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unexpected read count: %" PRIzd "\n",
+		 read_count );
+
+		result = 0;
+	}
+on_error:
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		if( result != 1 )
+		{
+			libewf_error_backtrace_fprint(
+			 error,
+			 stderr );
+		}
+		libewf_error_free(
+		 &error );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	for( read_request_index = 0;
+	     read_request_index < EWF_TEST_READ_NUMBER_OF_READ_REQUESTS;
+	     read_request_index++ )
+	{
+		if( read_requests[ read_request_index ].buffer != NULL )
+		{
+			memory_free(
+			 read_requests[ read_request_index ].buffer );
+		}
+	}
+	return( result );
+}
+
 /* Tests reading data from a handle
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -581,6 +792,20 @@ int ewf_test_read_from_handle(
 
 		return( result );
 	}
+	/* Case 4: test vector read
+	 */
+	result = ewf_test_read_vector(
+	          handle,
+	          media_size );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to test read vector.\n" );
+
+		return( result );
+	}
 	return( 1 );
 }
 
@@ -0,0 +1,814 @@
+/*
+ * Library cache read testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_read_cache generate verbose output
+#define EWF_TEST_READ_CACHE_VERBOSE
+ */
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the buffers contain partial chunks
+ */
+#define EWF_TEST_READ_CACHE_BUFFER_SIZE		5000
+#define EWF_TEST_READ_CACHE_MAXIMUM_SIZE	( 32 * 1024 * 1024 )
+
+#define EWF_TEST_READ_CACHE_NUMBER_OF_CACHE_SIZES	4
+
+/* The cache sizes, a cache size of 0 represents the default cache size
+ * and a cache size of 1 a cache of a single chunk and chunk group
+ */
+size64_t ewf_test_read_cache_sizes[ EWF_TEST_READ_CACHE_NUMBER_OF_CACHE_SIZES ] = {
+	0, 1, 1024 * 1024, 64 * 1024 * 1024 };
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     size64_t cache_size,
+     uint8_t cache_policy,
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_cache_size(
+	     *handle,
+	     cache_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set cache size.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_cache_policy(
+	     *handle,
+	     cache_policy,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set cache policy.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file(s).\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_close_handle(
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+	int result            = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_close(
+	     *handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data with libewf_handle_read_buffer_at_offset
+ * The buffers are read backwards if requested so that the chunks
+ * are accessed in a different order
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_data(
+     libewf_handle_t *handle,
+     uint8_t *data,
+     size64_t data_size,
+     int read_backwards )
+{
+	libewf_error_t *error      = NULL;
+	off64_t offset             = 0;
+	size64_t buffer_index      = 0;
+	size64_t number_of_buffers = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	int result                 = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	number_of_buffers = ( data_size + EWF_TEST_READ_CACHE_BUFFER_SIZE - 1 )
+	                  / EWF_TEST_READ_CACHE_BUFFER_SIZE;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_backwards == 0 )
+		{
+			offset = (off64_t) ( buffer_index * EWF_TEST_READ_CACHE_BUFFER_SIZE );
+		}
+		else
+		{
+			offset = (off64_t) ( ( number_of_buffers - buffer_index - 1 ) * EWF_TEST_READ_CACHE_BUFFER_SIZE );
+		}
+		read_size = EWF_TEST_READ_CACHE_BUFFER_SIZE;
+
+		if( ( data_size - offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( data_size - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              &( data[ offset ] ),
+		              read_size,
+		              offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIi64 ".\n",
+			 offset );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data with a specific cache size and policy and compares it with the data read with the default cache size
+ * The cache is resized while the handle is open after which the data is read again
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_cache(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     const uint8_t *expected_data,
+     size64_t data_size,
+     size64_t cache_size,
+     size64_t resized_cache_size,
+     uint8_t cache_policy )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *data           = NULL;
+	int read_backwards      = 0;
+	int result              = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing read with cache size: %" PRIu64 " resized to: %" PRIu64 " and policy: %" PRIu8 "\t",
+	 cache_size,
+	 resized_cache_size,
+	 cache_policy );
+
+	data = (uint8_t *) memory_allocate(
+	                    (size_t) data_size );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     cache_size,
+	     cache_policy,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	for( read_backwards = 0;
+	     read_backwards <= 1;
+	     read_backwards++ )
+	{
+		if( read_backwards != 0 )
+		{
+			if( libewf_handle_set_cache_size(
+			     handle,
+			     resized_cache_size,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to resize cache.\n" );
+
+				goto on_error;
+			}
+		}
+		if( memory_set(
+		     data,
+		     0,
+		     (size_t) data_size ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to clear data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     data,
+		     data_size,
+		     read_backwards ) != 1 )
+		{
+			goto on_error;
+		}
+		if( memory_compare(
+		     data,
+		     expected_data,
+		     (size_t) data_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* Tests the cache statistics with a specific cache size and policy
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_cache_statistics(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     size64_t data_size,
+     size64_t cache_size,
+     uint8_t cache_policy )
+{
+	uint8_t buffer[ EWF_TEST_READ_CACHE_BUFFER_SIZE ];
+
+	libewf_error_t *error     = NULL;
+	libewf_handle_t *handle   = NULL;
+	uint64_t number_of_hits   = 0;
+	uint64_t number_of_misses = 0;
+	uint64_t previous_hits    = 0;
+	size_t read_size          = EWF_TEST_READ_CACHE_BUFFER_SIZE;
+	ssize_t read_count        = 0;
+	int read_iterator         = 0;
+	int result                = 1;
+
+	fprintf(
+	 stdout,
+	 "Testing cache statistics with cache size: %" PRIu64 " and policy: %" PRIu8 "\t",
+	 cache_size,
+	 cache_policy );
+
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     cache_size,
+	     cache_policy,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( read_size > (size_t) data_size )
+	{
+		read_size = (size_t) data_size;
+	}
+	/* Every chunk that is read is either a cache hit or a cache miss
+	 * and reading the same data again should be served from the cache
+	 */
+	for( read_iterator = 0;
+	     read_iterator < 3;
+	     read_iterator++ )
+	{
+		previous_hits = number_of_hits;
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              read_size,
+		              0,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: 0.\n" );
+
+			goto on_error;
+		}
+		if( libewf_handle_get_cache_statistics(
+		     handle,
+		     &number_of_hits,
+		     &number_of_misses,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to retrieve cache statistics.\n" );
+
+			goto on_error;
+		}
+		if( read_iterator == 0 )
+		{
+			if( ( number_of_hits + number_of_misses ) == 0 )
+			{
+				result = 0;
+			}
+		}
+		else if( number_of_hits <= previous_hits )
+		{
+			result = 0;
+		}
+	}
+	/* The statistics are reset when the cache is resized
+	 */
+	if( libewf_handle_set_cache_size(
+	     handle,
+	     cache_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to resize cache.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_cache_statistics(
+	     handle,
+	     &number_of_hits,
+	     &number_of_misses,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve cache statistics.\n" );
+
+		goto on_error;
+	}
+	if( ( number_of_hits != 0 )
+	 || ( number_of_misses != 0 ) )
+	{
+		result = 0;
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t **filenames     = NULL;
+#else
+	char **filenames        = NULL;
+#endif
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *expected_data  = NULL;
+	size64_t data_size      = 0;
+	size64_t media_size     = 0;
+	uint8_t cache_policy    = 0;
+	int cache_size_index    = 0;
+	int number_of_filenames = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filename(s).\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_READ_CACHE_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ 1 ],
+	     libcstring_wide_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ 1 ],
+	     libcstring_narrow_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( number_of_filenames <= 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filenames.\n" );
+
+		goto on_error;
+	}
+	/* The data read with the default cache size is used as the reference
+	 */
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     0,
+	     LIBEWF_CACHE_POLICY_DIRECT,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Media size: %" PRIu64 " bytes\n",
+	 media_size );
+
+	/* The data is read into memory hence the size of the tested data is limited
+	 */
+	data_size = media_size;
+
+	if( data_size > (size64_t) EWF_TEST_READ_CACHE_MAXIMUM_SIZE )
+	{
+		data_size = (size64_t) EWF_TEST_READ_CACHE_MAXIMUM_SIZE;
+	}
+	if( data_size > 0 )
+	{
+		expected_data = (uint8_t *) memory_allocate(
+		                             (size_t) data_size );
+
+		if( expected_data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create expected data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     expected_data,
+		     data_size,
+		     0 ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data with the default cache size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( data_size > 0 )
+	{
+		for( cache_policy = LIBEWF_CACHE_POLICY_DIRECT;
+		     cache_policy <= LIBEWF_CACHE_POLICY_2Q;
+		     cache_policy++ )
+		{
+			for( cache_size_index = 0;
+			     cache_size_index < EWF_TEST_READ_CACHE_NUMBER_OF_CACHE_SIZES;
+			     cache_size_index++ )
+			{
+				if( ewf_test_read_cache(
+				     filenames,
+				     number_of_filenames,
+				     expected_data,
+				     data_size,
+				     ewf_test_read_cache_sizes[ cache_size_index ],
+				     ewf_test_read_cache_sizes[ ( cache_size_index + 1 ) % EWF_TEST_READ_CACHE_NUMBER_OF_CACHE_SIZES ],
+				     cache_policy ) != 1 )
+				{
+					goto on_error;
+				}
+				if( ewf_test_read_cache_statistics(
+				     filenames,
+				     number_of_filenames,
+				     data_size,
+				     ewf_test_read_cache_sizes[ cache_size_index ],
+				     cache_policy ) != 1 )
+				{
+					goto on_error;
+				}
+			}
+		}
+		memory_free(
+		 expected_data );
+
+		expected_data = NULL;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
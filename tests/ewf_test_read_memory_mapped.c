@@ -0,0 +1,603 @@
+/*
+ * Library memory mapped read testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_read_memory_mapped generate verbose output
+#define EWF_TEST_READ_MEMORY_MAPPED_VERBOSE
+ */
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the buffers contain partial chunks
+ */
+#define EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE		5000
+#define EWF_TEST_READ_MEMORY_MAPPED_MAXIMUM_SIZE	( 32 * 1024 * 1024 )
+
+/* Opens a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     uint8_t read_memory_mapped,
+     int maximum_number_of_open_handles,
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_read_memory_mapped(
+	     *handle,
+	     read_memory_mapped,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set read memory mapped.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_maximum_number_of_open_handles(
+	     *handle,
+	     maximum_number_of_open_handles,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum number of open handles.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file(s).\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_close_handle(
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+	int result            = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_close(
+	     *handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data with libewf_handle_read_buffer_at_offset
+ * The buffers are read backwards if requested so that the mapped files
+ * are accessed in a different order
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_data(
+     libewf_handle_t *handle,
+     uint8_t *data,
+     size64_t data_size,
+     int read_backwards )
+{
+	libewf_error_t *error      = NULL;
+	off64_t offset             = 0;
+	size64_t buffer_index      = 0;
+	size64_t number_of_buffers = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	int result                 = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	number_of_buffers = ( data_size + EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE - 1 )
+	                  / EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_backwards == 0 )
+		{
+			offset = (off64_t) ( buffer_index * EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE );
+		}
+		else
+		{
+			offset = (off64_t) ( ( number_of_buffers - buffer_index - 1 ) * EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE );
+		}
+		read_size = EWF_TEST_READ_MEMORY_MAPPED_BUFFER_SIZE;
+
+		if( ( data_size - offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( data_size - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              &( data[ offset ] ),
+		              read_size,
+		              offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIi64 ".\n",
+			 offset );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data memory mapped and compares it with the data read buffered
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_memory_mapped(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     const uint8_t *expected_data,
+     size64_t data_size,
+     int maximum_number_of_open_handles,
+     int read_backwards )
+{
+	libewf_handle_t *handle = NULL;
+	uint8_t *data           = NULL;
+	int result              = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing memory mapped read with maximum number of open handles: %d%s\t",
+	 maximum_number_of_open_handles,
+	 ( read_backwards == 0 ) ? "" : " backwards" );
+
+	data = (uint8_t *) memory_allocate(
+	                    (size_t) data_size );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     1,
+	     maximum_number_of_open_handles,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	result = ewf_test_read_data(
+	          handle,
+	          data,
+	          data_size,
+	          read_backwards );
+
+	if( result == 1 )
+	{
+		if( memory_compare(
+		     data,
+		     expected_data,
+		     (size_t) data_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t **filenames     = NULL;
+#else
+	char **filenames        = NULL;
+#endif
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *expected_data  = NULL;
+	size64_t data_size      = 0;
+	size64_t media_size     = 0;
+	int number_of_filenames = 0;
+
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+	int read_backwards      = 0;
+#endif
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filename(s).\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_READ_MEMORY_MAPPED_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ 1 ],
+	     libcstring_wide_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ 1 ],
+	     libcstring_narrow_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( number_of_filenames <= 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filenames.\n" );
+
+		goto on_error;
+	}
+	/* The data read buffered is used as the reference
+	 */
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     0,
+	     0,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Media size: %" PRIu64 " bytes\n",
+	 media_size );
+
+	/* The data is read into memory hence the size of the tested data is limited
+	 */
+	data_size = media_size;
+
+	if( data_size > (size64_t) EWF_TEST_READ_MEMORY_MAPPED_MAXIMUM_SIZE )
+	{
+		data_size = (size64_t) EWF_TEST_READ_MEMORY_MAPPED_MAXIMUM_SIZE;
+	}
+	if( data_size > 0 )
+	{
+		expected_data = (uint8_t *) memory_allocate(
+		                             (size_t) data_size );
+
+		if( expected_data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create expected data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     expected_data,
+		     data_size,
+		     0 ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data buffered.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( data_size > 0 )
+	{
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+		/* A maximum of 1 open handle unmaps the least recently used segment file
+		 * every time the data of another segment file is read
+		 */
+		for( read_backwards = 0;
+		     read_backwards <= 1;
+		     read_backwards++ )
+		{
+			if( ewf_test_read_memory_mapped(
+			     filenames,
+			     number_of_filenames,
+			     expected_data,
+			     data_size,
+			     0,
+			     read_backwards ) != 1 )
+			{
+				goto on_error;
+			}
+			if( ewf_test_read_memory_mapped(
+			     filenames,
+			     number_of_filenames,
+			     expected_data,
+			     data_size,
+			     1,
+			     read_backwards ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+#else
+		fprintf(
+		 stdout,
+		 "Memory mapping not supported, reading memory mapped not tested.\n" );
+#endif
+		memory_free(
+		 expected_data );
+
+		expected_data = NULL;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,790 @@
+/*
+ * Library multi-threaded read testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_read_multi_thread generate verbose output
+#define EWF_TEST_READ_MULTI_THREAD_VERBOSE
+ */
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the threads read partial chunks that are shared with other threads
+ */
+#define EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE		5000
+#define EWF_TEST_READ_MULTI_THREAD_MAXIMUM_SIZE		( 32 * 1024 * 1024 )
+#define EWF_TEST_READ_MULTI_THREAD_NUMBER_OF_THREADS	4
+
+typedef struct ewf_test_read_job ewf_test_read_job_t;
+
+struct ewf_test_read_job
+{
+	/* The handle shared by all threads
+	 */
+	libewf_handle_t *handle;
+
+	/* The data read by a single thread
+	 */
+	const uint8_t *expected_data;
+
+	/* The size of the data
+	 */
+	size64_t data_size;
+
+	/* The index of the thread
+	 */
+	int thread_index;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The result, 1 if successful, 0 if not or -1 on error
+	 */
+	int result;
+};
+
+/* Reads the data with libewf_handle_read_buffer_at_offset
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_data(
+     libewf_handle_t *handle,
+     uint8_t *data,
+     size64_t data_size )
+{
+	libewf_error_t *error = NULL;
+	off64_t offset        = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	int result            = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	while( (size64_t) offset < data_size )
+	{
+		read_size = EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE;
+
+		if( ( data_size - offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( data_size - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              &( data[ offset ] ),
+		              read_size,
+		              offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIi64 ".\n",
+			 offset );
+
+			result = -1;
+
+			break;
+		}
+		offset += (off64_t) read_count;
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Reads every number of threads-th buffer of the data and compares it with the expected data
+ * The buffers are read forwards and then backwards so that the threads read different chunks at the same time
+ * Callback function for the thread pool
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_job_run(
+     ewf_test_read_job_t *read_job,
+     void *arguments EWF_TEST_ATTRIBUTE_UNUSED )
+{
+	uint8_t buffer[ EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE ];
+
+	libewf_error_t *error = NULL;
+	off64_t offset        = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	int64_t buffer_index  = 0;
+	int64_t last_index    = 0;
+	int pass              = 0;
+
+	EWF_TEST_UNREFERENCED_PARAMETER( arguments )
+
+	if( read_job == NULL )
+	{
+		return( -1 );
+	}
+	read_job->result = 1;
+
+	last_index = (int64_t) ( ( read_job->data_size - 1 ) / EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE );
+
+	for( pass = 0;
+	     pass < 2;
+	     pass++ )
+	{
+		for( buffer_index = read_job->thread_index;
+		     buffer_index <= last_index;
+		     buffer_index += read_job->number_of_threads )
+		{
+			if( pass == 0 )
+			{
+				offset = (off64_t) buffer_index * EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE;
+			}
+			else
+			{
+				offset = (off64_t) ( last_index - buffer_index ) * EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE;
+			}
+			read_size = EWF_TEST_READ_MULTI_THREAD_BUFFER_SIZE;
+
+			if( ( read_job->data_size - offset ) < (size64_t) read_size )
+			{
+				read_size = (size_t) ( read_job->data_size - offset );
+			}
+			read_count = libewf_handle_read_buffer_at_offset(
+			              read_job->handle,
+			              buffer,
+			              read_size,
+			              offset,
+			              &error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				fprintf(
+				 stderr,
+				 "Thread: %d unable to read buffer at offset: %" PRIi64 ".\n",
+				 read_job->thread_index,
+				 offset );
+
+				read_job->result = -1;
+
+				break;
+			}
+			if( memory_compare(
+			     buffer,
+			     &( read_job->expected_data[ offset ] ),
+			     read_size ) != 0 )
+			{
+				fprintf(
+				 stderr,
+				 "Thread: %d mismatch in data at offset: %" PRIi64 ".\n",
+				 read_job->thread_index,
+				 offset );
+
+				read_job->result = 0;
+
+				break;
+			}
+		}
+		if( read_job->result != 1 )
+		{
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( 1 );
+}
+
+/* Tests reading the data with multiple threads that share the handle
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_multi_thread(
+     libewf_handle_t *handle,
+     const uint8_t *expected_data,
+     size64_t data_size,
+     int number_of_threads )
+{
+	ewf_test_read_job_t read_jobs[ EWF_TEST_READ_MULTI_THREAD_NUMBER_OF_THREADS ];
+
+	libcerror_error_t *error               = NULL;
+	libcthreads_thread_pool_t *thread_pool = NULL;
+	int result                             = 1;
+	int thread_index                       = 0;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > EWF_TEST_READ_MULTI_THREAD_NUMBER_OF_THREADS ) )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 stdout,
+	 "Testing reading with %d threads\t",
+	 number_of_threads );
+
+	if( libcthreads_thread_pool_create(
+	     &thread_pool,
+	     NULL,
+	     number_of_threads,
+	     number_of_threads,
+	     (int (*)(intptr_t *, void *)) &ewf_test_read_job_run,
+	     NULL,
+	     &error ) != 1 )
+	{
+		result = -1;
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		read_jobs[ thread_index ].handle            = handle;
+		read_jobs[ thread_index ].expected_data     = expected_data;
+		read_jobs[ thread_index ].data_size         = data_size;
+		read_jobs[ thread_index ].thread_index      = thread_index;
+		read_jobs[ thread_index ].number_of_threads = number_of_threads;
+		read_jobs[ thread_index ].result            = -1;
+
+		if( result != 1 )
+		{
+			continue;
+		}
+		if( libcthreads_thread_pool_push(
+		     thread_pool,
+		     (intptr_t *) &( read_jobs[ thread_index ] ),
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	if( thread_pool != NULL )
+	{
+		/* Joining waits until all the read jobs have been run
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     &error ) != 1 )
+		{
+			result = -1;
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( ( result == 1 )
+		 && ( read_jobs[ thread_index ].result != 1 ) )
+		{
+			result = read_jobs[ thread_index ].result;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)" );
+	}
+	fprintf(
+	 stdout,
+	 "\n" );
+
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Opens a handle using scan threads and compares the data with the expected data
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_scan_threads(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     const uint8_t *expected_data,
+     size64_t data_size,
+     int number_of_scan_threads )
+{
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *data           = NULL;
+	int result              = 0;
+
+	fprintf(
+	 stdout,
+	 "Testing open with %d scan thread(s)\t",
+	 number_of_scan_threads );
+
+	data = (uint8_t *) memory_allocate(
+	                    (size_t) data_size );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_number_of_scan_threads(
+	     handle,
+	     number_of_scan_threads,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set number of scan threads.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file(s).\n" );
+
+		goto on_error;
+	}
+	result = ewf_test_read_data(
+	          handle,
+	          data,
+	          data_size );
+
+	if( result == 1 )
+	{
+		if( memory_compare(
+		     data,
+		     expected_data,
+		     (size_t) data_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t **filenames     = NULL;
+#else
+	char **filenames        = NULL;
+#endif
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *expected_data  = NULL;
+	size64_t data_size      = 0;
+	size64_t media_size     = 0;
+	int number_of_filenames = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_threads   = 0;
+#endif
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filename(s).\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_READ_MULTI_THREAD_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ 1 ],
+	     libcstring_wide_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ 1 ],
+	     libcstring_narrow_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( number_of_filenames <= 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filenames.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_initialize(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file(s).\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Media size: %" PRIu64 " bytes\n",
+	 media_size );
+
+	/* The data is read into memory hence the size of the tested data is limited
+	 */
+	data_size = media_size;
+
+	if( data_size > (size64_t) EWF_TEST_READ_MULTI_THREAD_MAXIMUM_SIZE )
+	{
+		data_size = (size64_t) EWF_TEST_READ_MULTI_THREAD_MAXIMUM_SIZE;
+	}
+	if( data_size > 0 )
+	{
+		expected_data = (uint8_t *) memory_allocate(
+		                             (size_t) data_size );
+
+		if( expected_data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create expected data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     expected_data,
+		     data_size ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data with a single thread.\n" );
+
+			goto on_error;
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		for( number_of_threads = 2;
+		     number_of_threads <= EWF_TEST_READ_MULTI_THREAD_NUMBER_OF_THREADS;
+		     number_of_threads *= 2 )
+		{
+			if( ewf_test_read_multi_thread(
+			     handle,
+			     expected_data,
+			     data_size,
+			     number_of_threads ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to test read with multiple threads.\n" );
+
+				goto on_error;
+			}
+		}
+		/* A single scan thread is read serially, multiple scan threads scan
+		 * the segment files of a multi segment file image concurrently
+		 */
+		for( number_of_threads = 1;
+		     number_of_threads <= EWF_TEST_READ_MULTI_THREAD_NUMBER_OF_THREADS;
+		     number_of_threads *= 2 )
+		{
+			if( ewf_test_read_scan_threads(
+			     filenames,
+			     number_of_filenames,
+			     expected_data,
+			     data_size,
+			     number_of_threads ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to test open with scan threads.\n" );
+
+				goto on_error;
+			}
+		}
+#else
+		fprintf(
+		 stdout,
+		 "Multi-threading not supported, reading and scanning with multiple threads not tested.\n" );
+#endif
+		memory_free(
+		 expected_data );
+
+		expected_data = NULL;
+	}
+	if( libewf_handle_close(
+	     handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		goto on_error;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( handle != NULL )
+	{
+		libewf_handle_close(
+		 handle,
+		 NULL );
+		libewf_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,699 @@
+/*
+ * Library read with different buffer and cache sizes testing program
+ *
+ * Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include <stdio.h>
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcstring.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+/* Define to make ewf_test_read_sizes generate verbose output
+#define EWF_TEST_READ_SIZES_VERBOSE
+ */
+
+/* The buffer size is deliberately not a multiple of the chunk size
+ * so that the buffers contain partial chunks
+ */
+#define EWF_TEST_READ_SIZES_BUFFER_SIZE		5000
+#define EWF_TEST_READ_SIZES_MAXIMUM_SIZE	( 32 * 1024 * 1024 )
+
+typedef int (*ewf_test_get_size_function_t)(
+             libewf_handle_t *handle,
+             size64_t *size,
+             libewf_error_t **error );
+
+typedef int (*ewf_test_set_size_function_t)(
+             libewf_handle_t *handle,
+             size64_t size,
+             libewf_error_t **error );
+
+typedef struct ewf_test_size_setting ewf_test_size_setting_t;
+
+struct ewf_test_size_setting
+{
+	/* The name
+	 */
+	const char *name;
+
+	/* The function to retrieve the size
+	 */
+	ewf_test_get_size_function_t get_size;
+
+	/* The function to set the size
+	 */
+	ewf_test_set_size_function_t set_size;
+
+	/* A size other than 0 and the default size
+	 */
+	size64_t size;
+};
+
+#define EWF_TEST_READ_SIZES_NUMBER_OF_SETTINGS	4
+
+/* The size settings of the buffers and caches used when reading
+ */
+ewf_test_size_setting_t ewf_test_read_sizes_settings[ EWF_TEST_READ_SIZES_NUMBER_OF_SETTINGS ] = {
+	{ "packed chunk table",
+	  libewf_handle_get_packed_chunk_table_size,
+	  libewf_handle_set_packed_chunk_table_size,
+	  64 * 1024 },
+	{ "buffer pool",
+	  libewf_handle_get_buffer_pool_size,
+	  libewf_handle_set_buffer_pool_size,
+	  256 * 1024 },
+	{ "compressed chunk cache",
+	  libewf_handle_get_compressed_chunk_cache_size,
+	  libewf_handle_set_compressed_chunk_cache_size,
+	  256 * 1024 },
+	{ "read-ahead buffer",
+	  libewf_handle_get_read_ahead_buffer_size,
+	  libewf_handle_set_read_ahead_buffer_size,
+	  1024 * 1024 } };
+
+/* Opens a handle
+ * The chunk cache is limited to a single chunk and chunk group so that
+ * the data is read through the buffers and caches of the size setting
+ * A size index of 0 represents a size of 0, 1 the default size
+ * and 2 the size of the size setting
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_open_handle(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     ewf_test_size_setting_t *size_setting,
+     int size_index,
+     size64_t *size,
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create handle.\n" );
+
+		goto on_error;
+	}
+	if( size_setting != NULL )
+	{
+		if( libewf_handle_set_cache_size(
+		     *handle,
+		     1,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set cache size.\n" );
+
+			goto on_error;
+		}
+		if( size_index == 0 )
+		{
+			*size = 0;
+		}
+		else if( size_index == 1 )
+		{
+			if( size_setting->get_size(
+			     *handle,
+			     size,
+			     &error ) != 1 )
+			{
+				fprintf(
+				 stderr,
+				 "Unable to retrieve default %s size.\n",
+				 size_setting->name );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			*size = size_setting->size;
+		}
+		if( size_setting->set_size(
+		     *handle,
+		     *size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set %s size.\n",
+			 size_setting->name );
+
+			goto on_error;
+		}
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *handle,
+	     filenames,
+	     number_of_filenames,
+	     LIBEWF_OPEN_READ,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open file(s).\n" );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( *handle != NULL )
+	{
+		libewf_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_close_handle(
+     libewf_handle_t **handle )
+{
+	libewf_error_t *error = NULL;
+	int result            = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	if( libewf_handle_close(
+	     *handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free handle.\n" );
+
+		result = -1;
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data with libewf_handle_read_buffer_at_offset
+ * The buffers are read backwards if requested so that the chunks
+ * are accessed in a different order
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_read_data(
+     libewf_handle_t *handle,
+     uint8_t *data,
+     size64_t data_size,
+     int read_backwards )
+{
+	libewf_error_t *error      = NULL;
+	off64_t offset             = 0;
+	size64_t buffer_index      = 0;
+	size64_t number_of_buffers = 0;
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	int result                 = 1;
+
+	if( handle == NULL )
+	{
+		return( -1 );
+	}
+	number_of_buffers = ( data_size + EWF_TEST_READ_SIZES_BUFFER_SIZE - 1 )
+	                  / EWF_TEST_READ_SIZES_BUFFER_SIZE;
+
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( read_backwards == 0 )
+		{
+			offset = (off64_t) ( buffer_index * EWF_TEST_READ_SIZES_BUFFER_SIZE );
+		}
+		else
+		{
+			offset = (off64_t) ( ( number_of_buffers - buffer_index - 1 ) * EWF_TEST_READ_SIZES_BUFFER_SIZE );
+		}
+		read_size = EWF_TEST_READ_SIZES_BUFFER_SIZE;
+
+		if( ( data_size - offset ) < (size64_t) read_size )
+		{
+			read_size = (size_t) ( data_size - offset );
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              &( data[ offset ] ),
+		              read_size,
+		              offset,
+		              &error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read buffer at offset: %" PRIi64 ".\n",
+			 offset );
+
+			result = -1;
+
+			break;
+		}
+	}
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Reads the data with a specific size setting and compares it with the data read with the default sizes
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int ewf_test_read_size(
+     libcstring_system_character_t * const filenames[],
+     int number_of_filenames,
+     const uint8_t *expected_data,
+     size64_t data_size,
+     ewf_test_size_setting_t *size_setting,
+     int size_index )
+{
+	libewf_handle_t *handle = NULL;
+	uint8_t *data           = NULL;
+	size64_t size           = 0;
+	int read_backwards      = 0;
+	int result              = 1;
+
+	data = (uint8_t *) memory_allocate(
+	                    (size_t) data_size );
+
+	if( data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create data.\n" );
+
+		goto on_error;
+	}
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     size_setting,
+	     size_index,
+	     &size,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Testing read with %s size: %" PRIu64 "\t",
+	 size_setting->name,
+	 size );
+
+	/* The data is read forwards to trigger the sequential read handling
+	 * and backwards to defeat it
+	 */
+	for( read_backwards = 0;
+	     read_backwards <= 1;
+	     read_backwards++ )
+	{
+		if( memory_set(
+		     data,
+		     0,
+		     (size_t) data_size ) == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to clear data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     data,
+		     data_size,
+		     read_backwards ) != 1 )
+		{
+			goto on_error;
+		}
+		if( memory_compare(
+		     data,
+		     expected_data,
+		     (size_t) data_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	memory_free(
+	 data );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 stdout,
+		 "(PASS)\n" );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "(FAIL)\n" );
+	}
+	return( result );
+
+on_error:
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	fprintf(
+	 stdout,
+	 "(FAIL)\n" );
+
+	return( -1 );
+}
+
+/* The main program
+ */
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	wchar_t **filenames     = NULL;
+#else
+	char **filenames        = NULL;
+#endif
+	libewf_error_t *error   = NULL;
+	libewf_handle_t *handle = NULL;
+	uint8_t *expected_data  = NULL;
+	size64_t data_size      = 0;
+	size64_t media_size     = 0;
+	size64_t size           = 0;
+	int number_of_filenames = 0;
+	int setting_index       = 0;
+	int size_index          = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filename(s).\n" );
+
+		return( EXIT_FAILURE );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( EWF_TEST_READ_SIZES_VERBOSE )
+	libewf_notify_set_verbose(
+	 1 );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide(
+	     argv[ 1 ],
+	     libcstring_wide_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob(
+	     argv[ 1 ],
+	     libcstring_narrow_string_length(
+	      argv[ 1 ] ),
+	     LIBEWF_FORMAT_UNKNOWN,
+	     &filenames,
+	     &number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to glob filenames.\n" );
+
+		goto on_error;
+	}
+	if( number_of_filenames <= 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Missing filenames.\n" );
+
+		goto on_error;
+	}
+	/* The data read with the default sizes is used as the reference
+	 */
+	if( ewf_test_open_handle(
+	     filenames,
+	     number_of_filenames,
+	     NULL,
+	     0,
+	     &size,
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open handle.\n" );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve media size.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Media size: %" PRIu64 " bytes\n",
+	 media_size );
+
+	/* The data is read into memory hence the size of the tested data is limited
+	 */
+	data_size = media_size;
+
+	if( data_size > (size64_t) EWF_TEST_READ_SIZES_MAXIMUM_SIZE )
+	{
+		data_size = (size64_t) EWF_TEST_READ_SIZES_MAXIMUM_SIZE;
+	}
+	if( data_size > 0 )
+	{
+		expected_data = (uint8_t *) memory_allocate(
+		                             (size_t) data_size );
+
+		if( expected_data == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create expected data.\n" );
+
+			goto on_error;
+		}
+		if( ewf_test_read_data(
+		     handle,
+		     expected_data,
+		     data_size,
+		     0 ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read data with the default sizes.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ewf_test_close_handle(
+	     &handle ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close handle.\n" );
+
+		goto on_error;
+	}
+	if( data_size > 0 )
+	{
+		for( setting_index = 0;
+		     setting_index < EWF_TEST_READ_SIZES_NUMBER_OF_SETTINGS;
+		     setting_index++ )
+		{
+			for( size_index = 0;
+			     size_index < 3;
+			     size_index++ )
+			{
+				if( ewf_test_read_size(
+				     filenames,
+				     number_of_filenames,
+				     expected_data,
+				     data_size,
+				     &( ewf_test_read_sizes_settings[ setting_index ] ),
+				     size_index ) != 1 )
+				{
+					goto on_error;
+				}
+			}
+		}
+		memory_free(
+		 expected_data );
+
+		expected_data = NULL;
+	}
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_glob_wide_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#else
+	if( libewf_glob_free(
+	     filenames,
+	     number_of_filenames,
+	     &error ) != 1 )
+#endif
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libewf_error_backtrace_fprint(
+		 error,
+		 stderr );
+		libewf_error_free(
+		 &error );
+	}
+	if( expected_data != NULL )
+	{
+		memory_free(
+		 expected_data );
+	}
+	if( handle != NULL )
+	{
+		ewf_test_close_handle(
+		 &handle );
+	}
+	if( filenames != NULL )
+	{
+#if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
+		libewf_glob_wide_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#else
+		libewf_glob_free(
+		 filenames,
+		 number_of_filenames,
+		 NULL );
+#endif
+	}
+	return( EXIT_FAILURE );
+}
+
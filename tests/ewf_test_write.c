@@ -38,6 +38,10 @@
 #define EWF_TEST_WRITE_VERBOSE
  */
 
+/* The acquiry and system date written to the header values
+ */
+#define EWF_TEST_WRITE_DATE	"2014 1 1 0 0 0"
+
 /* Tests writing data of media size to EWF file(s) with a maximum segment size
  * Return 1 if successful, 0 if not or -1 on error
  */
@@ -47,6 +51,7 @@ int ewf_test_write(
      size64_t maximum_segment_size,
      int8_t compression_level,
      uint8_t compression_flags,
+     int number_of_compression_threads,
      libcerror_error_t **error )
 {
 	libewf_handle_t *handle = NULL;
@@ -69,6 +74,25 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( number_of_compression_threads > 0 )
+	{
+		if( libewf_handle_set_number_of_compression_threads(
+		     handle,
+		     number_of_compression_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable set number of compression threads.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 #if defined( LIBCSTRING_HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
 	     handle,
@@ -143,6 +167,44 @@ int ewf_test_write(
 
 		goto on_error;
 	}
+	/* The dates are set so that the segment files are identical for every run
+	 */
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "acquiry_date",
+	     12,
+	     (uint8_t *) EWF_TEST_WRITE_DATE,
+	     libcstring_narrow_string_length(
+	      EWF_TEST_WRITE_DATE ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set header value: acquiry_date.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     handle,
+	     (uint8_t *) "system_date",
+	     11,
+	     (uint8_t *) EWF_TEST_WRITE_DATE,
+	     libcstring_narrow_string_length(
+	      EWF_TEST_WRITE_DATE ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable set header value: system_date.",
+		 function );
+
+		goto on_error;
+	}
 	buffer = (uint8_t *) memory_allocate(
 	                      EWF_TEST_BUFFER_SIZE );
 
@@ -336,11 +398,13 @@ int main( int argc, char * const argv[] )
 	libcstring_system_character_t *option_compression_level    = NULL;
 	libcstring_system_character_t *option_maximum_segment_size = NULL;
 	libcstring_system_character_t *option_media_size           = NULL;
+	libcstring_system_character_t *option_number_of_threads    = NULL;
 	libcerror_error_t *error                                    = NULL;
 	libcstring_system_integer_t option                         = 0;
 	size64_t chunk_size                                        = 0;
 	size64_t maximum_segment_size                              = 0;
 	size64_t media_size                                        = 0;
+	uint64_t number_of_threads                                 = 0;
 	size_t string_length                                       = 0;
 	uint8_t compression_flags                                  = 0;
 	int8_t compression_level                                   = LIBEWF_COMPRESSION_NONE;
@@ -348,7 +412,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:S:" ) ) ) != (libcstring_system_integer_t) -1 )
+	                   _LIBCSTRING_SYSTEM_STRING( "b:B:c:j:S:" ) ) ) != (libcstring_system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -376,6 +440,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (libcstring_system_integer_t) 'j':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (libcstring_system_integer_t) 'S':
 				option_maximum_segment_size = optarg;
 
@@ -493,12 +562,40 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_number_of_threads != NULL )
+	{
+		string_length = libcstring_system_string_length(
+				 option_number_of_threads );
+
+		if( ( libcsystem_string_decimal_copy_to_64_bit(
+		       option_number_of_threads,
+		       string_length + 1,
+		       &number_of_threads,
+		       &error ) != 1 )
+		 || ( number_of_threads > 32 ) )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+#if !defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( number_of_threads > 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Multi-threading support not available, writing without compression threads.\n" );
+		}
+#endif
+	}
 	if( ewf_test_write(
 	     argv[ optind ],
 	     media_size,
 	     maximum_segment_size,
 	     compression_level,
 	     compression_flags,
+	     (int) number_of_threads,
 	     &error ) != 1 )
 	{
 		fprintf(
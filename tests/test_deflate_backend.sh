@@ -0,0 +1,85 @@
+#!/bin/bash
+#
+# Expert Witness Compression Format (EWF) library deflate backend testing script
+#
+# Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TMP="tmp";
+
+test_deflate_backend()
+{ 
+	rm -rf ${TMP};
+	mkdir ${TMP};
+
+	${TEST_RUNNER} ./${EWF_TEST_DEFLATE_BACKEND} ${TMP}/deflate_backend;
+
+	RESULT=$?;
+
+	rm -rf ${TMP};
+
+	echo -n "Testing deflate backends ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+EWF_TEST_DEFLATE_BACKEND="ewf_test_deflate_backend";
+
+if ! test -x ${EWF_TEST_DEFLATE_BACKEND};
+then
+	EWF_TEST_DEFLATE_BACKEND="ewf_test_deflate_backend.exe";
+fi
+
+if ! test -x ${EWF_TEST_DEFLATE_BACKEND};
+then
+	echo "Missing executable: ${EWF_TEST_DEFLATE_BACKEND}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TEST_RUNNER="tests/test_runner.sh";
+
+if ! test -x ${TEST_RUNNER};
+then
+	TEST_RUNNER="./test_runner.sh";
+fi
+
+if ! test -x ${TEST_RUNNER};
+then
+	echo "Missing test runner: ${TEST_RUNNER}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test_deflate_backend
+then
+	exit ${EXIT_FAILURE};
+fi
+
+exit ${EXIT_SUCCESS};
+
@@ -139,6 +139,68 @@ test_acquire_unattended_file()
 	return ${RESULT};
 }
 
+test_acquire_unattended_file_multi_thread()
+{ 
+	INPUT_FILE=$1;
+	OUTPUT_FORMAT=$2;
+	COMPRESSION_METHOD=$3;
+	COMPRESSION_LEVEL=$4;
+	MAXIMUM_SEGMENT_SIZE=$5;
+	CHUNK_SIZE=$6;
+	NUMBER_OF_THREADS=$7;
+	ACQUIRY_OPTIONS=$8;
+
+	OPTIONS="-C case_number -D description -E evidence_number -e examiner -N notes -m removable -M logical -c ${COMPRESSION_METHOD}:${COMPRESSION_LEVEL} -f ${OUTPUT_FORMAT} -S ${MAXIMUM_SEGMENT_SIZE} -b ${CHUNK_SIZE} ${ACQUIRY_OPTIONS}";
+
+	mkdir ${TMP};
+	mkdir ${TMP}/serial;
+	mkdir ${TMP}/threads;
+
+	${EWFACQUIRE} -q -u -d sha1 -t ${TMP}/serial/unattended_acquire ${OPTIONS} ${INPUT_FILE} > ${TMP}/serial.log;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFACQUIRE} -q -u -d sha1 -t ${TMP}/threads/unattended_acquire ${OPTIONS} -j ${NUMBER_OF_THREADS} ${INPUT_FILE} > ${TMP}/threads.log;
+
+		RESULT=$?;
+	fi
+	# The digests (hashes) calculated, the digests stored and the verification
+	# of the multi-threaded acquiry must match those of the single-threaded acquiry
+	for MODE in serial threads;
+	do
+		if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+		then
+			sed -n '/hash calculated over data/p' ${TMP}/${MODE}.log > ${TMP}/${MODE}.hashes;
+
+			${EWFVERIFY} -q -d sha1 ${TMP}/${MODE}/unattended_acquire.* > ${TMP}/${MODE}.verify;
+
+			RESULT=$?;
+
+			sed '1,2d;/second(s)/d' ${TMP}/${MODE}.verify >> ${TMP}/${MODE}.hashes;
+		fi
+	done
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		cmp -s ${TMP}/serial.hashes ${TMP}/threads.hashes;
+
+		RESULT=$?;
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing unattended ewfacquire of raw input: ${INPUT_FILE} to ewf format: ${OUTPUT_FORMAT} with compression: ${COMPRESSION_METHOD}:${COMPRESSION_LEVEL}, chunk size: ${CHUNK_SIZE}, ${NUMBER_OF_THREADS} threads and acquiry options: ${ACQUIRY_OPTIONS} ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 EWFACQUIRE="../ewftools/ewfacquire";
 
 if ! test -x ${EWFACQUIRE};
@@ -308,6 +370,33 @@ do
 	done
 done
 
+for FILENAME in `${LS} ${INPUT}/*.[rR][aA][wW] | ${TR} ' ' '\n'`;
+do
+	for NUMBER_OF_THREADS in 1 4;
+	do
+		for FORMAT in encase6 encase7-v2;
+		do
+			for COMPRESSION_LEVEL in none empty-block fast best;
+			do
+				if ! test_acquire_unattended_file_multi_thread "${FILENAME}" "${FORMAT}" deflate "${COMPRESSION_LEVEL}" 1MiB 64 "${NUMBER_OF_THREADS}" "";
+				then
+					exit ${EXIT_FAILURE};
+				fi
+			done
+		done
+	done
+
+	# The device handle reads ahead from the acquiry offset up to the end of the acquiry size
+	# where the last buffer read ahead can be smaller than the process buffer
+	for ACQUIRY_OPTIONS in "-B 512" "-o 512 -B 99840" "-o 32768";
+	do
+		if ! test_acquire_unattended_file_multi_thread "${FILENAME}" encase6 deflate fast 1MiB 64 4 "${ACQUIRY_OPTIONS}";
+		then
+			exit ${EXIT_FAILURE};
+		fi
+	done
+done
+
 for FILENAME in `${LS} ${INPUT_MORE}/*.[rR][aA][wW] | ${TR} ' ' '\n'`;
 do
 	for COMPRESSION_LEVEL in none empty-block fast best;
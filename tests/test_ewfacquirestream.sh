@@ -81,6 +81,85 @@ test_acquire_file()
 	return ${RESULT};
 }
 
+acquire_stream()
+{
+	INPUT_FILE=$1;
+	INPUT_MODE=$2;
+	TARGET=$3;
+	shift 3;
+
+	# Piped input has an unknown size
+	if test ${INPUT_MODE} = "pipe";
+	then
+		cat ${INPUT_FILE} | ${EWFACQUIRESTREAM} -q -d sha1 -t ${TARGET} $*;
+	else
+		${EWFACQUIRESTREAM} -q -d sha1 -t ${TARGET} $* < ${INPUT_FILE};
+	fi
+}
+
+test_acquire_file_multi_thread()
+{ 
+	INPUT_FILE=$1;
+	INPUT_MODE=$2;
+	OUTPUT_FORMAT=$3;
+	COMPRESSION_METHOD=$4;
+	COMPRESSION_LEVEL=$5;
+	MAXIMUM_SEGMENT_SIZE=$6;
+	CHUNK_SIZE=$7;
+	NUMBER_OF_THREADS=$8;
+	QUEUE_DEPTH=$9;
+
+	OPTIONS="-C case_number -D description -E evidence_number -e examiner -N notes -m removable -M logical -c ${COMPRESSION_METHOD}:${COMPRESSION_LEVEL} -f ${OUTPUT_FORMAT} -S ${MAXIMUM_SEGMENT_SIZE} -b ${CHUNK_SIZE}";
+
+	mkdir ${TMP};
+	mkdir ${TMP}/serial;
+	mkdir ${TMP}/threads;
+
+	acquire_stream ${INPUT_FILE} ${INPUT_MODE} ${TMP}/serial/acquirestream ${OPTIONS} > ${TMP}/serial.log;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		acquire_stream ${INPUT_FILE} ${INPUT_MODE} ${TMP}/threads/acquirestream ${OPTIONS} -j ${NUMBER_OF_THREADS} -Q ${QUEUE_DEPTH} > ${TMP}/threads.log;
+
+		RESULT=$?;
+	fi
+	# The digests (hashes) calculated, the digests stored and the verification
+	# of the multi-threaded acquiry must match those of the single-threaded acquiry
+	for MODE in serial threads;
+	do
+		if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+		then
+			sed -n '/hash calculated over data/p' ${TMP}/${MODE}.log > ${TMP}/${MODE}.hashes;
+
+			${EWFVERIFY} -q -d sha1 ${TMP}/${MODE}/acquirestream.* > ${TMP}/${MODE}.verify;
+
+			RESULT=$?;
+
+			sed '1,2d;/second(s)/d' ${TMP}/${MODE}.verify >> ${TMP}/${MODE}.hashes;
+		fi
+	done
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		cmp -s ${TMP}/serial.hashes ${TMP}/threads.hashes;
+
+		RESULT=$?;
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfacquirestream of ${INPUT_MODE} raw input: ${INPUT_FILE} to ewf format: ${OUTPUT_FORMAT} with compression: ${COMPRESSION_METHOD}:${COMPRESSION_LEVEL}, chunk size: ${CHUNK_SIZE}, ${NUMBER_OF_THREADS} threads and queue depth: ${QUEUE_DEPTH} ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 EWFACQUIRESTREAM="../ewftools/ewfacquirestream";
 
 if ! test -x ${EWFACQUIRESTREAM};
@@ -181,5 +260,25 @@ do
 	done
 done
 
+for FILENAME in `${LS} ${INPUT}/*.[rR][aA][wW] | ${TR} ' ' '\n'`;
+do
+	for INPUT_MODE in file pipe;
+	do
+		for FORMAT in encase6 encase7-v2;
+		do
+			for COMPRESSION_LEVEL in none empty-block fast best;
+			do
+				for QUEUE_DEPTH in 1 16;
+				do
+					if ! test_acquire_file_multi_thread "${FILENAME}" "${INPUT_MODE}" "${FORMAT}" deflate "${COMPRESSION_LEVEL}" 1MiB 64 4 "${QUEUE_DEPTH}";
+					then
+						exit ${EXIT_FAILURE};
+					fi
+				done
+			done
+		done
+	done
+done
+
 exit ${EXIT_SUCCESS};
 
@@ -125,6 +125,80 @@ test_export_unattended()
 	return ${RESULT};
 }
 
+test_export_unattended_multi_thread()
+{ 
+	INPUT_FILE=$1;
+	OUTPUT_FORMAT=$2;
+	NUMBER_OF_THREADS=$3;
+
+	OPTIONS="-c deflate:fast -f ${OUTPUT_FORMAT}";
+
+	mkdir ${TMP};
+	mkdir ${TMP}/serial;
+	mkdir ${TMP}/threads;
+
+	${EWFEXPORT} -q -u -d sha1 -t ${TMP}/serial/unattended_export ${OPTIONS} ${INPUT_FILE} > ${TMP}/serial.log;
+
+	RESULT=$?;
+
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		${EWFEXPORT} -q -u -d sha1 -t ${TMP}/threads/unattended_export ${OPTIONS} -j ${NUMBER_OF_THREADS} ${INPUT_FILE} > ${TMP}/threads.log;
+
+		RESULT=$?;
+	fi
+	# The digests (hashes) calculated by the digest threads and the exported data
+	# must match those of the single-threaded export
+	for MODE in serial threads;
+	do
+		if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+		then
+			sed -n '/hash calculated over data/p' ${TMP}/${MODE}.log > ${TMP}/${MODE}.hashes;
+
+			if [ "${OUTPUT_FORMAT}" != "raw" ];
+			then
+				${EWFVERIFY} -q -d sha1 ${TMP}/${MODE}/unattended_export.* > ${TMP}/${MODE}.verify;
+
+				RESULT=$?;
+
+				sed '1,2d;/second(s)/d' ${TMP}/${MODE}.verify >> ${TMP}/${MODE}.hashes;
+			fi
+		fi
+	done
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ];
+	then
+		cmp -s ${TMP}/serial.hashes ${TMP}/threads.hashes;
+
+		RESULT=$?;
+	fi
+	if [ ${RESULT} -eq ${EXIT_SUCCESS} ] && [ "${OUTPUT_FORMAT}" = "raw" ];
+	then
+		for FILE in `${LS} ${TMP}/serial`;
+		do
+			cmp -s ${TMP}/serial/${FILE} ${TMP}/threads/${FILE};
+
+			RESULT=$?;
+
+			if [ ${RESULT} -ne ${EXIT_SUCCESS} ];
+			then
+				break;
+			fi
+		done
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing ewfexport of input: ${INPUT_FILE} to ewf format: ${OUTPUT_FORMAT} with ${NUMBER_OF_THREADS} threads ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 EWFEXPORT="../ewftools/ewfexport";
 
 if ! test -x ${EWFEXPORT};
@@ -139,6 +213,20 @@ then
 	exit ${EXIT_FAILURE};
 fi
 
+EWFVERIFY="../ewftools/ewfverify";
+
+if ! test -x ${EWFVERIFY};
+then
+	EWFVERIFY="../ewftools/ewfverify.exe";
+fi
+
+if ! test -x ${EWFVERIFY};
+then
+	echo "Missing executable: ${EWFVERIFY}";
+
+	exit ${EXIT_FAILURE};
+fi
+
 if ! test -d ${INPUT};
 then
 	echo "No ${INPUT} directory found, to test ewfexport create ${INPUT} directory and place EWF test files in directory.";
@@ -204,5 +292,19 @@ do
 	done
 done
 
+for FILENAME in `${LS} ${INPUT}/*.[esE]01 | ${TR} ' ' '\n'`;
+do
+	for NUMBER_OF_THREADS in 1 4;
+	do
+		for FORMAT in raw encase6;
+		do
+			if ! test_export_unattended_multi_thread "${FILENAME}" "${FORMAT}" "${NUMBER_OF_THREADS}";
+			then
+				exit ${EXIT_FAILURE};
+			fi
+		done
+	done
+done
+
 exit ${EXIT_SUCCESS};
 
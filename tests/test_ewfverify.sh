@@ -77,6 +77,52 @@ test_verify()
 	return ${RESULT};
 }
 
+test_verify_multi_thread()
+{ 
+	INPUT_FILE=$1;
+	NUMBER_OF_THREADS=$2;
+
+	rm -rf tmp;
+	mkdir tmp;
+
+	${TEST_RUNNER} ${EWFVERIFY} -q -d sha1 ${INPUT_FILE} > tmp/serial.log;
+
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${TEST_RUNNER} ${EWFVERIFY} -q -d sha1 -j ${NUMBER_OF_THREADS} ${INPUT_FILE} > tmp/threads.log;
+
+		RESULT=$?;
+	fi
+	# The digests (hashes) calculated by the digest threads and the verification
+	# result must match those of the single-threaded verification
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		for MODE in serial threads;
+		do
+			# Remove the version and the lines that contain the duration of the verification
+			sed '1,2d;/second(s)/d' tmp/${MODE}.log > tmp/${MODE}.hashes;
+		done
+
+		cmp -s tmp/serial.hashes tmp/threads.hashes;
+
+		RESULT=$?;
+	fi
+
+	rm -rf tmp;
+
+	echo -n "Testing ewfverify with ${NUMBER_OF_THREADS} threads of input: ${INPUT_FILE} ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 EWFVERIFY="../ewftools/ewfverify";
 
 if ! test -x ${EWFVERIFY};
@@ -158,6 +204,14 @@ else
 					then
 						exit ${EXIT_FAILURE};
 					fi
+
+					for NUMBER_OF_THREADS in 1 4;
+					do
+						if ! test_verify_multi_thread "${TESTFILE}" "${NUMBER_OF_THREADS}";
+						then
+							exit ${EXIT_FAILURE};
+						fi
+					done
 				done
 			fi
 		fi
@@ -0,0 +1,189 @@
+#!/bin/bash
+#
+# ewfverify asynchronous IO queue depth testing script
+#
+# Copyright (c) 2006-2014, Joachim Metz <joachim.metz@gmail.com>
+#
+# Refer to AUTHORS for acknowledgements.
+#
+# This software is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this software.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+# The elapsed time of every ewfverify run is printed so that the tests
+# also show the throughput of the queue depths relative to synchronous IO
+TIMEFORMAT="%R";
+
+list_contains()
+{
+	LIST=$1;
+	SEARCH=$2;
+
+	for LINE in $LIST;
+	do
+		if test $LINE = $SEARCH;
+		then
+			return ${EXIT_SUCCESS};
+		fi
+	done
+
+	return ${EXIT_FAILURE};
+}
+
+test_verify_queue_depth()
+{
+	INPUT_FILE=$1;
+	QUEUE_DEPTH=$2;
+
+	{ time ${TEST_RUNNER} ${EWFVERIFY} -q -d sha1 -Q ${QUEUE_DEPTH} ${INPUT_FILE} > tmp/verify.log 2> /dev/null; } 2> tmp/time.log;
+
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# Remove the version and the lines that contain the duration of the verification
+		sed '1,2d;/second(s)/d' tmp/verify.log > tmp/verify.${QUEUE_DEPTH}.log;
+
+		if test ${QUEUE_DEPTH} -ne 0;
+		then
+			cmp -s tmp/verify.0.log tmp/verify.${QUEUE_DEPTH}.log;
+
+			RESULT=$?;
+		fi
+	fi
+
+	ELAPSED_TIME=`tail -n 1 tmp/time.log`;
+
+	echo -n "Testing ewfverify with queue depth: ${QUEUE_DEPTH} of input: ${INPUT_FILE} (${ELAPSED_TIME} seconds)";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+test_verify()
+{
+	INPUT_FILE=$1;
+
+	rm -rf tmp;
+	mkdir tmp;
+
+	# A queue depth of 0 is the synchronous IO, the output of which is used as the reference
+	for QUEUE_DEPTH in 0 1 4 16 64;
+	do
+		if ! test_verify_queue_depth "${INPUT_FILE}" "${QUEUE_DEPTH}";
+		then
+			rm -rf tmp;
+
+			return ${EXIT_FAILURE};
+		fi
+	done
+
+	rm -rf tmp;
+
+	return ${EXIT_SUCCESS};
+}
+
+EWFVERIFY="../ewftools/ewfverify";
+
+if ! test -x ${EWFVERIFY};
+then
+	EWFVERIFY="../ewftools/ewfverify.exe";
+fi
+
+if ! test -x ${EWFVERIFY};
+then
+	echo "Missing executable: ${EWFVERIFY}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TEST_RUNNER="tests/test_runner.sh";
+
+if ! test -x ${TEST_RUNNER};
+then
+	TEST_RUNNER="./test_runner.sh";
+fi
+
+if ! test -x ${TEST_RUNNER};
+then
+	echo "Missing test runner: ${TEST_RUNNER}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if ! test -d "input";
+then
+	echo "No input directory found.";
+
+	exit ${EXIT_IGNORE};
+fi
+
+OLDIFS=${IFS};
+IFS="
+";
+
+RESULT=`ls input/* | tr ' ' '\n' | wc -l`;
+
+if test ${RESULT} -eq 0;
+then
+	echo "No files or directories found in the input directory.";
+
+	EXIT_RESULT=${EXIT_IGNORE};
+else
+	IGNORELIST="";
+
+	if test -f "input/.ewfverify/ignore";
+	then
+		IGNORELIST=`cat input/.ewfverify/ignore | sed '/^#/d'`;
+	fi
+	for TESTDIR in input/*;
+	do
+		if test -d "${TESTDIR}";
+		then
+			DIRNAME=`basename ${TESTDIR}`;
+
+			if ! list_contains "${IGNORELIST}" "${DIRNAME}";
+			then
+				if test -f "input/.ewfverify/${DIRNAME}/files";
+				then
+					TESTFILES=`cat input/.ewfverify/${DIRNAME}/files | sed "s?^?${TESTDIR}/?"`;
+				else
+					TESTFILES=`ls ${TESTDIR}/*.[ELes]01 ${TESTDIR}/*.[EL]x01 2> /dev/null`;
+				fi
+				for TESTFILE in ${TESTFILES};
+				do
+					if ! test_verify "${TESTFILE}";
+					then
+						exit ${EXIT_FAILURE};
+					fi
+				done
+			fi
+		fi
+	done
+
+	EXIT_RESULT=${EXIT_SUCCESS};
+fi
+
+IFS=${OLDIFS};
+
+exit ${EXIT_RESULT};
+
@@ -28,6 +28,8 @@ TMP="tmp";
 
 CUT="cut";
 
+MD5SUM="md5sum";
+
 test_write()
 { 
 	MEDIA_SIZE=$1;
@@ -53,6 +55,51 @@ test_write()
 	return ${RESULT};
 }
 
+test_write_compression_threads()
+{ 
+	MEDIA_SIZE=$1;
+	MAXIMUM_SEGMENT_SIZE=$2;
+	COMPRESSION_LEVEL=$3;
+	NUMBER_OF_THREADS=$4;
+
+	mkdir ${TMP};
+	mkdir ${TMP}/serial;
+	mkdir ${TMP}/threads;
+
+	./${EWF_TEST_WRITE} -B ${MEDIA_SIZE} -c `echo ${COMPRESSION_LEVEL} | ${CUT} -c 1` -S ${MAXIMUM_SEGMENT_SIZE} ${TMP}/serial/write;
+
+	RESULT=$?;
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		./${EWF_TEST_WRITE} -B ${MEDIA_SIZE} -c `echo ${COMPRESSION_LEVEL} | ${CUT} -c 1` -j ${NUMBER_OF_THREADS} -S ${MAXIMUM_SEGMENT_SIZE} ${TMP}/threads/write;
+
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		# The segment files written with compression threads must be identical to those written without
+		(cd ${TMP}/serial && ${MD5SUM} write.*) > ${TMP}/serial.md5;
+		(cd ${TMP}/threads && ${MD5SUM} write.*) > ${TMP}/threads.md5;
+
+		cmp -s ${TMP}/serial.md5 ${TMP}/threads.md5;
+
+		RESULT=$?;
+	fi
+
+	rm -rf ${TMP};
+
+	echo -n "Testing write with media size: ${MEDIA_SIZE}, maximum segment size: ${MAXIMUM_SEGMENT_SIZE}, compression level: ${COMPRESSION_LEVEL} and ${NUMBER_OF_THREADS} compression threads ";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
 test_write_chunk()
 { 
 	MEDIA_SIZE=$1;
@@ -130,6 +177,21 @@ do
 
 	echo "";
 
+	for NUMBER_OF_THREADS in 1 4;
+	do
+		if ! test_write_compression_threads 0 10000 ${COMPRESSION_LEVEL} ${NUMBER_OF_THREADS}
+		then
+			exit ${EXIT_FAILURE};
+		fi
+
+		if ! test_write_compression_threads 100000 10000 ${COMPRESSION_LEVEL} ${NUMBER_OF_THREADS}
+		then
+			exit ${EXIT_FAILURE};
+		fi
+	done
+
+	echo "";
+
 	if ! test_write_chunk 0 0 ${COMPRESSION_LEVEL}
 	then
 		exit ${EXIT_FAILURE};